@@ -55,6 +55,7 @@
 #include "api_core.h"
 #include "grid.h"
 #include "parameters.h"
+#include "profiler.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -147,6 +148,21 @@ TSG_PFNC_UI_Callback	SG_Get_UI_Callback(void)
 	return( gSG_UI_Callback );
 }
 
+//---------------------------------------------------------
+static int				_SG_UI_Callback(TSG_UI_Callback_ID ID, CSG_UI_Parameter &Param_1, CSG_UI_Parameter &Param_2)
+{
+	if( !SG_Profile_is_Enabled() )
+	{
+		return( gSG_UI_Callback(ID, Param_1, Param_2) );
+	}
+
+	double Time = SG_Profile_Get_Time(); int Result = gSG_UI_Callback(ID, Param_1, Param_2);
+
+	SG_Profile_Add("ui callbacks", SG_Profile_Get_Time() - Time);
+
+	return( Result );
+}
+
 
 ///////////////////////////////////////////////////////////
 //                                                       //
@@ -210,7 +226,7 @@ bool		SG_UI_Process_Get_Okay(bool bBlink)
 	{
 		CSG_UI_Parameter p1(gSG_UI_Progress_Lock == 0 && bBlink), p2;
 
-		return( gSG_UI_Callback(CALLBACK_PROCESS_GET_OKAY, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_PROCESS_GET_OKAY, p1, p2) != 0 );
 	}
 
 	if( gSG_UI_Progress_Lock == 0 && bBlink )
@@ -232,7 +248,7 @@ bool		SG_UI_Process_Set_Okay(bool bOkay)
 	{
 		CSG_UI_Parameter p1(bOkay), p2;
 
-		return( gSG_UI_Callback(CALLBACK_PROCESS_SET_OKAY, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_PROCESS_SET_OKAY, p1, p2) != 0 );
 	}
 
 	return( true );
@@ -245,7 +261,7 @@ bool		SG_UI_Process_Set_Busy(bool bOn, const CSG_String &Message)
 	{
 		CSG_UI_Parameter p1(bOn), p2(Message);
 
-		return( gSG_UI_Callback(CALLBACK_PROCESS_SET_BUSY, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_PROCESS_SET_BUSY, p1, p2) != 0 );
 	}
 
 	return( true );
@@ -275,7 +291,7 @@ bool		SG_UI_Process_Set_Progress(double Position, double Range)
 	{
 		CSG_UI_Parameter p1(Position), p2(Range);
 
-		return( gSG_UI_Callback(CALLBACK_PROCESS_SET_PROGRESS, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_PROCESS_SET_PROGRESS, p1, p2) != 0 );
 	}
 
 	//-----------------------------------------------------
@@ -310,7 +326,7 @@ bool		SG_UI_Process_Set_Ready(void)
 		{
 			CSG_UI_Parameter p1, p2;
 
-			return( gSG_UI_Callback(CALLBACK_PROCESS_SET_READY, p1, p2) != 0 );
+			return( _SG_UI_Callback(CALLBACK_PROCESS_SET_READY, p1, p2) != 0 );
 		}
 	}
 
@@ -328,7 +344,7 @@ void		SG_UI_Process_Set_Text(const CSG_String &Text)
 		{
 			CSG_UI_Parameter p1(Text), p2;
 
-			gSG_UI_Callback(CALLBACK_PROCESS_SET_TEXT, p1, p2);
+			_SG_UI_Callback(CALLBACK_PROCESS_SET_TEXT, p1, p2);
 		}
 		else
 		{
@@ -351,7 +367,7 @@ bool		SG_UI_Stop_Execution(bool bDialog)
 	{
 		CSG_UI_Parameter p1(bDialog), p2;
 
-		return( gSG_UI_Callback(CALLBACK_STOP_EXECUTION, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_STOP_EXECUTION, p1, p2) != 0 );
 	}
 
 	return( false );
@@ -373,7 +389,7 @@ void		SG_UI_Dlg_Message(const CSG_String &Message, const CSG_String &Caption)
 		{
 			CSG_UI_Parameter p1(Message), p2(Caption);
 
-			gSG_UI_Callback(CALLBACK_DLG_MESSAGE, p1, p2);
+			_SG_UI_Callback(CALLBACK_DLG_MESSAGE, p1, p2);
 		}
 		else
 		{
@@ -391,7 +407,7 @@ bool		SG_UI_Dlg_Continue(const CSG_String &Message, const CSG_String &Caption)
 		{
 			CSG_UI_Parameter p1(Message), p2(Caption);
 
-			return( gSG_UI_Callback(CALLBACK_DLG_CONTINUE, p1, p2) != 0 );
+			return( _SG_UI_Callback(CALLBACK_DLG_CONTINUE, p1, p2) != 0 );
 		}
 	}
 
@@ -413,7 +429,7 @@ int			SG_UI_Dlg_Error(const CSG_String &Message, const CSG_String &Caption)
 	{
 		CSG_UI_Parameter p1(Message), p2(Caption);
 
-		return( gSG_UI_Callback(CALLBACK_DLG_ERROR, p1, p2) );
+		return( _SG_UI_Callback(CALLBACK_DLG_ERROR, p1, p2) );
 	}
 
 	return( 0 );
@@ -428,7 +444,7 @@ void		SG_UI_Dlg_Info(const CSG_String &Message, const CSG_String &Caption)
 		{
 			CSG_UI_Parameter p1(Message), p2(Caption);
 
-			gSG_UI_Callback(CALLBACK_DLG_INFO, p1, p2);
+			_SG_UI_Callback(CALLBACK_DLG_INFO, p1, p2);
 		}
 		else
 		{
@@ -451,7 +467,7 @@ bool		SG_UI_Dlg_Parameters(CSG_Parameters *pParameters, const CSG_String &Captio
 	{
 		CSG_UI_Parameter p1(pParameters), p2(Caption.is_Empty() ? pParameters->Get_Name() : Caption);
 
-		return( gSG_UI_Callback(CALLBACK_DLG_PARAMETERS, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_DLG_PARAMETERS, p1, p2) != 0 );
 	}
 
 	return( true );
@@ -511,7 +527,7 @@ void		SG_UI_Msg_Add(const CSG_String &Message, bool bNewLine, TSG_UI_MSG_STYLE S
 
 			CSG_UI_Parameter p1(Message), p2(Flags);
 
-			gSG_UI_Callback(CALLBACK_MESSAGE_ADD, p1, p2);
+			_SG_UI_Callback(CALLBACK_MESSAGE_ADD, p1, p2);
 		}
 		else
 		{
@@ -538,7 +554,7 @@ void		SG_UI_Msg_Add_Execution(const CSG_String &Message, bool bNewLine, TSG_UI_M
 
 			CSG_UI_Parameter p1(Message), p2(Flags);
 
-			gSG_UI_Callback(CALLBACK_MESSAGE_ADD_EXECUTION, p1, p2);
+			_SG_UI_Callback(CALLBACK_MESSAGE_ADD_EXECUTION, p1, p2);
 		}
 		else
 		{
@@ -563,7 +579,7 @@ void		SG_UI_Msg_Add_Error(const CSG_String &Message)
 		{
 			CSG_UI_Parameter p1(Message), p2;
 
-			gSG_UI_Callback(CALLBACK_MESSAGE_ADD_ERROR, p1, p2);
+			_SG_UI_Callback(CALLBACK_MESSAGE_ADD_ERROR, p1, p2);
 		}
 		else
 		{
@@ -613,7 +629,7 @@ bool		SG_UI_DataObject_Add(CSG_Data_Object *pDataObject, int Show)
 	{
 		CSG_UI_Parameter p1(pDataObject), p2(Show);
 
-		return( gSG_UI_Callback(CALLBACK_DATAOBJECT_ADD, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_DATAOBJECT_ADD, p1, p2) != 0 );
 	}
 
 	return( false );
@@ -626,7 +642,7 @@ bool		SG_UI_DataObject_Del(CSG_Data_Object *pDataObject, bool bConfirm)
 	{
 		CSG_UI_Parameter p1(pDataObject), p2(bConfirm);
 
-		return( gSG_UI_Callback(CALLBACK_DATAOBJECT_DEL, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_DATAOBJECT_DEL, p1, p2) != 0 );
 	}
 
 	return( false );
@@ -639,7 +655,7 @@ bool		SG_UI_DataObject_Update(CSG_Data_Object *pDataObject, int Show, CSG_Parame
 	{
 		CSG_UI_Parameter p1(pDataObject->Get_Owner() ? pDataObject->Get_Owner() : pDataObject), p2(pParameters);
 
-		if( gSG_UI_Callback(CALLBACK_DATAOBJECT_UPDATE, p1, p2) != 0 )
+		if( _SG_UI_Callback(CALLBACK_DATAOBJECT_UPDATE, p1, p2) != 0 )
 		{
 			if( Show != SG_UI_DATAOBJECT_UPDATE )
 			{
@@ -660,7 +676,7 @@ bool		SG_UI_DataObject_Show(CSG_Data_Object *pDataObject, int Show)
 	{
 		CSG_UI_Parameter p1(pDataObject), p2(Show);
 
-		return( gSG_UI_Callback(CALLBACK_DATAOBJECT_SHOW, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_DATAOBJECT_SHOW, p1, p2) != 0 );
 	}
 
 	return( false );
@@ -673,7 +689,7 @@ bool		SG_UI_DataObject_asImage(CSG_Data_Object *pDataObject, CSG_Grid *pGrid)
 	{
 		CSG_UI_Parameter p1(pDataObject), p2(pGrid);
 
-		return( gSG_UI_Callback(CALLBACK_DATAOBJECT_ASIMAGE, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_DATAOBJECT_ASIMAGE, p1, p2) != 0 );
 	}
 
 	return( false );
@@ -686,7 +702,7 @@ bool		SG_UI_DataObject_Colors_Get(CSG_Data_Object *pDataObject, CSG_Colors *pCol
 	{
 		CSG_UI_Parameter p1(pDataObject), p2(pColors);
 
-		return( gSG_UI_Callback(CALLBACK_DATAOBJECT_COLORS_GET, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_DATAOBJECT_COLORS_GET, p1, p2) != 0 );
 	}
 
 	return( false );
@@ -699,7 +715,7 @@ bool		SG_UI_DataObject_Colors_Set(CSG_Data_Object *pDataObject, CSG_Colors *pCol
 	{
 		CSG_UI_Parameter p1(pDataObject), p2(pColors);
 
-		return( gSG_UI_Callback(CALLBACK_DATAOBJECT_COLORS_SET, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_DATAOBJECT_COLORS_SET, p1, p2) != 0 );
 	}
 
 	return( false );
@@ -712,7 +728,7 @@ bool		SG_UI_DataObject_Classify(CSG_Data_Object *pDataObject, const CSG_MetaData
 	{
 		CSG_UI_Parameter p1(pDataObject), p2((void *)&Options);
 
-		return( gSG_UI_Callback(CALLBACK_DATAOBJECT_CLASSIFY, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_DATAOBJECT_CLASSIFY, p1, p2) != 0 );
 	}
 
 	return( false );
@@ -725,7 +741,7 @@ bool		SG_UI_DataObject_Params_Get	(CSG_Data_Object *pDataObject, CSG_Parameters
 	{
 		CSG_UI_Parameter p1(pDataObject), p2(pParameters);
 
-		return( gSG_UI_Callback(CALLBACK_DATAOBJECT_PARAMS_GET, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_DATAOBJECT_PARAMS_GET, p1, p2) != 0 );
 	}
 
 	return( false );
@@ -738,7 +754,7 @@ bool		SG_UI_DataObject_Params_Set	(CSG_Data_Object *pDataObject, CSG_Parameters
 	{
 		CSG_UI_Parameter p1(pDataObject), p2(pParameters);
 
-		return( gSG_UI_Callback(CALLBACK_DATAOBJECT_PARAMS_SET, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_DATAOBJECT_PARAMS_SET, p1, p2) != 0 );
 	}
 
 	return( false );
@@ -751,7 +767,7 @@ bool		SG_UI_Set_Map_Extent		(double xMin, double yMin, double xMax, double yMax,
 	{
 		CSG_Rect r(xMin, yMin, xMax, yMax); CSG_UI_Parameter p1(&r), p2(Maps);
 
-		return( gSG_UI_Callback(CALLBACK_SET_MAP_EXTENT, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_SET_MAP_EXTENT, p1, p2) != 0 );
 	}
 
 	return( false );
@@ -764,7 +780,7 @@ bool		SG_UI_Diagram_Show			(class CSG_Table *pTable, class CSG_Parameters *pPara
 	{
 		CSG_UI_Parameter p1(pTable), p2(pParameters);
 
-		return( gSG_UI_Callback(CALLBACK_DIAGRAM_SHOW, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_DIAGRAM_SHOW, p1, p2) != 0 );
 	}
 
 	return( false );
@@ -777,7 +793,7 @@ bool		SG_UI_ODBC_Update			(const CSG_String &Server)
 	{
 		CSG_UI_Parameter p1(Server), p2;
 
-		return( gSG_UI_Callback(CALLBACK_DATABASE_UPDATE, p1, p2) != 0 );
+		return( _SG_UI_Callback(CALLBACK_DATABASE_UPDATE, p1, p2) != 0 );
 	}
 
 	return( false );
@@ -797,7 +813,7 @@ int			SG_UI_Window_Arrange		(int Arrange)
 	{
 		CSG_UI_Parameter p1, p2;
 
-		gSG_UI_Callback(CALLBACK_WINDOW_ARRANGE, p1, p2);
+		_SG_UI_Callback(CALLBACK_WINDOW_ARRANGE, p1, p2);
 
 		return( 1 );
 	}
@@ -812,7 +828,7 @@ void *		SG_UI_Get_Window_Main		(void)
 	{
 		CSG_UI_Parameter p1, p2;
 
-		gSG_UI_Callback(CALLBACK_GET_APP_WINDOW, p1, p2);
+		_SG_UI_Callback(CALLBACK_GET_APP_WINDOW, p1, p2);
 
 		return( p1.Pointer );
 	}
@@ -1257,6 +1257,99 @@ public:
 //---------------------------------------------------------
 #define CSG_File_Zip CSG_Archive // for backward compatibility
 
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//						Text Reader						 //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+typedef struct SSG_Text_Field
+{
+	const char		*Text;
+
+	int				Length;
+
+	bool			bQuoted;
+}
+TSG_Text_Field;
+
+//---------------------------------------------------------
+/**
+  * CSG_Text_Reader is a fast reader for large delimited text
+  * files (tables, point clouds, xyz or ascii grids). It reads
+  * the file in large blocks that are cut at line endings. The
+  * lines of a block can then be tokenized and parsed in parallel
+  * directly from the block buffer. Only single byte encodings
+  * (ANSI, UTF-8) are supported, Open() fails for files starting
+  * with a UTF-16 or UTF-32 byte order mark.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Text_Reader
+{
+public:
+
+	CSG_Text_Reader(void);
+	virtual ~CSG_Text_Reader(void);
+
+									CSG_Text_Reader		(const CSG_String &File, size_t Block_Size = 0);
+	bool							Open				(const CSG_String &File, size_t Block_Size = 0);
+	bool							Close				(void);
+
+	bool							is_Open				(void)	const	{	return( m_File.is_Open() );	}
+	bool							is_EOF				(void)	const	{	return( m_bEOF && m_Pos >= m_nBuffer );	}
+
+	sLong							Length				(void)	const	{	return( m_Length );	}
+	sLong							Tell				(void)	const	{	return( m_Offset + m_Pos );	}
+	bool							Seek				(sLong Offset);
+
+	/// Any of the given characters separates two fields. If bMerge is true, consecutive separators are treated as one, which is what you want for white space separated columns.
+	void							Set_Separators		(const CSG_String &Separators, bool bMerge = false);
+	void							Set_Comment			(char Comment)	{	m_Comment       = Comment;	}
+	void							Set_Decimal_Comma	(bool bOn)		{	m_bDecimalComma = bOn;		}
+	void							Set_Quotes			(bool bOn)		{	m_bQuotes       = bOn;		}
+
+	bool							Read_Line			(CSG_String &Line, bool bUTF8 = true);
+	bool							Skip_Lines			(int nLines);
+
+	/// Reads the next block of complete lines. Returns false if the end of file has been reached.
+	bool							Read_Block			(void);
+
+	sLong							Get_Line_Count		(void)	const	{	return( m_Lines.Get_Size() / 2 );	}
+	sLong							Get_Line_Number		(sLong Line)	const	{	return( m_Line_Number + Line + 1 );	}
+	bool							Get_Line			(sLong Line, const char *&Text, int &Length)	const;
+
+	/// Tokenizes a line of the current block. Returns the number of fields found, which might be larger than nFields. Empty and comment lines return zero. Thread-safe.
+	int								Get_Fields			(sLong Line, TSG_Text_Field *Fields, int nFields)	const;
+
+	bool							Get_Value			(const TSG_Text_Field &Field, double &Value)	const	{	return( To_Double(Field.Text, Field.Length, Value, m_bDecimalComma) );	}
+
+	static bool						To_Double			(const char *Text, int Length, double &Value, bool bDecimalComma = false);
+	static CSG_String				To_String			(const TSG_Text_Field &Field, bool bUTF8 = true);
+
+
+private:
+
+	bool							m_bEOF, m_bMerge, m_bDecimalComma, m_bQuotes, m_bSeparator[256];
+
+	char							m_Comment, *m_Buffer;
+
+	size_t							m_Block_Size, m_nBuffer, m_Pos, m_nAllocated;
+
+	sLong							m_Length, m_Offset, m_Line_Number;
+
+	CSG_Array_sLong					m_Lines;
+
+	CSG_File						m_File;
+
+
+	void							_On_Construction	(void);
+
+	bool							_Fill				(size_t nMinimum);
+
+};
+
 //---------------------------------------------------------
 SAGA_API_DLL_EXPORT bool			SG_Dir_Exists				(const CSG_String &Directory);
 SAGA_API_DLL_EXPORT bool			SG_Dir_Create				(const CSG_String &Directory, bool bFullPath = false);
@@ -1268,6 +1361,7 @@ SAGA_API_DLL_EXPORT bool			SG_Dir_List_Files			(CSG_Strings &List, const CSG_Str
 
 SAGA_API_DLL_EXPORT bool			SG_File_Exists				(const CSG_String &FileName);
 SAGA_API_DLL_EXPORT bool			SG_File_Delete				(const CSG_String &FileName);
+SAGA_API_DLL_EXPORT bool			SG_File_Rename				(const CSG_String &FileName, const CSG_String &NewName, bool bOverwrite = true);
 SAGA_API_DLL_EXPORT CSG_String		SG_File_Get_Name_Temp		(const CSG_String &Prefix);
 SAGA_API_DLL_EXPORT CSG_String		SG_File_Get_Name_Temp		(const CSG_String &Prefix, const CSG_String &Directory);
 SAGA_API_DLL_EXPORT CSG_String		SG_File_Get_Name			(const CSG_String &full_Path, bool bExtension);
@@ -63,6 +63,7 @@
 #include <wx/version.h>
 
 #include "api_core.h"
+#include "profiler.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -337,10 +338,13 @@ int CSG_File::Printf(const wchar_t *Format, ...)
 //---------------------------------------------------------
 size_t CSG_File::Read(void *Buffer, size_t Size, size_t Count) const
 {
-	return( !is_Reading() || Size == 0 || Count == 0 ? 0 : m_Mode == SG_FILE_R
-		? m_pStream_I ->Read(Buffer, Size * Count).LastRead() / Size
-		: m_pStream_IO->Read(Buffer, Size * Count).LastRead() / Size
-	);
+	size_t Bytes = !is_Reading() || Size == 0 || Count == 0 ? 0 : m_Mode == SG_FILE_R
+		? m_pStream_I ->Read(Buffer, Size * Count).LastRead()
+		: m_pStream_IO->Read(Buffer, Size * Count).LastRead();
+
+	SG_Profile_Add_Counter(SG_PROFILE_BYTES_READ, (sLong)Bytes);
+
+	return( Size > 0 ? Bytes / Size : 0 );
 }
 
 size_t CSG_File::Read(CSG_String &Buffer, size_t Size) const
@@ -369,10 +373,13 @@ size_t CSG_File::Read(CSG_String &Buffer, size_t Size) const
 //---------------------------------------------------------
 size_t CSG_File::Write(void *Buffer, size_t Size, size_t Count) const
 {
-	return( !is_Writing() || Size == 0 || Count == 0 ? 0 : m_Mode == SG_FILE_W
+	size_t Bytes = !is_Writing() || Size == 0 || Count == 0 ? 0 : m_Mode == SG_FILE_W
 		? m_pStream_O ->Write(Buffer, Size * Count).LastWrite()
-		: m_pStream_IO->Write(Buffer, Size * Count).LastWrite()
-	);
+		: m_pStream_IO->Write(Buffer, Size * Count).LastWrite();
+
+	SG_Profile_Add_Counter(SG_PROFILE_BYTES_WRITTEN, (sLong)Bytes);
+
+	return( Bytes );
 }
 
 size_t CSG_File::Write(const CSG_String &Buffer) const
@@ -1086,6 +1093,12 @@ bool			SG_File_Delete(const CSG_String &FileName)
 	return( SG_File_Exists(FileName) && wxRemoveFile(FileName.c_str()) );
 }
 
+//---------------------------------------------------------
+bool			SG_File_Rename(const CSG_String &FileName, const CSG_String &NewName, bool bOverwrite)
+{
+	return( SG_File_Exists(FileName) && wxRenameFile(FileName.c_str(), NewName.c_str(), bOverwrite) );
+}
+
 //---------------------------------------------------------
 CSG_String		SG_File_Get_Name_Temp(const CSG_String &Prefix)
 {
@@ -0,0 +1,704 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                  api_text_reader.cpp                  //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//                         agent                         //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+
+//---------------------------------------------------------
+#include <string.h>
+#include <math.h>
+#include <locale>
+#include <sstream>
+
+#include "api_core.h"
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define TEXT_BLOCK_SIZE	(16 * 1024 * 1024)
+
+//---------------------------------------------------------
+inline bool SG_Text_is_Space(char c)
+{
+	return( c == ' ' || c == '\t' || c == '\r' || c == '\n' || c == '\v' || c == '\f' );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Text_Reader::CSG_Text_Reader(void)
+{
+	_On_Construction();
+}
+
+//---------------------------------------------------------
+CSG_Text_Reader::CSG_Text_Reader(const CSG_String &File, size_t Block_Size)
+{
+	_On_Construction();
+
+	Open(File, Block_Size);
+}
+
+//---------------------------------------------------------
+void CSG_Text_Reader::_On_Construction(void)
+{
+	m_Buffer = NULL; m_nAllocated = m_nBuffer = m_Pos = 0;
+
+	m_Block_Size = TEXT_BLOCK_SIZE; m_Length = m_Offset = m_Line_Number = 0; m_bEOF = true;
+
+	m_Lines.Set_Growth(TSG_Array_Growth::SG_ARRAY_GROWTH_3);
+
+	Set_Separators("\t");
+
+	m_Comment = '\0'; m_bDecimalComma = false; m_bQuotes = true;
+}
+
+//---------------------------------------------------------
+CSG_Text_Reader::~CSG_Text_Reader(void)
+{
+	Close();
+
+	SG_FREE_SAFE(m_Buffer);
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Text_Reader::Open(const CSG_String &File, size_t Block_Size)
+{
+	Close();
+
+	m_Block_Size = Block_Size > 0 ? Block_Size : TEXT_BLOCK_SIZE;
+
+	if( !m_File.Open(File, SG_FILE_R, true) )
+	{
+		return( false );
+	}
+
+	m_Length = m_File.Length();
+
+	if( !Seek(0) )
+	{
+		Close();
+
+		return( false );
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Text_Reader::Close(void)
+{
+	m_File.Close();
+
+	m_nBuffer = m_Pos = 0; m_Length = m_Offset = m_Line_Number = 0; m_bEOF = true;
+
+	m_Lines.Set_Array(0);
+
+	if( m_nAllocated > m_Block_Size + 1 ) // don't keep an overly large buffer from very long lines
+	{
+		SG_FREE_SAFE(m_Buffer); m_nAllocated = 0;
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Text_Reader::Seek(sLong Offset)
+{
+	if( !m_File.is_Open() )
+	{
+		return( false );
+	}
+
+	m_Lines.Set_Array(0, false); m_Line_Number = 0;
+
+	if( m_nBuffer > 0 && Offset >= m_Offset && Offset <= m_Offset + (sLong)m_nBuffer ) // still in buffer
+	{
+		m_Pos = (size_t)(Offset - m_Offset);
+	}
+	else
+	{
+		if( !m_File.Seek(Offset) )
+		{
+			return( false );
+		}
+
+		m_Offset = Offset; m_nBuffer = m_Pos = 0; m_bEOF = false;
+
+		_Fill(0);
+	}
+
+	if( Offset == 0 && m_nBuffer >= 2 )
+	{
+		const unsigned char *BOM = (const unsigned char *)m_Buffer;
+
+		if( m_nBuffer >= 3 && BOM[0] == 0xEF && BOM[1] == 0xBB && BOM[2] == 0xBF ) // UTF-8
+		{
+			m_Pos = 3;
+		}
+		else if( (BOM[0] == 0xFF && BOM[1] == 0xFE) || (BOM[0] == 0xFE && BOM[1] == 0xFF) ) // UTF-16 or UTF-32 (LE)
+		{
+			return( false );
+		}
+		else if( m_nBuffer >= 4 && BOM[0] == 0x00 && BOM[1] == 0x00 && BOM[2] == 0xFE && BOM[3] == 0xFF ) // UTF-32 (BE)
+		{
+			return( false );
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Moves the unconsumed bytes to the front of the buffer and
+// appends as many bytes from file as fit into the buffer,
+// which is enlarged if it can not take nMinimum bytes.
+//---------------------------------------------------------
+bool CSG_Text_Reader::_Fill(size_t nMinimum)
+{
+	if( m_Pos > 0 )
+	{
+		m_nBuffer -= m_Pos;
+
+		if( m_nBuffer > 0 )
+		{
+			memmove(m_Buffer, m_Buffer + m_Pos, m_nBuffer);
+		}
+
+		m_Offset += m_Pos; m_Pos = 0;
+	}
+
+	if( nMinimum < m_Block_Size )
+	{
+		nMinimum = m_Block_Size;
+	}
+
+	if( m_nAllocated < nMinimum + 1 )
+	{
+		char *Buffer = (char *)SG_Realloc(m_Buffer, (nMinimum + 1) * sizeof(char));
+
+		if( !Buffer )
+		{
+			return( false );
+		}
+
+		m_Buffer = Buffer; m_nAllocated = nMinimum + 1;
+	}
+
+	if( !m_bEOF && m_nBuffer < m_nAllocated - 1 )
+	{
+		size_t nRequest = m_nAllocated - 1 - m_nBuffer, nRead = m_File.Read(m_Buffer + m_nBuffer, sizeof(char), nRequest);
+
+		m_bEOF = nRead < nRequest; m_nBuffer += nRead;
+	}
+
+	m_Buffer[m_nBuffer] = '\0';
+
+	return( m_nBuffer > 0 );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void CSG_Text_Reader::Set_Separators(const CSG_String &Separators, bool bMerge)
+{
+	memset(m_bSeparator, 0, sizeof(m_bSeparator));
+
+	CSG_Buffer Buffer(Separators.to_ASCII());
+
+	for(size_t i=0; i<Buffer.Get_Size() && Buffer[i]; i++)
+	{
+		m_bSeparator[(unsigned char)Buffer[i]] = true;
+	}
+
+	m_bMerge = bMerge;
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Text_Reader::Read_Line(CSG_String &Line, bool bUTF8)
+{
+	if( !m_File.is_Open() )
+	{
+		return( false );
+	}
+
+	m_Line_Number += Get_Line_Count(); m_Lines.Set_Array(0, false);
+
+	//-----------------------------------------------------
+	const char *End;
+
+	while( (End = (const char *)memchr(m_Buffer + m_Pos, '\n', m_nBuffer - m_Pos)) == NULL && !m_bEOF )
+	{
+		if( !_Fill(2 * (m_nBuffer - m_Pos)) )
+		{
+			return( false );
+		}
+	}
+
+	if( m_Pos >= m_nBuffer )
+	{
+		return( false ); // end of file
+	}
+
+	//-----------------------------------------------------
+	TSG_Text_Field Field; Field.Text = m_Buffer + m_Pos; Field.bQuoted = false;
+
+	size_t Next = End ? End - m_Buffer + 1 : m_nBuffer;
+
+	if( !End )
+	{
+		End = m_Buffer + m_nBuffer;
+	}
+
+	if( End > Field.Text && End[-1] == '\r' )
+	{
+		End--;
+	}
+
+	Field.Length = (int)(End - Field.Text);
+
+	Line = To_String(Field, bUTF8);
+
+	m_Pos = Next; m_Line_Number++;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Text_Reader::Skip_Lines(int nLines)
+{
+	CSG_String Line;
+
+	for(int i=0; i<nLines; i++)
+	{
+		if( !Read_Line(Line) )
+		{
+			return( false );
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Text_Reader::Read_Block(void)
+{
+	if( !m_File.is_Open() )
+	{
+		return( false );
+	}
+
+	m_Line_Number += Get_Line_Count(); m_Lines.Set_Array(0, false);
+
+	//-----------------------------------------------------
+	// fill the buffer and cut it behind the last line end,
+	// enlarge the buffer if it does not contain a single line end
+
+	size_t End = 0;
+
+	for(size_t nMinimum=0; ; nMinimum=2*m_nAllocated)
+	{
+		if( !_Fill(nMinimum) )
+		{
+			return( false );
+		}
+
+		for(size_t i=m_nBuffer; !End && i>m_Pos; i--)
+		{
+			if( m_Buffer[i - 1] == '\n' )
+			{
+				End = i;
+			}
+		}
+
+		if( End || m_bEOF )
+		{
+			break;
+		}
+	}
+
+	if( !End )
+	{
+		End = m_nBuffer;
+	}
+
+	//-----------------------------------------------------
+	for(size_t i=m_Pos; i<End; )
+	{
+		const char *p = (const char *)memchr(m_Buffer + i, '\n', End - i);
+
+		size_t j = p ? p - m_Buffer : End, e = j;
+
+		if( e > i && m_Buffer[e - 1] == '\r' )
+		{
+			e--;
+		}
+
+		m_Lines += (sLong)i; m_Lines += (sLong)e;
+
+		i = j + 1;
+	}
+
+	m_Pos = End;
+
+	return( Get_Line_Count() > 0 );
+}
+
+//---------------------------------------------------------
+bool CSG_Text_Reader::Get_Line(sLong Line, const char *&Text, int &Length)	const
+{
+	if( Line >= 0 && Line < Get_Line_Count() )
+	{
+		Text   = m_Buffer + m_Lines[2 * Line];
+		Length = (int)(m_Lines[2 * Line + 1] - m_Lines[2 * Line]);
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+int CSG_Text_Reader::Get_Fields(sLong Line, TSG_Text_Field *Fields, int nFields)	const
+{
+	const char *p; int Length;
+
+	if( !Get_Line(Line, p, Length) )
+	{
+		return( 0 );
+	}
+
+	const char *e = p + Length;
+
+	#define IS_SEPARATOR(c)	m_bSeparator[(unsigned char)(c)]
+	#define IS_SPACE(c)		(SG_Text_is_Space(c) && !IS_SEPARATOR(c))
+
+	//-----------------------------------------------------
+	while( p < e && IS_SPACE(*p) ) { p++; }
+
+	if( m_bMerge )
+	{
+		while( p < e && (IS_SEPARATOR(*p) || IS_SPACE(*p)) ) { p++; }
+	}
+
+	if( p >= e || (m_Comment && *p == m_Comment) )
+	{
+		return( 0 ); // empty or comment
+	}
+
+	//-----------------------------------------------------
+	int Count = 0;
+
+	for(;;)
+	{
+		while( p < e && IS_SPACE(*p) ) { p++; }
+
+		TSG_Text_Field Field; Field.Text = p; Field.bQuoted = false;
+
+		if( m_bQuotes && p < e && *p == '\"' ) // value in quotas
+		{
+			bool bInQuotes = true;
+
+			for(p++; p<e && (bInQuotes || !IS_SEPARATOR(*p)); p++)
+			{
+				if( *p == '\"' )
+				{
+					bInQuotes = !bInQuotes;
+				}
+			}
+
+			const char *q = p; while( q > Field.Text + 1 && IS_SPACE(q[-1]) ) { q--; }
+
+			if( q > Field.Text + 1 && q[-1] == '\"' )
+			{
+				q--;
+			}
+
+			Field.Text++; Field.Length = (int)(q - Field.Text); Field.bQuoted = true;
+		}
+		else
+		{
+			while( p < e && !IS_SEPARATOR(*p) ) { p++; }
+
+			const char *q = p; while( q > Field.Text && IS_SPACE(q[-1]) ) { q--; }
+
+			Field.Length = (int)(q - Field.Text);
+		}
+
+		if( Count < nFields )
+		{
+			Fields[Count] = Field;
+		}
+
+		Count++;
+
+		//-------------------------------------------------
+		if( p >= e )
+		{
+			break;
+		}
+
+		p++; // skip separator
+
+		if( m_bMerge )
+		{
+			while( p < e && (IS_SEPARATOR(*p) || IS_SPACE(*p)) ) { p++; }
+
+			if( p >= e )
+			{
+				break;
+			}
+		}
+	}
+
+	#undef IS_SEPARATOR
+	#undef IS_SPACE
+
+	return( Count );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Parses a decimal floating point number without any
+// locale dependency. The complete text (except of leading
+// and trailing white space) has to be a valid number. For
+// mantissas up to 2^53 and small exponents (which covers
+// usual coordinates and measurements) the result is exact.
+// Longer digit strings and larger exponents would be
+// rounded twice, these are passed to the C library's
+// correctly rounding conversion (C locale stream).
+//---------------------------------------------------------
+bool CSG_Text_Reader::To_Double(const char *Text, int Length, double &Value, bool bDecimalComma)
+{
+	static const double Pow10[23] =
+	{
+		1e0 , 1e1 , 1e2 , 1e3 , 1e4 , 1e5 , 1e6 , 1e7 , 1e8 , 1e9 , 1e10, 1e11,
+		1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22
+	};
+
+	const char *p = Text, *e = Text + Length;
+
+	while( p < e && SG_Text_is_Space(*p   ) ) { p++; }
+	while( e > p && SG_Text_is_Space(e[-1]) ) { e--; }
+
+	if( p >= e )
+	{
+		return( false );
+	}
+
+	const char *pNumber = p;
+
+	//-----------------------------------------------------
+	bool bNegative = false;
+
+	if( *p == '-' || *p == '+' )
+	{
+		bNegative = *p++ == '-';
+	}
+
+	unsigned long long Mantissa = 0; int nDigits = 0, Exponent = 0; bool bDigits = false, bTruncated = false;
+
+	for( ; p<e && *p>='0' && *p<='9'; p++)
+	{
+		bDigits = true;
+
+		if( nDigits < 19 )
+		{
+			Mantissa = 10 * Mantissa + (*p - '0'); if( Mantissa ) { nDigits++; }
+		}
+		else
+		{
+			Exponent++; bTruncated = bTruncated || *p != '0';
+		}
+	}
+
+	if( p < e && (*p == '.' || (bDecimalComma && *p == ',')) )
+	{
+		for(p++; p<e && *p>='0' && *p<='9'; p++)
+		{
+			bDigits = true;
+
+			if( nDigits < 19 )
+			{
+				Mantissa = 10 * Mantissa + (*p - '0'); if( Mantissa ) { nDigits++; } Exponent--;
+			}
+			else
+			{
+				bTruncated = bTruncated || *p != '0';
+			}
+		}
+	}
+
+	if( !bDigits )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	if( p < e && (*p == 'e' || *p == 'E') )
+	{
+		bool bNegExp = false;
+
+		if( ++p < e && (*p == '-' || *p == '+') )
+		{
+			bNegExp = *p++ == '-';
+		}
+
+		if( p >= e || *p < '0' || *p > '9' )
+		{
+			return( false );
+		}
+
+		int Exp = 0;
+
+		for( ; p<e && *p>='0' && *p<='9'; p++)
+		{
+			if( Exp < 100000 )
+			{
+				Exp = 10 * Exp + (*p - '0');
+			}
+		}
+
+		Exponent += bNegExp ? -Exp : Exp;
+	}
+
+	if( p != e )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	if( Mantissa == 0 && !bTruncated )
+	{
+		Value = 0.;
+	}
+	else if( Mantissa <= (1ull << 53) && !bTruncated && Exponent >= -22 && Exponent <= 22 )
+	{
+		Value = Exponent < 0 ? (double)Mantissa / Pow10[-Exponent] : (double)Mantissa * Pow10[Exponent];
+	}
+	else	// a single, correct rounding of the complete digit string
+	{
+		std::string Number(pNumber, e - pNumber);
+
+		if( bDecimalComma )
+		{
+			for(size_t i=0; i<Number.size(); i++) { if( Number[i] == ',' ) { Number[i] = '.'; } }
+		}
+
+		std::istringstream Stream(Number); Stream.imbue(std::locale::classic());
+
+		if( !(Stream >> Value) )	// out of range
+		{
+			Value = Exponent > 0 ? HUGE_VAL : 0.; if( bNegative ) { Value = -Value; }
+		}
+
+		return( true );
+	}
+
+	if( bNegative )
+	{
+		Value = -Value;
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+CSG_String CSG_Text_Reader::To_String(const TSG_Text_Field &Field, bool bUTF8)
+{
+	if( Field.Length < 1 )
+	{
+		return( "" );
+	}
+
+	if( bUTF8 )
+	{
+		CSG_String String(CSG_String::from_UTF8(Field.Text, Field.Length));
+
+		if( !String.is_Empty() ) // otherwise not valid UTF-8, fall back to local encoding
+		{
+			return( String );
+		}
+	}
+
+	return( CSG_String(std::string(Field.Text, Field.Length).c_str()) );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -320,9 +320,13 @@ CSG_Data_Object * CSG_Data_Manager::Add(CSG_Data_Object *pObject)
 
 		if( pCollection && pCollection->Add(pObject) )
 		{
+			pObject->Set_Memory_Access();
+
 			if( this == &g_Data_Manager ) // SAGA API's global data manager ?
 			{
 				SG_UI_DataObject_Add(pObject, SG_UI_DATAOBJECT_UPDATE); // for SAGA GUI !
+
+				SG_Data_Memory_Check();
 			}
 
 			return( pObject );
@@ -346,7 +350,8 @@ CSG_Data_Object * CSG_Data_Manager::Add(const CSG_String &File, TSG_Data_Object_
 			Type = SG_DATAOBJECT_TYPE_Table;
 		}
 
-		if( SG_File_Cmp_Extension(File, "shp"     ) )
+		if( SG_File_Cmp_Extension(File, "shp"     )
+		||  SG_File_Cmp_Extension(File, "sg-shp"  ) )
 		{
 			Type = SG_DATAOBJECT_TYPE_Shapes;
 		}
@@ -0,0 +1,550 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                    data_memory.cpp                    //
+//                                                       //
+//              Copyright (C) 2026 by agent              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "data_manager.h"
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define SG_DATA_MEMORY_TYPES	SG_DATAOBJECT_TYPE_Undefined
+
+//---------------------------------------------------------
+/**
+  * Keeps track of the memory held by data objects and
+  * spills the least recently used ones to disk, if the
+  * memory budget is exceeded. Data objects are found by
+  * the global data manager, so there is no need for an
+  * extra registry.
+*/
+//---------------------------------------------------------
+class CSG_Data_Memory
+{
+public:
+
+	static sLong				Budget, Spill_Size, Access, Peak, nSpills, nRestores, Size[SG_DATA_MEMORY_TYPES], Spilled[SG_DATA_MEMORY_TYPES];
+
+
+	//-----------------------------------------------------
+	static CSG_Data_Object *	Get_Root			(CSG_Data_Object *pObject)
+	{
+		return( pObject->Get_Owner() ? pObject->Get_Owner() : pObject );
+	}
+
+	//-----------------------------------------------------
+	static sLong				Get_Tracked			(void)
+	{
+		return( Size[SG_DATAOBJECT_TYPE_Grid] + Size[SG_DATAOBJECT_TYPE_Grids] + Size[SG_DATAOBJECT_TYPE_PointCloud] );
+	}
+
+	//-----------------------------------------------------
+	static void					Add					(TSG_Data_Object_Type Type, sLong *Bytes, sLong Change)
+	{
+		if( Type >= 0 && Type < SG_DATA_MEMORY_TYPES )
+		{
+			Bytes[Type] += Change;
+		}
+	}
+
+	//-----------------------------------------------------
+	static void					Set_Used			(CSG_Data_Object *pObject, sLong Bytes)
+	{
+		#pragma omp critical(SG_Data_Memory)
+		{
+			if( Bytes > 0 && pObject->m_Memory_Type == SG_DATAOBJECT_TYPE_Undefined )
+			{
+				pObject->m_Memory_Type = Get_Root(pObject)->Get_ObjectType();
+			}
+
+			Add(pObject->m_Memory_Type, Size, Bytes - pObject->m_Memory_Used);
+
+			pObject->m_Memory_Used = Bytes;
+
+			if( Peak < Get_Tracked() )
+			{
+				Peak = Get_Tracked();
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	static void					Set_Spilled			(CSG_Data_Object *pObject, sLong Bytes)
+	{
+		#pragma omp critical(SG_Data_Memory)
+		{
+			if( Bytes > 0 && pObject->m_Memory_Type == SG_DATAOBJECT_TYPE_Undefined )
+			{
+				pObject->m_Memory_Type = Get_Root(pObject)->Get_ObjectType();
+			}
+
+			Add(pObject->m_Memory_Type, Spilled, Bytes - pObject->m_Memory_Spilled);
+
+			if( pObject->m_Memory_Spilled <= 0 && Bytes > 0 ) { nSpills  ++; }
+			if( pObject->m_Memory_Spilled  > 0 && Bytes < 1 ) { nRestores++; }
+
+			pObject->m_Memory_Spilled = Bytes;
+		}
+	}
+
+	//-----------------------------------------------------
+	static void					Set_Type			(CSG_Data_Object *pObject, TSG_Data_Object_Type Type)
+	{
+		#pragma omp critical(SG_Data_Memory)
+		{
+			if( pObject->m_Memory_Type != Type && (pObject->m_Memory_Used > 0 || pObject->m_Memory_Spilled > 0) )
+			{
+				Add(pObject->m_Memory_Type, Size   , -pObject->m_Memory_Used   );
+				Add(pObject->m_Memory_Type, Spilled, -pObject->m_Memory_Spilled);
+				Add(                  Type, Size   ,  pObject->m_Memory_Used   );
+				Add(                  Type, Spilled,  pObject->m_Memory_Spilled);
+
+				pObject->m_Memory_Type = Type;
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	static void					Set_Access			(CSG_Data_Object *pObject)
+	{
+		#pragma omp critical(SG_Data_Memory)
+		{
+			pObject->m_Memory_Access = ++Access;
+		}
+	}
+
+	//-----------------------------------------------------
+	static bool					is_Candidate		(CSG_Data_Object *pObject)
+	{
+		CSG_Data_Object *pRoot = Get_Root(pObject);
+
+		return( pRoot->Get_Managed() > 0 && !pRoot->is_Memory_Locked() && pObject->m_Memory_Used >= Spill_Size );
+	}
+
+	//-----------------------------------------------------
+	static void					Add_Candidate		(CSG_Array_Pointer &Objects, CSG_Data_Object *pObject)
+	{
+		if( pObject && is_Candidate(pObject) )
+		{
+			Objects += pObject;
+		}
+	}
+
+	//-----------------------------------------------------
+	static bool					Get_Candidates		(CSG_Array_Pointer &Objects)
+	{
+		CSG_Data_Manager &Manager = SG_Get_Data_Manager();
+
+		for(size_t i=0; i<Manager.Grid      ().Count(); i++)
+		{
+			Add_Candidate(Objects, Manager.Grid().Get(i));
+		}
+
+		for(size_t i=0; i<Manager.Grids     ().Count(); i++)
+		{
+			CSG_Grids *pGrids = Manager.Grids().Get(i)->asGrids();
+
+			for(int z=0; z<pGrids->Get_Grid_Count(); z++)
+			{
+				Add_Candidate(Objects, pGrids->Get_Grid_Ptr(z));
+			}
+		}
+
+		for(size_t i=0; i<Manager.PointCloud().Count(); i++)
+		{
+			Add_Candidate(Objects, Manager.PointCloud().Get(i));
+		}
+
+		return( Objects.Get_Size() > 0 );
+	}
+
+	//-----------------------------------------------------
+	static sLong				Get_Access			(CSG_Data_Object *pObject)
+	{
+		return( M_GET_MAX(pObject->m_Memory_Access, Get_Root(pObject)->m_Memory_Access) );
+	}
+
+	//-----------------------------------------------------
+	static int					Compare_Access		(const void *a, const void *b)
+	{
+		sLong A = Get_Access(*(CSG_Data_Object **)a);
+		sLong B = Get_Access(*(CSG_Data_Object **)b);
+
+		return( A < B ? -1 : A > B ? 1 : 0 );
+	}
+
+	//-----------------------------------------------------
+	static bool					Check				(void)
+	{
+		if( Budget <= 0 || Get_Tracked() <= Budget )
+		{
+			return( true );
+		}
+
+		CSG_Array_Pointer Objects;
+
+		if( Get_Candidates(Objects) )
+		{
+			qsort(Objects.Get_Array(), Objects.Get_Size(), sizeof(void *), Compare_Access); // least recently used first
+
+			for(sLong i=0; i<(sLong)Objects.Get_Size() && Get_Tracked() > Budget; i++)
+			{
+				CSG_Data_Object *pObject = (CSG_Data_Object *)Objects[i]; sLong Bytes = pObject->m_Memory_Used;
+
+				if( pObject->On_Memory_Spill() )
+				{
+					SG_UI_Msg_Add_Execution(CSG_String::Format("\n%s: %s [%.2fMB]", _TL("memory budget exceeded, spilled to disk"),
+						pObject->Get_Name(), (double)Bytes / N_MEGABYTE_BYTES), false
+					);
+				}
+			}
+		}
+
+		return( Get_Tracked() <= Budget );
+	}
+
+	//-----------------------------------------------------
+	static sLong				Get_Estimate		(CSG_Table *pTable)
+	{
+		sLong Bytes = pTable->Get_Count() * (sLong)(sizeof(CSG_Table_Record) + pTable->Get_Field_Count() * 4 * sizeof(void *));
+
+		if( pTable->Get_ObjectType() == SG_DATAOBJECT_TYPE_Shapes )
+		{
+			CSG_Shapes *pShapes = pTable->asShapes(); sLong nPoints = 0;
+
+			for(sLong i=0; !pShapes->is_Deferred() && i<pShapes->Get_Count(); i++)	// don't force reading deferred shapes
+			{
+				nPoints += pShapes->Get_Shape(i)->Get_Point_Count();
+			}
+
+			Bytes += nPoints * (sLong)(sizeof(TSG_Point) + pShapes->Get_Vertex_Type() * sizeof(double));
+		}
+
+		if( pTable->Get_ObjectType() == SG_DATAOBJECT_TYPE_TIN )
+		{
+			CSG_TIN *pTIN = (CSG_TIN *)pTable;
+
+			Bytes += pTIN->Get_Edge_Count() * (sLong)sizeof(CSG_TIN_Edge) + pTIN->Get_Triangle_Count() * (sLong)sizeof(CSG_TIN_Triangle);
+		}
+
+		return( Bytes );
+	}
+
+	//-----------------------------------------------------
+	static sLong				Get_Estimate		(const CSG_Data_Collection &Objects)
+	{
+		sLong Bytes = 0;
+
+		for(size_t i=0; i<Objects.Count(); i++)
+		{
+			Bytes += Get_Estimate(Objects.Get(i)->asTable(true));
+		}
+
+		return( Bytes );
+	}
+
+};
+
+//---------------------------------------------------------
+sLong	CSG_Data_Memory::Budget                         = 0;
+sLong	CSG_Data_Memory::Spill_Size                     = 16 * N_MEGABYTE_BYTES;
+sLong	CSG_Data_Memory::Access                         = 0;
+sLong	CSG_Data_Memory::Peak                           = 0;
+sLong	CSG_Data_Memory::nSpills                        = 0;
+sLong	CSG_Data_Memory::nRestores                      = 0;
+sLong	CSG_Data_Memory::Size   [SG_DATA_MEMORY_TYPES]  = { 0 };
+sLong	CSG_Data_Memory::Spilled[SG_DATA_MEMORY_TYPES]  = { 0 };
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool	SG_Data_Memory_Set_Budget		(sLong Bytes)
+{
+	CSG_Data_Memory::Budget = Bytes > 0 ? Bytes : 0;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+sLong	SG_Data_Memory_Get_Budget		(void)
+{
+	return( CSG_Data_Memory::Budget );
+}
+
+//---------------------------------------------------------
+bool	SG_Data_Memory_Set_Budget_MB	(double MB)
+{
+	return( SG_Data_Memory_Set_Budget((sLong)(MB * N_MEGABYTE_BYTES)) );
+}
+
+//---------------------------------------------------------
+double	SG_Data_Memory_Get_Budget_MB	(void)
+{
+	return( (double)CSG_Data_Memory::Budget / N_MEGABYTE_BYTES );
+}
+
+//---------------------------------------------------------
+bool	SG_Data_Memory_Set_Spill_Size	(sLong Bytes)
+{
+	if( Bytes >= 0 )
+	{
+		CSG_Data_Memory::Spill_Size = Bytes;
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+sLong	SG_Data_Memory_Get_Spill_Size	(void)
+{
+	return( CSG_Data_Memory::Spill_Size );
+}
+
+//---------------------------------------------------------
+sLong	SG_Data_Memory_Get_Size			(TSG_Data_Object_Type Type)
+{
+	switch( Type )
+	{
+	case SG_DATAOBJECT_TYPE_Grid      :
+	case SG_DATAOBJECT_TYPE_Grids     :
+	case SG_DATAOBJECT_TYPE_PointCloud:
+		return( CSG_Data_Memory::Size[Type] );
+
+	case SG_DATAOBJECT_TYPE_Table     : return( CSG_Data_Memory::Get_Estimate(SG_Get_Data_Manager().Table ()) );
+	case SG_DATAOBJECT_TYPE_Shapes    : return( CSG_Data_Memory::Get_Estimate(SG_Get_Data_Manager().Shapes()) );
+	case SG_DATAOBJECT_TYPE_TIN       : return( CSG_Data_Memory::Get_Estimate(SG_Get_Data_Manager().TIN   ()) );
+
+	default: break;
+	}
+
+	sLong Bytes = 0;
+
+	for(int i=0; i<SG_DATA_MEMORY_TYPES; i++)
+	{
+		Bytes += SG_Data_Memory_Get_Size((TSG_Data_Object_Type)i);
+	}
+
+	return( Bytes );
+}
+
+//---------------------------------------------------------
+sLong	SG_Data_Memory_Get_Spilled		(TSG_Data_Object_Type Type)
+{
+	if( Type >= 0 && Type < SG_DATA_MEMORY_TYPES )
+	{
+		return( CSG_Data_Memory::Spilled[Type] );
+	}
+
+	sLong Bytes = 0;
+
+	for(int i=0; i<SG_DATA_MEMORY_TYPES; i++)
+	{
+		Bytes += CSG_Data_Memory::Spilled[i];
+	}
+
+	return( Bytes );
+}
+
+//---------------------------------------------------------
+bool	SG_Data_Memory_Check			(void)
+{
+	return( CSG_Data_Memory::Check() );
+}
+
+//---------------------------------------------------------
+CSG_String	SG_Data_Memory_Get_Report	(bool bObjects)
+{
+	#define MB(Bytes)	((double)(Bytes) / N_MEGABYTE_BYTES)
+
+	CSG_String Report;
+
+	Report += CSG_String::Format("%s: ", _TL("Memory Budget"));
+
+	if( CSG_Data_Memory::Budget > 0 )
+	{
+		Report += CSG_String::Format("%.2fMB (%s: %.2fMB)\n", MB(CSG_Data_Memory::Budget), _TL("spill size"), MB(CSG_Data_Memory::Spill_Size));
+	}
+	else
+	{
+		Report += CSG_String::Format("%s\n", _TL("no limit"));
+	}
+
+	Report += CSG_String::Format("%-12s %12s %12s\n", _TL("Type"), _TL("Memory [MB]"), _TL("Spilled [MB]"));
+
+	for(int i=0; i<SG_DATA_MEMORY_TYPES; i++)
+	{
+		TSG_Data_Object_Type Type = (TSG_Data_Object_Type)i;
+
+		bool bEstimate = Type == SG_DATAOBJECT_TYPE_Table || Type == SG_DATAOBJECT_TYPE_Shapes || Type == SG_DATAOBJECT_TYPE_TIN;
+
+		Report += CSG_String::Format("%-12s %12.2f %12.2f%s\n", SG_Get_DataObject_Name(Type).c_str(),
+			MB(SG_Data_Memory_Get_Size(Type)), MB(SG_Data_Memory_Get_Spilled(Type)), bEstimate ? SG_T(" (~)") : SG_T("")
+		);
+	}
+
+	Report += CSG_String::Format("%-12s %12.2f %12.2f\n", _TL("Total"), MB(SG_Data_Memory_Get_Size()), MB(SG_Data_Memory_Get_Spilled()));
+
+	Report += CSG_String::Format("%s: %.2fMB, %s: %lld, %s: %lld\n",
+		_TL("Peak (grids, point clouds)"), MB(CSG_Data_Memory::Peak),
+		_TL("spilled"), CSG_Data_Memory::nSpills, _TL("paged back in"), CSG_Data_Memory::nRestores
+	);
+
+	//-----------------------------------------------------
+	if( bObjects )
+	{
+		CSG_Data_Manager &Manager = SG_Get_Data_Manager(); CSG_Data_Collection *Collections[3] = { &Manager.Grid(), &Manager.Grids(), &Manager.PointCloud() };
+
+		for(int i=0; i<3; i++)
+		{
+			for(size_t j=0; j<Collections[i]->Count(); j++)
+			{
+				CSG_Data_Object *pObject = Collections[i]->Get(j); sLong Used = pObject->Get_Memory_Used(), Spilled = pObject->is_Memory_Spilled() ? 1 : 0;
+
+				if( pObject->Get_ObjectType() == SG_DATAOBJECT_TYPE_Grids )
+				{
+					for(int z=0; z<pObject->asGrids()->Get_Grid_Count(); z++)
+					{
+						Used    += pObject->asGrids()->Get_Grid_Ptr(z)->Get_Memory_Used();
+						Spilled += pObject->asGrids()->Get_Grid_Ptr(z)->is_Memory_Spilled() ? 1 : 0;
+					}
+				}
+
+				if( Used > 0 || Spilled > 0 )
+				{
+					Report += CSG_String::Format("  %-40s %12.2f %s%s\n", pObject->Get_Name(), MB(Used),
+						Spilled > 0 ? _TL("[spilled]") : SG_T(""), pObject->is_Memory_Locked() ? _TL("[locked]") : SG_T("")
+					);
+				}
+			}
+		}
+	}
+
+	return( Report );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                  CSG_Data_Object                      //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void CSG_Data_Object::Set_Owner(CSG_Data_Object *pOwner)
+{
+	m_pOwner = pOwner;
+
+	if( m_Memory_Type != SG_DATAOBJECT_TYPE_Undefined ) // account memory for the owner's type
+	{
+		CSG_Data_Memory::Set_Type(this, CSG_Data_Memory::Get_Root(this)->Get_ObjectType());
+	}
+}
+
+//---------------------------------------------------------
+void CSG_Data_Object::Set_Memory_Lock(bool bOn)
+{
+	#pragma omp critical(SG_Data_Memory)
+	{
+		if( bOn )
+		{
+			m_Memory_Lock++;
+		}
+		else if( m_Memory_Lock > 0 )
+		{
+			m_Memory_Lock--;
+		}
+	}
+}
+
+//---------------------------------------------------------
+void CSG_Data_Object::Set_Memory_Access(void)
+{
+	CSG_Data_Memory::Set_Access(this);
+
+	if( is_Memory_Spilled() )
+	{
+		On_Memory_Restore();
+	}
+}
+
+//---------------------------------------------------------
+void CSG_Data_Object::Set_Memory_Used(sLong Bytes)
+{
+	if( Bytes != m_Memory_Used )
+	{
+		CSG_Data_Memory::Set_Used(this, Bytes);
+	}
+}
+
+//---------------------------------------------------------
+void CSG_Data_Object::Set_Memory_Spilled(sLong Bytes)
+{
+	if( Bytes != m_Memory_Spilled )
+	{
+		if( Bytes == 0 ) // paged back in, i.e. recently used
+		{
+			CSG_Data_Memory::Set_Access(this);
+		}
+
+		CSG_Data_Memory::Set_Spilled(this, Bytes);
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
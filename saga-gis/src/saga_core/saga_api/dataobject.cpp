@@ -247,6 +247,9 @@ CSG_Data_Object::~CSG_Data_Object(void)
 {
 	Destroy();
 
+	Set_Memory_Used   (0);	// release memory accounting, if not yet done by the derived class
+	Set_Memory_Spilled(0);
+
 	#ifdef WITH_LIFETIME_TRACKER
 	#pragma omp critical
 	{
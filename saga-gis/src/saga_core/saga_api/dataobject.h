@@ -77,6 +77,7 @@
 //---------------------------------------------------------
 #include "mat_tools.h"
 #include "metadata.h"
+#include "profiler.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -160,6 +161,41 @@ SAGA_API_DLL_EXPORT void		SG_Set_History_Ignore_Lists		(int Ignore);
 SAGA_API_DLL_EXPORT int			SG_Get_History_Ignore_Lists		(void);
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Process wide memory accounting. The bytes held by grids,
+  * grid collections and point clouds are tracked exactly,
+  * those of tables, shapes and TINs are estimated for the
+  * data sets of the data manager. If a budget is set (zero
+  * means no limit), SG_Data_Memory_Check() spills the least
+  * recently used unlocked data sets that are managed by a
+  * data manager to temporary files until the budget is met.
+  * Spilled data is paged back in on access. The budget is
+  * checked at tool start and end and when data is added to
+  * the data manager.
+*/
+SAGA_API_DLL_EXPORT bool		SG_Data_Memory_Set_Budget		(sLong Bytes);
+SAGA_API_DLL_EXPORT sLong		SG_Data_Memory_Get_Budget		(void);
+SAGA_API_DLL_EXPORT bool		SG_Data_Memory_Set_Budget_MB	(double MB);
+SAGA_API_DLL_EXPORT double		SG_Data_Memory_Get_Budget_MB	(void);
+
+/** Data sets smaller than the spill size are never spilled (default 16 MB). */
+SAGA_API_DLL_EXPORT bool		SG_Data_Memory_Set_Spill_Size	(sLong Bytes);
+SAGA_API_DLL_EXPORT sLong		SG_Data_Memory_Get_Spill_Size	(void);
+
+/** Bytes held in memory, resp. spilled to disk, by data objects of given type or of all types (SG_DATAOBJECT_TYPE_Undefined). */
+SAGA_API_DLL_EXPORT sLong		SG_Data_Memory_Get_Size			(TSG_Data_Object_Type Type = SG_DATAOBJECT_TYPE_Undefined);
+SAGA_API_DLL_EXPORT sLong		SG_Data_Memory_Get_Spilled		(TSG_Data_Object_Type Type = SG_DATAOBJECT_TYPE_Undefined);
+
+SAGA_API_DLL_EXPORT bool		SG_Data_Memory_Check			(void);
+
+SAGA_API_DLL_EXPORT CSG_String	SG_Data_Memory_Get_Report		(bool bObjects = true);
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 ///////////////////////////////////////////////////////////
@@ -179,6 +215,7 @@ SAGA_API_DLL_EXPORT int			SG_Get_History_Ignore_Lists		(void);
 class SAGA_API_DLL_EXPORT CSG_Data_Object
 {
 	friend class CSG_Data_Collection;
+	friend class CSG_Data_Memory;
 
 public:
 	CSG_Data_Object(void);
@@ -229,7 +266,7 @@ public:
 	bool							Update			(bool bForce = false);
 
 	CSG_Data_Object *				Get_Owner		(void)	const				{	return( m_pOwner );		}
-	void							Set_Owner		(CSG_Data_Object *pOwner)	{	m_pOwner = pOwner;		}
+	void							Set_Owner		(CSG_Data_Object *pOwner);
 
 	CSG_MetaData &					Get_MetaData	(void)	const			{	return( *m_pMD_Source   );	}
 	CSG_MetaData &					Get_MetaData_DB	(void)	const 			{	return( *m_pMD_Database );	}
@@ -265,6 +302,17 @@ public:
 	/// Activate/deactivate lifetime tracking (data object construction/destruction). Needs compiler flag WITH_LIFETIME_TRACKER being defined.
 	static void						Track				(bool Track = true, bool Offset = false);
 
+	/// Bytes currently held in memory by this data object (only tracked for grids, grid collections and point clouds).
+	sLong							Get_Memory_Used		(void)	const	{	return( m_Memory_Used    );	}
+	bool							is_Memory_Spilled	(void)	const	{	return( m_Memory_Spilled > 0 );	}
+
+	/// A locked data object is not spilled to disk when the memory budget is exceeded. Calls can be nested.
+	void							Set_Memory_Lock		(bool bOn);
+	bool							is_Memory_Locked	(void)	const	{	return( m_Memory_Lock > 0 );	}
+
+	/// Marks the data object as recently used and pages it back in, if it has been spilled.
+	void							Set_Memory_Access	(void);
+
 
 protected:
 
@@ -287,6 +335,11 @@ protected:
 	virtual bool					On_Update			(void)				{	return( true );				}
 	virtual bool					On_NoData_Changed	(void);
 
+	void							Set_Memory_Used		(sLong Bytes);
+	void							Set_Memory_Spilled	(sLong Bytes);
+	virtual bool					On_Memory_Spill		(void)				{	return( false );			}
+	virtual bool					On_Memory_Restore	(void)				{	return( false );			}
+
 
 private:
 
@@ -296,9 +349,11 @@ private:
 
 	bool							m_bModified, m_bUpdate, m_File_bNative;
 
-	int								m_RefID, m_File_Type, m_Managed{0};
+	int								m_RefID, m_File_Type, m_Managed{0}, m_Memory_Lock{0};
+
+	sLong							m_Max_Samples, m_Memory_Used{0}, m_Memory_Spilled{0}, m_Memory_Access{0};
 
-	sLong							m_Max_Samples;
+	TSG_Data_Object_Type			m_Memory_Type{SG_DATAOBJECT_TYPE_Undefined};
 
 	double							m_NoData_Value[2];
 
@@ -216,6 +216,11 @@ void CSG_Grid::_On_Construction(void)
 	m_Cache_bSwap  = false;
 	m_Cache_bFlip  = false;
 
+	m_Spill_Offset = 0;
+	m_Spill_bSwap  = false;
+	m_Spill_bFlip  = false;
+	m_Spill_bCache = false;
+
 	m_zScale       = 1.;
 	m_zOffset      = 0.;
 
@@ -318,6 +323,8 @@ bool CSG_Grid::Create(const char       *File, TSG_Data_Type Type, bool bCached,
 bool CSG_Grid::Create(const wchar_t    *File, TSG_Data_Type Type, bool bCached, bool bLoadData) { return( Create(CSG_String(File), Type, bCached, bLoadData) ); }
 bool CSG_Grid::Create(const CSG_String &File, TSG_Data_Type Type, bool bCached, bool bLoadData)
 {
+	SG_PROFILE_SCOPE("grid load");
+
 	Destroy();
 
 	SG_UI_Msg_Add(CSG_String::Format("%s: %s...", _TL("Loading grid"), File.c_str()), true);
@@ -956,6 +963,8 @@ inline bool CSG_Grid::_Get_ValAtPos_Fill4x4Submatrix(int x, int y, double v_xy[4
 //---------------------------------------------------------
 bool CSG_Grid::On_Update(void)
 {
+	SG_PROFILE_SCOPE("grid statistics");
+
 	if( !is_Valid() )
 	{
 		return( false );
@@ -1254,6 +1263,8 @@ bool CSG_Grid::Get_Histogram(const CSG_Rect &rWorld, CSG_Histogram &Histogram, s
 //---------------------------------------------------------
 bool CSG_Grid::_Set_Index(void)
 {
+	SG_PROFILE_SCOPE("grid index");
+
 	if( m_Index == NULL && (m_Index = (sLong *)SG_Malloc((size_t)Get_NCells() * sizeof(sLong))) == NULL )
 	{
 		SG_UI_Msg_Add_Error(_TL("could not create index: insufficient memory"));
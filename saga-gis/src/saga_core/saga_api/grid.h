@@ -872,17 +872,22 @@ protected:	///////////////////////////////////////////////
 	virtual bool				On_Reload				(void);
 	virtual bool				On_Delete				(void);
 
+	virtual bool				On_Memory_Spill			(void);
+	virtual bool				On_Memory_Restore		(void);
+
 
 //---------------------------------------------------------
 private:	///////////////////////////////////////////////
 
+	friend class CSG_Simulation_State;	// raw access to 64 bit values for checkpoints
+
 	void						**m_Values;
 
-	bool						m_Cache_bTemp, m_Cache_bSwap, m_Cache_bFlip;
+	bool						m_Cache_bTemp, m_Cache_bSwap, m_Cache_bFlip, m_Spill_bSwap, m_Spill_bFlip, m_Spill_bCache;
 
 	size_t						m_nBytes_Value, m_nBytes_Line;
 
-	sLong						*m_Index, m_Cache_Offset;
+	sLong						*m_Index, m_Cache_Offset, m_Spill_Offset;
 
 	double						m_zOffset, m_zScale;
 
@@ -890,7 +895,7 @@ private:	///////////////////////////////////////////////
 
 	TSG_Data_Type				m_Type;
 
-	CSG_String					m_Unit, m_Cache_File;
+	CSG_String					m_Unit, m_Cache_File, m_Spill_File;
 
 	CSG_Simple_Statistics		m_Statistics;
 
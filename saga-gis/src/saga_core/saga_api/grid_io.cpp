@@ -151,6 +151,8 @@ bool CSG_Grid::Save(const CSG_String &File, int Format)
 		return( *Get_File_Name(false) ? Save(Get_File_Name(false), Format) : false );
 	}
 
+	SG_PROFILE_SCOPE("grid save");
+
 	SG_UI_Msg_Add(CSG_String::Format("%s %s: %s...", _TL("Saving"), _TL("grid"), File.c_str()), true);
 
 	//-----------------------------------------------------
@@ -273,6 +275,8 @@ bool CSG_Grid::_Load_External(const CSG_String &File, bool bCached, bool bLoadDa
 		m_Type           = pGrid->m_Type;
 		m_Values         = pGrid->m_Values; pGrid->m_Values = NULL; // take ownership of data array
 
+		Set_Memory_Used(pGrid->Get_Memory_Used()); pGrid->Set_Memory_Used(0);
+
 		m_zOffset        = pGrid->m_zOffset;
 		m_zScale         = pGrid->m_zScale;
 		m_Unit           = pGrid->m_Unit;
@@ -210,6 +210,8 @@ bool CSG_Grid::_Array_Create(void)
 					m_Values[y]	 = pLine;
 				}
 
+				Set_Memory_Used((sLong)Get_NY() * Get_nLineBytes());
+
 				return( true );
 			}
 
@@ -234,6 +236,8 @@ void CSG_Grid::_Array_Destroy(void)
 
 		m_Values	= NULL;
 	}
+
+	Set_Memory_Used(0);
 }
 
 
@@ -256,6 +260,15 @@ void CSG_Grid::_Array_Destroy(void)
 //---------------------------------------------------------
 bool CSG_Grid::Set_Cache(bool bOn)
 {
+	if( bOn && is_Memory_Spilled() )	// just keep the spill file as cache, the original cache source is restored with _Cache_Destroy()
+	{
+		m_Spill_bCache = true;
+
+		Set_Memory_Spilled(0);
+
+		return( true );
+	}
+
 	if( bOn )
 	{
 		return( is_Cached()
@@ -401,6 +414,19 @@ bool CSG_Grid::_Cache_Destroy(bool bMemory_Restore)
 			SG_File_Delete(m_Cache_File);
 		}
 
+		if( is_Memory_Spilled() || m_Spill_bCache )	// restore the original cache source
+		{
+			m_Cache_File   = m_Spill_File;
+			m_Cache_bTemp  = false;
+			m_Cache_Offset = m_Spill_Offset;
+			m_Cache_bSwap  = m_Spill_bSwap;
+			m_Cache_bFlip  = m_Spill_bFlip;
+
+			m_Spill_bCache = false;
+
+			Set_Memory_Spilled(0);
+		}
+
 		return( true );
 	}
 
@@ -408,6 +434,101 @@ bool CSG_Grid::_Cache_Destroy(bool bMemory_Restore)
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//						Spill							 //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Called by the memory accounting, if the memory budget is
+  * exceeded. Moves the data to a temporary cache file. The
+  * settings of a cache file source (e.g. the native grid
+  * file) are kept and restored, when the data is paged back
+  * in on the next access or, if the spill file has been kept
+  * as cache with Set_Cache(), when this cache is destroyed.
+*/
+//---------------------------------------------------------
+bool CSG_Grid::On_Memory_Spill(void)
+{
+	if( is_Cached() || !m_Values )
+	{
+		return( false );
+	}
+
+	CSG_String File = SG_File_Get_Name_Temp("sg_grd", SG_Grid_Cache_Get_Directory());
+
+	FILE *Stream = fopen(File, "w+b");
+
+	if( !Stream )
+	{
+		return( false );
+	}
+
+	for(int y=0; y<Get_NY(); y++)
+	{
+		if( fwrite(m_Values[y], 1, Get_nLineBytes(), Stream) != (size_t)Get_nLineBytes() )
+		{
+			fclose(Stream); SG_File_Delete(File);
+
+			return( false );
+		}
+	}
+
+	m_Spill_File   = m_Cache_File  ;
+	m_Spill_Offset = m_Cache_Offset;
+	m_Spill_bSwap  = m_Cache_bSwap ;
+	m_Spill_bFlip  = m_Cache_bFlip ;
+
+	m_Cache_File   = File;
+	m_Cache_bTemp  = true;
+	m_Cache_Offset = 0;
+	m_Cache_bSwap  = false;
+	m_Cache_bFlip  = false;
+
+	sLong Bytes = Get_Memory_Used();
+
+	m_Cache_Stream = Stream;
+
+	_Array_Destroy();
+
+	Set_Memory_Spilled(Bytes);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grid::On_Memory_Restore(void)
+{
+	bool bResult = false;
+
+	#pragma omp critical(CSG_Grid_Memory_Restore)
+	{
+		if( is_Memory_Spilled() && _Array_Create() )
+		{
+			bResult = !CACHE_FILE_SEEK(m_Cache_Stream, 0, SEEK_SET);
+
+			for(int y=0; bResult && y<Get_NY(); y++)
+			{
+				bResult = fread(m_Values[y], 1, Get_nLineBytes(), m_Cache_Stream) == (size_t)Get_nLineBytes();
+			}
+
+			if( bResult )
+			{
+				_Cache_Destroy(false);
+			}
+			else // keep the data spilled
+			{
+				_Array_Destroy();
+			}
+		}
+	}
+
+	return( bResult );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 ///////////////////////////////////////////////////////////
@@ -415,6 +536,16 @@ bool CSG_Grid::_Cache_Destroy(bool bMemory_Restore)
 //---------------------------------------------------------
 void CSG_Grid::_Cache_Set_Value(int x, int y, double Value)
 {
+	if( is_Memory_Spilled() || !m_Cache_Stream )	// page back in (or has just been paged back in by another thread)
+	{
+		if( On_Memory_Restore() || !is_Cached() )
+		{
+			Set_Value(x, y, Value, false);
+
+			return;
+		}
+	}
+
 	char	Buffer[8];
 
 	switch( m_Type )
@@ -447,6 +578,14 @@ void CSG_Grid::_Cache_Set_Value(int x, int y, double Value)
 //---------------------------------------------------------
 double CSG_Grid::_Cache_Get_Value(int x, int y) const
 {
+	if( is_Memory_Spilled() || !m_Cache_Stream )	// page back in (or has just been paged back in by another thread)
+	{
+		if( ((CSG_Grid *)this)->On_Memory_Restore() || !is_Cached() )
+		{
+			return( asDouble(x, y, false) );
+		}
+	}
+
 	if( !CACHE_FILE_SEEK(m_Cache_Stream, CACHE_FILE_POS(x, y), SEEK_SET) )
 	{
 		char	Buffer[8];
@@ -280,6 +280,7 @@ void CSG_Grids::_On_Construction(void)
 	m_Attributes.Set_Owner(this);
 
 	m_Index     = NULL;
+	m_Profiles  = NULL;
 
 	Destroy();
 
@@ -292,6 +293,8 @@ void CSG_Grids::_On_Construction(void)
 */
 bool CSG_Grids::Destroy(void)
 {
+	_Del_Profiles(); // before the grid system is gone
+
 	for(size_t i=1; i<m_Grids.Get_uSize(); i++)
 	{
 		delete(m_pGrids[i]); // do not delete the dummy before deconstruction
@@ -657,6 +660,11 @@ bool CSG_Grids::Update_Z_Order(void)
 		}
 	}
 
+	if( bChanged )
+	{
+		SG_FREE_SAFE(m_Index); _Del_Profiles();
+	}
+
 	return( bChanged );
 }
 
@@ -687,6 +695,7 @@ bool CSG_Grids::Set_Grid_Count(int Count)
 
 	//-----------------------------------------------------
 	SG_FREE_SAFE(m_Index);	// invalidate index
+	_Del_Profiles();
 
 	if( Count < Get_NZ() )
 	{
@@ -780,6 +789,7 @@ bool CSG_Grids::Add_Grid(CSG_Table_Record &Attributes)
 	m_Attributes.Add_Record(&Attributes);
 
 	SG_FREE_SAFE(m_Index); // invalidate index
+	_Del_Profiles();
 
 	Update_Z_Order();
 
@@ -838,6 +848,7 @@ bool CSG_Grids::Add_Grid(CSG_Table_Record &Attributes, CSG_Grid *pGrid, bool bAt
 	}
 
 	SG_FREE_SAFE(m_Index); // invalidate index
+	_Del_Profiles();
 
 	Update_Z_Order();
 
@@ -855,6 +866,7 @@ bool CSG_Grids::Del_Grid(int i, bool bDetach)
 	if( m_Attributes.Del_Record(i) ) // Get_NZ() is now decreased by one
 	{
 		SG_FREE_SAFE(m_Index); // invalidate index
+		_Del_Profiles();
 
 		if( Get_NZ() > 0 )
 		{
@@ -891,6 +903,7 @@ bool CSG_Grids::Del_Grid(int i, bool bDetach)
 bool CSG_Grids::Del_Grids(bool bDetach)
 {
 	SG_FREE_SAFE(m_Index); // invalidate index
+	_Del_Profiles();
 
 	if( bDetach )
 	{
@@ -977,6 +990,8 @@ CSG_String CSG_Grids::Get_Grid_Name(int i, int Style) const
 //---------------------------------------------------------
 void CSG_Grids::Assign_NoData(void)
 {
+	_Del_Profiles();
+
 	for(int i=0; i<Get_Grid_Count(); i++)
 	{
 		m_pGrids[i]->Assign_NoData();
@@ -986,6 +1001,8 @@ void CSG_Grids::Assign_NoData(void)
 //---------------------------------------------------------
 bool CSG_Grids::Assign(double Value)
 {
+	_Del_Profiles();
+
 	for(int i=0; i<Get_Grid_Count(); i++)
 	{
 		m_pGrids[i]->Assign(Value);
@@ -999,6 +1016,8 @@ bool CSG_Grids::Assign(CSG_Data_Object *pObject, bool bProgress)
 {
 	if( pObject )
 	{
+		_Del_Profiles();
+
 		switch( pObject->Get_ObjectType() )
 		{
 		case SG_DATAOBJECT_TYPE_Grid :
@@ -1028,6 +1047,8 @@ bool CSG_Grids::Assign(CSG_Grids *pGrids, TSG_Grid_Resampling Interpolation, boo
 {
 	if( pGrids && Get_Grid_Count() == pGrids->Get_Grid_Count() )
 	{
+		_Del_Profiles();
+
 		bool bResult = true;
 
 		for(int i=0; i<Get_Grid_Count() && (!bProgress || SG_UI_Process_Get_Okay()); i++)
@@ -1068,6 +1089,8 @@ CSG_Grids & CSG_Grids::operator += (double Value)
 
 CSG_Grids & CSG_Grids::Add(double Value)
 {
+	_Del_Profiles();
+
 	for(int i=0; i<Get_Grid_Count(); i++)
 	{
 		m_pGrids[i]->Add(Value);
@@ -1084,6 +1107,8 @@ CSG_Grids & CSG_Grids::operator -= (double Value)
 
 CSG_Grids & CSG_Grids::Subtract(double Value)
 {
+	_Del_Profiles();
+
 	for(int i=0; i<Get_Grid_Count(); i++)
 	{
 		m_pGrids[i]->Subtract(Value);
@@ -1100,6 +1125,8 @@ CSG_Grids & CSG_Grids::operator *= (double Value)
 
 CSG_Grids & CSG_Grids::Multiply(double Value)
 {
+	_Del_Profiles();
+
 	for(int i=0; i<Get_Grid_Count(); i++)
 	{
 		m_pGrids[i]->Multiply(Value);
@@ -1116,6 +1143,8 @@ CSG_Grids & CSG_Grids::operator /= (double Value)
 
 CSG_Grids & CSG_Grids::Divide(double Value)
 {
+	_Del_Profiles();
+
 	for(int i=0; i<Get_Grid_Count(); i++)
 	{
 		m_pGrids[i]->Divide(Value);
@@ -1405,6 +1434,142 @@ bool CSG_Grids::_Set_Index(void)
 #undef SORT_SWAP
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//                     Z-Profiles                        //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Grids::Set_Profiles(bool bOn)
+{
+	if( !bOn )
+	{
+		_Del_Profiles();
+
+		return( true );
+	}
+
+	if( m_Profiles )
+	{
+		return( true );
+	}
+
+	if( Get_Update_Flag() )
+	{
+		Update();
+	}
+
+	return( Get_NZ() > 0 && (m_Profiles = (double **)SG_Calloc(Get_NY(), sizeof(double *))) != NULL );
+}
+
+//---------------------------------------------------------
+// Builds (or releases) the profiles of row y. Must not be
+// called while other threads are reading the row, e.g. call
+// it before and after a parallel loop over the row's cells.
+//---------------------------------------------------------
+bool CSG_Grids::Set_Profiles_Row(int y, bool bOn)
+{
+	if( !m_Profiles || y < 0 || y >= Get_NY() )
+	{
+		return( false );
+	}
+
+	if( !bOn )
+	{
+		SG_FREE_SAFE(m_Profiles[y]);
+	}
+	else if( !m_Profiles[y] )
+	{
+		m_Profiles[y] = _Get_Profiles(y);
+	}
+
+	return( !bOn || m_Profiles[y] != NULL );
+}
+
+//---------------------------------------------------------
+void CSG_Grids::_Del_Profiles(void)
+{
+	if( m_Profiles )
+	{
+		for(int y=0; y<Get_NY(); y++)
+		{
+			SG_FREE_SAFE(m_Profiles[y]);
+		}
+
+		SG_FREE_SAFE(m_Profiles);
+	}
+}
+
+//---------------------------------------------------------
+// Returns a newly allocated, cell interleaved copy of row y.
+//---------------------------------------------------------
+double * CSG_Grids::_Get_Profiles(int y)	const
+{
+	double *pRow = (double *)SG_Malloc((size_t)Get_NX() * Get_NZ() * sizeof(double));
+
+	if( pRow )
+	{
+		for(int z=0; z<Get_NZ(); z++)	// layer by layer, to read each layer's row sequentially
+		{
+			CSG_Grid *pGrid = m_pGrids[z]; double *pValue = pRow + z;
+
+			for(int x=0; x<Get_NX(); x++, pValue+=Get_NZ())
+			{
+				*pValue = pGrid->asDouble(x, y, false);
+			}
+		}
+	}
+
+	return( pRow );
+}
+
+//---------------------------------------------------------
+bool CSG_Grids::Get_Profile(int x, int y, CSG_Vector &Values, bool bScaled)
+{
+	if( !Get_System().is_InGrid(x, y) || !Values.Create(Get_NZ()) )
+	{
+		return( false );
+	}
+
+	const double *Profile = Get_Profile(x, y);	// without profiles read the layers
+
+	for(int z=0; z<Get_NZ(); z++)
+	{
+		Values[z] = Profile ? Profile[z] : m_pGrids[z]->asDouble(x, y, false);
+	}
+
+	if( bScaled && is_Scaled() )
+	{
+		for(int z=0; z<Get_NZ(); z++)
+		{
+			if( !is_NoData_Value(Values[z]) )
+			{
+				Values[z] = Get_Offset() + Get_Scaling() * Values[z];
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grids::Set_Profile(int x, int y, const double *Values, bool bScaled)
+{
+	if( !Values || !Get_System().is_InGrid(x, y) )
+	{
+		return( false );
+	}
+
+	for(int z=0; z<Get_NZ(); z++)
+	{
+		Set_Value(x, y, z, Values[z], bScaled);
+	}
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                     Statistics                        //
@@ -1418,6 +1583,8 @@ bool CSG_Grids::On_Update(void)
 	{
 		SG_FREE_SAFE(m_Index);
 
+		_Del_Profiles();
+
 		m_Statistics.Invalidate();
 		m_Histogram.Destroy();
 
@@ -1762,6 +1929,8 @@ bool CSG_Grids::On_Delete(void)
 //---------------------------------------------------------
 bool CSG_Grids::Load(const CSG_String &File, bool bLoadData)
 {
+	SG_PROFILE_SCOPE("grids load");
+
 	Destroy();
 
 	SG_UI_Msg_Add(CSG_String::Format("%s: %s...", _TL("Loading grid collection"), File.c_str()), true);
@@ -1795,6 +1964,8 @@ bool CSG_Grids::Save(const CSG_String &File, int Format)
 		return( *Get_File_Name(false) ? Save(Get_File_Name(false), Format) : false );
 	}
 
+	SG_PROFILE_SCOPE("grids save");
+
 	SG_UI_Msg_Add(CSG_String::Format("%s %s: %s...", _TL("Saving"), _TL("grid collection"), File.c_str()), true);
 
 	if( Format == GRIDS_FILE_FORMAT_Undefined )
@@ -2489,6 +2660,161 @@ bool CSG_Grids::_Save_Data(CSG_File &Stream, CSG_Grid *pGrid)
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//                   CSG_Grids_Stream                    //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Grids_Stream::CSG_Grids_Stream(void)
+{
+	m_NZ = -1;
+}
+
+//---------------------------------------------------------
+CSG_Grids_Stream::~CSG_Grids_Stream(void)
+{
+	Close();
+}
+
+//---------------------------------------------------------
+bool CSG_Grids_Stream::Create(const CSG_String &_File, const CSG_Grid &Template, const CSG_String &Z_Name)
+{
+	Close();
+
+	CSG_Table Attributes; Attributes.Add_Field(Z_Name, SG_DATATYPE_Double);
+
+	if( !Template.Get_System().is_Valid() || !m_Header.Create(Template.Get_System(), Attributes, 0, Template.Get_Type()) )
+	{
+		return( false );
+	}
+
+	m_Header.Set_Name       (Template.Get_Name       ());
+	m_Header.Set_Description(Template.Get_Description());
+	m_Header.Set_Unit       (Template.Get_Unit       ());
+	m_Header.Set_Scaling    (Template.Get_Scaling(), Template.Get_Offset());
+	m_Header.Set_NoData_Value_Range(Template.Get_NoData_Value(), Template.Get_NoData_Value(true));
+
+	//-----------------------------------------------------
+	CSG_String File(_File); CSG_File Stream;
+
+	SG_File_Set_Extension(File, "sg-gds");
+
+	if( !Stream.Open(File, SG_FILE_W, false) || !m_Header._Save_Header(Stream) )
+	{
+		return( false );
+	}
+
+	SG_File_Set_Extension(File, "sg-att");
+
+	if( !Stream.Open(File, SG_FILE_W, false) )
+	{
+		return( false );
+	}
+
+	Stream.Close();
+
+	Template.Get_Projection().Save(SG_File_Make_Path("", File, "sg-prj"));
+
+	//-----------------------------------------------------
+	SG_File_Set_Extension(m_File = File, "sg-gds");
+
+	m_NZ = 0;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grids_Stream::Open(const CSG_String &_File, int NZ)
+{
+	Close();
+
+	CSG_String File(_File); CSG_File Stream;
+
+	SG_File_Set_Extension(File, "sg-gds");
+
+	if( !Stream.Open(File, SG_FILE_R, false) || !m_Header._Load_Header(Stream) )
+	{
+		return( false );
+	}
+
+	m_File = File;
+
+	//-----------------------------------------------------
+	// count the stored z-levels, drop those beyond NZ
+
+	SG_File_Set_Extension(File, "sg-att");
+
+	CSG_Strings Levels; CSG_String Line;
+
+	if( Stream.Open(File, SG_FILE_R, false) )
+	{
+		while( Stream.Read_Line(Line) && !Line.is_Empty() && (NZ < 0 || Levels.Get_Count() < NZ) )
+		{
+			Levels += Line;
+		}
+	}
+
+	if( !Stream.Open(File, SG_FILE_W, false) )
+	{
+		return( false );
+	}
+
+	for(int i=0; i<Levels.Get_Count(); i++)
+	{
+		Stream.Write(Levels[i] + "\n");
+	}
+
+	m_NZ = Levels.Get_Count();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grids_Stream::Close(void)
+{
+	m_NZ = -1;
+
+	m_File.Clear();
+
+	m_Header.Destroy();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Grids_Stream::Add_Grid(double Z, CSG_Grid *pGrid)
+{
+	if( !is_Open() || !pGrid || !m_Header.is_Compatible(pGrid->Get_System()) )
+	{
+		return( false );
+	}
+
+	CSG_String File(m_File); CSG_File Stream;
+
+	SG_File_Set_Extension(File, CSG_String::Format("sg-%03d", m_NZ + 1));
+
+	if( !Stream.Open(File, SG_FILE_W, true) || !m_Header._Save_Data(Stream, pGrid) )
+	{
+		return( false );
+	}
+
+	Stream.Close();
+
+	//-----------------------------------------------------
+	SG_File_Set_Extension(File, "sg-att");	// the level is added not before its data has been written
+
+	if( !Stream.Open(File, SG_FILE_RW, false) || !Stream.Seek_End() || !Stream.Write(SG_Get_String(Z) + "\n") || !Stream.Flush() )
+	{
+		return( false );
+	}
+
+	m_NZ++;
+
+	return( true );
+}
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 ///////////////////////////////////////////////////////////
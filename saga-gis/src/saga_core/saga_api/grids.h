@@ -426,15 +426,63 @@ public:		///////////////////////////////////////////////
 	{
 		int	z	= (int)(i / m_pGrids[0]->Get_NCells());
 
-		m_pGrids[z]->Set_Value((sLong)(i % m_pGrids[0]->Get_NCells()), Value, bScaled);
+		i	= i % m_pGrids[0]->Get_NCells();
+
+		m_pGrids[z]->Set_Value(i, Value, bScaled);
+
+		if( m_Profiles && m_Profiles[i / Get_NX()] )	// keep z-profiles in sync
+		{
+			m_Profiles[i / Get_NX()][(size_t)(i % Get_NX()) * Get_NZ() + z]	= m_pGrids[z]->asDouble(i, false);
+		}
 	}
 
 	virtual void					Set_Value(int x, int y, int z, double Value, bool bScaled = true)
 	{
 		m_pGrids[z]->Set_Value(x, y, Value, bScaled);
+
+		if( m_Profiles && m_Profiles[y] )	// keep z-profiles in sync
+		{
+			m_Profiles[y][(size_t)x * Get_NZ() + z]	= m_pGrids[z]->asDouble(x, y, false);
+		}
 	}
 
 
+	//-----------------------------------------------------
+	// Z-Profiles...
+
+	/** Z-profiles provide contiguous access to the values of
+	  * all layers of a single cell. They are kept as a cell
+	  * interleaved copy of the layers, which is built row by
+	  * row on request, so that memory use stays with the rows
+	  * in work. Set_Profiles() switches profiles on or off,
+	  * Set_Profiles_Row() builds or releases a row's profiles.
+	  * Values are unscaled. Changes through Set_Value() and
+	  * Set_Profile() keep profiles and layers in sync, modifying
+	  * a layer directly requires a call to Set_Profiles(false)
+	  * or Update().
+	*/
+	bool							Set_Profiles	(bool bOn = true);
+	bool							has_Profiles	(void)	const	{	return( m_Profiles != NULL );	}
+
+	bool							Set_Profiles_Row(int y, bool bOn = true);
+
+	/** Returns a pointer to the Get_NZ() unscaled values of
+	  * the cell's z-profile, or NULL if the profiles of row y
+	  * have not been built. Reading needs no synchronization.
+	  * The pointer becomes invalid when the row is released,
+	  * profiles are switched off, layers are added or removed,
+	  * or the collection is updated, none of which must happen
+	  * while other threads are still using profile pointers.
+	*/
+	const double *					Get_Profile		(int x, int y)	const
+	{
+		return( m_Profiles && m_Profiles[y] ? m_Profiles[y] + (size_t)x * Get_NZ() : NULL );
+	}
+
+	bool							Get_Profile		(int x, int y, CSG_Vector &Values, bool bScaled = true);
+	bool							Set_Profile		(int x, int y, const double *Values, bool bScaled = false);
+
+
 	//-----------------------------------------------------
 	// Index...
 
@@ -499,10 +547,14 @@ protected:	///////////////////////////////////////////////
 //---------------------------------------------------------
 private:	///////////////////////////////////////////////
 
+	friend class CSG_Grids_Stream;
+
 	int								m_Z_Attribute, m_Z_Name;
 
 	sLong							*m_Index;
 
+	double							**m_Profiles;
+
 	CSG_Table						m_Attributes;
 
 	CSG_Array_Pointer				m_Grids;
@@ -534,6 +586,10 @@ private:	///////////////////////////////////////////////
 		return( m_Index || _Set_Index() );
 	}
 
+	//-----------------------------------------------------
+	double *						_Get_Profiles			(int y)	const;
+	void							_Del_Profiles			(void);
+
 	//-----------------------------------------------------
 	bool							_Load_External			(const CSG_String &FileName);
 	bool							_Load_PGSQL				(const CSG_String &FileName);
@@ -566,6 +622,58 @@ private:	///////////////////////////////////////////////
 };
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//                   CSG_Grids_Stream                    //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Grids_Stream appends grids as new z-levels to a grid
+  * collection file in the normal (uncompressed, 'sg-gds')
+  * file format, without keeping the levels in memory. It is
+  * intended to store time series (time cubes) of long running
+  * simulations. A z-level becomes part of the collection only
+  * after its data has been written completely, so that the file
+  * stays readable, if the writing process is interrupted.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Grids_Stream
+{
+public:
+	CSG_Grids_Stream(void);
+	virtual ~CSG_Grids_Stream(void);
+
+	/** Creates a new grid collection file using the grid system, data type, name and no-data settings of Template. */
+	bool							Create				(const CSG_String &File, const CSG_Grid &Template, const CSG_String &Z_Name = "Z");
+
+	/** Opens an existing grid collection file for appending. If NZ is not negative, only the first NZ z-levels are kept. */
+	bool							Open				(const CSG_String &File, int NZ = -1);
+
+	bool							Close				(void);
+
+	bool							is_Open				(void)	const	{	return( m_NZ >= 0 );	}
+
+	const CSG_String &				Get_File			(void)	const	{	return( m_File );		}
+
+	int								Get_NZ				(void)	const	{	return( m_NZ );			}
+
+	/** Appends the values of pGrid, which has to share the stream's grid system, as new z-level. */
+	bool							Add_Grid			(double Z, CSG_Grid *pGrid);
+
+
+private:
+
+	int								m_NZ;
+
+	CSG_String						m_File;
+
+	CSG_Grids						m_Header;
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //						Functions						 //
@@ -458,6 +458,387 @@ double CSG_Thin_Plate_Spline::Get_Value(double x, double y)
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+typedef struct
+{
+	int		Child[4], Patch, First, Count;	// leaves reference their points in m_Index[First, First + Count)
+
+	double	xMin, yMin, xMax, yMax;	// quadtree cell
+
+	double	x, y, Radius;			// patch (leaves only)
+
+	double	pxMin, pyMin, pxMax, pyMax;	// extent of all patches below this node
+}
+TSG_TPS_PU_Node;
+
+//---------------------------------------------------------
+#define TPS_PU_NODE(i)	((TSG_TPS_PU_Node *)m_Nodes.Get_Entry(i))
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Thin_Plate_Spline_PU::CSG_Thin_Plate_Spline_PU(void)
+{
+}
+
+//---------------------------------------------------------
+CSG_Thin_Plate_Spline_PU::~CSG_Thin_Plate_Spline_PU(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+bool CSG_Thin_Plate_Spline_PU::Destroy(void)
+{
+	if( m_Patches )
+	{
+		delete[](m_Patches); m_Patches = NULL;
+	}
+
+	m_nPatches = 0;
+
+	m_Nodes.Destroy(); m_Index.Destroy();
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Leaves hold up to maxPoints points. Each leaf gets a patch
+// centered on its cell with a radius of Overlap times half
+// the cell diagonal. Patches with too few points are enlarged
+// until they contain at least half of maxPoints (or all)
+// points. The local systems are independent and get solved
+// in parallel, each in coordinates relative to its center.
+//---------------------------------------------------------
+bool CSG_Thin_Plate_Spline_PU::Create(double Regularization, int maxPoints, double Overlap, bool bSilent)
+{
+	Destroy();
+
+	if( m_Points.Get_Count() < 3 )
+	{
+		return( false );
+	}
+
+	m_maxPoints = maxPoints < 8 ? 8 : maxPoints;
+
+	if( Overlap < 1.1 )
+	{
+		Overlap = 1.1;
+	}
+
+	//-----------------------------------------------------
+	CSG_Array_Int Points((size_t)m_Points.Get_Count());
+
+	double xMin = m_Points[0].x, yMin = m_Points[0].y, xMax = xMin, yMax = yMin;
+
+	for(sLong i=0; i<m_Points.Get_Count(); i++)
+	{
+		Points[i] = (int)i;
+
+		if( xMin > m_Points[i].x ) { xMin = m_Points[i].x; } else if( xMax < m_Points[i].x ) { xMax = m_Points[i].x; }
+		if( yMin > m_Points[i].y ) { yMin = m_Points[i].y; } else if( yMax < m_Points[i].y ) { yMax = m_Points[i].y; }
+	}
+
+	double Size = 0.5 * M_GET_MAX(xMax - xMin, yMax - yMin) + M_ALMOST_ZERO, xCenter = 0.5 * (xMin + xMax), yCenter = 0.5 * (yMin + yMax);
+
+	m_Nodes.Create(sizeof(TSG_TPS_PU_Node), 0, TSG_Array_Growth::SG_ARRAY_GROWTH_2);
+
+	_Add_Node(xCenter - Size, yCenter - Size, xCenter + Size, yCenter + Size, Points, 0);
+
+	//-----------------------------------------------------
+	CSG_Array_Int Leaves;
+
+	for(sLong i=0; i<m_Nodes.Get_Size(); i++)
+	{
+		if( TPS_PU_NODE(i)->Child[0] < 0 )
+		{
+			TPS_PU_NODE(i)->Patch = m_nPatches++; Leaves.Add((int)i);
+		}
+	}
+
+	m_Patches = new CSG_Thin_Plate_Spline[m_nPatches];
+
+	int nMin = M_GET_MIN(m_maxPoints / 2, (int)m_Points.Get_Count()), nDone = 0;
+
+	#pragma omp parallel for schedule(dynamic)
+	for(int iPatch=0; iPatch<m_nPatches; iPatch++)
+	{
+		TSG_TPS_PU_Node &Leaf = *TPS_PU_NODE(Leaves[iPatch]);
+
+		Leaf.x      = 0.5 * (Leaf.xMin + Leaf.xMax);
+		Leaf.y      = 0.5 * (Leaf.yMin + Leaf.yMax);
+		Leaf.Radius = Overlap * 0.5 * sqrt(SG_Get_Square(Leaf.xMax - Leaf.xMin) + SG_Get_Square(Leaf.yMax - Leaf.yMin));
+
+		CSG_Array_Int Patch;
+
+		for(;;)
+		{
+			Patch.Destroy(); _Get_Points(0, Leaf.x, Leaf.y, Leaf.Radius, Patch);
+
+			if( (int)Patch.Get_Size() >= nMin )
+			{
+				break;
+			}
+
+			Leaf.Radius *= 1.5;
+		}
+
+		CSG_Thin_Plate_Spline &Spline = m_Patches[iPatch];
+
+		for(sLong i=0; i<Patch.Get_Size(); i++)
+		{
+			const TSG_Point_3D &p = m_Points[Patch[i]];
+
+			Spline.Add_Point(p.x - Leaf.x, p.y - Leaf.y, p.z);
+		}
+
+		Spline.Create(Regularization, true);	// a failing patch is ignored when blending
+
+		if( !bSilent )
+		{
+			#pragma omp atomic
+			nDone++;
+
+			if( SG_OMP_Get_Thread_Num() == 0 )
+			{
+				SG_UI_Process_Set_Progress(nDone, m_nPatches);
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	for(sLong i=m_Nodes.Get_Size()-1; i>=0; i--)	// children are always added after their parents
+	{
+		TSG_TPS_PU_Node &Node = *TPS_PU_NODE(i);
+
+		if( Node.Child[0] < 0 )
+		{
+			Node.pxMin = Node.x - Node.Radius; Node.pxMax = Node.x + Node.Radius;
+			Node.pyMin = Node.y - Node.Radius; Node.pyMax = Node.y + Node.Radius;
+		}
+		else
+		{
+			TSG_TPS_PU_Node &First = *TPS_PU_NODE(Node.Child[0]);
+
+			Node.pxMin = First.pxMin; Node.pxMax = First.pxMax;
+			Node.pyMin = First.pyMin; Node.pyMax = First.pyMax;
+
+			for(int j=1; j<4; j++)
+			{
+				TSG_TPS_PU_Node &Child = *TPS_PU_NODE(Node.Child[j]);
+
+				Node.pxMin = M_GET_MIN(Node.pxMin, Child.pxMin); Node.pxMax = M_GET_MAX(Node.pxMax, Child.pxMax);
+				Node.pyMin = M_GET_MIN(Node.pyMin, Child.pyMin); Node.pyMax = M_GET_MAX(Node.pyMax, Child.pyMax);
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+int CSG_Thin_Plate_Spline_PU::_Add_Node(double xMin, double yMin, double xMax, double yMax, CSG_Array_Int &Points, int Depth)
+{
+	int Index = (int)m_Nodes.Get_Size(); m_Nodes.Inc_Array();
+
+	TSG_TPS_PU_Node *pNode = TPS_PU_NODE(Index);
+
+	pNode->xMin = xMin; pNode->xMax = xMax; pNode->Patch = -1;
+	pNode->yMin = yMin; pNode->yMax = yMax; pNode->Radius = 0.;
+
+	for(int i=0; i<4; i++) { pNode->Child[i] = -1; }
+
+	if( (int)Points.Get_Size() <= m_maxPoints || Depth >= 24 )	// depth limit catches clusters of duplicates
+	{
+		pNode->First = (int)m_Index.Get_Size(); pNode->Count = (int)Points.Get_Size();
+
+		for(sLong i=0; i<Points.Get_Size(); i++)
+		{
+			m_Index.Add(Points[i]);
+		}
+
+		return( Index );
+	}
+
+	pNode->First = pNode->Count = 0;
+
+	//-----------------------------------------------------
+	double xCenter = 0.5 * (xMin + xMax), yCenter = 0.5 * (yMin + yMax);
+
+	CSG_Array_Int Quadrant[4];
+
+	for(sLong i=0; i<Points.Get_Size(); i++)
+	{
+		const TSG_Point_3D &p = m_Points[Points[i]];
+
+		Quadrant[(p.x < xCenter ? 0 : 1) + (p.y < yCenter ? 0 : 2)].Add(Points[i]);
+	}
+
+	Points.Destroy();
+
+	int Child[4] =
+	{
+		_Add_Node(xMin   , yMin   , xCenter, yCenter, Quadrant[0], Depth + 1),
+		_Add_Node(xCenter, yMin   , xMax   , yCenter, Quadrant[1], Depth + 1),
+		_Add_Node(xMin   , yCenter, xCenter, yMax   , Quadrant[2], Depth + 1),
+		_Add_Node(xCenter, yCenter, xMax   , yMax   , Quadrant[3], Depth + 1)
+	};
+
+	pNode = TPS_PU_NODE(Index);	// the array might have been reallocated
+
+	for(int i=0; i<4; i++) { pNode->Child[i] = Child[i]; }
+
+	return( Index );
+}
+
+//---------------------------------------------------------
+// Collects the points within the circle (x, y, Radius).
+//---------------------------------------------------------
+void CSG_Thin_Plate_Spline_PU::_Get_Points(int Node, double x, double y, double Radius, CSG_Array_Int &Points)	const
+{
+	const TSG_TPS_PU_Node &N = *TPS_PU_NODE(Node);
+
+	if( x + Radius < N.xMin || x - Radius > N.xMax || y + Radius < N.yMin || y - Radius > N.yMax )
+	{
+		return;
+	}
+
+	if( N.Child[0] >= 0 )
+	{
+		for(int i=0; i<4; i++)
+		{
+			_Get_Points(N.Child[i], x, y, Radius, Points);
+		}
+
+		return;
+	}
+
+	//-----------------------------------------------------
+	double r2 = Radius*Radius;
+
+	for(int i=N.First; i<N.First+N.Count; i++)
+	{
+		const TSG_Point_3D &p = m_Points[m_Index[i]];
+
+		if( SG_Get_Square(p.x - x) + SG_Get_Square(p.y - y) <= r2 )
+		{
+			Points.Add(m_Index[i]);
+		}
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Wendland's C2 function (1 - d)^4 (4d + 1) as weight of a
+// patch, normalized by the sum of all weights (Shepard).
+//---------------------------------------------------------
+void CSG_Thin_Plate_Spline_PU::_Get_Value(int Node, double x, double y, double &Sum, double &Weights)	const
+{
+	const TSG_TPS_PU_Node &N = *TPS_PU_NODE(Node);
+
+	if( x < N.pxMin || x > N.pxMax || y < N.pyMin || y > N.pyMax )
+	{
+		return;
+	}
+
+	if( N.Child[0] >= 0 )
+	{
+		for(int i=0; i<4; i++)
+		{
+			_Get_Value(N.Child[i], x, y, Sum, Weights);
+		}
+	}
+	else if( m_Patches[N.Patch].is_Okay() )
+	{
+		double d = sqrt(SG_Get_Square(x - N.x) + SG_Get_Square(y - N.y)) / N.Radius;
+
+		if( d < 1. )
+		{
+			double w = pow(1. - d, 4.) * (4. * d + 1.);
+
+			Sum     += w * m_Patches[N.Patch].Get_Value(x - N.x, y - N.y);
+			Weights += w;
+		}
+	}
+}
+
+//---------------------------------------------------------
+int CSG_Thin_Plate_Spline_PU::_Get_Leaf(int Node, double x, double y)	const
+{
+	const TSG_TPS_PU_Node &N = *TPS_PU_NODE(Node);
+
+	if( N.Child[0] < 0 )
+	{
+		return( Node );
+	}
+
+	double xCenter = 0.5 * (N.xMin + N.xMax), yCenter = 0.5 * (N.yMin + N.yMax);
+
+	return( _Get_Leaf(N.Child[(x < xCenter ? 0 : 1) + (y < yCenter ? 0 : 2)], x, y) );
+}
+
+//---------------------------------------------------------
+bool CSG_Thin_Plate_Spline_PU::Get_Value(double x, double y, double &Value)	const
+{
+	if( m_nPatches < 1 )
+	{
+		return( false );
+	}
+
+	double Sum = 0., Weights = 0.;
+
+	_Get_Value(0, x, y, Sum, Weights);
+
+	if( Weights > 0. )
+	{
+		Value = Sum / Weights;
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	// outside of all patches: extrapolate with the patch of
+	// the nearest leaf
+
+	const TSG_TPS_PU_Node &N = *TPS_PU_NODE(_Get_Leaf(0, x, y));
+
+	if( m_Patches[N.Patch].is_Okay() )
+	{
+		Value = m_Patches[N.Patch].Get_Value(x - N.x, y - N.y);
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+double CSG_Thin_Plate_Spline_PU::Get_Value(double x, double y)	const
+{
+	double Value;
+
+	return( Get_Value(x, y, Value) ? Value : 0. );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                                                       //
@@ -1652,14 +1652,31 @@ bool CSG_Histogram::Create(size_t nClasses, CSG_Grid *pGrid, double Minimum, dou
 	}
 
 	//-----------------------------------------------------
+	int nThreads = pGrid->Get_NCells() > 65536 ? SG_OMP_Get_Max_Num_Threads() : 1;	// one pass with per thread histograms
+
+	CSG_Histogram *Histograms = new CSG_Histogram[nThreads];
+
+	for(int iThread=0; iThread<nThreads; iThread++)
+	{
+		Histograms[iThread]._Create(m_nClasses, m_Minimum, m_Maximum);
+	}
+
+	#pragma omp parallel for num_threads(nThreads)
 	for(sLong i=0; i<pGrid->Get_NCells(); i++)
 	{
 		if( !pGrid->is_NoData(i) )
 		{
-			Add_Value(pGrid->asDouble(i));
+			Histograms[SG_OMP_Get_Thread_Num()].Add_Value(pGrid->asDouble(i));
 		}
 	}
 
+	for(int iThread=0; iThread<nThreads; iThread++)
+	{
+		Add_Histogram(Histograms[iThread]);
+	}
+
+	delete[](Histograms);
+
 	return( Update() );
 }
 
@@ -1692,14 +1709,31 @@ bool CSG_Histogram::Create(size_t nClasses, CSG_Grids *pGrids, double Minimum, d
 	}
 
 	//-----------------------------------------------------
+	int nThreads = pGrids->Get_NCells() > 65536 ? SG_OMP_Get_Max_Num_Threads() : 1;	// one pass with per thread histograms
+
+	CSG_Histogram *Histograms = new CSG_Histogram[nThreads];
+
+	for(int iThread=0; iThread<nThreads; iThread++)
+	{
+		Histograms[iThread]._Create(m_nClasses, m_Minimum, m_Maximum);
+	}
+
+	#pragma omp parallel for num_threads(nThreads)
 	for(sLong i=0; i<pGrids->Get_NCells(); i++)
 	{
 		if( !pGrids->is_NoData(i) )
 		{
-			Add_Value(pGrids->asDouble(i));
+			Histograms[SG_OMP_Get_Thread_Num()].Add_Value(pGrids->asDouble(i));
 		}
 	}
 
+	for(int iThread=0; iThread<nThreads; iThread++)
+	{
+		Add_Histogram(Histograms[iThread]);
+	}
+
+	delete[](Histograms);
+
 	return( Update() );
 }
 
@@ -1717,6 +1751,343 @@ CSG_Histogram & CSG_Histogram::operator = (const CSG_Histogram &Histogram)
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_TDigest::CSG_TDigest(void)
+{
+	Create();
+}
+
+//---------------------------------------------------------
+CSG_TDigest::CSG_TDigest(const CSG_TDigest &Digest)
+{
+	Create(Digest);
+}
+
+//---------------------------------------------------------
+CSG_TDigest::CSG_TDigest(double Compression)
+{
+	Create(Compression);
+}
+
+//---------------------------------------------------------
+CSG_TDigest::~CSG_TDigest(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+bool CSG_TDigest::Destroy(void)
+{
+	m_Centroids.Destroy();
+
+	m_bExact = true; m_nMerged = 0; m_Weights = 0.; m_Minimum = m_Maximum = 0.;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_TDigest::Create(double Compression)
+{
+	m_Centroids.Create(sizeof(TCentroid), 0, TSG_Array_Growth::SG_ARRAY_GROWTH_1);
+
+	Destroy();
+
+	m_Compression = Compression < 10. ? 10. : Compression;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_TDigest::Create(const CSG_TDigest &Digest)
+{
+	m_Centroids.Create(Digest.m_Centroids);
+
+	m_bExact      = Digest.m_bExact     ;
+	m_nMerged     = Digest.m_nMerged    ;
+	m_Compression = Digest.m_Compression;
+	m_Weights     = Digest.m_Weights    ;
+	m_Minimum     = Digest.m_Minimum    ;
+	m_Maximum     = Digest.m_Maximum    ;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void CSG_TDigest::Add_Value(double Value, double Weight)
+{
+	if( Weight <= 0. || !m_Centroids.Inc_Array() )
+	{
+		return;
+	}
+
+	TCentroid &Centroid = _Get_Centroids()[m_Centroids.Get_Size() - 1];
+
+	Centroid.Mean = Value; Centroid.Weight = Weight;
+
+	if( m_Weights <= 0. )
+	{
+		m_Minimum = m_Maximum = Value;
+	}
+	else if( m_Minimum > Value )
+	{
+		m_Minimum = Value;
+	}
+	else if( m_Maximum < Value )
+	{
+		m_Maximum = Value;
+	}
+
+	m_Weights += Weight;
+
+	_Check_Buffer();
+}
+
+//---------------------------------------------------------
+bool CSG_TDigest::Add(const CSG_TDigest &Digest)
+{
+	if( Digest.m_Weights <= 0. )
+	{
+		return( true );
+	}
+
+	sLong n = m_Centroids.Get_Size();
+
+	if( !m_Centroids.Inc_Array(Digest.m_Centroids.Get_Size()) )
+	{
+		return( false );
+	}
+
+	memcpy(_Get_Centroids() + n, Digest._Get_Centroids(), Digest.m_Centroids.Get_Size() * sizeof(TCentroid));
+
+	if( m_Weights <= 0. )
+	{
+		m_Minimum = Digest.m_Minimum;
+		m_Maximum = Digest.m_Maximum;
+	}
+	else
+	{
+		if( m_Minimum > Digest.m_Minimum ) { m_Minimum = Digest.m_Minimum; }
+		if( m_Maximum < Digest.m_Maximum ) { m_Maximum = Digest.m_Maximum; }
+	}
+
+	m_Weights += Digest.m_Weights;
+
+	m_bExact = m_bExact && Digest.m_bExact;
+
+	_Check_Buffer();
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static int SG_TDigest_Compare(const void *a, const void *b)
+{
+	double A = *((const double *)a), B = *((const double *)b);	// centroid mean is the first member
+
+	return( A < B ? -1 : A > B ? 1 : 0 );
+}
+
+//---------------------------------------------------------
+static double SG_TDigest_Get_Limit(double q, double Compression)
+{
+	double kScale = Compression / (2. * M_PI), k = kScale * asin(2. * q - 1.) + 1.;
+
+	return( k >= Compression / 4. ? 1. : 0.5 * (1. + sin(k / kScale)) );
+}
+
+//---------------------------------------------------------
+// The raw values are kept until the buffer overflows for
+// the first time. From then on added values are merged.
+//---------------------------------------------------------
+void CSG_TDigest::_Check_Buffer(void)
+{
+	if( m_Centroids.Get_Size() - (m_bExact ? 0 : m_nMerged) > (sLong)(4. * m_Compression) )
+	{
+		m_bExact = false;
+
+		_Compress();
+	}
+}
+
+//---------------------------------------------------------
+// Sorts all centroids by their mean and merges neighbours
+// as long as the merged centroid does not exceed the size
+// limit given by the arcsine scale function
+//   k(q) = Compression / (2 PI) * asin(2q - 1)
+// i.e. a centroid may cover at most one unit of k. As long
+// as the buffer has not overflowed, the values are only
+// sorted, so that quantiles are calculated exactly.
+//---------------------------------------------------------
+void CSG_TDigest::_Compress(void)
+{
+	sLong n = m_Centroids.Get_Size();
+
+	if( n <= m_nMerged || n < 2 )
+	{
+		m_nMerged = n;
+
+		return;
+	}
+
+	TCentroid *C = _Get_Centroids();
+
+	qsort(C, (size_t)n, sizeof(TCentroid), SG_TDigest_Compare);
+
+	if( m_bExact )	// keep the raw values
+	{
+		m_nMerged = n;
+
+		return;
+	}
+
+	double Sum = 0., qLimit = SG_TDigest_Get_Limit(0., m_Compression);
+
+	sLong j = 0;
+
+	for(sLong i=1; i<n; i++)
+	{
+		if( (Sum + C[j].Weight + C[i].Weight) / m_Weights <= qLimit )
+		{
+			C[j].Weight += C[i].Weight;
+			C[j].Mean   += (C[i].Mean - C[j].Mean) * C[i].Weight / C[j].Weight;
+		}
+		else
+		{
+			Sum += C[j].Weight; qLimit = SG_TDigest_Get_Limit(Sum / m_Weights, m_Compression);
+
+			C[++j] = C[i];
+		}
+	}
+
+	m_nMerged = j + 1;
+
+	m_Centroids.Set_Array(m_nMerged, false);
+}
+
+//---------------------------------------------------------
+size_t CSG_TDigest::Get_Centroid_Count(void)
+{
+	_Compress();
+
+	return( (size_t)m_nMerged );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+double CSG_TDigest::Get_Quantile(double Quantile)
+{
+	_Compress();
+
+	sLong n = m_nMerged; const TCentroid *C = _Get_Centroids();
+
+	if( n < 1 )
+	{
+		return( 0. );
+	}
+
+	if( n == 1 || Quantile <= 0. )
+	{
+		return( Quantile >= 1. ? m_Maximum : n == 1 ? C[0].Mean : m_Minimum );
+	}
+
+	if( Quantile >= 1. )
+	{
+		return( m_Maximum );
+	}
+
+	//-----------------------------------------------------
+	if( m_Weights == (double)n )	// no centroid has been merged yet, same interpolation as CSG_Simple_Statistics
+	{
+		double r = Quantile * (n - 1); sLong i = (sLong)r; r -= i;
+
+		return( i + 1 < n ? C[i].Mean + r * (C[i + 1].Mean - C[i].Mean) : C[i].Mean );
+	}
+
+	//-----------------------------------------------------
+	double Target = Quantile * m_Weights, Sum = 0.5 * C[0].Weight;
+
+	if( Target < Sum )	// between minimum and first centroid
+	{
+		return( m_Minimum + (C[0].Mean - m_Minimum) * Target / Sum );
+	}
+
+	for(sLong i=0; i<n-1; i++)
+	{
+		double d = 0.5 * (C[i].Weight + C[i + 1].Weight);
+
+		if( Target <= Sum + d )
+		{
+			return( C[i].Mean + (C[i + 1].Mean - C[i].Mean) * (Target - Sum) / d );
+		}
+
+		Sum += d;
+	}
+
+	double d = 0.5 * C[n - 1].Weight;	// between last centroid and maximum
+
+	return( C[n - 1].Mean + (m_Maximum - C[n - 1].Mean) * (d > 0. ? M_GET_MIN(1., (Target - Sum) / d) : 1.) );
+}
+
+//---------------------------------------------------------
+double CSG_TDigest::Get_Percentile(double Percentile)
+{
+	return( Get_Quantile(Percentile / 100.) );
+}
+
+//---------------------------------------------------------
+// Gini coefficient from the weighted, sorted centroids. The
+// dispersion inside the centroids is neglected.
+//---------------------------------------------------------
+double CSG_TDigest::Get_Gini(void)
+{
+	_Compress();
+
+	const TCentroid *C = _Get_Centroids(); double Sum = 0., Gini = 0., Below = 0.;
+
+	for(sLong i=0; i<m_nMerged; i++)
+	{
+		Sum += C[i].Weight * C[i].Mean;
+	}
+
+	if( m_nMerged < 2 || Sum == 0. )
+	{
+		return( 0. );
+	}
+
+	for(sLong i=0; i<m_nMerged; i++)
+	{
+		Gini += C[i].Weight * C[i].Mean * (2. * Below + C[i].Weight - m_Weights); Below += C[i].Weight;
+	}
+
+	return( Gini / (m_Weights * Sum) );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                                                       //
@@ -1755,6 +2126,18 @@ CSG_Natural_Breaks::CSG_Natural_Breaks(const CSG_Vector &Values, int nClasses, i
 	Create(Values, nClasses, Histogram);
 }
 
+//---------------------------------------------------------
+CSG_Natural_Breaks::CSG_Natural_Breaks(const CSG_Vector &Values, const CSG_Vector &Weights, int nClasses)
+{
+	Create(Values, Weights, nClasses);
+}
+
+//---------------------------------------------------------
+CSG_Natural_Breaks::CSG_Natural_Breaks(const CSG_Histogram &Histogram, int nClasses)
+{
+	Create(Histogram, nClasses);
+}
+
 
 ///////////////////////////////////////////////////////////
 //                                                       //
@@ -1781,9 +2164,7 @@ bool CSG_Natural_Breaks::Create(CSG_Table *pTable, int Field, int nClasses, int
 			}
 		}
 
-		bResult = m_Values.Sort() && _Calculate(nClasses);
-
-		m_Values.Destroy();
+		bResult = m_Values.Sort() && _Values(nClasses);
 	}
 
 	return( bResult );
@@ -1808,9 +2189,7 @@ bool CSG_Natural_Breaks::Create(CSG_Grid *pGrid, int nClasses, int Histogram)
 			}
 		}
 
-		bResult	= m_Values.Sort() && _Calculate(nClasses);
-
-		m_Values.Destroy();
+		bResult	= m_Values.Sort() && _Values(nClasses);
 	}
 
 	return( bResult );
@@ -1835,31 +2214,59 @@ bool CSG_Natural_Breaks::Create(CSG_Grids *pGrids, int nClasses, int Histogram)
 			}
 		}
 
-		bResult = m_Values.Sort() && _Calculate(nClasses);
+		bResult = m_Values.Sort() && _Values(nClasses);
+	}
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+bool CSG_Natural_Breaks::Create(const CSG_Vector &Values, int nClasses, int Histogram)
+{
+	bool bResult = false;
+
+	if( Histogram > 0 )
+	{
+		bResult = m_Histogram.Create(Histogram, Values) && _Histogram(nClasses);
+	}
+	else
+	{
+		bResult = m_Values.Create(Values) && m_Values.Sort() && _Values(nClasses);
+	}
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+/**
+* Breaks for weighted values, e.g. the class centers and element
+* counts of a histogram. Values do not need to be sorted.
+*/
+bool CSG_Natural_Breaks::Create(const CSG_Vector &Values, const CSG_Vector &Weights, int nClasses)
+{
+	if( Values.Get_N() < 1 || Values.Get_N() != Weights.Get_N() )
+	{
+		return( false );
+	}
+
+	CSG_Index Index(Values.Get_N(), Values.Get_Data());
 
-		m_Values.Destroy();
+	for(sLong i=0; i<Index.Get_Count(); i++)
+	{
+		if( Weights[Index[i]] > 0. )
+		{
+			m_Values .Add_Row(Values [Index[i]]);
+			m_Weights.Add_Row(Weights[Index[i]]);
+		}
 	}
 
-	return( bResult );
+	return( _Values(nClasses) );
 }
 
 //---------------------------------------------------------
-bool CSG_Natural_Breaks::Create(const CSG_Vector &Values, int nClasses, int Histogram)
+bool CSG_Natural_Breaks::Create(const CSG_Histogram &Histogram, int nClasses)
 {
-	bool bResult = false;
-
-	if( Histogram > 0 )
-	{
-		bResult = m_Histogram.Create(Histogram, Values) && _Histogram(nClasses);
-	}
-	else
-	{
-		bResult = m_Values.Create(Values) && m_Values.Sort() && _Calculate(nClasses);
-
-		m_Values.Destroy();
-	}
-
-	return( bResult );
+	return( m_Histogram.Create(Histogram) && _Histogram(nClasses) );
 }
 
 
@@ -1867,123 +2274,170 @@ bool CSG_Natural_Breaks::Create(const CSG_Vector &Values, int nClasses, int Hist
 //                                                       //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+// The occupied histogram classes are taken as values weighted
+// by their element counts. A break is placed at the upper
+// boundary of the last histogram class of each natural class.
 //---------------------------------------------------------
 bool CSG_Natural_Breaks::_Histogram(int nClasses)
 {
-	if( _Calculate(nClasses) )
+	CSG_Array_Int Class, Last;
+
+	for(size_t i=0; i<m_Histogram.Get_Class_Count(); i++)
+	{
+		if( m_Histogram.Get_Elements(i) > 0 )
+		{
+			m_Values .Add_Row(m_Histogram.Get_Center(i));
+			m_Weights.Add_Row((double)m_Histogram.Get_Elements(i));
+
+			Class.Add((int)i);
+		}
+	}
+
+	bool bResult = _Calculate(nClasses, Last);
+
+	if( bResult )
 	{
-		double d = (double)m_Histogram.Get_Class_Count() / m_Histogram.Get_Cumulative((int)(m_Histogram.Get_Class_Count() - 1));
+		m_Breaks.Create((size_t)nClasses + 1);
 
 		m_Breaks[0] = m_Histogram.Get_Break(0);
 
-		for(int i=1; i<Get_Count(); i++)
+		for(int i=1; i<nClasses; i++)
 		{
-			m_Breaks[i] = m_Histogram.Get_Value(m_Breaks[i] * d);
+			m_Breaks[i] = m_Histogram.Get_Break(Class[Last[i - 1]] + 1);
 		}
 
 		m_Breaks[nClasses] = m_Histogram.Get_Break((int)m_Histogram.Get_Class_Count());
-
-		m_Histogram.Destroy();
-
-		return( true );
 	}
 
-	m_Histogram.Destroy();
+	m_Histogram.Destroy(); m_Values.Destroy(); m_Weights.Destroy();
 
-	return( false );
+	return( bResult );
 }
 
 //---------------------------------------------------------
-inline double CSG_Natural_Breaks::_Get_Value(int i)
+// Breaks are set to the midpoint between the largest value
+// of a class and the smallest value of the next one, so that
+// half-open class intervals [min, max) get all members right.
+//---------------------------------------------------------
+bool CSG_Natural_Breaks::_Values(int nClasses)
 {
-	if( m_Histogram.Get_Class_Count() > 0 )
+	CSG_Array_Int Last;
+
+	bool bResult = _Calculate(nClasses, Last);
+
+	if( bResult )
 	{
-		return( (double)m_Histogram.Get_Cumulative(i) );
+		m_Breaks.Create((size_t)nClasses + 1);
+
+		m_Breaks[0] = m_Values[0];
+
+		for(int i=1; i<nClasses; i++)
+		{
+			m_Breaks[i] = 0.5 * (m_Values[Last[i - 1]] + m_Values[Last[i - 1] + 1]);
+		}
+
+		m_Breaks[nClasses] = m_Values[m_Values.Get_N() - 1];
 	}
 
-	return( m_Values[i] );
+	m_Values.Destroy(); m_Weights.Destroy();
+
+	return( bResult );
 }
 
 //---------------------------------------------------------
-bool CSG_Natural_Breaks::_Calculate(int nClasses)
+// Fills row k of the dynamic program for the elements
+// [iMin, iMax], knowing that the optimal start of the last
+// class lies within [jMin, jMax]. The optimal start is
+// monotone in the element index, so divide and conquer
+// needs O(n log n) cost evaluations per class.
+//---------------------------------------------------------
+static void SG_Natural_Breaks_Fill(int k, int iMin, int iMax, int jMin, int jMax, const double *S1, const double *S2, const double *W, const double *D_Prev, double *D, int *J)
 {
-	if( m_Histogram.Get_Class_Count() == 0 && m_Values.Get_Size() == 0 )
+	if( iMin > iMax )
 	{
-		return( false );
+		return;
 	}
 
-	int nValues = m_Histogram.Get_Class_Count() > 0 ? (int)m_Histogram.Get_Class_Count() : m_Values.Get_N();
+	int i = (iMin + iMax) / 2, jBest = -1; double dBest = 0.;
 
-	CSG_Matrix mv(nClasses, nValues); mv.Assign(FLT_MAX);
+	for(int j=M_GET_MAX(k, jMin); j<=M_GET_MIN(i, jMax); j++)
+	{
+		double s = S1[i + 1] - S1[j], w = W[i + 1] - W[j];
+
+		double d = D_Prev[j - 1] + M_GET_MAX(0., S2[i + 1] - S2[j] - s * s / w);
+
+		if( jBest < 0 || d < dBest )
+		{
+			jBest = j; dBest = d;
+		}
+	}
 
-	int	**mc = (int **)SG_Malloc(nValues * sizeof(int *));
+	D[i] = dBest; J[i] = jBest;
 
-	mc[0] = (int *)SG_Calloc((size_t)nClasses * nValues, sizeof(int));
+	SG_Natural_Breaks_Fill(k, iMin, i - 1, jMin, jBest, S1, S2, W, D_Prev, D, J);
+	SG_Natural_Breaks_Fill(k, i + 1, iMax, jBest, jMax, S1, S2, W, D_Prev, D, J);
+}
 
-	for(int i=0; i<nValues; i++)
+//---------------------------------------------------------
+// Optimal univariate k-means (Wang & Song 2011), i.e. Jenks'
+// natural breaks minimizing the (weighted) within class sum
+// of squares, with the divide and conquer speed-up of the
+// dynamic program resulting in O(k n log n). Expects sorted
+// values. Returns for each class the index of its last value.
+//---------------------------------------------------------
+bool CSG_Natural_Breaks::_Calculate(int nClasses, CSG_Array_Int &Last)
+{
+	int nValues = m_Values.Get_N();
+
+	if( nClasses < 1 || nValues < nClasses )
 	{
-		mc[i] = mc[0] + i * (size_t)nClasses;
+		return( false );
 	}
 
-	//-----------------------------------------------------
-	for(int i=1; i<nValues; i++)
-	{
-		double v = 0., s1 = 0., s2 = 0., w = 0.;
+	bool bWeighted = m_Weights.Get_N() == nValues;
 
-		for(int m=0, n=i+1; m<=i; m++, n--)
-		{
-			v   = _Get_Value(n);
-			s2 += v*v;
-			s1 += v;
-			w  ++;
-			v   = s2 - (s1 * s1) / w;
+	//-----------------------------------------------------
+	CSG_Vector S1(nValues + 1), S2(nValues + 1), W(nValues + 1);	// cumulative sums
 
-			if( n > 0 )
-			{
-				for(int j=1; j<nClasses; j++)
-				{
-					if( mv[i][j] >= (v + mv[n - 1][j - 1]) )
-					{
-						mc[i][j] = n;
-						mv[i][j] = v + mv[n - 1][j - 1];
-					}
-				}
-			}
-		}
+	for(int i=0; i<nValues; i++)
+	{
+		double v = m_Values[i], w = bWeighted ? m_Weights[i] : 1.;
 
-		mc[i][0] = 0;
-		mv[i][0] = v;
+		S1[i + 1] = S1[i] + w * v;
+		S2[i + 1] = S2[i] + w * v * v;
+		W [i + 1] = W [i] + w;
 	}
 
 	//-----------------------------------------------------
-	CSG_Array_Int Class(nClasses);
+	CSG_Vector D_Prev(nValues), D(nValues); CSG_Array_Int J((size_t)nClasses * nValues);
 
-	for(int i=0; i<nClasses; i++)
+	for(int i=0; i<nValues; i++)
 	{
-		Class[i] = i;
-	}
+		double s = S1[i + 1];
 
-	int j = Class[(size_t)nClasses - 1] = nValues - 1;
+		D[i] = M_GET_MAX(0., S2[i + 1] - s * s / W[i + 1]); J[i] = 0;
+	}
 
-	for(int i=nClasses-1; i>0; i--)
+	for(int k=1; k<nClasses; k++)
 	{
-		Class[(size_t)i - 1] = j = mc[j - 1][i];
+		D_Prev = D;
+
+		SG_Natural_Breaks_Fill(k, k, nValues - 1, k, nValues - 1,
+			S1.Get_Data(), S2.Get_Data(), W.Get_Data(), D_Prev.Get_Data(), D.Get_Data(), J.Get_Array() + (size_t)k * nValues
+		);
 	}
 
 	//-----------------------------------------------------
-	m_Breaks.Create((size_t)nClasses + 1);
+	Last.Create(nClasses);
 
-	m_Breaks[0] = _Get_Value(0);
+	Last[nClasses - 1] = nValues - 1;
 
-	for(int i=1; i<nClasses; i++)
+	for(int k=nClasses-1; k>0; k--)
 	{
-		m_Breaks[i] = _Get_Value(Class[i - 1]);
+		Last[k - 1] = J[(size_t)k * nValues + Last[k]] - 1;
 	}
 
-	m_Breaks[nClasses] = _Get_Value(nValues - 1);
-
-	SG_Free(mc[0]); SG_Free(mc);
-
 	return( true );
 }
 
@@ -2061,14 +2515,16 @@ bool CSG_Cluster_Analysis::Set_Feature(sLong iElement, int iFeature, double Valu
 /**
 * Performs the cluster analysis using the features added prior
 * to this step. Method is minimum distance (= default), hill
-* climbing (= 1), or both methods in combination. If nMaxIterations
-* is set to zero, the analysis is iterated until it converges.
-* Initialization is done randomly (= default), periodically (= 1),
-* or skipped (= 2). The latter case allows starting the clustering
-* with user supplied start partitions.
+* climbing (= 1), both methods in combination (= 2), or mini-batch
+* minimum distance (= 3). If nMaxIterations is set to zero, the
+* analysis is iterated until it converges. Initialization is done
+* randomly (= default), periodically (= 1), or skipped (= 2). The
+* latter case allows starting the clustering with user supplied
+* start partitions. Batch_Size is the number of randomly sampled
+* elements per iteration of the mini-batch method (default 1000).
 */
 //---------------------------------------------------------
-bool CSG_Cluster_Analysis::Execute(int Method, int nClusters, int nMaxIterations, int Initialization)
+bool CSG_Cluster_Analysis::Execute(int Method, int nClusters, int nMaxIterations, int Initialization, sLong Batch_Size)
 {
 	if( Get_nElements() < 2 || nClusters < 2 )
 	{
@@ -2120,6 +2576,7 @@ bool CSG_Cluster_Analysis::Execute(int Method, int nClusters, int nMaxIterations
 	case  1: bResult = _Hill_Climbing   (true , nMaxIterations); break;
 	case  2: bResult = _Minimum_Distance(true , nMaxIterations)
 	              &&   _Hill_Climbing   (false, nMaxIterations); break;
+	case  3: bResult = _Mini_Batch      (Initialization == 0, nMaxIterations, Batch_Size); break;
 	}
 
 	//-----------------------------------------------------
@@ -2135,96 +2592,331 @@ bool CSG_Cluster_Analysis::Execute(int Method, int nClusters, int nMaxIterations
 }
 
 //---------------------------------------------------------
-bool CSG_Cluster_Analysis::_Minimum_Distance(bool bInitialize, int nMaxIterations)
+inline double CSG_Cluster_Analysis::_Get_Distance(const double *a, const double *b)	const
 {
-	int iElement, iCluster, nClusters = m_Variance.Get_N();
+	double d = 0.;
 
-	double SP_Last = -1.;
+	for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+	{
+		d += SG_Get_Square(a[iFeature] - b[iFeature]);
+	}
 
-	//-----------------------------------------------------
-	for(m_Iteration=1; SG_UI_Process_Get_Okay(); m_Iteration++)
+	return( d );	// squared euclidean distance
+}
+
+//---------------------------------------------------------
+int CSG_Cluster_Analysis::_Get_Nearest(const double *Features, double &Nearest, double &Second)	const
+{
+	int iNearest = 0; Nearest = Second = -1.;
+
+	for(int iCluster=0; iCluster<m_Centroid.Get_NRows(); iCluster++)
 	{
-		m_Variance = 0.;
-		m_Centroid = 0.;
-		m_nMembers = 0;
+		double d = _Get_Distance(Features, m_Centroid[iCluster]);
 
-		//-------------------------------------------------
-		for(iElement=0; iElement<Get_nElements(); iElement++)
+		if( Nearest < 0. || d < Nearest )
+		{
+			Second = Nearest; Nearest = d; iNearest = iCluster;
+		}
+		else if( Second < 0. || d < Second )
 		{
-			m_nMembers[iCluster = m_Clusters[iElement]]++;
+			Second = d;
+		}
+	}
+
+	Nearest = sqrt(Nearest); Second = Second < 0. ? Nearest : sqrt(Second);
+
+	return( iNearest );
+}
+
+//---------------------------------------------------------
+// Calculates the centroids from the current partition. The
+// feature sums are collected per thread and merged afterwards.
+//---------------------------------------------------------
+void CSG_Cluster_Analysis::_Set_Centroids(void)
+{
+	int nClusters = Get_nClusters(), nThreads = SG_OMP_Get_Max_Num_Threads();
+
+	CSG_Matrix *Sums = new CSG_Matrix[nThreads], Count(nClusters, nThreads);
+
+	for(int iThread=0; iThread<nThreads; iThread++)
+	{
+		Sums[iThread].Create(m_nFeatures, nClusters);
+	}
+
+	#pragma omp parallel for
+	for(sLong iElement=0; iElement<Get_nElements(); iElement++)
+	{
+		int iThread = SG_OMP_Get_Thread_Num(), iCluster = m_Clusters[iElement];
+
+		const double *Features = _Get_Features(iElement); double *Sum = Sums[iThread][iCluster];
 
-			double *Feature = (double *)m_Features.Get_Entry(iElement);
+		for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+		{
+			Sum[iFeature] += Features[iFeature];
+		}
+
+		Count[iThread][iCluster]++;
+	}
+
+	//-----------------------------------------------------
+	m_Centroid = 0.;
 
+	for(int iCluster=0; iCluster<nClusters; iCluster++)
+	{
+		double n = 0.;
+
+		for(int iThread=0; iThread<nThreads; iThread++)
+		{
 			for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
 			{
-				m_Centroid[iCluster][iFeature] += Feature[iFeature];
+				m_Centroid[iCluster][iFeature] += Sums[iThread][iCluster][iFeature];
 			}
+
+			n += Count[iThread][iCluster];
 		}
 
-		//-------------------------------------------------
-		for(iCluster=0; iCluster<nClusters; iCluster++)
+		m_nMembers[iCluster] = (int)n;
+
+		for(int iFeature=0; n>0. && iFeature<m_nFeatures; iFeature++)
+		{
+			m_Centroid[iCluster][iFeature] /= n;
+		}
+	}
+
+	delete[](Sums);
+}
+
+//---------------------------------------------------------
+// Sum of squared distances to the centroid per cluster and
+// the mean over all elements (SP) for the current partition.
+//---------------------------------------------------------
+void CSG_Cluster_Analysis::_Set_Variances(void)
+{
+	int nClusters = Get_nClusters(), nThreads = SG_OMP_Get_Max_Num_Threads();
+
+	CSG_Matrix Variance(nClusters, nThreads), Count(nClusters, nThreads);
+
+	#pragma omp parallel for
+	for(sLong iElement=0; iElement<Get_nElements(); iElement++)
+	{
+		int iThread = SG_OMP_Get_Thread_Num(), iCluster = m_Clusters[iElement];
+
+		Variance[iThread][iCluster] += _Get_Distance(_Get_Features(iElement), m_Centroid[iCluster]);
+		Count   [iThread][iCluster] ++;
+	}
+
+	m_SP = 0.;
+
+	for(int iCluster=0; iCluster<nClusters; iCluster++)
+	{
+		m_Variance[iCluster] = 0.; m_nMembers[iCluster] = 0;
+
+		for(int iThread=0; iThread<nThreads; iThread++)
 		{
-			double d = m_nMembers[iCluster] > 0 ? 1. / m_nMembers[iCluster] : 0.;
+			m_Variance[iCluster] +=      Variance[iThread][iCluster];
+			m_nMembers[iCluster] += (int)Count   [iThread][iCluster];
+		}
 
-			for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+		m_SP += m_Variance[iCluster];
+	}
+
+	m_SP /= Get_nElements();
+}
+
+//---------------------------------------------------------
+// Iterative minimum distance (k-means) with Hamerly's bounds.
+// For each element an upper bound of the distance to its own
+// centroid and a lower bound of the distance to any other
+// centroid is kept. After the centroids moved, the bounds are
+// loosened by the movements. Only if the upper bound exceeds
+// the lower bound and half the distance between the own and
+// the next centroid, distances need to be calculated.
+//---------------------------------------------------------
+bool CSG_Cluster_Analysis::_Minimum_Distance(bool bInitialize, int nMaxIterations)
+{
+	int nClusters = Get_nClusters();
+
+	CSG_Vector Upper(Get_nElements()), Lower(Get_nElements()), Moved(nClusters), Half(nClusters);
+
+	//-----------------------------------------------------
+	_Set_Centroids();
+
+	#pragma omp parallel for
+	for(sLong iElement=0; iElement<Get_nElements(); iElement++)
+	{
+		m_Clusters[iElement] = _Get_Nearest(_Get_Features(iElement), Upper[iElement], Lower[iElement]);
+	}
+
+	//-----------------------------------------------------
+	for(m_Iteration=1; SG_UI_Process_Get_Okay(); m_Iteration++)
+	{
+		CSG_Matrix Previous(m_Centroid);
+
+		_Set_Centroids();
+
+		double maxMoved = 0.;
+
+		for(int iCluster=0; iCluster<nClusters; iCluster++)
+		{
+			Moved[iCluster] = sqrt(_Get_Distance(Previous[iCluster], m_Centroid[iCluster]));
+
+			if( maxMoved < Moved[iCluster] )
+			{
+				maxMoved = Moved[iCluster];
+			}
+
+			Half[iCluster] = -1.;
+
+			for(int jCluster=0; jCluster<nClusters; jCluster++)
 			{
-				m_Centroid[iCluster][iFeature] *= d;
+				if( jCluster != iCluster )
+				{
+					double d = 0.5 * sqrt(_Get_Distance(m_Centroid[iCluster], m_Centroid[jCluster]));
+
+					if( Half[iCluster] < 0. || d < Half[iCluster] )
+					{
+						Half[iCluster] = d;
+					}
+				}
 			}
 		}
 
 		//-------------------------------------------------
-		int nShifts = 0; m_SP = 0.;
+		sLong nShifts = 0;
 
-		for(iElement=0; iElement<Get_nElements(); iElement++)
+		#pragma omp parallel for reduction(+:nShifts)
+		for(sLong iElement=0; iElement<Get_nElements(); iElement++)
 		{
-			double *Feature = (double *)m_Features.Get_Entry(iElement);
+			int iCluster = m_Clusters[iElement];
 
-			double minVariance = -1.;
-			int    minCluster  = -1;
+			Upper[iElement] += Moved[iCluster];
+			Lower[iElement] -= maxMoved;
 
-			for(iCluster=0; iCluster<nClusters; iCluster++)
+			double Bound = M_GET_MAX(Half[iCluster], Lower[iElement]);
+
+			if( Upper[iElement] > Bound )
 			{
-				double Variance = 0.;
+				const double *Features = _Get_Features(iElement);
 
-				for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
-				{
-					Variance += SG_Get_Square(m_Centroid[iCluster][iFeature] - Feature[iFeature]);
-				}
+				Upper[iElement] = sqrt(_Get_Distance(Features, m_Centroid[iCluster]));	// tighten the upper bound
 
-				if( minVariance < 0. || Variance < minVariance )
+				if( Upper[iElement] > Bound )
 				{
-					minVariance = Variance;
-					minCluster  = iCluster;
+					int jCluster = _Get_Nearest(Features, Upper[iElement], Lower[iElement]);
+
+					if( jCluster != iCluster )
+					{
+						m_Clusters[iElement] = jCluster;
+
+						nShifts++;
+					}
 				}
 			}
+		}
 
-			if( m_Clusters[iElement] != minCluster )
-			{
-				m_Clusters[iElement] = minCluster;
+		//-------------------------------------------------
+		SG_UI_Process_Set_Text(CSG_String::Format("%s: %d >> %s %lld",
+			_TL("pass"   ), m_Iteration,
+			_TL("changes"), nShifts
+		));
 
-				nShifts++;
-			}
+		if( nShifts == 0 || (nMaxIterations > 0 && nMaxIterations <= m_Iteration) )
+		{
+			break;
+		}
+	}
+
+	//-----------------------------------------------------
+	_Set_Centroids();
+	_Set_Variances();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Mini-batch minimum distance (Sculley 2010). Each iteration
+// assigns a random sample of elements to their nearest
+// centroid and moves the centroids towards their new members
+// with a per centroid learning rate (1 / number of members
+// seen so far). Finally all elements are assigned once.
+//---------------------------------------------------------
+bool CSG_Cluster_Analysis::_Mini_Batch(bool bInitialize, int nMaxIterations, sLong Batch_Size)
+{
+	int nClusters = Get_nClusters();
+
+	if( Batch_Size <= 0 )
+	{
+		Batch_Size = 1000;
+	}
+
+	if( Batch_Size > Get_nElements() )
+	{
+		Batch_Size = Get_nElements();
+	}
+
+	if( nMaxIterations <= 0 )
+	{
+		nMaxIterations = 100;
+	}
+
+	//-----------------------------------------------------
+	if( bInitialize )	// random elements as initial centroids
+	{
+		for(int iCluster=0; iCluster<nClusters; iCluster++)
+		{
+			sLong iElement = (sLong)CSG_Random::Get_Uniform(0, (double)Get_nElements()); if( iElement >= Get_nElements() ) { iElement = Get_nElements() - 1; }
 
-			m_SP                   += minVariance;
-			m_Variance[minCluster] += minVariance;
+			for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+			{
+				m_Centroid[iCluster][iFeature] = _Get_Features(iElement)[iFeature];
+			}
 		}
+	}
+	else
+	{
+		_Set_Centroids();
+	}
 
-		//-------------------------------------------------
-		m_SP /= Get_nElements();
+	//-----------------------------------------------------
+	CSG_Array_sLong Batch(Batch_Size); CSG_Array_Int Nearest(Batch_Size), Count(nClusters); Count.Assign(0);
 
-		SG_UI_Process_Set_Text(CSG_String::Format("%s: %d >> %s %f",
-			_TL("pass"  ), m_Iteration,
-			_TL("change"), m_Iteration < 2 ? m_SP : SP_Last - m_SP
-		));
+	for(m_Iteration=1; m_Iteration<=nMaxIterations && SG_UI_Process_Get_Okay(); m_Iteration++)
+	{
+		for(sLong i=0; i<Batch_Size; i++)
+		{
+			Batch[i] = (sLong)CSG_Random::Get_Uniform(0, (double)Get_nElements()); if( Batch[i] >= Get_nElements() ) { Batch[i] = Get_nElements() - 1; }
+		}
 
-		SP_Last = m_SP;
+		#pragma omp parallel for
+		for(sLong i=0; i<Batch_Size; i++)
+		{
+			double Distance, Second; Nearest[i] = _Get_Nearest(_Get_Features(Batch[i]), Distance, Second);
+		}
 
-		if( nShifts == 0 || (nMaxIterations > 0 && nMaxIterations <= m_Iteration) )
+		for(sLong i=0; i<Batch_Size; i++)
 		{
-			return( true );
+			int iCluster = Nearest[i]; double Rate = 1. / ++Count[iCluster];
+
+			const double *Features = _Get_Features(Batch[i]);
+
+			for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+			{
+				m_Centroid[iCluster][iFeature] += Rate * (Features[iFeature] - m_Centroid[iCluster][iFeature]);
+			}
 		}
+
+		SG_UI_Process_Set_Text(CSG_String::Format("%s: %d", _TL("pass"), m_Iteration));
+	}
+
+	//-----------------------------------------------------
+	#pragma omp parallel for
+	for(sLong iElement=0; iElement<Get_nElements(); iElement++)
+	{
+		double Distance, Second; m_Clusters[iElement] = _Get_Nearest(_Get_Features(iElement), Distance, Second);
 	}
 
+	_Set_Variances();
+
 	return( true );
 }
 
@@ -1100,6 +1100,86 @@ private:
 };
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Mergeable quantile sketch (merging t-digest, Dunning & Ertl).
+  * Digests of partial data sets can be added to each other, which
+  * allows single pass quantile estimation in parallel or for data
+  * not fitting into memory. About Compression / 2 centroids are kept.
+  * Until more than 4 * Compression values have been added, the values
+  * are kept unmerged and quantiles are exact.
+*///---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_TDigest
+{
+public:
+	CSG_TDigest(void);
+	virtual ~CSG_TDigest(void);
+
+	bool			Destroy				(void);
+
+	CSG_TDigest							(const CSG_TDigest &Digest);
+	bool			Create				(const CSG_TDigest &Digest);
+
+	CSG_TDigest							(double Compression);
+	bool			Create				(double Compression = 100.);
+
+	//-----------------------------------------------------
+	void			Add_Value			(double Value, double Weight = 1.);
+
+	bool			Add					(const CSG_TDigest &Digest);
+
+	double			Get_Weights			(void)              const { return( m_Weights ); }
+
+	double			Get_Minimum			(void)              const { return( m_Minimum ); }
+	double			Get_Maximum			(void)              const { return( m_Maximum ); }
+
+	size_t			Get_Centroid_Count	(void);
+
+	double			Get_Quantile		(double   Quantile);
+	double			Get_Percentile		(double Percentile);
+	double			Get_Median			(void)                    { return( Get_Quantile(0.5) ); }
+
+	double			Get_Gini			(void);
+
+	//-----------------------------------------------------
+	CSG_TDigest &	operator =			(const CSG_TDigest &Digest) { Create(Digest);   return( *this ); }
+
+	CSG_TDigest &	operator +=			(const CSG_TDigest &Digest) { Add(Digest);      return( *this ); }
+	CSG_TDigest &	operator +=			(double Value)              { Add_Value(Value); return( *this ); }
+
+
+private:
+
+	typedef struct
+	{
+		double				Mean, Weight;
+	}
+	TCentroid;
+
+
+	bool					m_bExact = true;
+
+	sLong					m_nMerged = 0;
+
+	double					m_Compression = 100., m_Weights = 0., m_Minimum = 0., m_Maximum = 0.;
+
+	CSG_Array				m_Centroids;
+
+
+	TCentroid *				_Get_Centroids		(void)	const	{	return( (TCentroid *)m_Centroids.Get_Array() );	}
+
+	void					_Compress			(void);
+	void					_Check_Buffer		(void);
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                                                       //
@@ -1125,6 +1205,12 @@ public:
 	CSG_Natural_Breaks				(const CSG_Vector &Values          , int nClasses, int Histogram = 0);
 	bool			Create			(const CSG_Vector &Values          , int nClasses, int Histogram = 0);
 
+	CSG_Natural_Breaks				(const CSG_Vector &Values, const CSG_Vector &Weights, int nClasses);
+	bool			Create			(const CSG_Vector &Values, const CSG_Vector &Weights, int nClasses);
+
+	CSG_Natural_Breaks				(const CSG_Histogram &Histogram    , int nClasses);
+	bool			Create			(const CSG_Histogram &Histogram    , int nClasses);
+
 	int				Get_Count		(void)	const	{	return( m_Breaks.Get_N() );	}
 	double			Get_Break		(int i)	const	{	return( m_Breaks[i] );	}
 
@@ -1135,14 +1221,14 @@ private:
 
 	CSG_Histogram	m_Histogram;
 
-	CSG_Vector		m_Breaks, m_Values;
+	CSG_Vector		m_Breaks, m_Values, m_Weights;
 
 
 	bool			_Histogram		(int nClasses);
 
-	double			_Get_Value		(int i);
+	bool			_Values			(int nClasses);
 
-	bool			_Calculate		(int nClasses);
+	bool			_Calculate		(int nClasses, CSG_Array_Int &Last);
 
 };
 
@@ -1176,7 +1262,7 @@ public:
 
 	sLong					Get_Cluster			(sLong iElement) const	{	return( iElement >= 0 && iElement < Get_nElements() ? m_Clusters[iElement] : -1 );	}
 
-	bool					Execute				(int Method, int nClusters, int nMaxIterations = 0, int Initialization = 0);
+	bool					Execute				(int Method, int nClusters, int nMaxIterations = 0, int Initialization = 0, sLong Batch_Size = 0);
 
 	sLong					Get_nElements		(void)	const	{	return(      m_Features.Get_Size() );	}
 	int						Get_nFeatures		(void)	const	{	return(      m_nFeatures           );	}
@@ -1206,10 +1292,20 @@ private:
 	CSG_Matrix				m_Centroid;
 
 
+	const double *			_Get_Features		(sLong iElement)	const	{	return( (const double *)m_Features.Get_Array() + iElement * m_nFeatures );	}
+
+	double					_Get_Distance		(const double *a, const double *b)	const;
+	int						_Get_Nearest		(const double *Features, double &Nearest, double &Second)	const;
+
+	void					_Set_Centroids		(void);
+	void					_Set_Variances		(void);
+
 	bool					_Minimum_Distance	(bool bInitialize, int nMaxIterations);
 
 	bool					_Hill_Climbing		(bool bInitialize, int nMaxIterations);
 
+	bool					_Mini_Batch			(bool bInitialize, int nMaxIterations, sLong Batch_Size);
+
 };
 
 
@@ -1514,6 +1610,69 @@ private:
 };
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+* Partition of unity thin plate spline. The points are split
+* by a quadtree until each leaf holds no more than a given
+* number of points. A local thin plate spline is solved once
+* for each leaf, using all points within a circular patch that
+* overlaps the neighbouring leaves. Values are blended from all
+* patches covering a location with compactly supported weights.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Thin_Plate_Spline_PU
+{
+public:
+	CSG_Thin_Plate_Spline_PU(void);
+	virtual ~CSG_Thin_Plate_Spline_PU(void);
+
+	bool					Destroy				(void);
+
+	bool					Set_Point_Count		(int Count)	{	return( m_Points.Set_Count(Count) );	}
+	int						Get_Point_Count		(void)		{	return( (int)m_Points.Get_Count() );	}
+
+	CSG_Points_3D &			Get_Points			(void)		{	return( m_Points );	}
+
+	bool					Add_Point			(double x, double y, double z)	{	return( m_Points.Add(  x,   y, z) );	}
+	bool					Add_Point			(const TSG_Point &p, double z)	{	return( m_Points.Add(p.x, p.y, z) );	}
+
+	bool					Create				(double Regularization = 0., int maxPoints = 32, double Overlap = 1.5, bool bSilent = true);
+
+	bool					is_Okay				(void)	const	{	return( m_nPatches > 0 );	}
+
+	int						Get_Patch_Count		(void)	const	{	return( m_nPatches );	}
+
+	bool					Get_Value			(double x, double y, double &Value)	const;
+	double					Get_Value			(double x, double y)	const;
+
+
+private:
+
+	int						m_nPatches = 0, m_maxPoints = 32;
+
+	CSG_Points_3D			m_Points;
+
+	CSG_Array				m_Nodes;
+
+	CSG_Array_Int			m_Index;
+
+	CSG_Thin_Plate_Spline	*m_Patches = NULL;
+
+
+	int						_Add_Node			(double xMin, double yMin, double xMax, double yMax, CSG_Array_Int &Points, int Depth);
+
+	void					_Get_Points			(int Node, double x, double y, double Radius, CSG_Array_Int &Points)	const;
+
+	void					_Get_Value			(int Node, double x, double y, double &Sum, double &Weights)	const;
+	int						_Get_Leaf			(int Node, double x, double y)	const;
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                                                       //
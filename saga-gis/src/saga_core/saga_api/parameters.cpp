@@ -1859,6 +1859,45 @@ bool CSG_Parameters::DataObjects_Get_Projection(CSG_Projection &Projection)	cons
 	return( Projection.is_Okay() );
 }
 
+//---------------------------------------------------------
+/**
+* Adds all data objects referenced by the (enabled) input and
+* output parameters to the given pointer array.
+*/
+//---------------------------------------------------------
+bool CSG_Parameters::DataObjects_Get_List(CSG_Array_Pointer &Objects)	const
+{
+	for(int i=0; i<Get_Count(); i++)
+	{
+		CSG_Parameter	*p	= m_Parameters[i];
+
+		if( p->is_Enabled() )
+		{
+			if( p->Get_Type() == PARAMETER_TYPE_Parameters )
+			{
+				p->asParameters()->DataObjects_Get_List(Objects);
+			}
+			else if( p->is_DataObject() )
+			{
+				if( p->asDataObject() != DATAOBJECT_NOTSET
+				&&  p->asDataObject() != DATAOBJECT_CREATE )
+				{
+					Objects	+= p->asDataObject();
+				}
+			}
+			else if( p->is_DataObject_List() )
+			{
+				for(int j=0; j<p->asList()->Get_Item_Count(); j++)
+				{
+					Objects	+= p->asList()->Get_Item(j);
+				}
+			}
+		}
+	}
+
+	return( Objects.Get_Size() > 0 );
+}
+
 //---------------------------------------------------------
 bool CSG_Parameters::DataObjects_Set_Projection(const CSG_Projection &Projection)
 {
@@ -1939,6 +1939,7 @@ private:
 	bool						DataObjects_Create			(void);
 	bool						DataObjects_Synchronize		(void);
 	bool						DataObjects_Get_Projection	(CSG_Projection &Projection)		const;
+	bool						DataObjects_Get_List		(CSG_Array_Pointer &Objects)		const;
 	bool						DataObjects_Set_Projection	(const CSG_Projection &Projection);
 
 
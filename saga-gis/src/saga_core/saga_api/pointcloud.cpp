@@ -49,6 +49,7 @@
 
 //---------------------------------------------------------
 #include "pointcloud.h"
+#include "grid.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -153,6 +154,8 @@ bool CSG_PointCloud::Create(const char       *File) { return( Create(CSG_String(
 bool CSG_PointCloud::Create(const wchar_t    *File) { return( Create(CSG_String(File)) ); }
 bool CSG_PointCloud::Create(const CSG_String &File)
 {
+	SG_PROFILE_SCOPE("point cloud load");
+
 	return( _Load(File) );
 }
 
@@ -317,6 +320,8 @@ bool CSG_PointCloud::Save(const CSG_String &_File, int Format)
 		return( *Get_File_Name(false) ? Save(Get_File_Name(false), Format) : false );
 	}
 
+	SG_PROFILE_SCOPE("point cloud save");
+
 	if( Format == POINTCLOUD_FILE_FORMAT_Undefined )
 	{
 		Format	= SG_File_Cmp_Extension(_File, "sg-pts-z")
@@ -518,7 +523,7 @@ bool CSG_PointCloud::_Load(CSG_File &Stream)
 //---------------------------------------------------------
 bool CSG_PointCloud::_Save(CSG_File &Stream)
 {
-	if( !Stream.is_Writing() )
+	if( !Stream.is_Writing() || !_Memory_Check() )
 	{
 		return( false );
 	}
@@ -597,6 +602,11 @@ bool CSG_PointCloud::Assign(CSG_Data_Object *pObject, bool bProgress)
 	{
 		CSG_PointCloud *pPoints = pObject->asPointCloud();
 
+		if( !pPoints->_Memory_Check() )
+		{
+			return( false );
+		}
+
 		Create(pPoints);
 
 		Get_Projection().Create(pPoints->Get_Projection());
@@ -609,6 +619,8 @@ bool CSG_PointCloud::Assign(CSG_Data_Object *pObject, bool bProgress)
 			}
 		}
 
+		_Memory_Update();
+
 		return( true );
 	}
 
@@ -661,7 +673,7 @@ bool CSG_PointCloud::Add_Field(const CSG_String &Name, TSG_Data_Type Type, int F
 //---------------------------------------------------------
 bool CSG_PointCloud::_Add_Field(const SG_Char *Name, TSG_Data_Type Type, int Field)
 {
-	if( !Name || PC_SIZE_TYPE(Type) <= 0 )
+	if( !Name || PC_SIZE_TYPE(Type) <= 0 || !_Memory_Check() )
 	{
 		return( false );
 	}
@@ -721,6 +733,8 @@ bool CSG_PointCloud::_Add_Field(const SG_Char *Name, TSG_Data_Type Type, int Fie
 	//-----------------------------------------------------
 	m_Shapes.Add_Field(Name, Type, Field);
 
+	_Memory_Update();
+
 	Set_Modified();
 
 	return( true );
@@ -729,7 +743,7 @@ bool CSG_PointCloud::_Add_Field(const SG_Char *Name, TSG_Data_Type Type, int Fie
 //---------------------------------------------------------
 bool CSG_PointCloud::Del_Field(int Field)
 {
-	if( Field < 3 || Field >= m_nFields )
+	if( Field < 3 || Field >= m_nFields || !_Memory_Check() )
 	{
 		return( false );
 	}
@@ -768,6 +782,8 @@ bool CSG_PointCloud::Del_Field(int Field)
 	//-----------------------------------------------------
 	m_Shapes.Del_Field(Field);
 
+	_Memory_Update();
+
 	Set_Modified();
 
 	return( true );
@@ -785,7 +801,7 @@ bool CSG_PointCloud::Mov_Field(int Field, int Position)
 		Position = m_nFields - 1;
 	}
 
-	if( Field < 3 || Field >= m_nFields || Field == Position )
+	if( Field < 3 || Field >= m_nFields || Field == Position || !_Memory_Check() )
 	{
 		return( false );
 	}
@@ -1028,12 +1044,10 @@ TSG_Point_3D CSG_PointCloud::Get_Point(void)	const
 //---------------------------------------------------------
 TSG_Point_3D CSG_PointCloud::Get_Point(sLong Index)	const
 {
-	TSG_Point_3D p;
+	TSG_Point_3D p; char *pPoint = _Get_Point(Index);
 
-	if( Index >= 0 && Index < m_nRecords )
+	if( pPoint )
 	{
-		char *pPoint = m_Points[Index];
-
 		p.x = _Get_Field_Value(pPoint, 0);
 		p.y = _Get_Field_Value(pPoint, 1);
 		p.z = _Get_Field_Value(pPoint, 2);
@@ -1058,11 +1072,13 @@ bool CSG_PointCloud::Set_Point(const TSG_Point_3D &Point)
 //---------------------------------------------------------
 bool CSG_PointCloud::Set_Point(sLong Index, const TSG_Point_3D &Point)
 {
-	if( Index >= 0 && Index < m_nRecords )
+	char *pPoint = _Get_Point(Index);
+
+	if( pPoint )
 	{
-		return( _Set_Field_Value(m_Points[Index], 0, Point.x)
-			&&  _Set_Field_Value(m_Points[Index], 1, Point.y)
-			&&  _Set_Field_Value(m_Points[Index], 2, Point.z)
+		return( _Set_Field_Value(pPoint, 0, Point.x)
+			&&  _Set_Field_Value(pPoint, 1, Point.y)
+			&&  _Set_Field_Value(pPoint, 2, Point.z)
 		);
 	}
 
@@ -1104,7 +1120,7 @@ bool CSG_PointCloud::Add_Point(const CSG_Point_3D &Point)
 //---------------------------------------------------------
 bool CSG_PointCloud::Del_Point(sLong Index)
 {
-	if( Index >= 0 && Index < m_nRecords )
+	if( Index >= 0 && Index < m_nRecords && _Memory_Check() )
 	{
 		if( is_Selected(Index) )
 		{
@@ -1148,6 +1164,15 @@ bool CSG_PointCloud::Del_Points(void)
 	m_Points   = NULL;
 	m_Cursor   = NULL;
 
+	if( is_Memory_Spilled() ) // discard spilled data
+	{
+		SG_File_Delete(m_Spill_File); m_Spill_File.Clear();
+
+		Set_Memory_Spilled(0);
+	}
+
+	_Memory_Update();
+
 	m_Selection.Set_Array(0);
 
 	Set_Modified();
@@ -1157,6 +1182,64 @@ bool CSG_PointCloud::Del_Points(void)
 	return( true );
 }
 
+//---------------------------------------------------------
+/**
+* Resizes the point array at once instead of point by point,
+* which is preferable if the number of points is known in
+* advance, e.g. for bulk imports. Added points are zero
+* initialized, surplus points at the end are removed.
+*/
+//---------------------------------------------------------
+bool CSG_PointCloud::Set_Count(sLong nPoints)
+{
+	if( nPoints < 0 || m_nFields < 1 || !_Memory_Check() )
+	{
+		return( false );
+	}
+
+	if( nPoints == m_nRecords )
+	{
+		return( true );
+	}
+
+	if( nPoints < m_nRecords )
+	{
+		if( Get_Selection_Count() > 0 )
+		{
+			Select();	// clear selection
+		}
+
+		for(sLong i=nPoints; i<m_nRecords; i++)
+		{
+			SG_Free(m_Points[i]);
+		}
+
+		m_Array_Points.Set_Array(m_nRecords = nPoints, (void **)&m_Points);
+	}
+	else if( m_Array_Points.Set_Array(nPoints, (void **)&m_Points) )
+	{
+		for( ; m_nRecords<nPoints; m_nRecords++)
+		{
+			if( (m_Points[m_nRecords] = (char *)SG_Calloc(m_nPointBytes, sizeof(char))) == NULL )
+			{
+				m_Array_Points.Set_Array(m_nRecords, (void **)&m_Points);
+
+				break;
+			}
+		}
+	}
+
+	m_Cursor = NULL;
+
+	_Memory_Update();
+
+	Set_Modified();
+	Set_Update_Flag();
+	_Stats_Invalidate();
+
+	return( m_nRecords == nPoints );
+}
+
 
 ///////////////////////////////////////////////////////////
 //                                                       //
@@ -1167,10 +1250,12 @@ bool CSG_PointCloud::Del_Points(void)
 //---------------------------------------------------------
 bool CSG_PointCloud::_Inc_Array(void)
 {
-	if( m_nFields > 0 && m_Array_Points.Set_Array(m_nRecords + 1, (void **)&m_Points) )
+	if( m_nFields > 0 && _Memory_Check() && m_Array_Points.Set_Array(m_nRecords + 1, (void **)&m_Points) )
 	{
 		m_Points[m_nRecords++]	= m_Cursor	= (char *)SG_Calloc(m_nPointBytes, sizeof(char));
 
+		_Memory_Update(false);
+
 		return( true );
 	}
 
@@ -1180,7 +1265,7 @@ bool CSG_PointCloud::_Inc_Array(void)
 //---------------------------------------------------------
 bool CSG_PointCloud::_Dec_Array(void)
 {
-	if( m_nRecords > 0 )
+	if( m_nRecords > 0 && _Memory_Check() )
 	{
 		m_nRecords	--;
 
@@ -1189,12 +1274,136 @@ bool CSG_PointCloud::_Dec_Array(void)
 		SG_Free(m_Points[m_nRecords]);
 
 		m_Array_Points.Set_Array(m_nRecords, (void **)&m_Points);
+
+		_Memory_Update(false);
 	}
 
 	return( true );
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//						Memory							 //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void CSG_PointCloud::_Memory_Update(bool bForce)
+{
+	if( (bForce || (m_nRecords & 0xFFFF) == 0) && !is_Memory_Spilled() ) // adding or removing single points updates the accounting every 65536 points
+	{
+		Set_Memory_Used(m_nRecords * (sLong)(m_nPointBytes + sizeof(char *)));
+	}
+}
+
+//---------------------------------------------------------
+/**
+  * Called by the memory accounting, if the memory budget is
+  * exceeded. Writes the point data to a temporary file and
+  * frees it, keeping only the point array. The data is read
+  * back on the next access.
+*/
+//---------------------------------------------------------
+bool CSG_PointCloud::On_Memory_Spill(void)
+{
+	if( is_Memory_Spilled() || m_nRecords < 1 )
+	{
+		return( false );
+	}
+
+	_Shape_Flush();
+
+	CSG_String File = SG_File_Get_Name_Temp("sg_pts", SG_Grid_Cache_Get_Directory());
+
+	FILE *Stream = fopen(File, "wb");
+
+	if( !Stream )
+	{
+		return( false );
+	}
+
+	for(sLong i=0; i<m_nRecords; i++)
+	{
+		if( fwrite(m_Points[i], 1, m_nPointBytes, Stream) != (size_t)m_nPointBytes )
+		{
+			fclose(Stream); SG_File_Delete(File);
+
+			return( false );
+		}
+	}
+
+	fclose(Stream);
+
+	for(sLong i=0; i<m_nRecords; i++)
+	{
+		SG_FREE_SAFE(m_Points[i]);
+	}
+
+	m_Cursor     = NULL;
+	m_Spill_File = File;
+
+	Set_Memory_Used   (m_nRecords * (sLong)sizeof(char *));
+	Set_Memory_Spilled(m_nRecords * (sLong)m_nPointBytes   );
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_PointCloud::On_Memory_Restore(void)
+{
+	bool bResult = false;
+
+	#pragma omp critical(CSG_PointCloud_Memory_Restore)
+	{
+		if( !is_Memory_Spilled() ) // has just been paged back in by another thread
+		{
+			bResult = true;
+		}
+		else
+		{
+			FILE *Stream = fopen(m_Spill_File, "rb");
+
+			if( Stream )
+			{
+				bResult = true;
+
+				for(sLong i=0; bResult && i<m_nRecords; i++)
+				{
+					bResult = (m_Points[i] = (char *)SG_Malloc(m_nPointBytes)) != NULL
+						&& fread(m_Points[i], 1, m_nPointBytes, Stream) == (size_t)m_nPointBytes;
+				}
+
+				fclose(Stream);
+
+				if( bResult )
+				{
+					SG_File_Delete(m_Spill_File); m_Spill_File.Clear();
+
+					Set_Memory_Spilled(0);
+
+					_Memory_Update();
+				}
+				else // keep the data spilled
+				{
+					for(sLong i=0; i<m_nRecords; i++)
+					{
+						SG_FREE_SAFE(m_Points[i]);
+					}
+				}
+			}
+
+			if( !bResult )
+			{
+				SG_UI_Msg_Add_Error(CSG_String::Format("%s: %s", _TL("point cloud"), _TL("failed to restore spilled data")));
+			}
+		}
+	}
+
+	return( bResult );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //						Statistics						 //
@@ -1204,7 +1413,9 @@ bool CSG_PointCloud::_Dec_Array(void)
 //---------------------------------------------------------
 bool CSG_PointCloud::On_Update(void)
 {
-	if( m_nFields >= 2 )
+	_Memory_Update();
+
+	if( m_nFields >= 2 && _Memory_Check() )
 	{
 		_Shape_Flush();
 
@@ -1230,7 +1441,7 @@ bool CSG_PointCloud::_Stats_Update(int Field) const
 		return( CSG_Table::_Stats_Update(Field) );
 	}
 
-	if( Field < 0 || m_nRecords < 1 )
+	if( Field < 0 || m_nRecords < 1 || !_Memory_Check() )
 	{
 		return( false );
 	}
@@ -1281,6 +1492,11 @@ bool CSG_PointCloud::On_Delete(void)
 //---------------------------------------------------------
 CSG_Shape * CSG_PointCloud::_Shape_Get(sLong Index)
 {
+	if( !_Memory_Check() )
+	{
+		return( NULL );
+	}
+
 	SG_UI_Progress_Lock(true);
 
 	CSG_Shape *pShape = m_Shapes.Get_Shape(SG_OMP_Get_Thread_Num());
@@ -1446,6 +1662,11 @@ CSG_Shape * CSG_PointCloud::Add_Shape(CSG_Table_Record *pCopy, TSG_ADD_Shape_Cop
 //---------------------------------------------------------
 bool CSG_PointCloud::Select(sLong Index, bool bInvert)
 {
+	if( !_Memory_Check() )
+	{
+		return( false );
+	}
+
 	if( !bInvert && Get_Selection_Count() > 0 )
 	{
 		for(sLong i=0; i<Get_Selection_Count(); i++)
@@ -1526,7 +1747,9 @@ bool CSG_PointCloud::Select(const TSG_Point &Point, bool bInvert)
 //---------------------------------------------------------
 bool CSG_PointCloud::is_Selected(sLong Index)	const
 {
-	return( Index >= 0 && Index < m_nRecords && (m_Points[Index][0] & SG_TABLE_REC_FLAG_Selected) != 0 );
+	char *pPoint = _Get_Point(Index);
+
+	return( pPoint && (pPoint[0] & SG_TABLE_REC_FLAG_Selected) != 0 );
 }
 
 
@@ -1579,7 +1802,7 @@ sLong CSG_PointCloud::Del_Selection(void)
 {
 	sLong n = 0;
 
-	if( Get_Selection_Count() > 0 )
+	if( Get_Selection_Count() > 0 && _Memory_Check() )
 	{
 		m_Selection.Set_Array(0);
 
@@ -1604,6 +1827,8 @@ sLong CSG_PointCloud::Del_Selection(void)
 
 		m_Array_Points.Set_Array(m_nRecords = n, (void **)&m_Points);
 
+		_Memory_Update();
+
 		Set_Modified();
 		Set_Update_Flag();
 		_Stats_Invalidate();
@@ -1615,7 +1840,7 @@ sLong CSG_PointCloud::Del_Selection(void)
 //---------------------------------------------------------
 sLong CSG_PointCloud::Inv_Selection(void)
 {
-	if( m_Selection.Set_Array(m_nRecords - Get_Selection_Count()) )
+	if( _Memory_Check() && m_Selection.Set_Array(m_nRecords - Get_Selection_Count()) )
 	{
 		char **pPoint = m_Points;
 
@@ -1647,6 +1872,11 @@ sLong CSG_PointCloud::Inv_Selection(void)
 //---------------------------------------------------------
 bool CSG_PointCloud::Sort(const CSG_Index &Index)
 {
+	if( !_Memory_Check() )
+	{
+		return( false );
+	}
+
 	m_Points[m_nRecords++]	= (char *)SG_Calloc(m_nPointBytes, sizeof(char));
 
 	if( Get_Count() > 0 && Get_Count() == Index.Get_Count() )
@@ -161,8 +161,10 @@ public:
 	bool							Del_Point			(sLong Index);
 	bool							Del_Points			(void);
 
+	virtual bool					Set_Count			(sLong nPoints);
+
 	//-----------------------------------------------------
-	bool							Set_Cursor			(sLong Index)							{	return( (m_Cursor = Index >= 0 && Index < m_nRecords ? m_Points[Index] : NULL) != NULL );	}
+	bool							Set_Cursor			(sLong Index)							{	return( (m_Cursor = _Get_Point(Index)) != NULL );	}
 	virtual bool					Set_Value			(             int Field, double Value)	{	return( _Set_Field_Value(m_Cursor, Field, Value) );	}
 	virtual double					Get_Value			(             int Field)	const		{	return( _Get_Field_Value(m_Cursor, Field) );			}
 	double							Get_X				(void)						const		{	return( _Get_Field_Value(m_Cursor, 0) );				}
@@ -173,23 +175,23 @@ public:
 	bool							Set_NoData			(             int Field)				{	return( Set_Value(Field, Get_NoData_Value()) );	}
 	bool							is_NoData			(             int Field)	const		{	return( is_NoData_Value(Get_Value(Field)) );		}
 
-	virtual bool					Set_Value			(sLong Index, int Field, double Value)	{	return( _Set_Field_Value(Index >= 0 && Index < m_nRecords ? m_Points[Index] : NULL, Field, Value) );	}
-	virtual double					Get_Value			(sLong Index, int Field)	const		{	return( _Get_Field_Value(Index >= 0 && Index < m_nRecords ? m_Points[Index] : NULL, Field) );		}
-	double							Get_X				(sLong Index)				const		{	return( _Get_Field_Value(Index >= 0 && Index < m_nRecords ? m_Points[Index] : NULL, 0) );				}
-	double							Get_Y				(sLong Index)				const		{	return( _Get_Field_Value(Index >= 0 && Index < m_nRecords ? m_Points[Index] : NULL, 1) );				}
-	double							Get_Z				(sLong Index)				const		{	return( _Get_Field_Value(Index >= 0 && Index < m_nRecords ? m_Points[Index] : NULL, 2) );				}
+	virtual bool					Set_Value			(sLong Index, int Field, double Value)	{	return( _Set_Field_Value(_Get_Point(Index), Field, Value) );	}
+	virtual double					Get_Value			(sLong Index, int Field)	const		{	return( _Get_Field_Value(_Get_Point(Index), Field) );		}
+	double							Get_X				(sLong Index)				const		{	return( _Get_Field_Value(_Get_Point(Index), 0) );				}
+	double							Get_Y				(sLong Index)				const		{	return( _Get_Field_Value(_Get_Point(Index), 1) );				}
+	double							Get_Z				(sLong Index)				const		{	return( _Get_Field_Value(_Get_Point(Index), 2) );				}
 	bool							Set_Attribute		(sLong Index, int Field, double Value)	{	return( Set_Value(Index, Field + 3, Value) );				}
 	double							Get_Attribute		(sLong Index, int Field)	const		{	return( Get_Value(Index, Field + 3) );					}
 	bool							Set_NoData			(sLong Index, int Field)				{	return( Set_Value(Index, Field, Get_NoData_Value()) );}
 	bool							is_NoData			(sLong Index, int Field)	const		{	return( is_NoData_Value(Get_Value(Index, Field)) );	}
 
-	virtual bool					Get_Value			(sLong Index, int Field, double        &Value)	const	{	if( Index >= 0 && Index < m_nRecords ) { Value = _Get_Field_Value(m_Points[Index], Field); return( !is_NoData_Value(Value) ); } return( false ); }
+	virtual bool					Get_Value			(sLong Index, int Field, double        &Value)	const	{	char *pPoint = _Get_Point(Index); if( pPoint ) { Value = _Get_Field_Value(pPoint, Field); return( !is_NoData_Value(Value) ); } return( false ); }
 	virtual bool					Get_Attribute		(sLong Index, int Field, double        &Value)	const	{	return( Get_Value(Index, Field + 3, Value) );	}
 
 	virtual bool					Set_Value			(             int Field, const SG_Char *Value)			{	return( _Set_Field_Value(m_Cursor, Field, Value) );	}
 	virtual bool					Get_Value			(             int Field, CSG_String    &Value)	const	{	return( _Get_Field_Value(m_Cursor, Field, Value) );	}
-	virtual bool					Set_Value			(sLong Index, int Field, const SG_Char *Value)			{	return( _Set_Field_Value(Index >= 0 && Index < m_nRecords ? m_Points[Index] : NULL, Field, Value) );	}
-	virtual bool					Get_Value			(sLong Index, int Field, CSG_String    &Value)	const	{	return( _Get_Field_Value(Index >= 0 && Index < m_nRecords ? m_Points[Index] : NULL, Field, Value) );	}
+	virtual bool					Set_Value			(sLong Index, int Field, const SG_Char *Value)			{	return( _Set_Field_Value(_Get_Point(Index), Field, Value) );	}
+	virtual bool					Get_Value			(sLong Index, int Field, CSG_String    &Value)	const	{	return( _Get_Field_Value(_Get_Point(Index), Field, Value) );	}
 	virtual bool					Set_Attribute		(             int Field, const SG_Char *Value)			{	return( Set_Value(Field + 3, Value) );			}
 	virtual bool					Get_Attribute		(             int Field, CSG_String    &Value)	const	{	return( Get_Value(Field + 3, Value) );			}
 	virtual bool					Set_Attribute		(sLong Index, int Field, const SG_Char *Value)			{	return( Set_Value(Index, Field + 3, Value) );	}
@@ -246,6 +248,9 @@ protected:
 
 	virtual bool					_Stats_Update		(int Field)	const;
 
+	virtual bool					On_Memory_Spill		(void);
+	virtual bool					On_Memory_Restore	(void);
+
 
 private:
 
@@ -257,6 +262,8 @@ private:
 	
 	CSG_Array						m_Array_Points;
 
+	CSG_String						m_Spill_File;
+
 	CSG_Shapes						m_Shapes;
 
 
@@ -271,6 +278,10 @@ private:
 	bool							_Set_Field_Value	(char *pPoint, int Field, const SG_Char *Value);
 	bool							_Get_Field_Value	(char *pPoint, int Field, CSG_String    &Value)	const;
 
+	bool							_Memory_Check		(void)			const	{	return( !is_Memory_Spilled() || ((CSG_PointCloud *)this)->On_Memory_Restore() );	}
+	void							_Memory_Update		(bool bForce = true);
+	char *							_Get_Point			(sLong Index)	const	{	return( Index >= 0 && Index < m_nRecords && _Memory_Check() ? m_Points[Index] : NULL );	}
+
 	bool							_Inc_Array			(void);
 	bool							_Dec_Array			(void);
 
@@ -0,0 +1,448 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                     profiler.cpp                      //
+//                                                       //
+//              Copyright (C) 2026 by agent              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <chrono>
+#include <sstream>
+#include <iomanip>
+#include <locale>
+
+#if defined(_SAGA_MSW)
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <unistd.h>
+#include <sys/resource.h>
+#endif
+
+#include "profiler.h"
+#include "mat_tools.h"
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define SG_PROFILE_MAX_SECTIONS	256
+
+typedef struct
+{
+	const char	*Name;
+
+	double		Time;
+
+	sLong		Count;
+}
+TSG_Profile_Section;
+
+//---------------------------------------------------------
+static bool					gSG_Profile_bEnabled	= false;
+
+static sLong				gSG_Profile_Counter[SG_PROFILE_COUNTERS]	= { 0 };
+
+static int					gSG_Profile_nSections	= 0;
+
+static TSG_Profile_Section	gSG_Profile_Sections[SG_PROFILE_MAX_SECTIONS];
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void	SG_Profile_Set_Enabled	(bool bOn)
+{
+	gSG_Profile_bEnabled	= bOn;
+}
+
+//---------------------------------------------------------
+bool	SG_Profile_is_Enabled	(void)
+{
+	return( gSG_Profile_bEnabled );
+}
+
+//---------------------------------------------------------
+double	SG_Profile_Get_Time		(void)
+{
+	return( std::chrono::duration<double>(std::chrono::steady_clock::now().time_since_epoch()).count() );
+}
+
+//---------------------------------------------------------
+void	SG_Profile_Add			(const char *Section, double Time, sLong Count)
+{
+	if( !gSG_Profile_bEnabled || !Section )
+	{
+		return;
+	}
+
+	#pragma omp critical(SG_Profile_Sections)
+	{
+		int i = 0;
+
+		while( i < gSG_Profile_nSections && gSG_Profile_Sections[i].Name != Section && strcmp(gSG_Profile_Sections[i].Name, Section) )
+		{
+			i++;
+		}
+
+		if( i == gSG_Profile_nSections && i < SG_PROFILE_MAX_SECTIONS )
+		{
+			gSG_Profile_Sections[i].Name  = Section;
+			gSG_Profile_Sections[i].Time  = 0.;
+			gSG_Profile_Sections[i].Count = 0;
+
+			gSG_Profile_nSections++;
+		}
+
+		if( i < gSG_Profile_nSections )
+		{
+			gSG_Profile_Sections[i].Time  += Time ;
+			gSG_Profile_Sections[i].Count += Count;
+		}
+	}
+}
+
+//---------------------------------------------------------
+void	SG_Profile_Add_Counter	(TSG_Profile_Counter Counter, sLong Value)
+{
+	if( gSG_Profile_bEnabled && Counter >= 0 && Counter < SG_PROFILE_COUNTERS )
+	{
+		#pragma omp atomic
+		gSG_Profile_Counter[Counter] += Value;
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+double	SG_Profile_Get_CPU_Time		(void)
+{
+#if defined(_SAGA_MSW)
+	FILETIME Creation, Exit, Kernel, User;
+
+	if( GetProcessTimes(GetCurrentProcess(), &Creation, &Exit, &Kernel, &User) )
+	{
+		ULARGE_INTEGER k, u;
+
+		k.LowPart = Kernel.dwLowDateTime; k.HighPart = Kernel.dwHighDateTime;
+		u.LowPart = User  .dwLowDateTime; u.HighPart = User  .dwHighDateTime;
+
+		return( (k.QuadPart + u.QuadPart) / 1e7 );	// 100 nanosecond intervals
+	}
+#else
+	struct rusage Usage;
+
+	if( getrusage(RUSAGE_SELF, &Usage) == 0 )
+	{
+		return( Usage.ru_utime.tv_sec + Usage.ru_stime.tv_sec + (Usage.ru_utime.tv_usec + Usage.ru_stime.tv_usec) / 1e6 );
+	}
+#endif
+
+	return( 0. );
+}
+
+//---------------------------------------------------------
+sLong	SG_Profile_Get_Memory		(void)
+{
+#if defined(_SAGA_MSW)
+	PROCESS_MEMORY_COUNTERS Counters;
+
+	if( GetProcessMemoryInfo(GetCurrentProcess(), &Counters, sizeof(Counters)) )
+	{
+		return( (sLong)Counters.WorkingSetSize );
+	}
+#elif defined(_SAGA_LINUX)
+	FILE *Stream = fopen("/proc/self/statm", "r");
+
+	if( Stream )
+	{
+		long Size, Resident; bool bOkay = fscanf(Stream, "%ld %ld", &Size, &Resident) == 2;
+
+		fclose(Stream);
+
+		if( bOkay )
+		{
+			return( (sLong)Resident * sysconf(_SC_PAGESIZE) );
+		}
+	}
+#endif
+
+	return( 0 );
+}
+
+//---------------------------------------------------------
+sLong	SG_Profile_Get_Memory_Peak	(void)
+{
+#if defined(_SAGA_MSW)
+	PROCESS_MEMORY_COUNTERS Counters;
+
+	if( GetProcessMemoryInfo(GetCurrentProcess(), &Counters, sizeof(Counters)) )
+	{
+		return( (sLong)Counters.PeakWorkingSetSize );
+	}
+#else
+	struct rusage Usage;
+
+	if( getrusage(RUSAGE_SELF, &Usage) == 0 )
+	{
+	#if defined(__APPLE__)
+		return( (sLong)Usage.ru_maxrss        );	// bytes
+	#else
+		return( (sLong)Usage.ru_maxrss * 1024 );	// kilobytes
+	#endif
+	}
+#endif
+
+	return( 0 );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                      CSG_Profile                      //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Profile::CSG_Profile(void)
+{
+	m_bRunning    = false;
+
+	m_Wall_Time   = 0.;
+	m_CPU_Time    = 0.;
+	m_Memory      = 0 ;
+	m_Memory_Peak = 0 ;
+
+	for(int i=0; i<SG_PROFILE_COUNTERS; i++)
+	{
+		m_Counter[i] = 0;
+	}
+
+	m_Times.Create(sizeof(double));
+}
+
+//---------------------------------------------------------
+// While running, the members hold the state at start time,
+// Stop() turns them into the differences.
+//---------------------------------------------------------
+bool CSG_Profile::Start(const CSG_String &Name)
+{
+	m_Name        = Name;
+
+	m_bRunning    = true;
+
+	m_Wall_Time   = SG_Profile_Get_Time    ();
+	m_CPU_Time    = SG_Profile_Get_CPU_Time();
+	m_Memory      = SG_Profile_Get_Memory  ();
+	m_Memory_Peak = 0;
+
+	m_Names .Clear  ();
+	m_Counts.Destroy();
+	m_Times .Destroy();
+
+	#pragma omp critical(SG_Profile_Sections)
+	{
+		for(int i=0; i<SG_PROFILE_COUNTERS; i++)
+		{
+			m_Counter[i] = gSG_Profile_Counter[i];
+		}
+
+		for(int i=0; i<gSG_Profile_nSections; i++)
+		{
+			m_Counts += gSG_Profile_Sections[i].Count;
+
+			m_Times.Inc_Array(); *(double *)m_Times.Get_Entry(i) = gSG_Profile_Sections[i].Time;
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Profile::Stop(void)
+{
+	if( !m_bRunning )
+	{
+		return( false );
+	}
+
+	m_bRunning    = false;
+
+	m_Wall_Time   = SG_Profile_Get_Time    () - m_Wall_Time;
+	m_CPU_Time    = SG_Profile_Get_CPU_Time() - m_CPU_Time ;
+	m_Memory_Peak = SG_Profile_Get_Memory_Peak();
+
+	CSG_Array_sLong Counts; CSG_Array Times(sizeof(double));
+
+	#pragma omp critical(SG_Profile_Sections)
+	{
+		for(int i=0; i<SG_PROFILE_COUNTERS; i++)
+		{
+			m_Counter[i] = gSG_Profile_Counter[i] - m_Counter[i];
+		}
+
+		for(int i=0; i<gSG_Profile_nSections; i++)
+		{
+			sLong  Count = gSG_Profile_Sections[i].Count;
+			double Time  = gSG_Profile_Sections[i].Time ;
+
+			if( i < m_Counts.Get_Size() )
+			{
+				Count -= m_Counts[i];
+				Time  -= *(double *)m_Times.Get_Entry(i);
+			}
+
+			if( Count > 0 )
+			{
+				m_Names += CSG_String(gSG_Profile_Sections[i].Name);
+
+				Counts  += Count;
+
+				Times.Inc_Array(); *(double *)Times.Get_Entry(Times.Get_Size() - 1) = Time;
+			}
+		}
+	}
+
+	m_Counts = Counts;
+	m_Times  = Times ;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_String CSG_Profile::to_Text(void) const
+{
+	#define MEGABYTES(n)	((double)(n) / N_MEGABYTE_BYTES)
+
+	CSG_String Text;
+
+	Text += CSG_String::Format("[%s] %s\n", m_Name.c_str(), _TL("Profile"));
+
+	Text += CSG_String::Format("%s: %.3f s, %s: %.3f s (%.0f%%)\n",
+		_TL("wall time"), m_Wall_Time, _TL("CPU time"), m_CPU_Time, m_Wall_Time > 0. ? 100. * m_CPU_Time / m_Wall_Time : 0.
+	);
+
+	Text += CSG_String::Format("%s: %.1f MB %s, %.1f MB %s\n", _TL("memory"),
+		MEGABYTES(m_Memory), _TL("at start"), MEGABYTES(m_Memory_Peak), _TL("peak")
+	);
+
+	Text += CSG_String::Format("%s: %.1f MB, %s: %.1f MB\n",
+		_TL("read"   ), MEGABYTES(m_Counter[SG_PROFILE_BYTES_READ   ]),
+		_TL("written"), MEGABYTES(m_Counter[SG_PROFILE_BYTES_WRITTEN])
+	);
+
+	for(int i=0; i<Get_Section_Count(); i++)
+	{
+		Text += CSG_String::Format("- %s: %.3f s (%lld)\n", Get_Section_Name(i).c_str(), Get_Section_Time(i), Get_Section_Calls(i));
+	}
+
+	return( Text );
+}
+
+//---------------------------------------------------------
+// JSON wants the decimal point, whatever the locale is.
+//---------------------------------------------------------
+static CSG_String	SG_Profile_JSON_Number	(double Value)
+{
+	std::ostringstream Stream; Stream.imbue(std::locale::classic());
+
+	Stream << std::fixed << std::setprecision(6) << Value;
+
+	return( CSG_String(Stream.str().c_str()) );
+}
+
+//---------------------------------------------------------
+CSG_String	SG_Profile_JSON_String	(const CSG_String &Value)
+{
+	CSG_String String(Value); String.Replace("\\", "\\\\"); String.Replace("\"", "\\\"");
+
+	String.Replace("\n", "\\n"); String.Replace("\r", "\\r"); String.Replace("\t", "\\t");
+
+	return( "\"" + String + "\"" );
+}
+
+//---------------------------------------------------------
+CSG_String CSG_Profile::to_JSON(void) const
+{
+	CSG_String JSON("{\n");
+
+	JSON += CSG_String::Format("  \"name\": %s,\n"         , SG_Profile_JSON_String(m_Name).c_str());
+	JSON += CSG_String::Format("  \"wall_time\": %s,\n"    , SG_Profile_JSON_Number(m_Wall_Time).c_str());
+	JSON += CSG_String::Format("  \"cpu_time\": %s,\n"     , SG_Profile_JSON_Number(m_CPU_Time ).c_str());
+	JSON += CSG_String::Format("  \"memory_start\": %lld,\n", m_Memory     );
+	JSON += CSG_String::Format("  \"memory_peak\": %lld,\n" , m_Memory_Peak);
+	JSON += CSG_String::Format("  \"bytes_read\": %lld,\n"  , m_Counter[SG_PROFILE_BYTES_READ   ]);
+	JSON += CSG_String::Format("  \"bytes_written\": %lld,\n", m_Counter[SG_PROFILE_BYTES_WRITTEN]);
+	JSON += "  \"sections\": [";
+
+	for(int i=0; i<Get_Section_Count(); i++)
+	{
+		JSON += CSG_String::Format("%s\n    { \"name\": %s, \"time\": %s, \"calls\": %lld }", i > 0 ? SG_T(",") : SG_T(""),
+			SG_Profile_JSON_String(Get_Section_Name(i)).c_str(), SG_Profile_JSON_Number(Get_Section_Time(i)).c_str(), Get_Section_Calls(i)
+		);
+	}
+
+	JSON += Get_Section_Count() > 0 ? "\n  ]\n}" : "]\n}";
+
+	return( JSON );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
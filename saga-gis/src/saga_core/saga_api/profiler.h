@@ -0,0 +1,220 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                      profiler.h                       //
+//                                                       //
+//              Copyright (C) 2026 by agent              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef HEADER_INCLUDED__SAGA_API__profiler_H
+#define HEADER_INCLUDED__SAGA_API__profiler_H
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/** \file profiler.h
+* Run time instrumentation, i.e. timers and counters that
+* are accumulated while profiling is enabled and reported
+* for each tool execution.
+* @see CSG_Profile
+* @see CSG_Profile_Scope
+*/
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "api_core.h"
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                       Profiler                        //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+typedef enum
+{
+	SG_PROFILE_BYTES_READ	= 0,
+	SG_PROFILE_BYTES_WRITTEN,
+	SG_PROFILE_COUNTERS
+}
+TSG_Profile_Counter;
+
+//---------------------------------------------------------
+/** Profiling is disabled by default. While disabled all
+  * instrumentation reduces to a simple flag check.
+*/
+SAGA_API_DLL_EXPORT void		SG_Profile_Set_Enabled		(bool bOn);
+SAGA_API_DLL_EXPORT bool		SG_Profile_is_Enabled		(void);
+
+/** Returns a monotonic time stamp in seconds. */
+SAGA_API_DLL_EXPORT double		SG_Profile_Get_Time			(void);
+
+/** Adds time (seconds) and calls to the named section. The
+  * name is expected to be a string literal. Thread safe.
+*/
+SAGA_API_DLL_EXPORT void		SG_Profile_Add				(const char *Section, double Time, sLong Count = 1);
+SAGA_API_DLL_EXPORT void		SG_Profile_Add_Counter		(TSG_Profile_Counter Counter, sLong Value);
+
+/** Process wide CPU time (all threads) in seconds, current
+  * and peak resident memory size in bytes.
+*/
+SAGA_API_DLL_EXPORT double		SG_Profile_Get_CPU_Time		(void);
+SAGA_API_DLL_EXPORT sLong		SG_Profile_Get_Memory		(void);
+SAGA_API_DLL_EXPORT sLong		SG_Profile_Get_Memory_Peak	(void);
+
+/** Returns the string quoted and escaped as JSON string value. */
+SAGA_API_DLL_EXPORT CSG_String	SG_Profile_JSON_String		(const CSG_String &Value);
+
+//---------------------------------------------------------
+/**
+  * Scoped timer. Adds the time from construction to
+  * destruction to the given section, e.g.
+  * SG_PROFILE_SCOPE("grid load");
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Profile_Scope
+{
+public:
+	CSG_Profile_Scope(const char *Section) : m_Section(SG_Profile_is_Enabled() ? Section : NULL)
+	{
+		if( m_Section ) { m_Start = SG_Profile_Get_Time(); }
+	}
+
+	~CSG_Profile_Scope(void)
+	{
+		if( m_Section ) { SG_Profile_Add(m_Section, SG_Profile_Get_Time() - m_Start); }
+	}
+
+
+private:
+
+	const char					*m_Section;
+
+	double						m_Start { 0. };
+
+};
+
+//---------------------------------------------------------
+#define SG_PROFILE_SCOPE(Section)	CSG_Profile_Scope	_SG_Profile_Scope_(Section)
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                      CSG_Profile                      //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Profile reports the resources used between calls to
+  * Start() and Stop(), i.e. wall and CPU time, resident
+  * memory, bytes read and written through CSG_File and the
+  * time spent in the annotated sections (e.g. grid load and
+  * save, index building, statistics update, UI callbacks).
+  * Section times are inclusive and summed up over threads.
+  * Profiles may overlap, e.g. for tools called by tools.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Profile
+{
+public:
+	CSG_Profile(void);
+
+	bool						Start				(const CSG_String &Name);
+	bool						Stop				(void);
+
+	bool						is_Running			(void)	const	{	return( m_bRunning );	}
+
+	const CSG_String &			Get_Name			(void)	const	{	return( m_Name );	}
+
+	double						Get_Wall_Time		(void)	const	{	return( m_Wall_Time   );	}
+	double						Get_CPU_Time		(void)	const	{	return( m_CPU_Time    );	}
+	sLong						Get_Memory			(void)	const	{	return( m_Memory      );	}
+	sLong						Get_Memory_Peak		(void)	const	{	return( m_Memory_Peak );	}
+	sLong						Get_Counter			(TSG_Profile_Counter Counter)	const	{	return( m_Counter[Counter] );	}
+
+	int							Get_Section_Count	(void)	const	{	return( m_Names.Get_Count() );	}
+	const CSG_String &			Get_Section_Name	(int i)	const	{	return( m_Names[i]      );	}
+	double						Get_Section_Time	(int i)	const	{	return( *(double *)m_Times.Get_Entry(i) );	}
+	sLong						Get_Section_Calls	(int i)	const	{	return( m_Counts[i]     );	}
+
+	CSG_String					to_Text				(void)	const;
+	CSG_String					to_JSON				(void)	const;
+
+
+private:
+
+	bool						m_bRunning;
+
+	double						m_Wall_Time, m_CPU_Time;
+
+	sLong						m_Memory, m_Memory_Peak, m_Counter[SG_PROFILE_COUNTERS];
+
+	CSG_String					m_Name;
+
+	CSG_Strings					m_Names;
+
+	CSG_Array_sLong				m_Counts;
+
+	CSG_Array					m_Times;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef HEADER_INCLUDED__SAGA_API__profiler_H
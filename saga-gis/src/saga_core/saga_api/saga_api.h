@@ -75,6 +75,7 @@
 //---------------------------------------------------------
 #include "tool_library.h"
 #include "data_manager.h"
+#include "simulation.h"
 
 
 ///////////////////////////////////////////////////////////
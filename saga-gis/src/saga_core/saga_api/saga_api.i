@@ -67,8 +67,10 @@
 #include "metadata.h"
 #include "parameters.h"
 #include "pointcloud.h"
+#include "profiler.h"
 #include "saga_api.h"
 #include "shapes.h"
+#include "simulation.h"
 #include "table.h"
 #include "table_value.h"
 #include "tin.h"
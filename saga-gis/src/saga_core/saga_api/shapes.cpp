@@ -175,6 +175,13 @@ CSG_Shapes::CSG_Shapes(const CSG_String &File)
 	_On_Construction(); Create(File);
 }
 
+//---------------------------------------------------------
+CSG_Shapes::CSG_Shapes(const CSG_String &File, const CSG_Rect &Extent)
+	: CSG_Table()
+{
+	_On_Construction(); Create(File, Extent);
+}
+
 //---------------------------------------------------------
 CSG_Shapes::CSG_Shapes(TSG_Shape_Type Type, const SG_Char *Name, CSG_Table *pTemplate, TSG_Vertex_Type Vertex_Type)
 	: CSG_Table()
@@ -216,6 +223,27 @@ bool CSG_Shapes::Create(const char       *File) { return( Create(CSG_String(File
 bool CSG_Shapes::Create(const wchar_t    *File) { return( Create(CSG_String(File)) ); }
 bool CSG_Shapes::Create(const CSG_String &File)
 {
+	return( _Load(File, NULL) );
+}
+
+//---------------------------------------------------------
+/**
+* Loads only those shapes whose extent intersects with the
+* given one. Native files (*.sg-shp) are queried through
+* their spatial index, so that nothing else is read. Any
+* other format is loaded completely and filtered afterwards.
+*/
+//---------------------------------------------------------
+bool CSG_Shapes::Create(const CSG_String &File, const CSG_Rect &Extent)
+{
+	return( _Load(File, &Extent) );
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes::_Load(const CSG_String &File, const CSG_Rect *pExtent)
+{
+	SG_PROFILE_SCOPE("shapes load");
+
 	Destroy();
 
 	SG_UI_Msg_Add(CSG_String::Format("%s %s: %s...", _TL("Loading"), _TL("shapes"), File.c_str()), true);
@@ -251,6 +279,10 @@ bool CSG_Shapes::Create(const CSG_String &File)
 			SG_UI_ProgressAndMsg_Lock(false);
 		}
 	}
+	else if( SG_File_Cmp_Extension(File, "sg-shp") )
+	{
+		bResult = _Load_Native(File, pExtent);
+	}
 	else
 	{
 		if( SG_File_Cmp_Extension(File, "shp") )
@@ -264,6 +296,20 @@ bool CSG_Shapes::Create(const CSG_String &File)
 		}
 	}
 
+	//-----------------------------------------------------
+	if( bResult && pExtent && !SG_File_Cmp_Extension(File, "sg-shp") )
+	{
+		for(sLong i=0; i<Get_Count(); i++)
+		{
+			if( pExtent->Intersects(Get_Shape(i)->Get_Extent()) == INTERSECTION_None )
+			{
+				Select(i, true);
+			}
+		}
+
+		Del_Selection();
+	}
+
 	//-----------------------------------------------------
 	if( bResult )
 	{
@@ -330,6 +376,8 @@ CSG_Shapes::~CSG_Shapes(void)
 //---------------------------------------------------------
 bool CSG_Shapes::Destroy(void)
 {
+	_Native_Close();
+
 	if( CSG_Table::Destroy() )
 	{
 		m_Type = SHAPE_TYPE_Undefined;
@@ -423,6 +471,136 @@ bool CSG_Shapes::Del_Shape(sLong Index)
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// While shapes are read deferred from a native file, the
+// records are in place but might still be empty. Anything
+// that changes the table structure, the record order or
+// processes the plain record array reads all remaining
+// shapes first.
+//---------------------------------------------------------
+CSG_Table_Record * CSG_Shapes::Get_Record(sLong Index)	const
+{
+	if( m_pNative && Index >= 0 && Index < Get_Count() )
+	{
+		((CSG_Shapes *)this)->_Native_Load(Index);
+	}
+
+	return( CSG_Table::Get_Record(Index) );
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes::Add_Field(const CSG_String &Name, TSG_Data_Type Type, int Position)
+{
+	return( _Native_Load() && CSG_Table::Add_Field(Name, Type, Position) );
+}
+
+bool CSG_Shapes::Del_Field(int Field)
+{
+	return( _Native_Load() && CSG_Table::Del_Field(Field) );
+}
+
+bool CSG_Shapes::Mov_Field(int Field, int Position)
+{
+	return( _Native_Load() && CSG_Table::Mov_Field(Field, Position) );
+}
+
+bool CSG_Shapes::Set_Field_Type(int Field, TSG_Data_Type Type)
+{
+	return( _Native_Load() && CSG_Table::Set_Field_Type(Field, Type) );
+}
+
+int CSG_Shapes::Get_Field_Length(int Field, int Encoding)	const
+{
+	return( ((CSG_Shapes *)this)->_Native_Load() ? CSG_Table::Get_Field_Length(Field, Encoding) : 0 );
+}
+
+//---------------------------------------------------------
+CSG_Table_Record * CSG_Shapes::Ins_Record(sLong Index, CSG_Table_Record *pCopy)
+{
+	return( _Native_Load() ? CSG_Table::Ins_Record(Index, pCopy) : NULL );
+}
+
+bool CSG_Shapes::Set_Record(sLong Index, CSG_Table_Record *pCopy)
+{
+	return( Get_Record(Index) && CSG_Table::Set_Record(Index, pCopy) );
+}
+
+bool CSG_Shapes::Del_Record(sLong Index)
+{
+	return( _Native_Load() && CSG_Table::Del_Record(Index) );
+}
+
+bool CSG_Shapes::Del_Records(void)
+{
+	_Native_Close();
+
+	return( CSG_Table::Del_Records() );
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes::Find_Record(sLong &Index, int Field, const CSG_String &Value, bool bCreateIndex)
+{
+	return( _Native_Load() && CSG_Table::Find_Record(Index, Field, Value, bCreateIndex) );
+}
+
+bool CSG_Shapes::Find_Record(sLong &Index, int Field, double Value, bool bCreateIndex)
+{
+	return( _Native_Load() && CSG_Table::Find_Record(Index, Field, Value, bCreateIndex) );
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes::Sort(const CSG_Index &Index)
+{
+	return( _Native_Load() && CSG_Table::Sort(Index) );
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes::_Stats_Update(int Field)	const
+{
+	return( ((CSG_Shapes *)this)->_Native_Load() && CSG_Table::_Stats_Update(Field) );
+}
+
+bool CSG_Shapes::_Histogram_Update(int Field, size_t nClasses)	const
+{
+	return( ((CSG_Shapes *)this)->_Native_Load() && CSG_Table::_Histogram_Update(Field, nClasses) );
+}
+
+//---------------------------------------------------------
+/**
+* Collects the indices of all shapes whose extent intersects
+* with the given rectangle in ascending order. While shapes
+* are read deferred from a native file, the file's spatial
+* index is queried and only the matching shapes are read.
+*/
+//---------------------------------------------------------
+sLong CSG_Shapes::Find_Shapes(const CSG_Rect &Extent, CSG_Array_sLong &Shapes)
+{
+	if( m_pNative )
+	{
+		return( _Native_Find(Extent, Shapes) );
+	}
+
+	Shapes.Destroy();
+
+	if( Extent.Intersects(Get_Extent()) != INTERSECTION_None )
+	{
+		for(sLong i=0; i<Get_Count(); i++)
+		{
+			if( Extent.Intersects(Get_Shape(i)->Get_Extent()) != INTERSECTION_None )
+			{
+				Shapes += i;
+			}
+		}
+	}
+
+	return( Shapes.Get_Size() );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                                                       //
@@ -432,6 +610,16 @@ bool CSG_Shapes::Del_Shape(sLong Index)
 //---------------------------------------------------------
 bool CSG_Shapes::On_Update(void)
 {
+	if( m_pNative )
+	{
+		if( !is_Modified() ) // the extent stored in the file header is still valid
+		{
+			return( CSG_Table::On_Update() );
+		}
+
+		_Native_Load();
+	}
+
 	if( Get_Count() > 0 )
 	{
 		CSG_Shape *pShape = Get_Shape(0);
@@ -488,11 +676,11 @@ CSG_Shape * CSG_Shapes::Get_Shape(const CSG_Point &Point, double Epsilon)
 
 	if( r.Intersects(Get_Extent()) != INTERSECTION_None )
 	{
-		double dNearest = -1.;
+		double dNearest = -1.; CSG_Array_sLong Shapes; Find_Shapes(r, Shapes);
 
-		for(sLong iShape=0; iShape<Get_Count(); iShape++)
+		for(sLong i=0; i<Shapes.Get_Size(); i++)
 		{
-			CSG_Shape *pShape = Get_Shape(iShape);
+			CSG_Shape *pShape = Get_Shape(Shapes[i]);
 
 			if( pShape->Intersects(r) )
 			{
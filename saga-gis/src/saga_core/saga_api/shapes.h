@@ -115,7 +115,8 @@ typedef enum
 	SHAPE_FILE_FORMAT_Undefined	= 0,
 	SHAPE_FILE_FORMAT_ESRI,
 	SHAPE_FILE_FORMAT_GeoPackage,
-	SHAPE_FILE_FORMAT_GeoJSON
+	SHAPE_FILE_FORMAT_GeoJSON,
+	SHAPE_FILE_FORMAT_Native
 }
 TSG_Shape_File_Format;
 
@@ -787,6 +788,9 @@ public:
 									CSG_Shapes	(const CSG_String &File);
 	bool							Create		(const CSG_String &File);
 
+									CSG_Shapes	(const CSG_String &File, const CSG_Rect &Extent);
+	bool							Create		(const CSG_String &File, const CSG_Rect &Extent);
+
 									CSG_Shapes	(TSG_Shape_Type Type, const SG_Char *Name = NULL, CSG_Table *pTemplate = NULL, TSG_Vertex_Type Vertex_Type = SG_VERTEX_TYPE_XY);
 	bool							Create		(TSG_Shape_Type Type, const SG_Char *Name = NULL, CSG_Table *pTemplate = NULL, TSG_Vertex_Type Vertex_Type = SG_VERTEX_TYPE_XY);
 
@@ -815,6 +819,39 @@ public:
 	double							Get_MMin				(void)					{	Update();	return( m_MMin );	}
 	double							Get_MMax				(void)					{	Update();	return( m_MMax );	}
 
+	//-----------------------------------------------------
+	virtual bool					Add_Field				(const CSG_String &Name, TSG_Data_Type Type, int Position = -1);
+	virtual bool					Del_Field				(int Field);
+	virtual bool					Mov_Field				(int Field, int Position);
+	virtual bool					Set_Field_Type			(int Field, TSG_Data_Type Type);
+	virtual int						Get_Field_Length		(int Field, int Encoding = SG_FILE_ENCODING_UNDEFINED)	const;
+
+	virtual CSG_Table_Record *		Get_Record				(sLong Index)	const;
+	virtual CSG_Table_Record *		Ins_Record				(sLong Index, CSG_Table_Record *pCopy = NULL);
+	virtual bool					Set_Record				(sLong Index, CSG_Table_Record *pCopy);
+	virtual bool					Del_Record				(sLong Index);
+	virtual bool					Del_Records				(void);
+
+	virtual bool					Find_Record				(sLong &Index, int Field, const CSG_String &Value, bool bCreateIndex = false);
+	virtual CSG_Table_Record *		Find_Record				(              int Field, const CSG_String &Value, bool bCreateIndex = false)	{	return( CSG_Table::Find_Record(Field, Value, bCreateIndex) );	}
+	virtual bool					Find_Record				(sLong &Index, int Field, double            Value, bool bCreateIndex = false);
+	virtual CSG_Table_Record *		Find_Record				(              int Field, double            Value, bool bCreateIndex = false)	{	return( CSG_Table::Find_Record(Field, Value, bCreateIndex) );	}
+
+	bool							Sort					(const char       *Field, bool bAscending = true)	{	return( CSG_Table::Sort(Field, bAscending) );	}
+	bool							Sort					(const wchar_t    *Field, bool bAscending = true)	{	return( CSG_Table::Sort(Field, bAscending) );	}
+	bool							Sort					(const CSG_String &Field, bool bAscending = true)	{	return( CSG_Table::Sort(Field, bAscending) );	}
+	bool							Sort					(int               Field, bool bAscending = true)	{	return( CSG_Table::Sort(Field, bAscending) );	}
+	virtual bool					Sort					(const CSG_Index &Index);
+
+	//-----------------------------------------------------
+	/** Returns true while shapes opened from a native file
+	  * (*.sg-shp) are still waiting to be read. Geometries and
+	  * attributes are then read page-wise on first access.
+	*/
+	bool							is_Deferred				(void)	const			{	return( m_pNative != NULL );	}
+
+	sLong							Find_Shapes				(const CSG_Rect &Extent, CSG_Array_sLong &Shapes);
+
 	//-----------------------------------------------------
 	virtual CSG_Shape *				Add_Shape				(CSG_Table_Record *pCopy = NULL, TSG_ADD_Shape_Copy_Mode mCopy = SHAPE_COPY);
 	virtual bool					Del_Shape				(sLong Index);
@@ -857,15 +894,31 @@ protected:
 
 	virtual CSG_Table_Record *		_Get_New_Record			(sLong Index);
 
+	virtual bool					_Stats_Update			(int Field) const;
+	virtual bool					_Histogram_Update		(int Field, size_t nClasses) const;
+
 
 private:
 
+	class CSG_Shapes_Native			*m_pNative = NULL;
+
+
+	bool							_Load					(const CSG_String &File, const CSG_Rect *pExtent);
+
 	bool							_Load_GDAL				(const CSG_String &File);
 	bool							_Save_GDAL				(const CSG_String &File, const CSG_String &Driver);
 
 	bool							_Load_ESRI				(const CSG_String &File);
 	bool							_Save_ESRI				(const CSG_String &File);
 
+	bool							_Load_Native			(const CSG_String &File, const CSG_Rect *pExtent);
+	bool							_Save_Native			(const CSG_String &File);
+
+	bool							_Native_Load			(sLong Index);
+	bool							_Native_Load			(void);
+	sLong							_Native_Find			(const CSG_Rect &Extent, CSG_Array_sLong &Shapes);
+	void							_Native_Close			(void);
+
 };
 
 
@@ -1472,6 +1525,78 @@ SAGA_API_DLL_EXPORT bool			SG_Shape_Get_Offset			(CSG_Shape *pSubject, double Si
 SAGA_API_DLL_EXPORT const char *	SG_Clipper_Get_Version		(void);
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//					Polygon Rasterizer					 //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Shape_Polygon_Rasterizer prepares a polygon once for
+  * rasterization to a grid system. The scanline crossings at
+  * the cell centers of each row are computed and sorted when
+  * the polygon is set, so that the cells inside (even-odd rule)
+  * can be requested as column spans. Optionally it keeps a row
+  * indexed edge table, which allows to calculate the exact
+  * fraction of each cell's area covered by the polygon.
+  * Row requests do not modify the rasterizer, so that the rows
+  * of a polygon can be processed in parallel.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Shape_Polygon_Rasterizer
+{
+public:
+	CSG_Shape_Polygon_Rasterizer(void);
+	virtual ~CSG_Shape_Polygon_Rasterizer(void);
+
+								CSG_Shape_Polygon_Rasterizer	(const class CSG_Grid_System &System);
+	bool						Create				(const class CSG_Grid_System &System);
+
+	bool						Destroy				(void);
+
+	bool						Set_Polygon			(CSG_Shape_Polygon *pPolygon, bool bCoverage = false);
+	bool						Set_Polygon			(CSG_Shape_Polygon *pPolygon, bool bCoverage, int yMin, int yMax);
+
+	bool						is_Empty			(void)	const	{	return( m_yMin > m_yMax );	}
+
+	int							Get_xMin			(void)	const	{	return( m_xMin );	}
+	int							Get_xMax			(void)	const	{	return( m_xMax );	}
+	int							Get_yMin			(void)	const	{	return( m_yMin );	}
+	int							Get_yMax			(void)	const	{	return( m_yMax );	}
+
+	int							Get_Spans			(int y, CSG_Array_Int &Spans)	const;
+
+	bool						Get_Coverage		(int y, CSG_Vector &Coverage)	const;
+
+
+private:
+
+	typedef struct
+	{
+		double					ax, ay, bx, by, Sign;
+	}
+	TEdge;
+
+
+	bool						m_bCoverage = false;
+
+	int							m_NX = 0, m_NY = 0, m_xMin = 0, m_xMax = -1, m_yMin = 0, m_yMax = -1;
+
+	double						m_xOrigin = 0., m_yOrigin = 0., m_Cellsize = 1.;
+
+	CSG_Array					m_Edges;
+
+	CSG_Array_Int				m_Crossing_Offset, m_Edge_Offset, m_Edge_Index;
+
+	CSG_Vector					m_Crossings;
+
+
+	const TEdge &				_Get_Edge			(sLong i)	const	{	return( ((const TEdge *)m_Edges.Get_Array())[i] );	}
+
+};
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //						OpenGIS							 //
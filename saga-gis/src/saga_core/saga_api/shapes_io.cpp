@@ -50,6 +50,9 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <algorithm>
+#include <atomic>
+
 #include "shapes.h"
 #include "table_dbase.h"
 #include "tool_library.h"
@@ -85,6 +88,8 @@ bool CSG_Shapes::On_Delete(void)
 	SG_File_Set_Extension(File_Name, "xml"); SG_File_Delete(File_Name);	// metadata
 	SG_File_Set_Extension(File_Name, "cpg"); SG_File_Delete(File_Name);	// code page
 	SG_File_Set_Extension(File_Name, "qix"); SG_File_Delete(File_Name);	// quadtree spatial index
+	SG_File_Set_Extension(File_Name, "mshp"  ); SG_File_Delete(File_Name);	// metadata (native)
+	SG_File_Set_Extension(File_Name, "sg-prj"); SG_File_Delete(File_Name);	// projection (native)
 
 	return( true );
 }
@@ -107,6 +112,7 @@ bool					SG_Shapes_Set_File_Format_Default	(int Format)
 	case SHAPE_FILE_FORMAT_ESRI      :
 	case SHAPE_FILE_FORMAT_GeoPackage:
 	case SHAPE_FILE_FORMAT_GeoJSON   :
+	case SHAPE_FILE_FORMAT_Native    :
 		gSG_Shape_File_Format_Default = (TSG_Shape_File_Format)Format;
 		return( true );
 	}
@@ -129,6 +135,7 @@ CSG_String				SG_Shapes_Get_File_Extension_Default	(void)
 	case SHAPE_FILE_FORMAT_ESRI      :	return( "shp"     );
 	case SHAPE_FILE_FORMAT_GeoPackage:	return( "gpkg"    );
 	case SHAPE_FILE_FORMAT_GeoJSON   :	return( "geojson" );
+	case SHAPE_FILE_FORMAT_Native    :	return( "sg-shp"  );
 	}
 }
 
@@ -145,6 +152,8 @@ bool CSG_Shapes::Save(const CSG_String &File, int Format)
 		return( *Get_File_Name(false) ? Save(Get_File_Name(false), Format) : false );
 	}
 
+	SG_PROFILE_SCOPE("shapes save");
+
 	if( Format == SHAPE_FILE_FORMAT_Undefined )
 	{
 		Format = gSG_Shape_File_Format_Default;
@@ -152,6 +161,7 @@ bool CSG_Shapes::Save(const CSG_String &File, int Format)
 		if( SG_File_Cmp_Extension(File, "shp"    ) ) { Format = SHAPE_FILE_FORMAT_ESRI      ; }
 		if( SG_File_Cmp_Extension(File, "gpkg"   ) ) { Format = SHAPE_FILE_FORMAT_GeoPackage; }
 		if( SG_File_Cmp_Extension(File, "geojson") ) { Format = SHAPE_FILE_FORMAT_GeoJSON   ; }
+		if( SG_File_Cmp_Extension(File, "sg-shp" ) ) { Format = SHAPE_FILE_FORMAT_Native    ; }
 
 		if( SG_File_Cmp_Extension(File, "txt"    ) ) { return( _Save_Text (File, true, '\t') ); }
 		if( SG_File_Cmp_Extension(File, "csv"    ) ) { return( _Save_Text (File, true,  ',') ); }
@@ -159,6 +169,11 @@ bool CSG_Shapes::Save(const CSG_String &File, int Format)
 	}
 
 	//-----------------------------------------------------
+	if( !_Native_Load() ) // read all deferred shapes before the source file might get overwritten
+	{
+		return( false );
+	}
+
 	bool bResult = false;
 
 	SG_UI_Msg_Add(CSG_String::Format("%s %s: %s...", _TL("Saving"), _TL("shapes"), File.c_str()), true);
@@ -168,6 +183,7 @@ bool CSG_Shapes::Save(const CSG_String &File, int Format)
 	case SHAPE_FILE_FORMAT_ESRI      : bResult = _Save_ESRI(File           ); break;
 	case SHAPE_FILE_FORMAT_GeoPackage: bResult = _Save_GDAL(File, "GPKG"   ); break;
 	case SHAPE_FILE_FORMAT_GeoJSON   : bResult = _Save_GDAL(File, "GeoJSON"); break;
+	case SHAPE_FILE_FORMAT_Native    : bResult = _Save_Native(File         ); break;
 	}
 
 	//-----------------------------------------------------
@@ -907,6 +923,946 @@ bool CSG_Shapes::_Save_ESRI(const CSG_String &File_Name)
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+//                  Native File Format                   //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// A single, uncompressed and randomly accessible file in
+// the byte order of the writing machine:
+//
+// - header (file id, byte order mark, shape and vertex
+//   type, field count, index node size, shape count,
+//   extent, z/m ranges, no-data range, offsets of
+//   directory and spatial index)
+// - field definitions (type, utf-8 name, column offsets)
+// - geometries (part count, point count, part sizes,
+//   x/y coordinates, optional z and m values)
+// - directory (absolute geometry offsets, n + 1 entries)
+// - attribute columns (fixed size values or, for strings,
+//   dates and binaries, the data followed by n + 1 offsets)
+// - packed Hilbert R-tree (levels stored root first)
+//
+// Shapes are kept in their original (FID) order. The leaf
+// nodes of the spatial index refer to these shape indices.
+
+//---------------------------------------------------------
+#define NATIVE_FILE_ID		"SGSHP01"	// 8 bytes including the terminating zero
+#define NATIVE_NODE_SIZE	16
+#define NATIVE_PAGE_SIZE	256
+#define NATIVE_BYTE_ORDER	0x01020304	// reads as 0x04030201 with swapped byte order
+
+//---------------------------------------------------------
+typedef struct
+{
+	double	xMin, yMin, xMax, yMax;
+
+	sLong	Offset;	// leaf: shape index, else: index of first child node
+}
+TSG_Native_Node;
+
+//---------------------------------------------------------
+int		SG_Native_Get_Value_Size	(int Type)
+{
+	switch( Type )
+	{
+	case SG_DATATYPE_Color :
+	case SG_DATATYPE_Byte  :
+	case SG_DATATYPE_Char  :
+	case SG_DATATYPE_Word  :
+	case SG_DATATYPE_Short :
+	case SG_DATATYPE_Int   : return( sizeof(int   ) );
+
+	case SG_DATATYPE_DWord :	// unsigned 32 bit values do not fit into int
+	case SG_DATATYPE_ULong :
+	case SG_DATATYPE_Long  : return( sizeof(sLong ) );
+
+	case SG_DATATYPE_Float :
+	case SG_DATATYPE_Double: return( sizeof(double) );
+
+	default                : return( 0 );	// variable size (string, date, binary)
+	}
+}
+
+//---------------------------------------------------------
+// Hilbert curve index of a 16 bit coordinate pair, based on
+// the non-recursive algorithm by rawrunprotected.
+//---------------------------------------------------------
+unsigned int	SG_Native_Get_Hilbert	(unsigned int x, unsigned int y)
+{
+	unsigned int	a	= x ^ y;
+	unsigned int	b	= 0xFFFF ^ a;
+	unsigned int	c	= 0xFFFF ^ (x | y);
+	unsigned int	d	= x & (y ^ 0xFFFF);
+
+	unsigned int	A	= a | (b >> 1);
+	unsigned int	B	= (a >> 1) ^ a;
+	unsigned int	C	= ((c >> 1) ^ (b & (d >> 1))) ^ c;
+	unsigned int	D	= ((a & (c >> 1)) ^ (d >> 1)) ^ d;
+
+	a = A; b = B; c = C; d = D;
+	A  = ((a & (a >> 2)) ^ (b & (b >> 2)));
+	B  = ((a & (b >> 2)) ^ (b & ((a ^ b) >> 2)));
+	C ^= ((a & (c >> 2)) ^ (b & (d >> 2)));
+	D ^= ((b & (c >> 2)) ^ ((a ^ b) & (d >> 2)));
+
+	a = A; b = B; c = C; d = D;
+	A  = ((a & (a >> 4)) ^ (b & (b >> 4)));
+	B  = ((a & (b >> 4)) ^ (b & ((a ^ b) >> 4)));
+	C ^= ((a & (c >> 4)) ^ (b & (d >> 4)));
+	D ^= ((b & (c >> 4)) ^ ((a ^ b) & (d >> 4)));
+
+	a = A; b = B; c = C; d = D;
+	C ^= ((a & (c >> 8)) ^ (b & (d >> 8)));
+	D ^= ((b & (c >> 8)) ^ ((a ^ b) & (d >> 8)));
+
+	a = C ^ (C >> 1);
+	b = D ^ (D >> 1);
+
+	unsigned int	i0	= x ^ y;
+	unsigned int	i1	= b | (0xFFFF ^ (i0 | a));
+
+	i0 = (i0 | (i0 << 8)) & 0x00FF00FF;
+	i0 = (i0 | (i0 << 4)) & 0x0F0F0F0F;
+	i0 = (i0 | (i0 << 2)) & 0x33333333;
+	i0 = (i0 | (i0 << 1)) & 0x55555555;
+
+	i1 = (i1 | (i1 << 8)) & 0x00FF00FF;
+	i1 = (i1 | (i1 << 4)) & 0x0F0F0F0F;
+	i1 = (i1 | (i1 << 2)) & 0x33333333;
+	i1 = (i1 | (i1 << 1)) & 0x55555555;
+
+	return( (i1 << 1) | i0 );
+}
+
+//---------------------------------------------------------
+// Writes Count items of Size bytes, unless a previous write
+// has failed already. CSG_File::Write() returns the number
+// of bytes written.
+//---------------------------------------------------------
+void	SG_Native_Write		(CSG_File &Stream, bool &bResult, const void *Buffer, size_t Size, size_t Count = 1)
+{
+	if( bResult && Count > 0 && Stream.Write((void *)Buffer, Size, Count) != Size * Count )
+	{
+		bResult = false;
+	}
+}
+
+//---------------------------------------------------------
+// Start positions and node counts of the R-tree levels,
+// root level first, leaf level last.
+//---------------------------------------------------------
+void	SG_Native_Get_Levels	(sLong nItems, int Node_Size, CSG_Array_sLong &Start, CSG_Array_sLong &Count)
+{
+	Start.Destroy(); Count.Destroy();
+
+	if( nItems > 0 )
+	{
+		CSG_Array_sLong	Levels; Levels += nItems;
+
+		while( nItems > 1 )
+		{
+			Levels += (nItems = (nItems + Node_Size - 1) / Node_Size);
+		}
+
+		for(sLong i=Levels.Get_Size()-1, n=0; i>=0; i--)
+		{
+			Start += n; Count += Levels[i]; n += Levels[i];
+		}
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+class CSG_Shapes_Native
+{
+public:
+
+	TSG_Shape_Type		m_Type = SHAPE_TYPE_Undefined;
+
+	TSG_Vertex_Type		m_Vertex_Type = SG_VERTEX_TYPE_XY;
+
+	sLong				m_nShapes = 0;
+
+	double				m_Bounds[10];	// xmin, ymin, xmax, ymax, zmin, zmax, mmin, mmax, no-data min, no-data max
+
+	CSG_Strings			m_Names;
+
+	CSG_Array_Int		m_Types;
+
+
+	//-----------------------------------------------------
+	~CSG_Shapes_Native(void)
+	{
+		delete[](m_Pages);
+	}
+
+	//-----------------------------------------------------
+	bool				Open				(const CSG_String &File)
+	{
+		char ID[8]; int Order, Header[4]; sLong Offsets[3];
+
+		if( !m_Stream.Open(File, SG_FILE_R, true)
+		||  m_Stream.Read(ID     , sizeof(char  ),  8) !=  8 || memcmp(ID, NATIVE_FILE_ID, 8)
+		||  m_Stream.Read(&Order , sizeof(int   )    ) !=  1 )
+		{
+			return( false );
+		}
+
+		if( Order != NATIVE_BYTE_ORDER )
+		{
+			SG_UI_Msg_Add_Error(_TL("shape file has been written with a different byte order"));
+
+			return( false );
+		}
+
+		if( m_Stream.Read(Header , sizeof(int   ),  4) !=  4
+		||  m_Stream.Read(&m_nShapes, sizeof(sLong)  ) !=  1
+		||  m_Stream.Read(m_Bounds, sizeof(double), 10) != 10
+		||  m_Stream.Read(Offsets, sizeof(sLong ),  3) !=  3 )
+		{
+			return( false );
+		}
+
+		m_Type = (TSG_Shape_Type)Header[0]; m_Vertex_Type = (TSG_Vertex_Type)Header[1]; m_Node_Size = Header[3];
+
+		if( m_Type < SHAPE_TYPE_Point || m_Type > SHAPE_TYPE_Polygon || m_Vertex_Type < SG_VERTEX_TYPE_XY || m_Vertex_Type > SG_VERTEX_TYPE_XYZM
+		||  Header[2] < 0 || m_Node_Size < 2 || m_nShapes < 0 || Offsets[2] < 0 || Offsets[2] > m_nShapes )
+		{
+			return( false );
+		}
+
+		m_Directory = Offsets[0]; m_Index = Offsets[1]; m_nIndex = Offsets[2];
+
+		//-------------------------------------------------
+		m_Columns.Create(2 * Header[2]);
+
+		for(int Field=0; Field<Header[2]; Field++)
+		{
+			int Type, nName; CSG_Buffer Name;
+
+			if( m_Stream.Read(&Type , sizeof(int)) != 1
+			||  m_Stream.Read(&nName, sizeof(int)) != 1 || nName < 0 || !Name.Set_Size(nName + 1)
+			||  m_Stream.Read(Name.Get_Data(), sizeof(char), nName) != (size_t)nName
+			||  m_Stream.Read(m_Columns.Get_Array() + 2 * Field, sizeof(sLong), 2) != 2 )
+			{
+				return( false );
+			}
+
+			m_Types += Type; m_Names += CSG_String::from_UTF8(Name.Get_Data(), nName);
+		}
+
+		//-------------------------------------------------
+		SG_Native_Get_Levels(m_nIndex, m_Node_Size, m_Level_Start, m_Level_Count);
+
+		sLong nPages = (m_nShapes + NATIVE_PAGE_SIZE - 1) / NATIVE_PAGE_SIZE;
+
+		m_Pages = new std::atomic<char>[nPages > 0 ? nPages : 1];
+
+		for(sLong i=0; i<nPages; i++)
+		{
+			m_Pages[i].store(0, std::memory_order_relaxed);
+		}
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	// Page flags are published with release semantics after
+	// the page's shapes have been read, so that readers can
+	// check them without locking.
+	//-----------------------------------------------------
+	bool				is_Loaded			(sLong Index)	const	{	return( m_Pages[Index / NATIVE_PAGE_SIZE].load(std::memory_order_acquire) != 0 );	}
+	void				Set_Loaded			(sLong Index)			{	m_Pages[Index / NATIVE_PAGE_SIZE].store(1, std::memory_order_release);	}
+
+	//-----------------------------------------------------
+	// Reads geometries and attributes of the given (sorted)
+	// shape indices, contiguous runs are read at once.
+	//-----------------------------------------------------
+	bool				Read				(const sLong *Index, sLong n, CSG_Shape **pShapes)
+	{
+		for(sLong i=0, j; i<n; i=j)
+		{
+			for(j=i+1; j<n && Index[j] == Index[j - 1] + 1; j++) {}
+
+			if( Index[i] < 0 || Index[j - 1] >= m_nShapes
+			||  !_Read_Geometry(Index[i], j - i, pShapes + i)
+			||  !_Read_Values  (Index[i], j - i, pShapes + i) )
+			{
+				return( false );
+			}
+		}
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	// Collects the indices of all shapes whose extent
+	// intersects the given one, sorted ascending.
+	//-----------------------------------------------------
+	bool				Find				(const CSG_Rect &Extent, CSG_Array_sLong &Shapes)	const
+	{
+		Shapes.Destroy();
+
+		if( m_nIndex < 1 )
+		{
+			return( true );
+		}
+
+		int Leaf = (int)m_Level_Start.Get_Size() - 1;
+
+		CSG_Array_sLong Stack; Stack += m_Level_Start[0]; Stack += m_Level_Count[0]; Stack += 0;	// first node, node count, level
+
+		CSG_Array Nodes(sizeof(TSG_Native_Node), m_Node_Size); TSG_Native_Node *pNodes = (TSG_Native_Node *)Nodes.Get_Array();
+
+		while( Stack.Get_Size() > 0 )
+		{
+			sLong n = Stack.Get_Size(), First = Stack[n - 3], Count = Stack[n - 2]; int Level = (int)Stack[n - 1];
+
+			Stack.Set_Array(n - 3, false);
+
+			if( Count > m_Node_Size
+			||  !m_Stream.Seek(m_Index + First * sizeof(TSG_Native_Node))
+			||  m_Stream.Read(pNodes, sizeof(TSG_Native_Node), (size_t)Count) != (size_t)Count )
+			{
+				return( false );
+			}
+
+			for(sLong i=0; i<Count; i++)
+			{
+				const TSG_Native_Node &Node = pNodes[i];
+
+				if( Node.xMax >= Extent.Get_XMin() && Node.xMin <= Extent.Get_XMax()
+				&&  Node.yMax >= Extent.Get_YMin() && Node.yMin <= Extent.Get_YMax() )
+				{
+					if( Level == Leaf )
+					{
+						Shapes += Node.Offset;
+					}
+					else
+					{
+						sLong End = m_Level_Start[Level + 1] + m_Level_Count[Level + 1];
+
+						Stack += Node.Offset; Stack += M_GET_MIN(m_Node_Size, End - Node.Offset); Stack += Level + 1;
+					}
+				}
+			}
+		}
+
+		std::sort(Shapes.Get_Array(), Shapes.Get_Array() + Shapes.Get_Size());
+
+		return( true );
+	}
+
+
+private:
+
+	int					m_Node_Size = NATIVE_NODE_SIZE;
+
+	sLong				m_Directory = 0, m_Index = 0, m_nIndex = 0;
+
+	std::atomic<char>	*m_Pages = NULL;
+
+	CSG_Array_sLong		m_Columns, m_Level_Start, m_Level_Count;
+
+	CSG_File			m_Stream;
+
+
+	//-----------------------------------------------------
+	bool				_Read_Offsets		(sLong Position, sLong First, sLong n, CSG_Array_sLong &Offsets)	const
+	{
+		return( Offsets.Create(n + 1) && m_Stream.Seek(Position + First * sizeof(sLong))
+			&&  m_Stream.Read(Offsets.Get_Array(), sizeof(sLong), n + 1) == (size_t)(n + 1)
+		);
+	}
+
+	//-----------------------------------------------------
+	bool				_Read_Geometry		(sLong First, sLong n, CSG_Shape **pShapes)
+	{
+		CSG_Array_sLong Offsets; CSG_Buffer Data;
+
+		if( !_Read_Offsets(m_Directory, First, n, Offsets) || Offsets[n] < Offsets[0]
+		||  !Data.Set_Size((size_t)(Offsets[n] - Offsets[0])) || !m_Stream.Seek(Offsets[0])
+		||  m_Stream.Read(Data.Get_Data(), sizeof(char), Data.Get_Size()) != Data.Get_Size() )
+		{
+			return( false );
+		}
+
+		for(sLong i=0; i<n; i++)
+		{
+			const char *pData = Data.Get_Data() + (Offsets[i] - Offsets[0]); sLong Size = Offsets[i + 1] - Offsets[i];
+
+			int nParts, nPoints;
+
+			if( Size < (sLong)(2 * sizeof(int)) )
+			{
+				return( false );
+			}
+
+			memcpy(&nParts , pData, sizeof(int)); pData += sizeof(int);
+			memcpy(&nPoints, pData, sizeof(int)); pData += sizeof(int);
+
+			int nValues = m_Vertex_Type == SG_VERTEX_TYPE_XYZM ? 4 : m_Vertex_Type == SG_VERTEX_TYPE_XYZ ? 3 : 2;
+
+			if( nParts < 0 || nPoints < 0 || Size != (sLong)(2 * sizeof(int) + nParts * sizeof(int) + nPoints * nValues * sizeof(double)) )
+			{
+				return( false );
+			}
+
+			const int *Parts = (const int *)pData; const double *xy = (const double *)(pData + nParts * sizeof(int));
+
+			const double *z = xy + 2 * nPoints, *m = z + nPoints;
+
+			CSG_Shape *pShape = pShapes[i];
+
+			for(int iPart=0, iPoint=0, Count; iPart<nParts; iPart++)
+			{
+				memcpy(&Count, Parts + iPart, sizeof(int));
+
+				for(int j=0; j<Count && iPoint<nPoints; j++, iPoint++)
+				{
+					double Point[2]; memcpy(Point, xy + 2 * iPoint, 2 * sizeof(double));
+
+					pShape->Add_Point(Point[0], Point[1], iPart);
+
+					if( nValues > 2 ) { double Value; memcpy(&Value, z + iPoint, sizeof(double)); pShape->Set_Z(Value, j, iPart); }
+					if( nValues > 3 ) { double Value; memcpy(&Value, m + iPoint, sizeof(double)); pShape->Set_M(Value, j, iPart); }
+				}
+			}
+		}
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	bool				_Read_Values		(sLong First, sLong n, CSG_Shape **pShapes)
+	{
+		for(int Field=0; Field<m_Types.Get_Size(); Field++)
+		{
+			int Size = SG_Native_Get_Value_Size(m_Types[Field]); CSG_Buffer Data;
+
+			if( Size > 0 )	// fixed size values
+			{
+				if( !Data.Set_Size((size_t)(n * Size)) || !m_Stream.Seek(m_Columns[2 * Field] + First * Size)
+				||  m_Stream.Read(Data.Get_Data(), Size, (size_t)n) != (size_t)n )
+				{
+					return( false );
+				}
+
+				for(sLong i=0; i<n; i++)
+				{
+					const char *pValue = Data.Get_Data() + i * Size; CSG_Table_Value *pField = pShapes[i]->Get_Value(Field);
+
+					switch( Size )
+					{
+					case sizeof(int   ): { int    Value; memcpy(&Value, pValue, Size); pField->Set_Value(Value); } break;
+					case sizeof(sLong ): if( m_Types[Field] == SG_DATATYPE_Double || m_Types[Field] == SG_DATATYPE_Float )
+						                 { double Value; memcpy(&Value, pValue, Size); pField->Set_Value(Value); }
+						                 else
+						                 { sLong  Value; memcpy(&Value, pValue, Size); pField->Set_Value(Value); } break;
+					}
+				}
+			}
+			else			// variable size values
+			{
+				CSG_Array_sLong Offsets;
+
+				if( !_Read_Offsets(m_Columns[2 * Field], First, n, Offsets) || Offsets[n] < Offsets[0]
+				||  !Data.Set_Size((size_t)(Offsets[n] - Offsets[0])) || !m_Stream.Seek(m_Columns[2 * Field + 1] + Offsets[0])
+				||  m_Stream.Read(Data.Get_Data(), sizeof(char), Data.Get_Size()) != Data.Get_Size() )
+				{
+					return( false );
+				}
+
+				for(sLong i=0; i<n; i++)
+				{
+					const char *pValue = Data.Get_Data() + (Offsets[i] - Offsets[0]); int Length = (int)(Offsets[i + 1] - Offsets[i]);
+
+					if( Length < 0 )
+					{
+						return( false );
+					}
+
+					if( m_Types[Field] == SG_DATATYPE_Binary )
+					{
+						pShapes[i]->Get_Value(Field)->Set_Value(CSG_Bytes((const BYTE *)pValue, Length));
+					}
+					else
+					{
+						pShapes[i]->Get_Value(Field)->Set_Value(CSG_String::from_UTF8(pValue, Length));
+					}
+				}
+			}
+		}
+
+		return( true );
+	}
+};
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Shapes::_Load_Native(const CSG_String &File, const CSG_Rect *pExtent)
+{
+	CSG_Shapes_Native *pNative = new CSG_Shapes_Native;
+
+	if( !pNative->Open(File) )
+	{
+		delete(pNative);
+
+		SG_UI_Msg_Add_Error(_TL("invalid or corrupted shape file"));
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	Create(pNative->m_Type, NULL, NULL, pNative->m_Vertex_Type);
+
+	for(int Field=0; Field<pNative->m_Types.Get_Size(); Field++)
+	{
+		Add_Field(pNative->m_Names[Field], (TSG_Data_Type)pNative->m_Types[Field]);
+	}
+
+	Set_NoData_Value_Range(pNative->m_Bounds[8], pNative->m_Bounds[9]);
+
+	Get_Projection().Load(SG_File_Make_Path("", File, "sg-prj"));
+
+	Load_MetaData(File);
+
+	//-----------------------------------------------------
+	if( pExtent )	// read the requested subset at once, the result does not represent the whole file
+	{
+		CSG_Array_sLong Shapes; CSG_Array_Pointer pShapes;
+
+		bool bResult = pNative->Find(*pExtent, Shapes);
+
+		for(sLong i=0; bResult && i<Shapes.Get_Size(); i++)
+		{
+			pShapes += Add_Shape();
+		}
+
+		bResult = bResult && pNative->Read(Shapes.Get_Array(), Shapes.Get_Size(), (CSG_Shape **)pShapes.Get_Array());
+
+		delete(pNative);
+
+		if( !bResult )
+		{
+			SG_UI_Msg_Add_Error(_TL("invalid or corrupted shape file"));
+
+			return( false );
+		}
+
+		Set_File_Name(File, false);
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	for(sLong i=0; i<pNative->m_nShapes; i++)	// empty records, geometries and attributes are read on first access
+	{
+		Add_Shape();
+	}
+
+	m_Extent.Assign(pNative->m_Bounds[0], pNative->m_Bounds[1], pNative->m_Bounds[2], pNative->m_Bounds[3]);
+
+	m_ZMin = pNative->m_Bounds[4]; m_ZMax = pNative->m_Bounds[5];
+	m_MMin = pNative->m_Bounds[6]; m_MMax = pNative->m_Bounds[7];
+
+	m_pNative = pNative;
+
+	Set_File_Name(File, true);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Shapes::_Save_Native(const CSG_String &File)
+{
+	CSG_File Stream;
+
+	if( !Stream.Open(File, SG_FILE_W, true) )
+	{
+		SG_UI_Msg_Add_Error(_TL("could not create shape file"));
+
+		return( false );
+	}
+
+	Update();
+
+	sLong nShapes = Get_Count(); int nFields = Get_Field_Count();
+
+	//-----------------------------------------------------
+	int Header[4] = { m_Type, m_Vertex_Type, nFields, NATIVE_NODE_SIZE };
+
+	double Bounds[10] = {
+		m_Extent.Get_XMin(), m_Extent.Get_YMin(), m_Extent.Get_XMax(), m_Extent.Get_YMax(),
+		m_ZMin, m_ZMax, m_MMin, m_MMax, Get_NoData_Value(false), Get_NoData_Value(true)
+	};
+
+	sLong Offsets[3] = { 0, 0, 0 };	// directory, spatial index, number of indexed shapes
+
+	int Order = NATIVE_BYTE_ORDER; bool bResult = true;
+
+	SG_Native_Write(Stream, bResult, NATIVE_FILE_ID, sizeof(char), 8);
+	SG_Native_Write(Stream, bResult, &Order , sizeof(int   )    );
+	SG_Native_Write(Stream, bResult, Header , sizeof(int   ),  4);
+	SG_Native_Write(Stream, bResult, &nShapes, sizeof(sLong)    );
+	SG_Native_Write(Stream, bResult, Bounds , sizeof(double), 10);
+
+	sLong Offsets_Position = Stream.Tell(); SG_Native_Write(Stream, bResult, Offsets, sizeof(sLong), 3);	// updated at the end
+
+	//-----------------------------------------------------
+	CSG_Array_sLong Columns(2 * nFields), Columns_Position(nFields); Columns.Assign(0);
+
+	for(int Field=0; Field<nFields; Field++)
+	{
+		int Type = Get_Field_Type(Field); CSG_Buffer Name(CSG_String(Get_Field_Name(Field)).to_UTF8()); int nName = (int)Name.Get_Size() - 1;
+
+		SG_Native_Write(Stream, bResult, &Type , sizeof(int));
+		SG_Native_Write(Stream, bResult, &nName, sizeof(int));
+		SG_Native_Write(Stream, bResult, Name.Get_Data(), sizeof(char), nName);
+
+		Columns_Position[Field] = Stream.Tell(); SG_Native_Write(Stream, bResult, Columns.Get_Array() + 2 * Field, sizeof(sLong), 2);	// updated at the end
+	}
+
+	//-----------------------------------------------------
+	CSG_Array_sLong Directory(nShapes + 1);
+
+	for(sLong iShape=0; bResult && iShape<nShapes && SG_UI_Process_Set_Progress(iShape, nShapes); iShape++)
+	{
+		CSG_Shape *pShape = Get_Shape(iShape); Directory[iShape] = Stream.Tell();
+
+		int n[2] = { pShape->Get_Part_Count(), pShape->Get_Point_Count() };
+
+		SG_Native_Write(Stream, bResult, n, sizeof(int), 2);
+
+		for(int iPart=0; iPart<n[0]; iPart++)
+		{
+			int Count = pShape->Get_Point_Count(iPart); SG_Native_Write(Stream, bResult, &Count, sizeof(int));
+		}
+
+		for(int iPart=0; iPart<n[0]; iPart++)
+		{
+			for(int iPoint=0; iPoint<pShape->Get_Point_Count(iPart); iPoint++)
+			{
+				TSG_Point Point = pShape->Get_Point(iPoint, iPart); SG_Native_Write(Stream, bResult, &Point, sizeof(TSG_Point));
+			}
+		}
+
+		if( m_Vertex_Type != SG_VERTEX_TYPE_XY )
+		{
+			for(int iPart=0; iPart<n[0]; iPart++)
+			{
+				for(int iPoint=0; iPoint<pShape->Get_Point_Count(iPart); iPoint++)
+				{
+					double Value = pShape->Get_Z(iPoint, iPart); SG_Native_Write(Stream, bResult, &Value, sizeof(double));
+				}
+			}
+
+			if( m_Vertex_Type == SG_VERTEX_TYPE_XYZM )
+			{
+				for(int iPart=0; iPart<n[0]; iPart++)
+				{
+					for(int iPoint=0; iPoint<pShape->Get_Point_Count(iPart); iPoint++)
+					{
+						double Value = pShape->Get_M(iPoint, iPart); SG_Native_Write(Stream, bResult, &Value, sizeof(double));
+					}
+				}
+			}
+		}
+	}
+
+	if( !SG_UI_Process_Get_Okay() )
+	{
+		bResult = false;
+	}
+
+	Directory[nShapes] = Stream.Tell();
+
+	Offsets[0] = Stream.Tell(); SG_Native_Write(Stream, bResult, Directory.Get_Array(), sizeof(sLong), nShapes + 1);
+
+	//-----------------------------------------------------
+	for(int Field=0; bResult && Field<nFields; Field++)
+	{
+		int Type = Get_Field_Type(Field);
+
+		if( SG_Native_Get_Value_Size(Type) > 0 )
+		{
+			Columns[2 * Field] = Columns[2 * Field + 1] = Stream.Tell();
+
+			for(sLong iShape=0; iShape<nShapes; iShape++)
+			{
+				CSG_Shape *pShape = Get_Shape(iShape);
+
+				switch( SG_Native_Get_Value_Size(Type) )
+				{
+				case sizeof(int   ): { int Value = pShape->asInt(Field); SG_Native_Write(Stream, bResult, &Value, sizeof(Value)); } break;
+				case sizeof(sLong ): if( Type == SG_DATATYPE_Double || Type == SG_DATATYPE_Float )
+					                 { double Value = pShape->asDouble(Field); SG_Native_Write(Stream, bResult, &Value, sizeof(Value)); }
+					                 else
+					                 { sLong  Value = pShape->asLong  (Field); SG_Native_Write(Stream, bResult, &Value, sizeof(Value)); } break;
+				}
+			}
+		}
+		else
+		{
+			CSG_Array_sLong Values(nShapes + 1); Values[0] = 0; Columns[2 * Field + 1] = Stream.Tell();
+
+			for(sLong iShape=0; iShape<nShapes; iShape++)
+			{
+				CSG_Shape *pShape = Get_Shape(iShape);
+
+				if( Type == SG_DATATYPE_Binary )
+				{
+					CSG_Bytes Bytes(pShape->Get_Value(Field)->asBinary());
+
+					SG_Native_Write(Stream, bResult, Bytes.Get_Bytes(), sizeof(BYTE), Bytes.Get_Count());
+
+					Values[iShape + 1] = Values[iShape] + Bytes.Get_Count();
+				}
+				else
+				{
+					CSG_Buffer String(CSG_String(pShape->asString(Field)).to_UTF8()); size_t Length = String.Get_Size() - 1;
+
+					SG_Native_Write(Stream, bResult, String.Get_Data(), sizeof(char), Length);
+
+					Values[iShape + 1] = Values[iShape] + Length;
+				}
+			}
+
+			Columns[2 * Field] = Stream.Tell(); SG_Native_Write(Stream, bResult, Values.Get_Array(), sizeof(sLong), nShapes + 1);
+		}
+	}
+
+	//-----------------------------------------------------
+	CSG_Array_sLong Items;	// shapes with points, ordered along a Hilbert curve through their extent centers
+
+	for(sLong iShape=0; iShape<nShapes; iShape++)
+	{
+		if( Get_Shape(iShape)->Get_Point_Count() > 0 )
+		{
+			Items += iShape;
+		}
+	}
+
+	if( bResult && Items.Get_Size() > 0 )
+	{
+		sLong nItems = Items.Get_Size(); CSG_Vector Hilbert(nItems);
+
+		double dx = m_Extent.Get_XRange() > 0. ? 65535. / m_Extent.Get_XRange() : 0.;
+		double dy = m_Extent.Get_YRange() > 0. ? 65535. / m_Extent.Get_YRange() : 0.;
+
+		for(sLong i=0; i<nItems; i++)
+		{
+			const CSG_Rect &r = Get_Shape(Items[i])->Get_Extent();
+
+			Hilbert[i] = SG_Native_Get_Hilbert(
+				(unsigned int)(dx * (r.Get_XCenter() - m_Extent.Get_XMin())),
+				(unsigned int)(dy * (r.Get_YCenter() - m_Extent.Get_YMin()))
+			);
+		}
+
+		CSG_Index Index(nItems, Hilbert.Get_Data());
+
+		//-------------------------------------------------
+		CSG_Array_sLong Start, Count; SG_Native_Get_Levels(nItems, NATIVE_NODE_SIZE, Start, Count);
+
+		int Leaf = (int)Start.Get_Size() - 1;
+
+		CSG_Array Nodes(sizeof(TSG_Native_Node), Start[Leaf] + Count[Leaf]); TSG_Native_Node *pNodes = (TSG_Native_Node *)Nodes.Get_Array();
+
+		for(sLong i=0; i<nItems; i++)
+		{
+			sLong iShape = Items[Index[i]]; const CSG_Rect &r = Get_Shape(iShape)->Get_Extent();
+
+			TSG_Native_Node &Node = pNodes[Start[Leaf] + i];
+
+			Node.xMin = r.Get_XMin(); Node.yMin = r.Get_YMin(); Node.xMax = r.Get_XMax(); Node.yMax = r.Get_YMax(); Node.Offset = iShape;
+		}
+
+		for(int Level=Leaf-1; Level>=0; Level--)
+		{
+			for(sLong i=0; i<Count[Level]; i++)
+			{
+				sLong Child = Start[Level + 1] + i * NATIVE_NODE_SIZE, End = M_GET_MIN(Child + NATIVE_NODE_SIZE, Start[Level + 1] + Count[Level + 1]);
+
+				TSG_Native_Node &Node = pNodes[Start[Level] + i]; Node = pNodes[Child]; Node.Offset = Child;
+
+				for(sLong j=Child+1; j<End; j++)
+				{
+					if( Node.xMin > pNodes[j].xMin ) Node.xMin = pNodes[j].xMin;
+					if( Node.yMin > pNodes[j].yMin ) Node.yMin = pNodes[j].yMin;
+					if( Node.xMax < pNodes[j].xMax ) Node.xMax = pNodes[j].xMax;
+					if( Node.yMax < pNodes[j].yMax ) Node.yMax = pNodes[j].yMax;
+				}
+			}
+		}
+
+		Offsets[1] = Stream.Tell(); Offsets[2] = nItems;
+
+		SG_Native_Write(Stream, bResult, pNodes, sizeof(TSG_Native_Node), (size_t)Nodes.Get_Size());
+	}
+
+	//-----------------------------------------------------
+	bResult = bResult && Stream.Seek(Offsets_Position); SG_Native_Write(Stream, bResult, Offsets, sizeof(sLong), 3);
+
+	for(int Field=0; Field<nFields; Field++)
+	{
+		bResult = bResult && Stream.Seek(Columns_Position[Field]); SG_Native_Write(Stream, bResult, Columns.Get_Array() + 2 * Field, sizeof(sLong), 2);
+	}
+
+	Stream.Close();
+
+	if( !bResult )	// failed or canceled, don't leave an incomplete file
+	{
+		SG_File_Delete(File);
+
+		if( SG_UI_Process_Get_Okay() )
+		{
+			SG_UI_Msg_Add_Error(_TL("failed to write shape file"));
+		}
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	if( Get_Projection().is_Okay() )
+	{
+		Get_Projection().Save(SG_File_Make_Path("", File, "sg-prj"));
+	}
+
+	Save_MetaData(File);
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Shapes::_Native_Load(sLong Index)
+{
+	if( !m_pNative || m_pNative->is_Loaded(Index) )	// no locking for pages that have been read already
+	{
+		return( true );
+	}
+
+	bool bResult = true;
+
+	#pragma omp critical(CSG_Shapes_Native)
+	{
+		if( m_pNative && !m_pNative->is_Loaded(Index) )
+		{
+			sLong First = Index - Index % NATIVE_PAGE_SIZE, n = M_GET_MIN(NATIVE_PAGE_SIZE, m_pNative->m_nShapes - First);
+
+			CSG_Array_sLong Shapes(n); CSG_Array_Pointer pShapes;
+
+			for(sLong i=0; i<n; i++)
+			{
+				Shapes[i] = First + i; pShapes += CSG_Table::Get_Record(First + i);
+			}
+
+			bool bModified = is_Modified();
+
+			bResult = m_pNative->Read(Shapes.Get_Array(), n, (CSG_Shape **)pShapes.Get_Array());
+
+			for(sLong i=0; i<n; i++)	// reading is not an edit
+			{
+				((CSG_Shape *)pShapes[i])->Set_Modified(false);
+			}
+
+			CSG_Data_Object::Set_Modified(bModified);
+
+			m_pNative->Set_Loaded(Index);	// also on failure, don't try again
+
+			if( !bResult )
+			{
+				SG_UI_Msg_Add_Error(CSG_String::Format("%s: %s", _TL("invalid or corrupted shape file"), Get_File_Name()));
+			}
+		}
+	}
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+// Reads all shapes not loaded so far and closes the file.
+// Required before any operation that changes the record
+// order or the field structure.
+//---------------------------------------------------------
+bool CSG_Shapes::_Native_Load(void)
+{
+	bool bResult = true;
+
+	if( m_pNative )
+	{
+		for(sLong i=0; i<m_pNative->m_nShapes; i+=NATIVE_PAGE_SIZE)
+		{
+			if( !_Native_Load(i) )
+			{
+				bResult = false;
+			}
+		}
+
+		_Native_Close();
+	}
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+sLong CSG_Shapes::_Native_Find(const CSG_Rect &Extent, CSG_Array_sLong &Shapes)
+{
+	bool bResult = false;
+
+	#pragma omp critical(CSG_Shapes_Native)
+	{
+		bResult = m_pNative && m_pNative->Find(Extent, Shapes);
+	}
+
+	if( !bResult )
+	{
+		Shapes.Destroy();
+
+		return( 0 );
+	}
+
+	for(sLong i=0, Page=-1; i<Shapes.Get_Size(); i++)
+	{
+		if( Page != Shapes[i] / NATIVE_PAGE_SIZE )
+		{
+			Page  = Shapes[i] / NATIVE_PAGE_SIZE;
+
+			_Native_Load(Shapes[i]);
+		}
+	}
+
+	return( Shapes.Get_Size() );
+}
+
+//---------------------------------------------------------
+void CSG_Shapes::_Native_Close(void)
+{
+	if( m_pNative )
+	{
+		delete(m_pNative);
+
+		m_pNative = NULL;
+	}
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                                                       //
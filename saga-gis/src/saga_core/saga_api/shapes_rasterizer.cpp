@@ -0,0 +1,473 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//               shapes_rasterizer.cpp                   //
+//                                                       //
+//              Copyright (C) 2026 by agent              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <algorithm>
+
+#include "shapes.h"
+#include "grid.h"
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Shape_Polygon_Rasterizer::CSG_Shape_Polygon_Rasterizer(void)
+{
+	m_Edges.Create(sizeof(TEdge), 0, TSG_Array_Growth::SG_ARRAY_GROWTH_2);
+}
+
+//---------------------------------------------------------
+CSG_Shape_Polygon_Rasterizer::CSG_Shape_Polygon_Rasterizer(const CSG_Grid_System &System)
+{
+	m_Edges.Create(sizeof(TEdge), 0, TSG_Array_Growth::SG_ARRAY_GROWTH_2);
+
+	Create(System);
+}
+
+//---------------------------------------------------------
+bool CSG_Shape_Polygon_Rasterizer::Create(const CSG_Grid_System &System)
+{
+	Destroy();
+
+	if( !System.is_Valid() )
+	{
+		return( false );
+	}
+
+	m_NX       = System.Get_NX      ();
+	m_NY       = System.Get_NY      ();
+	m_xOrigin  = System.Get_XMin    ();
+	m_yOrigin  = System.Get_YMin    ();
+	m_Cellsize = System.Get_Cellsize();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+CSG_Shape_Polygon_Rasterizer::~CSG_Shape_Polygon_Rasterizer(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+bool CSG_Shape_Polygon_Rasterizer::Destroy(void)
+{
+	m_xMin = 0; m_xMax = -1;
+	m_yMin = 0; m_yMax = -1;
+
+	m_Edges          .Destroy();
+	m_Edge_Index     .Destroy();
+	m_Edge_Offset    .Destroy();
+	m_Crossing_Offset.Destroy();
+	m_Crossings      .Destroy();
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// All calculations are done in column/row units, in which
+// cell (x, y) spans from x to x + 1 and from y to y + 1, so
+// that its center is located at (x + 0.5, y + 0.5).
+//
+// Scanline crossings are stored per row for the row's cell
+// center line, edges are stored per row for each row strip
+// they touch. Both tables are stored in compressed form with
+// an offset array, so that each row only visits the edges
+// really affecting it.
+//---------------------------------------------------------
+bool CSG_Shape_Polygon_Rasterizer::Set_Polygon(CSG_Shape_Polygon *pPolygon, bool bCoverage)
+{
+	return( Set_Polygon(pPolygon, bCoverage, 0, m_NY - 1) );
+}
+
+//---------------------------------------------------------
+// Restricts the rasterization to the rows from yMin to yMax,
+// e.g. to process a polygon block by block.
+//---------------------------------------------------------
+bool CSG_Shape_Polygon_Rasterizer::Set_Polygon(CSG_Shape_Polygon *pPolygon, bool bCoverage, int yMin, int yMax)
+{
+	m_xMin = 0; m_xMax = -1;
+	m_yMin = 0; m_yMax = -1;
+
+	m_Edges.Set_Array(0, false);
+
+	if( m_NX < 1 || m_NY < 1 || !pPolygon || !pPolygon->is_Valid() )
+	{
+		return( false );
+	}
+
+	m_bCoverage = bCoverage;
+
+	//-----------------------------------------------------
+	CSG_Rect Extent(pPolygon->Get_Extent());
+
+	yMin = std::max(0, yMin); yMax = std::min(m_NY - 1, yMax);
+
+	double ax = 0.5 + (Extent.xMin - m_xOrigin) / m_Cellsize, bx = 0.5 + (Extent.xMax - m_xOrigin) / m_Cellsize;
+	double ay = 0.5 + (Extent.yMin - m_yOrigin) / m_Cellsize, by = 0.5 + (Extent.yMax - m_yOrigin) / m_Cellsize;
+
+	if( bx < 0. || ax > m_NX || by < yMin || ay > yMax + 1 )
+	{
+		return( false );
+	}
+
+	m_xMin = std::max(0   , (int)floor(ax)); m_xMax = std::min(m_NX - 1, std::max(m_xMin, (int)ceil(bx) - 1));
+	m_yMin = std::max(yMin, (int)floor(ay)); m_yMax = std::min(yMax    , std::max(m_yMin, (int)ceil(by) - 1));
+
+	if( m_yMin > m_yMax )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	for(int iPart=0; iPart<pPolygon->Get_Part_Count(); iPart++)
+	{
+		int nPoints = pPolygon->Get_Point_Count(iPart); if( nPoints < 3 ) { continue; }
+
+		sLong First = m_Edges.Get_Size(); double Area = 0.;
+
+		TSG_Point b = pPolygon->Get_Point(nPoints - 1, iPart);
+
+		b.x = 0.5 + (b.x - m_xOrigin) / m_Cellsize;
+		b.y = 0.5 + (b.y - m_yOrigin) / m_Cellsize;
+
+		for(int iPoint=0; iPoint<nPoints; iPoint++)
+		{
+			TSG_Point a = b; b = pPolygon->Get_Point(iPoint, iPart);
+
+			b.x = 0.5 + (b.x - m_xOrigin) / m_Cellsize;
+			b.y = 0.5 + (b.y - m_yOrigin) / m_Cellsize;
+
+			Area += a.x * b.y - b.x * a.y;
+
+			if( a.y != b.y && std::max(a.y, b.y) > m_yMin && std::min(a.y, b.y) < m_yMax + 1 )
+			{
+				TEdge Edge;
+
+				if( a.y < b.y )
+				{
+					Edge.ax = a.x; Edge.ay = a.y; Edge.bx = b.x; Edge.by = b.y; Edge.Sign =  1.;
+				}
+				else
+				{
+					Edge.ax = b.x; Edge.ay = b.y; Edge.bx = a.x; Edge.by = a.y; Edge.Sign = -1.;
+				}
+
+				if( m_Edges.Inc_Array() )
+				{
+					*((TEdge *)m_Edges.Get_Entry(m_Edges.Get_Size() - 1)) = Edge;
+				}
+			}
+		}
+
+		//-------------------------------------------------
+		// coverage is integrated with the winding number,
+		// which needs outer rings counter-clockwise and
+		// lakes clockwise oriented, regardless of storage
+		if( bCoverage )
+		{
+			double Sign = Area < 0. ? -1. : 1.;
+
+			if( pPolygon->Get_Part_Count() > 1 && pPolygon->is_Lake(iPart) )
+			{
+				Sign = -Sign;
+			}
+
+			if( Sign < 0. )
+			{
+				for(sLong i=First; i<m_Edges.Get_Size(); i++)
+				{
+					((TEdge *)m_Edges.Get_Entry(i))->Sign *= -1.;
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	int nRows = m_yMax - m_yMin + 1;
+
+	m_Crossing_Offset.Create(nRows + 1); m_Crossing_Offset.Assign(0);
+
+	for(sLong i=0; i<m_Edges.Get_Size(); i++)
+	{
+		const TEdge &Edge = _Get_Edge(i);
+
+		int y0 = std::max(m_yMin, (int)ceil(Edge.ay - 0.5)), y1 = std::min(m_yMax, (int)ceil(Edge.by - 0.5) - 1);
+
+		for(int y=y0; y<=y1; y++)
+		{
+			m_Crossing_Offset[1 + y - m_yMin]++;
+		}
+	}
+
+	for(int y=0; y<nRows; y++)
+	{
+		m_Crossing_Offset[y + 1] += m_Crossing_Offset[y];
+	}
+
+	m_Crossings.Create(std::max(1, m_Crossing_Offset[nRows]));
+
+	CSG_Array_Int Next(m_Crossing_Offset);
+
+	for(sLong i=0; i<m_Edges.Get_Size(); i++)
+	{
+		const TEdge &Edge = _Get_Edge(i); double dx = (Edge.bx - Edge.ax) / (Edge.by - Edge.ay);
+
+		int y0 = std::max(m_yMin, (int)ceil(Edge.ay - 0.5)), y1 = std::min(m_yMax, (int)ceil(Edge.by - 0.5) - 1);
+
+		for(int y=y0; y<=y1; y++)
+		{
+			m_Crossings[Next[y - m_yMin]++] = Edge.ax + dx * (y + 0.5 - Edge.ay);
+		}
+	}
+
+	#pragma omp parallel for if(nRows > 64)
+	for(int y=0; y<nRows; y++)
+	{
+		std::sort(m_Crossings.Get_Data() + m_Crossing_Offset[y], m_Crossings.Get_Data() + m_Crossing_Offset[y + 1]);
+	}
+
+	//-----------------------------------------------------
+	if( bCoverage )
+	{
+		m_Edge_Offset.Create(nRows + 1); m_Edge_Offset.Assign(0);
+
+		for(sLong i=0; i<m_Edges.Get_Size(); i++)
+		{
+			const TEdge &Edge = _Get_Edge(i);
+
+			int y0 = std::max(m_yMin, (int)floor(Edge.ay)), y1 = std::min(m_yMax, (int)ceil(Edge.by) - 1);
+
+			for(int y=y0; y<=y1; y++)
+			{
+				m_Edge_Offset[1 + y - m_yMin]++;
+			}
+		}
+
+		for(int y=0; y<nRows; y++)
+		{
+			m_Edge_Offset[y + 1] += m_Edge_Offset[y];
+		}
+
+		m_Edge_Index.Create(std::max(1, m_Edge_Offset[nRows]));
+
+		Next = m_Edge_Offset;
+
+		for(sLong i=0; i<m_Edges.Get_Size(); i++)
+		{
+			const TEdge &Edge = _Get_Edge(i);
+
+			int y0 = std::max(m_yMin, (int)floor(Edge.ay)), y1 = std::min(m_yMax, (int)ceil(Edge.by) - 1);
+
+			for(int y=y0; y<=y1; y++)
+			{
+				m_Edge_Index[Next[y - m_yMin]++] = (int)i;
+			}
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Returns the number of column spans of row y, whose cell
+// centers are inside the polygon following the even-odd
+// rule. Spans are stored as pairs of first and last column.
+//---------------------------------------------------------
+int CSG_Shape_Polygon_Rasterizer::Get_Spans(int y, CSG_Array_Int &Spans) const
+{
+	Spans.Set_Array(0, false);
+
+	if( y < m_yMin || y > m_yMax )
+	{
+		return( 0 );
+	}
+
+	const double *Crossing = m_Crossings.Get_Data() + m_Crossing_Offset[y - m_yMin];
+
+	int nCrossings = m_Crossing_Offset[y - m_yMin + 1] - m_Crossing_Offset[y - m_yMin];
+
+	for(int i=0; i<nCrossings-1; i+=2)
+	{
+		int x0 = std::max(m_xMin, 1 + (int)floor(Crossing[i    ] - 0.5));
+		int x1 = std::min(m_xMax,     (int)floor(Crossing[i + 1] - 0.5));
+
+		if( x0 <= x1 )
+		{
+			Spans.Add(x0);
+			Spans.Add(x1);
+		}
+	}
+
+	return( (int)(Spans.Get_Size() / 2) );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Exact cell coverage for the columns Get_xMin() to Get_xMax()
+// of row y as fraction (0 to 1) of the cell area.
+// Each edge clipped to the row strip is split at the column
+// borders. A piece inside column x adds the area between
+// itself and the column's left border to x and, because the
+// winding number counts the edges right of a point, adds its
+// full height to all columns left of x. The latter is done
+// with a difference array, which is summed up from the right.
+//---------------------------------------------------------
+bool CSG_Shape_Polygon_Rasterizer::Get_Coverage(int y, CSG_Vector &Coverage) const
+{
+	if( !m_bCoverage || y < m_yMin || y > m_yMax )
+	{
+		return( false );
+	}
+
+	int n = m_xMax - m_xMin + 1;
+
+	Coverage.Create(n); CSG_Vector Full(n + 1);
+
+	//-----------------------------------------------------
+	for(int i=m_Edge_Offset[y - m_yMin]; i<m_Edge_Offset[y - m_yMin + 1]; i++)
+	{
+		const TEdge &Edge = _Get_Edge(m_Edge_Index[i]);
+
+		double ya = std::max(Edge.ay, (double)y), yb = std::min(Edge.by, y + 1.);
+
+		if( ya >= yb )
+		{
+			continue;
+		}
+
+		double dx = (Edge.bx - Edge.ax) / (Edge.by - Edge.ay);
+		double xa = Edge.ax + dx * (ya - Edge.ay);
+		double xb = Edge.ax + dx * (yb - Edge.ay);
+
+		double x0 = std::min(xa, xb), x1 = std::max(xa, xb);
+
+		if( x1 <= m_xMin )	// left of the polygon's columns
+		{
+			continue;
+		}
+
+		if( x0 >= m_xMax + 1 )	// right of the polygon's columns
+		{
+			Full[n] += Edge.Sign * (yb - ya);
+
+			continue;
+		}
+
+		if( x0 == x1 )	// vertical
+		{
+			int x = (int)floor(x0);
+
+			Coverage[x - m_xMin] += Edge.Sign * (yb - ya) * (x0 - x);
+			Full    [x - m_xMin] += Edge.Sign * (yb - ya);
+
+			continue;
+		}
+
+		//-------------------------------------------------
+		double dy = (yb - ya) / (x1 - x0);
+
+		if( x1 > m_xMax + 1 )
+		{
+			Full[n] += Edge.Sign * dy * (x1 - (m_xMax + 1)); x1 = m_xMax + 1;
+		}
+
+		if( x0 < m_xMin )
+		{
+			x0 = m_xMin;
+		}
+
+		for(int x=(int)floor(x0); x<m_xMax+1 && x<x1; x++)
+		{
+			double u0 = std::max(x0, (double)x), u1 = std::min(x1, x + 1.);
+
+			if( u1 > u0 )
+			{
+				double h = Edge.Sign * dy * (u1 - u0);
+
+				Coverage[x - m_xMin] += h * (0.5 * (u0 + u1) - x);
+				Full    [x - m_xMin] += h;
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	double Sum = Full[n];
+
+	for(int x=n-1; x>=0; x--)
+	{
+		double Value = Coverage[x] + Sum; Sum += Full[x];
+
+		Coverage[x] = Value < 0. ? 0. : Value > 1. ? 1. : Value;
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -79,11 +79,13 @@ bool CSG_Shapes::Select(const TSG_Rect &Extent, bool bInvert)
 		CSG_Table::Select();
 	}
 
-	for(sLong i=0; i<Get_Count(); i++)
+	CSG_Array_sLong Shapes; Find_Shapes(Extent, Shapes);
+
+	for(sLong i=0; i<Shapes.Get_Size(); i++)
 	{
-		if( Get_Shape(i)->Intersects(Extent) )
+		if( Get_Shape(Shapes[i])->Intersects(Extent) )
 		{
-			CSG_Table::Select(i, true);
+			CSG_Table::Select(Shapes[i], true);
 		}
 	}
 
@@ -103,11 +105,13 @@ bool CSG_Shapes::Select(const TSG_Point &Point, bool bInvert)
 		CSG_Table::Select();
 	}
 
-	for(sLong i=0; i<Get_Count(); i++)
+	CSG_Array_sLong Shapes; Find_Shapes(CSG_Rect(Point, Point), Shapes);
+
+	for(sLong i=0; i<Shapes.Get_Size(); i++)
 	{
-		if( ((CSG_Shape_Polygon *)Get_Shape(i))->Contains(Point) )
+		if( ((CSG_Shape_Polygon *)Get_Shape(Shapes[i]))->Contains(Point) )
 		{
-			CSG_Table::Select(i, true);
+			CSG_Table::Select(Shapes[i], true);
 		}
 	}
 
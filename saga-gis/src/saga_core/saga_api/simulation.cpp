@@ -0,0 +1,510 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                    simulation.cpp                     //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//                         agent                         //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "simulation.h"
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define CHECKPOINT_SIGNATURE	"SGSTATE1"
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static bool SG_Checkpoint_Write_String(CSG_File &Stream, const CSG_String &String)
+{
+	CSG_Buffer Buffer(String.to_UTF8()); int n = (int)Buffer.Get_Size();
+
+	return( Stream.Write(&n, sizeof(n)) == sizeof(n) && (n < 1 || Stream.Write(Buffer.Get_Data(), n) == (size_t)n) );
+}
+
+//---------------------------------------------------------
+static bool SG_Checkpoint_Read_String(CSG_File &Stream, CSG_String &String)
+{
+	int n; String.Clear();
+
+	if( Stream.Read(&n, sizeof(n)) != 1 || n < 0 )
+	{
+		return( false );
+	}
+
+	if( n > 0 )
+	{
+		CSG_Buffer Buffer(n);
+
+		if( Stream.Read(Buffer.Get_Data(), n) != 1 )
+		{
+			return( false );
+		}
+
+		String = CSG_String::from_UTF8(Buffer.Get_Data(), n);
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Values are stored with the grid's data type, bit grids are
+// stored as double. 64 bit integers are copied directly from
+// the grid's memory, because the value access goes through
+// double and would lose precision.
+//---------------------------------------------------------
+bool CSG_Simulation_State::_Write_Grid(CSG_File &Stream, CSG_Grid *pGrid)
+{
+	int NX = pGrid->Get_NX(), NY = pGrid->Get_NY(), Type = pGrid->Get_Type();
+
+	if( Stream.Write(&NX, sizeof(NX)) != sizeof(NX) || Stream.Write(&NY, sizeof(NY)) != sizeof(NY) || Stream.Write(&Type, sizeof(Type)) != sizeof(Type) )
+	{
+		return( false );
+	}
+
+	size_t nBytes = Type == SG_DATATYPE_Bit ? sizeof(double) : M_GET_MAX(SG_Data_Type_Get_Size(pGrid->Get_Type()), 1);
+
+	bool bRaw = (Type == SG_DATATYPE_Long || Type == SG_DATATYPE_ULong) && !pGrid->is_Cached() && pGrid->m_Values;
+
+	CSG_Array Line(nBytes, NX);
+
+	for(int y=0; y<NY; y++)
+	{
+		char *pValue = bRaw ? (char *)pGrid->m_Values[y] : (char *)Line.Get_Array();
+
+		for(int x=0; !bRaw && x<NX; x++, pValue+=nBytes)
+		{
+			switch( pGrid->Get_Type() )
+			{
+			case SG_DATATYPE_Byte  : *(BYTE   *)pValue = pGrid->asByte  (x, y, false); break;
+			case SG_DATATYPE_Char  : *(char   *)pValue = pGrid->asChar  (x, y, false); break;
+			case SG_DATATYPE_Word  : *(WORD   *)pValue = (WORD )pGrid->asInt(x, y, false); break;
+			case SG_DATATYPE_Short : *(short  *)pValue = pGrid->asShort (x, y, false); break;
+			case SG_DATATYPE_DWord : *(DWORD  *)pValue = (DWORD)pGrid->asDouble(x, y, false); break;
+			case SG_DATATYPE_Int   : *(int    *)pValue = pGrid->asInt   (x, y, false); break;
+			case SG_DATATYPE_Long  : *(sLong  *)pValue = (sLong)pGrid->asDouble(x, y, false); break;
+			case SG_DATATYPE_ULong : *(uLong  *)pValue = (uLong)pGrid->asDouble(x, y, false); break;
+			case SG_DATATYPE_Float : *(float  *)pValue = pGrid->asFloat (x, y, false); break;
+			default                : *(double *)pValue = pGrid->asDouble(x, y, false); break;
+			}
+		}
+
+		if( Stream.Write(bRaw ? pGrid->m_Values[y] : Line.Get_Array(), nBytes, NX) != nBytes * (size_t)NX )
+		{
+			return( false );
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Simulation_State::_Read_Grid(CSG_File &Stream, CSG_Grid *pGrid)
+{
+	int NX, NY, Type;
+
+	if( Stream.Read(&NX, sizeof(NX)) != 1 || Stream.Read(&NY, sizeof(NY)) != 1 || Stream.Read(&Type, sizeof(Type)) != 1 )
+	{
+		return( false );
+	}
+
+	if( NX != pGrid->Get_NX() || NY != pGrid->Get_NY() || Type != pGrid->Get_Type() )
+	{
+		return( false );
+	}
+
+	size_t nBytes = Type == SG_DATATYPE_Bit ? sizeof(double) : M_GET_MAX(SG_Data_Type_Get_Size(pGrid->Get_Type()), 1);
+
+	bool bRaw = (Type == SG_DATATYPE_Long || Type == SG_DATATYPE_ULong) && !pGrid->is_Cached() && pGrid->m_Values;
+
+	CSG_Array Line(nBytes, NX);
+
+	for(int y=0; y<NY; y++)
+	{
+		if( Stream.Read(bRaw ? pGrid->m_Values[y] : Line.Get_Array(), nBytes, NX) != (size_t)NX )
+		{
+			return( false );
+		}
+
+		char *pValue = (char *)Line.Get_Array();
+
+		for(int x=0; !bRaw && x<NX; x++, pValue+=nBytes)
+		{
+			switch( pGrid->Get_Type() )
+			{
+			case SG_DATATYPE_Byte  : pGrid->Set_Value(x, y, *(BYTE   *)pValue, false); break;
+			case SG_DATATYPE_Char  : pGrid->Set_Value(x, y, *(char   *)pValue, false); break;
+			case SG_DATATYPE_Word  : pGrid->Set_Value(x, y, *(WORD   *)pValue, false); break;
+			case SG_DATATYPE_Short : pGrid->Set_Value(x, y, *(short  *)pValue, false); break;
+			case SG_DATATYPE_DWord : pGrid->Set_Value(x, y, *(DWORD  *)pValue, false); break;
+			case SG_DATATYPE_Int   : pGrid->Set_Value(x, y, *(int    *)pValue, false); break;
+			case SG_DATATYPE_Long  : pGrid->Set_Value(x, y, (double)*(sLong *)pValue, false); break;
+			case SG_DATATYPE_ULong : pGrid->Set_Value(x, y, (double)*(uLong *)pValue, false); break;
+			case SG_DATATYPE_Float : pGrid->Set_Value(x, y, *(float  *)pValue, false); break;
+			default                : pGrid->Set_Value(x, y, *(double *)pValue, false); break;
+			}
+		}
+	}
+
+	if( bRaw )
+	{
+		pGrid->Set_Modified();
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSG_Simulation_State::CSG_Simulation_State(void)
+{
+	m_Interval = 0.;
+}
+
+//---------------------------------------------------------
+CSG_Simulation_State::~CSG_Simulation_State(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+bool CSG_Simulation_State::Destroy(void)
+{
+	Finalize();
+
+	for(sLong i=0; i<m_Outputs.Get_Size(); i++)
+	{
+		delete(_Get_Output((int)i));
+	}
+
+	m_Outputs     .Destroy(); m_Output_Grids.Destroy(); m_Output_Files.Clear(); m_Output_Z.Clear();
+	m_Grids       .Destroy(); m_Grid_IDs    .Clear();
+	m_Values      .Destroy(); m_Value_IDs   .Clear();
+
+	m_File.Clear(); m_Interval = 0.;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Simulation_State::Add_State(const CSG_String &ID, CSG_Grid *pGrid)
+{
+	if( pGrid && !ID.is_Empty() )
+	{
+		m_Grid_IDs += ID; m_Grids.Add(pGrid);
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Simulation_State::Add_State(const CSG_String &ID, double *pValue)
+{
+	if( pValue && !ID.is_Empty() )
+	{
+		m_Value_IDs += ID; m_Values.Add(pValue);
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Simulation_State::Add_Output(const CSG_String &File, CSG_Grid *pGrid, const CSG_String &Z_Name)
+{
+	if( pGrid && !File.is_Empty() )
+	{
+		CSG_String _File(File); SG_File_Set_Extension(_File, "sg-gds");
+
+		m_Output_Files += _File; m_Output_Z += Z_Name; m_Output_Grids.Add(pGrid); m_Outputs.Add(new CSG_Grids_Stream);
+
+		return( true );
+	}
+
+	return( false );
+}
+
+//---------------------------------------------------------
+bool CSG_Simulation_State::Set_Checkpoint(const CSG_String &File, double Interval)
+{
+	m_File     = File;
+	m_Interval = Interval > 0. ? Interval : 0.;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Simulation_State::Initialize(bool bResume, double &Time)
+{
+	Time = 0.;
+
+	if( bResume && !m_File.is_Empty() && SG_File_Exists(m_File) )
+	{
+		if( !Load_Checkpoint(Time) )
+		{
+			SG_UI_Msg_Add_Error(CSG_String::Format("%s [%s]", _TL("failed to resume from checkpoint"), m_File.c_str()));
+
+			return( false );
+		}
+
+		SG_UI_Msg_Add(CSG_String::Format("%s [%s]", _TL("resumed from checkpoint"), m_File.c_str()), true);
+	}
+	else
+	{
+		for(int i=0; i<Get_Output_Count(); i++)
+		{
+			if( !_Get_Output(i)->Create(m_Output_Files[i], *(CSG_Grid *)m_Output_Grids[i], m_Output_Z[i]) )
+			{
+				SG_UI_Msg_Add_Error(CSG_String::Format("%s [%s]", _TL("failed to create output file"), m_Output_Files[i].c_str()));
+
+				return( false );
+			}
+		}
+	}
+
+	m_Saved = CSG_DateTime::Now();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Simulation_State::Finalize(void)
+{
+	for(int i=0; i<Get_Output_Count(); i++)
+	{
+		_Get_Output(i)->Close();
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_Simulation_State::Set_Output(double Time)
+{
+	bool bResult = true;
+
+	for(int i=0; i<Get_Output_Count(); i++)
+	{
+		if( !_Get_Output(i)->Add_Grid(Time, (CSG_Grid *)m_Output_Grids[i]) )
+		{
+			bResult = false;
+		}
+	}
+
+	return( bResult );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// The checkpoint is written to a temporary file first, which
+// replaces the previous checkpoint only if written completely.
+//---------------------------------------------------------
+bool CSG_Simulation_State::Save_Checkpoint(double Time, bool bForce)
+{
+	if( m_File.is_Empty() )
+	{
+		return( false );
+	}
+
+	if( !bForce && (CSG_DateTime::Now() - m_Saved).Get_Value() < (sLong)(m_Interval * 60000.) )
+	{
+		return( true );	// nothing to do yet
+	}
+
+	//-----------------------------------------------------
+	CSG_String File(m_File + ".tmp"); CSG_File Stream;
+
+	if( !Stream.Open(File, SG_FILE_W, true) )
+	{
+		return( false );
+	}
+
+	int n; bool bResult = Stream.Write((void *)CHECKPOINT_SIGNATURE, 8) == 8 && Stream.Write(&Time, sizeof(Time)) == sizeof(Time);
+
+	n = m_Grid_IDs.Get_Count(); bResult = bResult && Stream.Write(&n, sizeof(n)) == sizeof(n);
+
+	for(int i=0; bResult && i<m_Grid_IDs.Get_Count(); i++)
+	{
+		bResult = SG_Checkpoint_Write_String(Stream, m_Grid_IDs[i]) && _Write_Grid(Stream, (CSG_Grid *)m_Grids[i]);
+	}
+
+	n = m_Value_IDs.Get_Count(); bResult = bResult && Stream.Write(&n, sizeof(n)) == sizeof(n);
+
+	for(int i=0; bResult && i<m_Value_IDs.Get_Count(); i++)
+	{
+		bResult = SG_Checkpoint_Write_String(Stream, m_Value_IDs[i]) && Stream.Write(m_Values[i], sizeof(double)) == sizeof(double);
+	}
+
+	n = Get_Output_Count(); bResult = bResult && Stream.Write(&n, sizeof(n)) == sizeof(n);
+
+	for(int i=0; bResult && i<Get_Output_Count(); i++)
+	{
+		n = _Get_Output(i)->Get_NZ();
+
+		bResult = SG_Checkpoint_Write_String(Stream, m_Output_Files[i]) && Stream.Write(&n, sizeof(n)) == sizeof(n);
+	}
+
+	bResult = bResult && Stream.Flush();
+
+	Stream.Close();
+
+	//-----------------------------------------------------
+	if( !bResult || !SG_File_Rename(File, m_File, true) )
+	{
+		SG_File_Delete(File);
+
+		SG_UI_Msg_Add_Error(CSG_String::Format("%s [%s]", _TL("failed to write checkpoint"), m_File.c_str()));
+
+		return( false );
+	}
+
+	m_Saved = CSG_DateTime::Now();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Simulation_State::Load_Checkpoint(double &Time)
+{
+	CSG_File Stream;
+
+	if( m_File.is_Empty() || !Stream.Open(m_File, SG_FILE_R, true) )
+	{
+		return( false );
+	}
+
+	char Signature[8];
+
+	if( Stream.Read(Signature, 8) != 1 || strncmp(Signature, CHECKPOINT_SIGNATURE, 8) || Stream.Read(&Time, sizeof(Time)) != 1 )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	int n; CSG_String ID;
+
+	if( Stream.Read(&n, sizeof(n)) != 1 || n != m_Grid_IDs.Get_Count() )
+	{
+		return( false );
+	}
+
+	for(int i=0; i<n; i++)
+	{
+		if( !SG_Checkpoint_Read_String(Stream, ID) || ID.Cmp(m_Grid_IDs[i]) || !_Read_Grid(Stream, (CSG_Grid *)m_Grids[i]) )
+		{
+			return( false );
+		}
+	}
+
+	//-----------------------------------------------------
+	if( Stream.Read(&n, sizeof(n)) != 1 || n != m_Value_IDs.Get_Count() )
+	{
+		return( false );
+	}
+
+	for(int i=0; i<n; i++)
+	{
+		if( !SG_Checkpoint_Read_String(Stream, ID) || ID.Cmp(m_Value_IDs[i]) || Stream.Read(m_Values[i], sizeof(double)) != 1 )
+		{
+			return( false );
+		}
+	}
+
+	//-----------------------------------------------------
+	if( Stream.Read(&n, sizeof(n)) != 1 || n != Get_Output_Count() )
+	{
+		return( false );
+	}
+
+	for(int i=0, NZ; i<n; i++)	// continue outputs with the z-levels written up to the checkpoint
+	{
+		if( !SG_Checkpoint_Read_String(Stream, ID) || Stream.Read(&NZ, sizeof(NZ)) != 1 || !_Get_Output(i)->Open(m_Output_Files[i], NZ) )
+		{
+			return( false );
+		}
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
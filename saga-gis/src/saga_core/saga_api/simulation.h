@@ -0,0 +1,157 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//           Application Programming Interface           //
+//                                                       //
+//                  Library: SAGA_API                    //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                     simulation.h                      //
+//                                                       //
+//              Copyright (C) 2026 by agent              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'.                              //
+//                                                       //
+// This library is free software; you can redistribute   //
+// it and/or modify it under the terms of the GNU Lesser //
+// General Public License as published by the Free       //
+// Software Foundation, either version 2.1 of the        //
+// License, or (at your option) any later version.       //
+//                                                       //
+// This library is distributed in the hope that it will  //
+// be useful, but WITHOUT ANY WARRANTY; without even the //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU Lesser General Public //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU Lesser     //
+// General Public License along with this program; if    //
+// not, see <http://www.gnu.org/licenses/>.              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef HEADER_INCLUDED__SAGA_API__simulation_H
+#define HEADER_INCLUDED__SAGA_API__simulation_H
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/** \file simulation.h
+* Support for long running simulations, i.e. checkpoints to
+* resume an interrupted simulation and time series output
+* streamed to disk.
+* @see CSG_Simulation_State
+* @see CSG_Grids_Stream
+*/
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "grids.h"
+#include "datetime.h"
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                 CSG_Simulation_State                  //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * CSG_Simulation_State keeps track of the state variables of
+  * a simulation, i.e. grids and single values, and takes
+  * snapshots of them in a binary checkpoint file. A simulation
+  * can be resumed from its last checkpoint. Output grids can
+  * be registered to be appended as new z-level to a grid
+  * collection file (time cube) for each requested time step.
+  * The outputs are not kept in memory, so that memory use
+  * does not depend on the simulation length.
+  *
+  * Typical use: register states and outputs, call Initialize(),
+  * then Set_Output() and Save_Checkpoint() within the time loop
+  * and Finalize() when done.
+*/
+//---------------------------------------------------------
+class SAGA_API_DLL_EXPORT CSG_Simulation_State
+{
+public:
+	CSG_Simulation_State(void);
+	virtual ~CSG_Simulation_State(void);
+
+	bool						Destroy				(void);
+
+	bool						Add_State			(const CSG_String &ID, CSG_Grid *pGrid );
+	bool						Add_State			(const CSG_String &ID, double   *pValue);
+
+	bool						Add_Output			(const CSG_String &File, CSG_Grid *pGrid, const CSG_String &Z_Name = "Time");
+	int							Get_Output_Count	(void)	const	{	return( m_Output_Files.Get_Count() );	}
+
+	/** Interval is the minimum (wall clock) time in minutes between two checkpoints. */
+	bool						Set_Checkpoint		(const CSG_String &File, double Interval = 0.);
+	const CSG_String &			Get_Checkpoint		(void)	const	{	return( m_File );	}
+
+	/** If bResume is true and a checkpoint can be read, the state variables are restored, Time is set to the checkpoint's simulation time and the outputs continue with the z-levels written up to the checkpoint. Otherwise Time is set to zero and new outputs are created. */
+	bool						Initialize			(bool bResume, double &Time);
+	bool						Finalize			(void);
+
+	/** Appends the current values of all output grids. */
+	bool						Set_Output			(double Time);
+
+	/** Writes a checkpoint, if forced or if the checkpoint interval has elapsed since the last one. */
+	bool						Save_Checkpoint		(double Time, bool bForce = false);
+	bool						Load_Checkpoint		(double &Time);
+
+
+private:
+
+	double						m_Interval;
+
+	CSG_String					m_File;
+
+	CSG_DateTime				m_Saved;
+
+	CSG_Strings					m_Grid_IDs, m_Value_IDs, m_Output_Files, m_Output_Z;
+
+	CSG_Array_Pointer			m_Grids, m_Values, m_Output_Grids, m_Outputs;
+
+
+	CSG_Grids_Stream *			_Get_Output			(int i)	const	{	return( (CSG_Grids_Stream *)m_Outputs[i] );	}
+
+	static bool					_Write_Grid			(CSG_File &Stream, CSG_Grid *pGrid);
+	static bool					_Read_Grid			(CSG_File &Stream, CSG_Grid *pGrid);
+
+};
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                                                       //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef HEADER_INCLUDED__SAGA_API__simulation_H
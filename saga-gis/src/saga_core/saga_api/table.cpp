@@ -1263,6 +1263,8 @@ bool CSG_Table::_Stats_Update(int Field) const
 		return( true );
 	}
 
+	SG_PROFILE_SCOPE("table statistics");
+
 	if( Get_Max_Samples() > 0 && Get_Max_Samples() < Get_Count() )
 	{
 		double Value, d = (double)Get_Count() / (double)Get_Max_Samples();
@@ -1614,6 +1616,8 @@ bool CSG_Table::Set_Index(CSG_Index &Index, const CSG_Array_Int &Fields, bool bA
 //---------------------------------------------------------
 void CSG_Table::_Index_Update(void)
 {
+	SG_PROFILE_SCOPE("table index");
+
 	if( m_Index_Fields.Get_Size() < 1 )
 	{
 		Del_Index();
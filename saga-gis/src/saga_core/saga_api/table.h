@@ -534,6 +534,7 @@ private:
 	size_t							_Load_Text_EndQuote	(const CSG_String &Text, const SG_Char Separator);
 
 	bool							_Load_Text			(const CSG_String &File, bool bHeadline, const SG_Char Separator);
+	bool							_Load_Text_Stream	(const CSG_String &File, bool bHeadline, const SG_Char Separator);
 	bool							_Load_DBase			(const CSG_String &File);
 
 	void							_Index_Update		(void);
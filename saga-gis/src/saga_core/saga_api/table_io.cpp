@@ -98,6 +98,8 @@ bool CSG_Table::Set_File_Encoding(int Encoding)
 //---------------------------------------------------------
 bool CSG_Table::Load(const CSG_String &File, int Format, SG_Char Separator, int Encoding)
 {
+	SG_PROFILE_SCOPE("table load");
+
 	Set_File_Encoding(Encoding);
 
 	if( !SG_File_Exists(File) )
@@ -154,6 +156,8 @@ bool CSG_Table::Save(const CSG_String &File, int Format, SG_Char Separator, int
 		return( *Get_File_Name(false) ? Save(Get_File_Name(false), Format) : false );
 	}
 
+	SG_PROFILE_SCOPE("table save");
+
 	SG_UI_Msg_Add(CSG_String::Format("%s %s: %s...", _TL("Saving"), _TL("table"), File.c_str()), true);
 
 	Set_File_Encoding(Encoding);
@@ -287,8 +291,274 @@ size_t	CSG_Table::_Load_Text_EndQuote(const CSG_String &s, const SG_Char Separat
 	return( 0 );
 }
 
+//---------------------------------------------------------
+// Returns the narrowest of the types Int, Double or String
+// that is able to store the given text value.
+//---------------------------------------------------------
+static TSG_Data_Type SG_Table_Text_Get_Type(const TSG_Text_Field &Field, bool bComma2Point, double &Value)
+{
+	if( Field.bQuoted )
+	{
+		return( SG_DATATYPE_String );
+	}
+
+	if( Field.Length > 1 && Field.Text[0] == '0' && Field.Text[1] != '.' && !(bComma2Point && Field.Text[1] == ',') ) // keep leading zero(s) => don't interpret as number !
+	{
+		return( SG_DATATYPE_String );
+	}
+
+	if( !CSG_Text_Reader::To_Double(Field.Text, Field.Length, Value, bComma2Point) )
+	{
+		return( SG_DATATYPE_String );
+	}
+
+	if( Value < -2147483648. || Value > 2147483647. || Value != (int)Value
+	||  memchr(Field.Text, '.', Field.Length) || (bComma2Point && memchr(Field.Text, ',', Field.Length)) )
+	{
+		return( SG_DATATYPE_Double );
+	}
+
+	return( SG_DATATYPE_Int );
+}
+
+//---------------------------------------------------------
+// Reads the file block-wise with CSG_Text_Reader. Field types
+// are estimated from a sample of the first lines, then the
+// lines of each block are tokenized and parsed in parallel and
+// appended to the table. If a value later on does not fit the
+// estimated type, the file is read once more with the types
+// found in the first run.
+//---------------------------------------------------------
+#define TEXT_TYPE_SAMPLE	10000
+
 //---------------------------------------------------------
 bool CSG_Table::_Load_Text(const CSG_String &File, bool bHeadline, const SG_Char _Separator)
+{
+	if( m_Encoding != SG_FILE_ENCODING_ANSI && m_Encoding != SG_FILE_ENCODING_UTF8 && m_Encoding != SG_FILE_ENCODING_UNDEFINED )
+	{
+		return( _Load_Text_Stream(File, bHeadline, _Separator) );
+	}
+
+	CSG_Text_Reader Stream;
+
+	if( !Stream.Open(File) )
+	{
+		return( SG_File_Exists(File) && _Load_Text_Stream(File, bHeadline, _Separator) ); // e.g. UTF-16 byte order mark
+	}
+
+	if( Stream.Length() < 1 )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	bool bCSV = SG_File_Cmp_Extension(File, "csv"), bComma2Point = false;
+
+	if( bCSV )
+	{
+		Stream.Set_Comment('#');
+	}
+
+	int nFields = 0; CSG_Array Fields(sizeof(TSG_Text_Field)); CSG_Array_Int Types, Found;
+
+	CSG_Vector Values; CSG_Array_Int nValues;
+
+	//-----------------------------------------------------
+	for(bool bRescan=true; bRescan; )
+	{
+		bRescan = false; bool bAppend = true;
+
+		for(bool bFirst=true; Stream.Read_Block() && SG_UI_Process_Set_Progress((double)Stream.Tell(), (double)Stream.Length()); )
+		{
+			sLong iFirst = 0, nLines = Stream.Get_Line_Count();
+
+			//---------------------------------------------
+			if( bFirst ) // search headline
+			{
+				const char *Text; int Length;
+
+				for(iFirst=0; iFirst<nLines; iFirst++)
+				{
+					if( Stream.Get_Line(iFirst, Text, Length) && Length > 0 && !(bCSV && Text[0] == '#') ) // skip empty or comment
+					{
+						break;
+					}
+				}
+
+				if( iFirst >= nLines )
+				{
+					continue;
+				}
+
+				bFirst = false;
+
+				//-----------------------------------------
+				if( nFields == 0 )
+				{
+					SG_Char Separator = _Separator;
+
+					if( Separator == '\0' )
+					{
+						if( bCSV ) // comma separated values
+						{
+							Separator = memchr(Text, ';', Length) ? ';' : ','; // assume semicolon as value separator, comma as decimal separator!
+						}
+						else // assume tab spaced text table
+						{
+							Separator = '\t';
+						}
+					}
+
+					Stream.Set_Separators(CSG_String(Separator));
+
+					Stream.Set_Decimal_Comma(bComma2Point = bCSV && Separator == ';');
+
+					if( (nFields = Stream.Get_Fields(iFirst, NULL, 0)) < 1 )
+					{
+						return( false );
+					}
+
+					TSG_Text_Field *Field = (TSG_Text_Field *)Fields.Get_Array(nFields);
+
+					Stream.Get_Fields(iFirst, Field, nFields);
+
+					for(int i=0; i<nFields; i++)
+					{
+						CSG_String Name(bHeadline ? CSG_Text_Reader::To_String(Field[i]) : CSG_String(""));
+
+						if( Name.is_Empty() )
+						{
+							Name.Printf("F%02d", i + 1);
+						}
+
+						Add_Field(Name, SG_DATATYPE_String);
+					}
+
+					//-------------------------------------
+					Types.Create(nFields); Types.Assign(SG_DATATYPE_Int);
+
+					for(sLong iLine=bHeadline ? iFirst + 1 : iFirst; iLine<nLines && iLine<iFirst+TEXT_TYPE_SAMPLE; iLine++)
+					{
+						int n = Stream.Get_Fields(iLine, Field, nFields);
+
+						for(int i=0; i<nFields && i<n; i++)
+						{
+							if( Types[i] != SG_DATATYPE_String && Field[i].Length > 0 )
+							{
+								double Value; TSG_Data_Type Type = SG_Table_Text_Get_Type(Field[i], bComma2Point, Value);
+
+								if( Type > Types[i] ) { Types[i] = Type; } // Int < Double < String
+							}
+						}
+					}
+
+					for(int i=0; i<nFields; i++)
+					{
+						Set_Field_Type(i, (TSG_Data_Type)Types[i]);
+					}
+
+					Found = Types;
+				}
+
+				if( bHeadline )
+				{
+					iFirst++;
+				}
+			}
+
+			//---------------------------------------------
+			Fields .Set_Array(nLines * nFields, false); TSG_Text_Field *Field = (TSG_Text_Field *)Fields.Get_Array();
+			Values .Create   (nLines * nFields       );
+			nValues.Create   (nLines                 );
+
+			#pragma omp parallel for
+			for(sLong iLine=iFirst; iLine<nLines; iLine++)
+			{
+				TSG_Text_Field *pField = Field + iLine * nFields; double *pValue = Values.Get_Data() + iLine * nFields;
+
+				int n = nValues[iLine] = Stream.Get_Fields(iLine, pField, nFields);
+
+				for(int i=0; i<nFields && i<n; i++)
+				{
+					if( Types[i] != SG_DATATYPE_String && pField[i].Length > 0 )
+					{
+						TSG_Data_Type Type = SG_Table_Text_Get_Type(pField[i], bComma2Point, pValue[i]);
+
+						if( Type > Types[i] )
+						{
+							#pragma omp critical(table_load_text_type)
+							{
+								if( Type > Found[i] ) { Found[i] = Type; }
+							}
+						}
+					}
+				}
+			}
+
+			//---------------------------------------------
+			for(int i=0; i<nFields; i++)
+			{
+				if( Found[i] > Types[i] ) // value does not fit the estimated type, we need to read again
+				{
+					Types[i] = Found[i]; bAppend = false; bRescan = true;
+				}
+			}
+
+			if( bAppend )
+			{
+				for(sLong iLine=iFirst; iLine<nLines; iLine++)
+				{
+					if( nValues[iLine] < 1 ) // empty or comment
+					{
+						continue;
+					}
+
+					CSG_Table_Record &Record = *Add_Record(); TSG_Text_Field *pField = Field + iLine * nFields; double *pValue = Values.Get_Data() + iLine * nFields;
+
+					for(int i=0; i<nFields; i++)
+					{
+						if( i >= nValues[iLine] || pField[i].Length < 1 )
+						{
+							Record.Set_NoData(i);
+						}
+						else if( Types[i] == SG_DATATYPE_String )
+						{
+							Record.Set_Value(i, CSG_Text_Reader::To_String(pField[i]));
+						}
+						else
+						{
+							Record.Set_Value(i, pValue[i]);
+						}
+					}
+				}
+			}
+		}
+
+		//-------------------------------------------------
+		if( bRescan && SG_UI_Process_Get_Okay() )
+		{
+			Del_Records();
+
+			for(int i=0; i<nFields; i++)
+			{
+				Set_Field_Type(i, (TSG_Data_Type)Types[i]);
+			}
+
+			Stream.Seek(0);
+		}
+		else
+		{
+			bRescan = false;
+		}
+	}
+
+	SG_UI_Process_Set_Ready();
+
+	return( Get_Field_Count() > 0 );
+}
+
+//---------------------------------------------------------
+bool CSG_Table::_Load_Text_Stream(const CSG_String &File, bool bHeadline, const SG_Char _Separator)
 {
 	CSG_File Stream;
 
@@ -271,21 +271,6 @@ public:
 	CSG_TIN_Triangle *				Add_Triangle			(CSG_TIN_Node *p[3]);
 
 
-protected:
-
-	typedef struct
-	{
-		int							p1, p2;
-	}
-	TTIN_Edge;
-
-	typedef struct
-	{
-		int							p1, p2, p3;
-	}
-	TTIN_Triangle;
-
-
 protected:
 
 	bool							m_bTriangulate{true};
@@ -315,8 +300,7 @@ protected:
 	CSG_TIN_Triangle *				_Add_Triangle			(CSG_TIN_Node *a, CSG_TIN_Node *b, CSG_TIN_Node *c);
 
 	bool							_Triangulate			(void);
-	bool							_Triangulate			(CSG_TIN_Node **Nodes, int nNodes, TTIN_Triangle *Triangles, int &nTriangles);
-	int								_CircumCircle			(double xp, double yp, double x1, double y1, double x2, double y2, double x3, double y3, double *xc, double *yc, double *r);
+	bool							_Triangulate			(CSG_TIN_Node **Nodes, int nNodes, CSG_Array_Int &Triangles, CSG_Array_Int &Edges);
 
 };
 
@@ -47,14 +47,23 @@
 //                                                       //
 //    e-mail:     oconrad@saga-gis.org                   //
 //                                                       //
-///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
 //
-// The Delaunay Triangulation algorithm used here is based
-// on Paul Bourke's C source codes, which can be found at:
+// Delaunay triangulation by incremental insertion (Bowyer &
+// Watson) in O(n log n) expected time:
+//
+// - points are inserted in the order of a Hilbert curve, so
+//   that the triangle containing the next point is found by
+//   a short walk starting at the previously created triangle,
+//
+// - the convex hull is closed by 'ghost' triangles sharing
+//   an infinite vertex, which avoids the numerical problems
+//   of a finite super triangle,
 //
-//     http://astronomy.swin.edu.au/~pbourke/
+// - orientation and in-circle tests are exact, using a
+//   floating point filter and expansion arithmetic as
+//   fall back (Shewchuk 1997).
 //
 //---------------------------------------------------------
 
@@ -96,7 +105,7 @@ bool CSG_TIN::_Triangulate(void)
 	_Destroy_Edges(); _Destroy_Triangles();
 
 	//-----------------------------------------------------
-	CSG_TIN_Node **Nodes = (CSG_TIN_Node **)SG_Malloc((Get_Node_Count() + 3l) * sizeof(CSG_TIN_Node *));
+	CSG_TIN_Node **Nodes = (CSG_TIN_Node **)SG_Malloc(Get_Node_Count() * sizeof(CSG_TIN_Node *));
 
 	for(sLong i=0; i<Get_Node_Count(); i++)
 	{
@@ -119,30 +128,40 @@ bool CSG_TIN::_Triangulate(void)
 	}
 
 	//-----------------------------------------------------
-	for(sLong i=Get_Node_Count(); i<Get_Node_Count()+3l; i++)
-	{
-		Nodes[i] = new CSG_TIN_Node(this, 0);
-	}
+	CSG_Array_Int Triangles, Edges;
 
-	//-----------------------------------------------------
-	TTIN_Triangle *Triangles = (TTIN_Triangle *)SG_Malloc(Get_Node_Count() * 3l * sizeof(TTIN_Triangle));
-
-	int nTriangles; bool bResult = _Triangulate(Nodes, (int)Get_Node_Count(), Triangles, nTriangles);
+	bool bResult = _Triangulate(Nodes, (int)Get_Node_Count(), Triangles, Edges);
 
 	if( bResult )
 	{
-		for(int i=0; i<nTriangles && SG_UI_Process_Set_Progress(i, nTriangles); i++)
+		m_nTriangles = Triangles.Get_Size() / 3;
+		m_Triangles  = (CSG_TIN_Triangle **)SG_Malloc(m_nTriangles * sizeof(CSG_TIN_Triangle *));
+
+		for(sLong i=0; i<m_nTriangles; i++)	// no cancel check, all triangles have to be built
 		{
-			_Add_Triangle(Nodes[Triangles[i].p1], Nodes[Triangles[i].p2], Nodes[Triangles[i].p3]);
+			SG_UI_Process_Set_Progress(i, m_nTriangles);
+
+			CSG_TIN_Node *a = Nodes[Triangles[3 * i]], *b = Nodes[Triangles[3 * i + 1]], *c = Nodes[Triangles[3 * i + 2]];
+
+			m_Triangles[i] = new CSG_TIN_Triangle(a, b, c);
+
+			a->_Add_Triangle(m_Triangles[i]);
+			b->_Add_Triangle(m_Triangles[i]);
+			c->_Add_Triangle(m_Triangles[i]);
 		}
-	}
 
-	SG_Free(Triangles);
+		m_nEdges = Edges.Get_Size() / 2;
+		m_Edges  = (CSG_TIN_Edge **)SG_Malloc(m_nEdges * sizeof(CSG_TIN_Edge *));
 
-	//-----------------------------------------------------
-	for(sLong i=Get_Node_Count(); i<Get_Node_Count()+3l; i++)
-	{
-		delete(Nodes[i]);
+		for(sLong i=0; i<m_nEdges; i++)
+		{
+			CSG_TIN_Node *a = Nodes[Edges[2 * i]], *b = Nodes[Edges[2 * i + 1]];
+
+			m_Edges[i] = new CSG_TIN_Edge(a, b);
+
+			a->_Add_Neighbor(b);
+			b->_Add_Neighbor(a);
+		}
 	}
 
 	SG_Free(Nodes);
@@ -155,275 +174,592 @@ bool CSG_TIN::_Triangulate(void)
 
 ///////////////////////////////////////////////////////////
 //                                                       //
+//                   Exact Predicates                    //
+//                                                       //
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CSG_TIN::_Triangulate(CSG_TIN_Node **Points, int nPoints, TTIN_Triangle *Triangles, int &nTriangles)
+// Expansion arithmetic following Shewchuk (1997): Adaptive
+// Precision Floating-Point Arithmetic and Fast Robust
+// Geometric Predicates. An expansion is a sum of non-
+// overlapping doubles ordered by increasing magnitude, so
+// that its sign is the sign of its last component.
+//---------------------------------------------------------
+static const double	SG_TIN_Epsilon		= 1.1102230246251565e-16;	// 2^-53
+static const double	SG_TIN_Splitter		= 134217729.;				// 2^27 + 1
+static const double	SG_TIN_Orient_Bound	= (3. + 16. * SG_TIN_Epsilon) * SG_TIN_Epsilon;
+static const double	SG_TIN_Circle_Bound	= (10. + 96. * SG_TIN_Epsilon) * SG_TIN_Epsilon;
+
+//---------------------------------------------------------
+static inline void SG_TIN_Two_Sum(double a, double b, double &x, double &y)
+{
+	x = a + b; double bv = x - a, av = x - bv; y = (a - av) + (b - bv);
+}
+
+//---------------------------------------------------------
+static inline void SG_TIN_Two_Diff(double a, double b, double &x, double &y)
+{
+	x = a - b; double bv = a - x, av = x + bv; y = (a - av) + (bv - b);
+}
+
+//---------------------------------------------------------
+static inline void SG_TIN_Split(double a, double &hi, double &lo)
+{
+	double c = SG_TIN_Splitter * a; hi = c - (c - a); lo = a - hi;
+}
+
+//---------------------------------------------------------
+static inline void SG_TIN_Two_Product(double a, double b, double &x, double &y)
 {
-	if( nPoints >= 3 ) // Update extent...
+	x = a * b; double ahi, alo, bhi, blo; SG_TIN_Split(a, ahi, alo); SG_TIN_Split(b, bhi, blo);
+
+	y = alo * blo - (((x - ahi * bhi) - alo * bhi) - ahi * blo);
+}
+
+//---------------------------------------------------------
+// h = e + f, returns the length of h (zero components removed)
+static int SG_TIN_Exp_Sum(int elen, const double *e, int flen, const double *f, double *h)
+{
+	int hlen = 0;
+
+	if( elen < 1 ) { for(int i=0; i<flen; i++) { h[hlen++] = f[i]; } return( hlen ); }
+	if( flen < 1 ) { for(int i=0; i<elen; i++) { h[hlen++] = e[i]; } return( hlen ); }
+
+	double Q, q, x; int ei = 0, fi = 0;
+
+	if( (f[0] > e[0]) == (f[0] > -e[0]) ) { Q = e[ei++]; } else { Q = f[fi++]; }
+
+	while( ei < elen && fi < flen )
 	{
-		m_Extent.Assign(Points[0]->Get_Point(), Points[0]->Get_Point());
+		if( (f[fi] > e[ei]) == (f[fi] > -e[ei]) ) { x = e[ei++]; } else { x = f[fi++]; }
 
-		for(int i=1; i<nPoints; i++)
-		{
-			m_Extent.Union(Points[i]->Get_Point());
-		}
+		SG_TIN_Two_Sum(Q, x, Q, q); if( q != 0. ) { h[hlen++] = q; }
 	}
-	else
+
+	while( ei < elen ) { SG_TIN_Two_Sum(Q, e[ei++], Q, q); if( q != 0. ) { h[hlen++] = q; } }
+	while( fi < flen ) { SG_TIN_Two_Sum(Q, f[fi++], Q, q); if( q != 0. ) { h[hlen++] = q; } }
+
+	if( Q != 0. || hlen == 0 ) { h[hlen++] = Q; }
+
+	return( hlen );
+}
+
+//---------------------------------------------------------
+// h = e * b, h needs space for 2 * elen components
+static int SG_TIN_Exp_Scale(int elen, const double *e, double b, double *h)
+{
+	double Q, sum, hh, p1, p0; int hlen = 0;
+
+	SG_TIN_Two_Product(e[0], b, Q, hh); if( hh != 0. ) { h[hlen++] = hh; }
+
+	for(int i=1; i<elen; i++)
 	{
-		return( false );
+		SG_TIN_Two_Product(e[i], b, p1, p0);
+		SG_TIN_Two_Sum(Q, p0, sum, hh); if( hh != 0. ) { h[hlen++] = hh; }
+		SG_TIN_Two_Sum(p1, sum, Q, hh); if( hh != 0. ) { h[hlen++] = hh; }
 	}
 
-	int status = 0, emax = 200, trimax = 4 * nPoints;
+	if( Q != 0. || hlen == 0 ) { h[hlen++] = Q; }
+
+	return( hlen );
+}
 
-	//-----------------------------------------------------	
-	int *complete = (int *)SG_Malloc(trimax * sizeof(int)); // Allocate memory for the completeness list, flag for each triangle
+//---------------------------------------------------------
+// h = e * f, h needs space for 2 * elen * flen components
+static int SG_TIN_Exp_Product(int elen, const double *e, int flen, const double *f, double *h)
+{
+	double s[64], t[1024]; int hlen = 0;
 
-	if( complete == NULL )
+	for(int i=0; i<flen; i++)
 	{
-		return( false );
+		int slen = SG_TIN_Exp_Scale(elen, e, f[i], s);
+
+		hlen = SG_TIN_Exp_Sum(hlen, h, slen, s, t);
+
+		for(int j=0; j<hlen; j++) { h[j] = t[j]; }
+	}
+
+	return( hlen );
+}
+
+//---------------------------------------------------------
+static inline int SG_TIN_Sign(double d)
+{
+	return( d > 0. ? 1 : d < 0. ? -1 : 0 );
+}
+
+//---------------------------------------------------------
+// > 0 if c lies to the left of the directed line a -> b
+static int SG_TIN_Orientation(const double *a, const double *b, const double *c)
+{
+	double l = (a[0] - c[0]) * (b[1] - c[1]), r = (a[1] - c[1]) * (b[0] - c[0]), det = l - r;
+
+	if( fabs(det) > SG_TIN_Orient_Bound * (fabs(l) + fabs(r)) )
+	{
+		return( SG_TIN_Sign(det) );
 	}
 
 	//-----------------------------------------------------
-	TTIN_Edge *edges = (TTIN_Edge *)SG_Malloc(emax * sizeof(TTIN_Edge)); // Allocate memory for the edge list
+	double acx[2], acy[2], bcx[2], bcy[2], L[8], R[8], D[16];
+
+	SG_TIN_Two_Diff(a[0], c[0], acx[1], acx[0]); SG_TIN_Two_Diff(a[1], c[1], acy[1], acy[0]);
+	SG_TIN_Two_Diff(b[0], c[0], bcx[1], bcx[0]); SG_TIN_Two_Diff(b[1], c[1], bcy[1], bcy[0]);
+
+	int nL = SG_TIN_Exp_Product(2, acx, 2, bcy, L);
+	int nR = SG_TIN_Exp_Product(2, acy, 2, bcx, R);
+
+	for(int i=0; i<nR; i++) { R[i] = -R[i]; }
+
+	int nD = SG_TIN_Exp_Sum(nL, L, nR, R, D);
+
+	return( SG_TIN_Sign(D[nD - 1]) );
+}
+
+//---------------------------------------------------------
+// > 0 if d lies inside the circumcircle of the counter-
+// clockwise oriented triangle a, b, c
+static int SG_TIN_In_Circle(const double *a, const double *b, const double *c, const double *d)
+{
+	double adx = a[0] - d[0], ady = a[1] - d[1];
+	double bdx = b[0] - d[0], bdy = b[1] - d[1];
+	double cdx = c[0] - d[0], cdy = c[1] - d[1];
 
-	if( edges == NULL )
+	double bc1 = bdx * cdy, bc2 = cdx * bdy, alift = adx * adx + ady * ady;
+	double ca1 = cdx * ady, ca2 = adx * cdy, blift = bdx * bdx + bdy * bdy;
+	double ab1 = adx * bdy, ab2 = bdx * ady, clift = cdx * cdx + cdy * cdy;
+
+	double det = alift * (bc1 - bc2) + blift * (ca1 - ca2) + clift * (ab1 - ab2);
+
+	double permanent = (fabs(bc1) + fabs(bc2)) * alift + (fabs(ca1) + fabs(ca2)) * blift + (fabs(ab1) + fabs(ab2)) * clift;
+
+	if( fabs(det) > SG_TIN_Circle_Bound * permanent )
 	{
-		SG_Free(complete); return( false );
+		return( SG_TIN_Sign(det) );
 	}
 
 	//-----------------------------------------------------
-	//	Find the maximum and minimum vertex bounds.
-	//	This is to allow calculation of the bounding triangle
-	//	Set up the supertriangle
-	//	This is a triangle which encompasses all the sample points.
-	//	The supertriangle coordinates are added to the end of the
-	//	vertex list. The supertriangle is the first triangle in
-	//	the triangle list.
+	double dx[3][2], dy[3][2];
+
+	SG_TIN_Two_Diff(a[0], d[0], dx[0][1], dx[0][0]); SG_TIN_Two_Diff(a[1], d[1], dy[0][1], dy[0][0]);
+	SG_TIN_Two_Diff(b[0], d[0], dx[1][1], dx[1][0]); SG_TIN_Two_Diff(b[1], d[1], dy[1][1], dy[1][0]);
+	SG_TIN_Two_Diff(c[0], d[0], dx[2][1], dx[2][0]); SG_TIN_Two_Diff(c[1], d[1], dy[2][1], dy[2][0]);
+
+	double Det[1600], Sum[1600]; int nDet = 0;
+
+	for(int i=0; i<3; i++)
+	{
+		int j = (i + 1) % 3, k = (i + 2) % 3;
+
+		double xx[8], yy[8], Lift[16], P[8], Q[8], Cross[16], Term[512];
 
-	double dmax = m_Extent.Get_XRange() > m_Extent.Get_YRange() ? m_Extent.Get_XRange() : m_Extent.Get_YRange();
+		int nxx   = SG_TIN_Exp_Product(2, dx[i], 2, dx[i], xx);
+		int nyy   = SG_TIN_Exp_Product(2, dy[i], 2, dy[i], yy);
+		int nLift = SG_TIN_Exp_Sum(nxx, xx, nyy, yy, Lift);
 
-	Points[nPoints + 0]->m_Point.x = m_Extent.Get_XCenter() - 20 * dmax;
-	Points[nPoints + 1]->m_Point.x = m_Extent.Get_XCenter();
-	Points[nPoints + 2]->m_Point.x = m_Extent.Get_XCenter() + 20 * dmax;
+		int nP    = SG_TIN_Exp_Product(2, dx[j], 2, dy[k], P);
+		int nQ    = SG_TIN_Exp_Product(2, dx[k], 2, dy[j], Q);
 
-	Points[nPoints + 0]->m_Point.y = m_Extent.Get_YCenter() -      dmax;
-	Points[nPoints + 1]->m_Point.y = m_Extent.Get_YCenter() + 20 * dmax;
-	Points[nPoints + 2]->m_Point.y = m_Extent.Get_YCenter() -      dmax;
+		for(int n=0; n<nQ; n++) { Q[n] = -Q[n]; }
 
-	Triangles[0].p1 = nPoints;
-	Triangles[0].p2 = nPoints + 1;
-	Triangles[0].p3 = nPoints + 2;
+		int nCross = SG_TIN_Exp_Sum(nP, P, nQ, Q, Cross);
+		int nTerm  = SG_TIN_Exp_Product(nLift, Lift, nCross, Cross, Term);
 
-	complete [0]    = false;
+		nDet = SG_TIN_Exp_Sum(nDet, Det, nTerm, Term, Sum);
+
+		for(int n=0; n<nDet; n++) { Det[n] = Sum[n]; }
+	}
+
+	return( SG_TIN_Sign(Det[nDet - 1]) );
+}
 
-	nTriangles      = 1;
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                    Triangulation                      //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Position of (x, y) on a Hilbert curve filling a square of
+// 2^16 x 2^16 cells.
+static sLong SG_TIN_Hilbert_Index(int x, int y)
+{
+	sLong d = 0;
+
+	for(int s=1<<15; s>0; s>>=1)
+	{
+		int rx = (x & s) > 0, ry = (y & s) > 0;
+
+		d += (sLong)s * s * ((3 * rx) ^ ry);
+
+		if( ry == 0 )
+		{
+			if( rx == 1 ) { x = s - 1 - x; y = s - 1 - y; }
+
+			int t = x; x = y; y = t;
+		}
+	}
+
+	return( d );
+}
+
+//---------------------------------------------------------
+typedef struct
+{
+	sLong	Key;
+
+	int		Index;
+}
+TSG_TIN_Hilbert;
+
+//---------------------------------------------------------
+static int SG_TIN_Hilbert_Compare(const void *a, const void *b)
+{
+	sLong d = ((TSG_TIN_Hilbert *)a)->Key - ((TSG_TIN_Hilbert *)b)->Key;
+
+	return( d < 0 ? -1 : d > 0 ? 1 : 0 );
+}
+
+//---------------------------------------------------------
+// Triangles are stored with their three vertices and the
+// three neighbours, the k-th neighbour lying opposite to the
+// k-th vertex. Vertex index n is the infinite vertex of the
+// ghost triangles, which is always kept at position 2.
+//---------------------------------------------------------
+class CSG_TIN_Delaunay
+{
+public:
+
+	CSG_TIN_Delaunay(int nPoints) : m_n(nPoints)
+	{
+		m_XY   .Create(2 * (sLong)nPoints);
+		m_Start.Create(nPoints + 1);
+		m_V    .Create(0, TSG_Array_Growth::SG_ARRAY_GROWTH_2);
+		m_N    .Create(0, TSG_Array_Growth::SG_ARRAY_GROWTH_2);
+		m_Mark .Create(0, TSG_Array_Growth::SG_ARRAY_GROWTH_2);
+		m_Free .Create(0, TSG_Array_Growth::SG_ARRAY_GROWTH_1);
+		m_Cavity.Create(0, TSG_Array_Growth::SG_ARRAY_GROWTH_1);
+		m_New  .Create(0, TSG_Array_Growth::SG_ARRAY_GROWTH_1);
+	}
 
 	//-----------------------------------------------------
-	//	Include each point one at a time into the existing mesh
-	for(int i=0; i<nPoints && SG_UI_Process_Set_Progress(i, nPoints); i++)
+	void				Set_Point		(int i, double x, double y)	{	m_XY[2 * (sLong)i] = x; m_XY[2 * (sLong)i + 1] = y;	}
+
+	const double *		Get_Point		(int i)	const	{	return( m_XY.Get_Data() + 2 * (sLong)i );	}
+
+	int					Get_Count		(void)	const	{	return( (int)(m_V.Get_Size() / 3) );	}
+
+	int					V				(int t, int k)	const	{	return( m_V.Get_Array()[3 * (sLong)t + k] );	}
+	int					N				(int t, int k)	const	{	return( m_N.Get_Array()[3 * (sLong)t + k] );	}
+
+	bool				is_Ghost		(int t)	const	{	return( V(t, 2) == m_n );	}
+	bool				is_Alive		(int t)	const	{	return( m_Mark.Get_Array()[t] != -2 );	}
+
+	//-----------------------------------------------------
+	bool				Initialize		(int a, int b, int c)
 	{
-		double xp = Points[i]->Get_X();
-		double yp = Points[i]->Get_Y();
+		if( SG_TIN_Orientation(Get_Point(a), Get_Point(b), Get_Point(c)) < 0 )
+		{
+			int i = b; b = c; c = i;
+		}
+
+		int t = _Add(a, b, c), g0 = _Add(c, b, m_n), g1 = _Add(a, c, m_n), g2 = _Add(b, a, m_n);
+
+		_Set_N(t , g0, g1, g2);	// opposite a: edge b-c, opposite b: edge c-a, opposite c: edge a-b
+		_Set_N(g0, g2, g1, t );	// (c, b, inf)
+		_Set_N(g1, g0, g2, t );	// (a, c, inf)
+		_Set_N(g2, g1, g0, t );	// (b, a, inf)
 
-		int nedge = 0;
+		m_Last = t;
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	void				Insert			(int p)
+	{
+		int t = _Locate(p);
 
 		//-------------------------------------------------
-		//	Set up the edge buffer.
-		//	If the point (xp,yp) lies inside the circumcircle then the
-		//	three edges of that triangle are added to the edge buffer
-		//	and that triangle is removed.
-		for(int j=0; j<nTriangles; j++)
+		// collect all triangles in conflict with p (cavity)
+
+		m_Cavity.Set_Array(0, false); m_Cavity.Add(t); m_Mark[t] = p;
+
+		for(sLong i=0; i<m_Cavity.Get_Size(); i++)
 		{
-			if( complete[j] )
+			int c = m_Cavity[i];
+
+			for(int k=0; k<3; k++)
 			{
-				continue;
+				int n = N(c, k);
+
+				if( m_Mark[n] != p && m_Mark[n] != -3 - p )
+				{
+					if( _is_Conflict(n, p) )
+					{
+						m_Mark[n] = p; m_Cavity.Add(n);
+					}
+					else
+					{
+						m_Mark[n] = -3 - p;	// tested, not in conflict
+					}
+				}
 			}
+		}
 
-			double x1 = Points[Triangles[j].p1]->Get_X();
-			double y1 = Points[Triangles[j].p1]->Get_Y();
-			double x2 = Points[Triangles[j].p2]->Get_X();
-			double y2 = Points[Triangles[j].p2]->Get_Y();
-			double x3 = Points[Triangles[j].p3]->Get_X();
-			double y3 = Points[Triangles[j].p3]->Get_Y();
+		//-------------------------------------------------
+		// retriangulate the cavity by connecting its
+		// boundary edges with p
 
-			double xc, yc, r; int inside = _CircumCircle(xp, yp, x1, y1, x2, y2, x3, y3, &xc, &yc, &r);
+		m_New.Set_Array(0, false);
 
-			if( xc + r < xp )
-			{
-				complete[j] = true;
-			}
+		for(sLong i=0; i<m_Cavity.Get_Size(); i++)
+		{
+			int c = m_Cavity[i];
 
-			if( inside )
+			for(int k=0; k<3; k++)
 			{
-				if( nedge + 3 >= emax ) // Check that we haven't exceeded the edge list size
+				int n = N(c, k);
+
+				if( m_Mark[n] != p )	// boundary edge
 				{
-					emax += 100; TTIN_Edge *_edges = (TTIN_Edge *)SG_Realloc(edges, emax * sizeof(TTIN_Edge));
+					int a = V(c, (k + 1) % 3), b = V(c, (k + 2) % 3), t;
+
+					if     ( a == m_n ) { t = _Add(b, p, a); _Set_N(t, -1, n, -1); }	// ghosts keep the infinite vertex at position 2
+					else if( b == m_n ) { t = _Add(p, a, b); _Set_N(t, n, -1, -1); }
+					else                { t = _Add(a, b, p); _Set_N(t, -1, -1, n); }
 
-					if( _edges == NULL )
+					m_Start[a] = t;
+
+					for(int j=0; j<3; j++)
 					{
-						SG_Free(edges); SG_Free(complete); return( false );
+						if( N(n, j) == c ) { m_N[3 * (sLong)n + j] = t; }
 					}
 
-					edges = _edges;
+					m_New.Add(t);
 				}
+			}
+		}
+
+		for(sLong i=0; i<m_Cavity.Get_Size(); i++)
+		{
+			m_Mark[m_Cavity[i]] = -2; m_Free.Add(m_Cavity[i]);	// deleted
+		}
 
-				edges[nedge + 0].p1 = Triangles[j].p1;
-				edges[nedge + 0].p2 = Triangles[j].p2;
-				edges[nedge + 1].p1 = Triangles[j].p2;
-				edges[nedge + 1].p2 = Triangles[j].p3;
-				edges[nedge + 2].p1 = Triangles[j].p3;
-				edges[nedge + 2].p2 = Triangles[j].p1;
+		//-------------------------------------------------
+		// link the new triangles among each other: (a, b, p)
+		// shares its edge b -> p with (b, c, p), the one
+		// starting at boundary vertex b, where it is p -> b
 
-				nedge += 3;
+		for(sLong i=0; i<m_New.Get_Size(); i++)
+		{
+			int t = m_New[i], k = _Get_Index(t, p), a = V(t, (k + 1) % 3), b = V(t, (k + 2) % 3);
 
-				Triangles[j] = Triangles[nTriangles - 1];
-				complete [j] = complete [nTriangles - 1];
+			int u = m_Start[b], c = V(u, (_Get_Index(u, p) + 2) % 3);
 
-				nTriangles--; j--;
-			}
+			m_N[3 * (sLong)t + _Get_Index(t, a)] = u;	// opposite a in t is edge b -> p
+			m_N[3 * (sLong)u + _Get_Index(u, c)] = t;	// opposite c in u is edge p -> b
 		}
 
-		//-------------------------------------------------
-		//	Tag multiple edges
-		//	Note: if all triangles are specified anticlockwise then all
-		//	      interior edges are opposite pointing in direction.
-		for(int j=0; j<nedge-1; j++)
+		m_Last = m_New[0];
+	}
+
+	//-----------------------------------------------------
+	bool				Get_Result		(CSG_Array_Int &Triangles, CSG_Array_Int &Edges)	const
+	{
+		Triangles.Set_Growth(TSG_Array_Growth::SG_ARRAY_GROWTH_2);
+		Edges    .Set_Growth(TSG_Array_Growth::SG_ARRAY_GROWTH_2);
+
+		for(int t=0; t<Get_Count(); t++)
 		{
-			for(int k=j+1; k<nedge; k++)
+			if( is_Alive(t) && !is_Ghost(t) )
 			{
-				if( (edges[j].p1 == edges[k].p2) && (edges[j].p2 == edges[k].p1) )
-				{
-					edges[j].p1 = -1;
-					edges[j].p2 = -1;
-					edges[k].p1 = -1;
-					edges[k].p2 = -1;
-				}
+				Triangles.Add(V(t, 0)); Triangles.Add(V(t, 1)); Triangles.Add(V(t, 2));
 
-				// Shouldn't need the following, see note above
-				if( (edges[j].p1 == edges[k].p1) && (edges[j].p2 == edges[k].p2) )
+				for(int k=0; k<3; k++)
 				{
-					edges[j].p1 = -1;
-					edges[j].p2 = -1;
-					edges[k].p1 = -1;
-					edges[k].p2 = -1;
+					int a = V(t, (k + 1) % 3), b = V(t, (k + 2) % 3);
+
+					if( a < b || is_Ghost(N(t, k)) )	// each edge only once
+					{
+						Edges.Add(a); Edges.Add(b);
+					}
 				}
 			}
 		}
 
-		//-------------------------------------------------
-		//	Form new triangles for the current point
-		//	Skipping over any tagged edges.
-		//	All edges are arranged in clockwise order.
-		for(int j=0; j<nedge; j++)
-		{
-			if( edges[j].p1 < 0 || edges[j].p2 < 0 )
-			{
-				continue;
-			}
+		return( Triangles.Get_Size() > 0 );
+	}
 
-			if( nTriangles >= trimax )
-			{
-				SG_Free(edges); SG_Free(complete); return( false );
-			}
 
-			Triangles[nTriangles].p1 = edges[j].p1;
-			Triangles[nTriangles].p2 = edges[j].p2;
-			Triangles[nTriangles].p3 = i;
-			complete [nTriangles]    = false;
-			nTriangles++;
+private:
+
+	int					m_n, m_Last = 0;
+
+	unsigned int		m_Random = 1;
+
+	CSG_Vector			m_XY;
+
+	CSG_Array_Int		m_V, m_N, m_Mark, m_Start, m_Free, m_Cavity, m_New;
+
+
+	//-----------------------------------------------------
+	int					_Add			(int a, int b, int c)
+	{
+		int t;
+
+		if( m_Free.Get_Size() > 0 )
+		{
+			t = m_Free[m_Free.Get_Size() - 1]; m_Free.Dec_Array(false);
+		}
+		else
+		{
+			t = Get_Count(); m_V.Inc_Array(3); m_N.Inc_Array(3); m_Mark.Add(-1);
 		}
+
+		m_V[3 * (sLong)t] = a; m_V[3 * (sLong)t + 1] = b; m_V[3 * (sLong)t + 2] = c; m_Mark[t] = -1;
+
+		return( t );
 	}
 
 	//-----------------------------------------------------
-	//	Remove triangles with supertriangle vertices
-	//	These are triangles which have a vertex number greater than nPoints
-	for(int i=0; i<nTriangles; i++)
+	void				_Set_N			(int t, int n0, int n1, int n2)
 	{
-		if(	Triangles[i].p1 >= nPoints
-		||	Triangles[i].p2 >= nPoints
-		||	Triangles[i].p3 >= nPoints )
+		m_N[3 * (sLong)t] = n0; m_N[3 * (sLong)t + 1] = n1; m_N[3 * (sLong)t + 2] = n2;
+	}
+
+	//-----------------------------------------------------
+	int					_Get_Index		(int t, int v)	const
+	{
+		return( V(t, 0) == v ? 0 : V(t, 1) == v ? 1 : 2 );
+	}
+
+	//-----------------------------------------------------
+	bool				_is_Conflict	(int t, int p)	const
+	{
+		const double *P = Get_Point(p), *A = Get_Point(V(t, 0)), *B = Get_Point(V(t, 1));
+
+		if( !is_Ghost(t) )
 		{
-			Triangles[i] = Triangles[nTriangles - 1];
-			nTriangles--;
-			i--;
+			return( SG_TIN_In_Circle(A, B, Get_Point(V(t, 2)), P) > 0 );
 		}
+
+		int o = SG_TIN_Orientation(A, B, P);	// (a, b, inf): outside is left of a -> b
+
+		if( o != 0 )
+		{
+			return( o > 0 );
+		}
+
+		return( A[0] != B[0]	// on the line through a and b, conflict if inside the segment
+			? (A[0] < P[0]) == (P[0] < B[0])
+			: (A[1] < P[1]) == (P[1] < B[1])
+		);
 	}
 
 	//-----------------------------------------------------
-	return( true );
-}
+	// walk from the last created triangle towards p, stops
+	// at a triangle containing p or at a ghost triangle
+	// whose hull edge is visible from p
+	int					_Locate			(int p)
+	{
+		const double *P = Get_Point(p); int t = m_Last;
 
+		if( is_Ghost(t) )
+		{
+			t = N(t, 2);
+		}
 
-///////////////////////////////////////////////////////////
-//                                                       //
-///////////////////////////////////////////////////////////
+		for(bool bMoved=true; bMoved && !is_Ghost(t); )
+		{
+			m_Random = m_Random * 1103515245u + 12345u; int r = (m_Random >> 16) % 3;
 
-//---------------------------------------------------------
-//	Return true if a point (xp,yp) is inside the circumcircle made up
-//	of the points (x1,y1), (x2,y2), (x3,y3)
-//	The circumcircle centre is returned in (xc,yc) and the radius r
-//	NOTE: A point on the edge is inside the circumcircle
-//
+			bMoved = false;
 
-//---------------------------------------------------------
-#define IS_IDENTICAL(a, b)	(a == b) // #define IS_IDENTICAL(a, b)	(fabs(a - b) < 0.0001)
+			for(int i=0; i<3 && !bMoved; i++)
+			{
+				int k = (r + i) % 3;
+
+				if( SG_TIN_Orientation(Get_Point(V(t, (k + 1) % 3)), Get_Point(V(t, (k + 2) % 3)), P) < 0 )
+				{
+					t = N(t, k); bMoved = true;
+				}
+			}
+		}
+
+		return( t );
+	}
+};
 
 //---------------------------------------------------------
-int CSG_TIN::_CircumCircle(double xp, double yp, double x1, double y1, double x2, double y2, double x3, double y3, double *xc, double *yc, double *r)
+bool CSG_TIN::_Triangulate(CSG_TIN_Node **Nodes, int nNodes, CSG_Array_Int &Triangles, CSG_Array_Int &Edges)
 {
-	double	m1, m2, mx1, mx2, my1, my2,
-			dx, dy, rsqr, drsqr;
-
-	// Check for coincident points
-	if( IS_IDENTICAL(y1, y2) && IS_IDENTICAL(y2, y3) )
+	if( nNodes < 3 )
 	{
 		return( false );
 	}
 
-	//-----------------------------------------------------
-	if( IS_IDENTICAL(y2, y1) )
+	m_Extent.Assign(Nodes[0]->Get_Point(), Nodes[0]->Get_Point());
+
+	for(int i=1; i<nNodes; i++)
 	{
-		m2	= -(x3 - x2) / (y3 - y2);
-		mx2	=  (x2 + x3) / 2.0;
-		my2	=  (y2 + y3) / 2.0;
-		*xc	=  (x2 + x1) / 2.0;
+		m_Extent.Union(Nodes[i]->Get_Point());
+	}
+
+	//-----------------------------------------------------
+	// insertion order along a Hilbert curve
+
+	TSG_TIN_Hilbert *Order = (TSG_TIN_Hilbert *)SG_Malloc(nNodes * sizeof(TSG_TIN_Hilbert));
 
-		*yc	= m2 * (*xc - mx2) + my2;
+	double dx = m_Extent.Get_XRange() > 0. ? 65535. / m_Extent.Get_XRange() : 0.;
+	double dy = m_Extent.Get_YRange() > 0. ? 65535. / m_Extent.Get_YRange() : 0.;
+
+	for(int i=0; i<nNodes; i++)
+	{
+		Order[i].Index = i;
+		Order[i].Key   = SG_TIN_Hilbert_Index(
+			(int)(dx * (Nodes[i]->Get_X() - m_Extent.Get_XMin())),
+			(int)(dy * (Nodes[i]->Get_Y() - m_Extent.Get_YMin()))
+		);
 	}
-	else if( IS_IDENTICAL(y3, y2) )
+
+	qsort(Order, nNodes, sizeof(TSG_TIN_Hilbert), SG_TIN_Hilbert_Compare);
+
+	//-----------------------------------------------------
+	CSG_TIN_Delaunay Delaunay(nNodes);
+
+	for(int i=0; i<nNodes; i++)
 	{
-		m1	= -(x2 - x1) / (y2 - y1);
-		mx1	=  (x1 + x2) / 2.0;
-		my1	=  (y1 + y2) / 2.0;
-		*xc	=  (x3 + x2) / 2.0;
+		Delaunay.Set_Point(i, Nodes[i]->Get_X(), Nodes[i]->Get_Y());
+	}
+
+	int c = 2;	// find a third point not collinear with the first two
 
-		*yc	= m1 * (*xc - mx1) + my1;
+	while( c < nNodes && SG_TIN_Orientation(Delaunay.Get_Point(Order[0].Index), Delaunay.Get_Point(Order[1].Index), Delaunay.Get_Point(Order[c].Index)) == 0 )
+	{
+		c++;
 	}
-	else
+
+	if( c >= nNodes )	// all points are collinear
 	{
-		m1	= -(x2 - x1) / (y2 - y1);
-		m2	= -(x3 - x2) / (y3 - y2);
-		mx1	=  (x1 + x2) / 2.0;
-		mx2	=  (x2 + x3) / 2.0;
-		my1	=  (y1 + y2) / 2.0;
-		my2	=  (y2 + y3) / 2.0;
-
-		*xc	= (m1 * mx1 - m2 * mx2 + my2 - my1) / (m1 - m2);
-		*yc	= m1 * (*xc - mx1) + my1;
+		SG_Free(Order);
+
+		return( false );
 	}
 
-	//-----------------------------------------------------
-	dx		= x2 - *xc;
-	dy		= y2 - *yc;
-	rsqr	= dx*dx + dy*dy;
-	*r		= sqrt(rsqr);
+	TSG_TIN_Hilbert Third = Order[c]; for(int i=c; i>2; i--) { Order[i] = Order[i - 1]; } Order[2] = Third;
+
+	Delaunay.Initialize(Order[0].Index, Order[1].Index, Order[2].Index);
 
-	dx		= xp - *xc;
-	dy		= yp - *yc;
-	drsqr	= dx*dx + dy*dy;
+	for(int i=3; i<nNodes && SG_UI_Process_Set_Progress(i, nNodes); i++)
+	{
+		Delaunay.Insert(Order[i].Index);
+	}
 
-	return( drsqr <= rsqr ? 1 : 0 );
+	SG_Free(Order);
+
+	//-----------------------------------------------------
+	return( SG_UI_Process_Get_Okay() && Delaunay.Get_Result(Triangles, Edges) );
 }
 
 
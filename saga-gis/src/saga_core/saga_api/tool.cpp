@@ -294,6 +294,30 @@ bool CSG_Tool::Execute(bool bAddHistory)
 	//	SG_UI_Process_Set_Busy(true, CSG_String::Format("%s: %s...", _TL("Executing"), Get_Name().c_str()));
 		CSG_DateTime Started(CSG_DateTime::Now());
 
+		m_Profile = CSG_Profile();
+
+		if( SG_Profile_is_Enabled() )
+		{
+			m_Profile.Start(Get_Name());
+		}
+
+		CSG_Array_Pointer DataObjects; Parameters.DataObjects_Get_List(DataObjects);
+
+		for(size_t i=0; i<DataObjects.Get_Size(); i++) // keep this tool's data in memory while it executes
+		{
+			CSG_Data_Object *pObject = (CSG_Data_Object *)DataObjects[i];
+
+			if( pObject->Get_Owner() )
+			{
+				pObject = pObject->Get_Owner();
+			}
+
+			pObject->Set_Memory_Lock(true);
+			pObject->Set_Memory_Access();
+		}
+
+		SG_Data_Memory_Check();
+
 ///////////////////////////////////////////////////////////
 //#if !defined(_DEBUG)
 #define _TOOL_EXCEPTION
@@ -321,8 +345,24 @@ bool CSG_Tool::Execute(bool bAddHistory)
 		CSG_TimeSpan Span = CSG_DateTime::Now() - Started;
 	//	SG_UI_Process_Set_Busy(false);
 
+		for(size_t i=0; i<DataObjects.Get_Size(); i++)
+		{
+			CSG_Data_Object *pObject = (CSG_Data_Object *)DataObjects[i];
+
+			if( pObject->Get_Owner() )
+			{
+				pObject = pObject->Get_Owner();
+			}
+
+			pObject->Set_Memory_Lock(false);
+		}
+
 		_Synchronize_DataObjects();
 
+		SG_Data_Memory_Check();
+
+		m_Profile.Stop();
+
 		if( !Process_Get_Okay(false) )
 		{
 			SG_UI_Msg_Add(_TL("Execution has been stopped by user!"), true, SG_UI_MSG_STYLE_BOLD);
@@ -378,6 +418,11 @@ bool CSG_Tool::Execute(bool bAddHistory)
 					bResult ? SG_UI_MSG_STYLE_SUCCESS : SG_UI_MSG_STYLE_FAILURE
 				);
 			}
+
+			if( has_GUI() && m_Profile.Get_Wall_Time() > 0. )
+			{
+				SG_UI_Msg_Add_Execution("\n" + m_Profile.to_Text(), false, SG_UI_MSG_STYLE_NORMAL);
+			}
 		}
 	}
 
@@ -79,6 +79,7 @@
 
 //---------------------------------------------------------
 #include "parameters.h"
+#include "profiler.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -233,6 +234,9 @@ public:
 
 	const SG_Char *				Get_Execution_Info			(void)	const	{	return( m_Execution_Info );	}
 
+	/** Resources used by the last execution, only collected while profiling is enabled (SG_Profile_Set_Enabled). */
+	const CSG_Profile &			Get_Profile					(void)	const	{	return( m_Profile );	}
+
 	CSG_MetaData				Get_History					(int Depth = -1);
 	bool						Set_History					(CSG_Data_Object *pDataObject, int Depth = -1);
 
@@ -359,6 +363,8 @@ private:
 
 	CSG_Array_Pointer			m_pParameters;
 
+	CSG_Profile					m_Profile;
+
 	CSG_String					m_ID, m_Library, m_Library_Menu, m_File_Name, m_Author, m_Version, m_Execution_Info;
 
 
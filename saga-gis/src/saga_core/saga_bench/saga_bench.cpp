@@ -0,0 +1,736 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                Command Line Interface                 //
+//                                                       //
+//                  Program: SAGA_BENCH                  //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                    saga_bench.cpp                     //
+//                                                       //
+//              Copyright (C) 2026 by agent              //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// saga_bench runs a fixed list of API calls and tools on
+// synthetic data sets that are generated from a fixed seed,
+// so that results of different builds are comparable. For
+// each benchmark and thread count the best wall time out of
+// a number of repetitions is reported together with CPU
+// time, throughput and memory. With --output the results
+// are written as JSON, e.g. to compare two commits:
+//
+//   saga_bench --size=2048 --label=$(git rev-parse --short HEAD) --output=bench.json
+//---------------------------------------------------------
+
+//---------------------------------------------------------
+#include <locale.h>
+
+#include <wx/app.h>
+
+#include <saga_api/saga_api.h>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define BENCH_SEED		20260101ULL
+
+//---------------------------------------------------------
+typedef bool (* TBench_Function)(double &Items);
+
+typedef struct
+{
+	const char		*ID;
+
+	bool			bParallel;	// run for each thread count, serial benchmarks run once
+
+	TBench_Function	Function;
+
+	const char		*Unit;
+}
+TBench;
+
+//---------------------------------------------------------
+int				g_Size = 1024, g_Repeat = 3;
+
+CSG_Array_Int	g_Threads;
+
+CSG_String		g_Filter, g_Output, g_Label, g_Temp;
+
+CSG_Grid		g_DEM;
+
+CSG_Shapes		g_Polygons(SHAPE_TYPE_Polygon), g_Clips(SHAPE_TYPE_Polygon);
+
+CSG_PointCloud	g_Points;
+
+CSG_KDTree_2D	g_Search;
+
+CSG_Strings		g_Results;
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//					Synthetic Data						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// A 64 bit linear congruential generator (Knuth's MMIX
+// constants). Unlike rand() it yields the same sequence on
+// every platform and with every runtime library.
+//---------------------------------------------------------
+unsigned long long	g_Random	= BENCH_SEED;
+
+inline void		Random_Seed		(unsigned long long Seed)
+{
+	g_Random	= Seed;
+}
+
+inline double	Random_Get		(void)	// [0, 1)
+{
+	g_Random	= 6364136223846793005ULL * g_Random + 1442695040888963407ULL;
+
+	return( (double)(g_Random >> 11) / 9007199254740992. );
+}
+
+inline double	Random_Get		(double Min, double Max)
+{
+	return( Min + (Max - Min) * Random_Get() );
+}
+
+//---------------------------------------------------------
+// Fractal surface by midpoint displacement (diamond-square)
+// as also used by the garden_fractals tools. The surface is
+// computed for the next 2^n + 1 square and then cropped.
+//---------------------------------------------------------
+bool		Create_DEM		(int Size)
+{
+	int	n	= 1;	while( n < Size - 1 )	{	n	*= 2;	}
+
+	CSG_Grid	Fractal(SG_DATATYPE_Float, n + 1, n + 1);
+
+	Random_Seed(BENCH_SEED);
+
+	Fractal.Set_Value(0, 0, 0.);	Fractal.Set_Value(n, 0, 0.);
+	Fractal.Set_Value(0, n, 0.);	Fractal.Set_Value(n, n, 0.);
+
+	double	Roughness	= n / 4.;
+
+	for(int Step=n; Step>1; Step/=2, Roughness/=2.)
+	{
+		int	Half	= Step / 2;
+
+		for(int y=Half; y<n; y+=Step)	// diamond
+		{
+			for(int x=Half; x<n; x+=Step)
+			{
+				Fractal.Set_Value(x, y, Random_Get(-Roughness, Roughness) + 0.25 * (
+					Fractal.asDouble(x - Half, y - Half) + Fractal.asDouble(x + Half, y - Half) +
+					Fractal.asDouble(x - Half, y + Half) + Fractal.asDouble(x + Half, y + Half)
+				));
+			}
+		}
+
+		for(int y=0; y<=n; y+=Half)		// square
+		{
+			for(int x=(y + Half) % Step; x<=n; x+=Step)
+			{
+				double	z = 0.;	int	m = 0;
+
+				if( y - Half >= 0 )	{	z += Fractal.asDouble(x, y - Half);	m++;	}
+				if( y + Half <= n )	{	z += Fractal.asDouble(x, y + Half);	m++;	}
+				if( x - Half >= 0 )	{	z += Fractal.asDouble(x - Half, y);	m++;	}
+				if( x + Half <= n )	{	z += Fractal.asDouble(x + Half, y);	m++;	}
+
+				Fractal.Set_Value(x, y, z / m + Random_Get(-Roughness, Roughness));
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	if( !g_DEM.Create(SG_DATATYPE_Float, Size, Size, 10.) )
+	{
+		return( false );
+	}
+
+	g_DEM.Set_Name("DEM");
+
+	for(int y=0; y<Size; y++) for(int x=0; x<Size; x++)
+	{
+		g_DEM.Set_Value(x, y, Fractal.asDouble(x, y));
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Random star shaped polygons. Each subject polygon gets a
+// clip polygon that is shifted by half its radius, so that
+// every pair overlaps.
+//---------------------------------------------------------
+bool		Create_Polygons	(int Count)
+{
+	Random_Seed(BENCH_SEED + 1);
+
+	g_Polygons.Create(SHAPE_TYPE_Polygon, SG_T("Polygons"));
+	g_Clips   .Create(SHAPE_TYPE_Polygon, SG_T("Clips"   ));
+
+	double	Extent	= g_Size * 10.;
+
+	for(int i=0; i<Count; i++)
+	{
+		double	x	= Random_Get(0., Extent), r = Random_Get(0.001, 0.01) * Extent;
+		double	y	= Random_Get(0., Extent);
+
+		int		nVertices	= 8 + (int)Random_Get(0., 56.);
+
+		CSG_Shape	*pPolygon	= g_Polygons.Add_Shape();
+		CSG_Shape	*pClip		= g_Clips   .Add_Shape();
+
+		for(int j=0; j<nVertices; j++)
+		{
+			double	a	= -M_PI_360 * j / nVertices, d = r * Random_Get(0.5, 1.);
+
+			pPolygon->Add_Point(x +            d * cos(a), y +            d * sin(a));
+			pClip   ->Add_Point(x + r / 2. + d * cos(a + 0.1), y + r / 2. + d * sin(a + 0.1));
+		}
+	}
+
+	return( g_Polygons.Get_Count() == Count );
+}
+
+//---------------------------------------------------------
+bool		Create_Points	(int Count)
+{
+	Random_Seed(BENCH_SEED + 2);
+
+	g_Points.Create();
+	g_Points.Set_Name("Points");
+
+	double	Extent	= g_Size * 10.;
+
+	for(int i=0; i<Count; i++)
+	{
+		g_Points.Add_Point(Random_Get(0., Extent), Random_Get(0., Extent), Random_Get(0., 1000.));
+	}
+
+	return( g_Points.Get_Count() == Count );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//						Benchmarks						 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool		Bench_Grid_Save			(double &Items)
+{
+	Items	= (double)g_DEM.Get_NCells();
+
+	return( g_DEM.Save(SG_File_Make_Path(g_Temp, "dem", "sg-grd-z")) );
+}
+
+//---------------------------------------------------------
+bool		Bench_Grid_Load			(double &Items)
+{
+	CSG_Grid	Grid;
+
+	if( !Grid.Create(SG_File_Make_Path(g_Temp, "dem", "sg-grd-z")) )
+	{
+		return( false );
+	}
+
+	Items	= (double)Grid.Get_NCells();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool		Bench_Grid_Index		(double &Items)
+{
+	g_DEM.Set_Index(false);
+
+	Items	= (double)g_DEM.Get_NCells();
+
+	return( g_DEM.Set_Index(true) );
+}
+
+//---------------------------------------------------------
+bool		Bench_Grid_Statistics	(double &Items)
+{
+	g_DEM.Set_Modified();	// forces On_Update()
+
+	Items	= (double)g_DEM.Get_NCells();
+
+	return( g_DEM.Get_StdDev() > 0. );
+}
+
+//---------------------------------------------------------
+bool		Bench_KDTree_Build		(double &Items)
+{
+	Items	= (double)g_Points.Get_Count();
+
+	return( g_Search.Create(&g_Points) );
+}
+
+//---------------------------------------------------------
+bool		Bench_KDTree_Search		(double &Items)
+{
+	if( g_Search.Get_Point_Count() < 1 && !g_Search.Create(&g_Points) )
+	{
+		return( false );
+	}
+
+	double	Sum	= 0.;
+
+	#pragma omp parallel for reduction(+:Sum)
+	for(sLong i=0; i<g_Points.Get_Count(); i++)
+	{
+		size_t	Index[16];	double	Distance[16];
+
+		size_t	n	= g_Search.Get_Nearest_Points(g_Points.Get_X(i), g_Points.Get_Y(i), 16, Index, Distance);
+
+		Sum	+= n > 0 ? Distance[n - 1] : 0.;
+	}
+
+	Items	= (double)g_Points.Get_Count();
+
+	return( Sum > 0. );
+}
+
+//---------------------------------------------------------
+bool		Bench_Clipper			(double &Items)
+{
+	double	Area	= 0.;
+
+	#pragma omp parallel for reduction(+:Area)
+	for(sLong i=0; i<g_Polygons.Get_Count(); i++)
+	{
+		CSG_Shapes	Result(SHAPE_TYPE_Polygon);	CSG_Shape *pResult = Result.Add_Shape();
+
+		if( SG_Shape_Get_Intersection(g_Polygons.Get_Shape(i), g_Clips.Get_Shape(i)->asPolygon(), pResult) )
+		{
+			Area	+= pResult->asPolygon()->Get_Area();
+		}
+	}
+
+	Items	= (double)g_Polygons.Get_Count();
+
+	return( Area > 0. );
+}
+
+//---------------------------------------------------------
+bool		Bench_Formula			(double &Items)
+{
+	CSG_Formula	Formula;
+
+	if( !Formula.Set_Formula("sqrt(x * x + 1) * sin(x / 100) + ln(abs(x) + 1) - pow(x, 0.5) / (1 + x)") )
+	{
+		return( false );
+	}
+
+	double	Sum	= 0.;
+
+	#pragma omp parallel for reduction(+:Sum)
+	for(sLong i=0; i<g_DEM.Get_NCells(); i++)
+	{
+		Sum	+= Formula.Get_Value(g_DEM.asDouble(i) + 1000.);
+	}
+
+	Items	= (double)g_DEM.Get_NCells();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool		Bench_Tool_Fill_Sinks	(double &Items)
+{
+	bool	bResult;	CSG_Grid Filled(g_DEM.Get_System());
+
+	SG_RUN_TOOL(bResult, "ta_preprocessor", 5,	// Fill Sinks XXL (Wang & Liu)
+			SG_TOOL_PARAMETER_SET("ELEV"    , &g_DEM )
+		&&	SG_TOOL_PARAMETER_SET("FILLED"  , &Filled)
+		&&	SG_TOOL_PARAMETER_SET("MINSLOPE", 0.01   )
+	);
+
+	Items	= (double)g_DEM.Get_NCells();
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+bool		Bench_Tool_Flow			(double &Items)
+{
+	bool	bResult;	CSG_Grid Flow(g_DEM.Get_System());
+
+	SG_RUN_TOOL(bResult, "ta_hydrology", 0,	// Flow Accumulation (Top-Down)
+			SG_TOOL_PARAMETER_SET("ELEVATION", &g_DEM)
+		&&	SG_TOOL_PARAMETER_SET("FLOW"     , &Flow )
+		&&	SG_TOOL_PARAMETER_SET("METHOD"   , 4     )	// Multiple Flow Direction
+	);
+
+	Items	= (double)g_DEM.Get_NCells();
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+bool		Bench_Tool_Filter		(double &Items)
+{
+	bool	bResult;	CSG_Grid Result(g_DEM.Get_System());
+
+	SG_RUN_TOOL(bResult, "grid_filter", 0,	// Simple Filter
+			SG_TOOL_PARAMETER_SET("INPUT" , &g_DEM )
+		&&	SG_TOOL_PARAMETER_SET("RESULT", &Result)
+		&&	SG_TOOL_PARAMETER_SET("METHOD", 0      )	// Smooth
+	);
+
+	Items	= (double)g_DEM.Get_NCells();
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+const TBench	g_Benchmarks[]	=
+{
+	{ "grid_save"      , false, Bench_Grid_Save      , "cells"    },
+	{ "grid_load"      , false, Bench_Grid_Load      , "cells"    },
+	{ "grid_index"     , false, Bench_Grid_Index     , "cells"    },
+	{ "grid_statistics", true , Bench_Grid_Statistics, "cells"    },
+	{ "kdtree_build"   , false, Bench_KDTree_Build   , "points"   },
+	{ "kdtree_search"  , true , Bench_KDTree_Search  , "points"   },
+	{ "clipper"        , true , Bench_Clipper        , "polygons" },
+	{ "formula"        , true , Bench_Formula        , "cells"    },
+	{ "tool_fill_sinks", true , Bench_Tool_Fill_Sinks, "cells"    },
+	{ "tool_flow"      , true , Bench_Tool_Flow      , "cells"    },
+	{ "tool_filter"    , true , Bench_Tool_Filter    , "cells"    },
+	{ NULL             , false, NULL                 , NULL       }
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool		Run_Benchmark	(const TBench &Bench, int nThreads)
+{
+	SG_OMP_Set_Max_Num_Threads(nThreads);
+
+	sLong	Memory	= SG_Profile_Get_Memory();
+
+	double	Wall = -1., CPU = 0., Items = 0.;	bool bResult = true;
+
+	for(int i=0; bResult && i<g_Repeat; i++)
+	{
+		double	t	= SG_Profile_Get_Time(), c = SG_Profile_Get_CPU_Time();
+
+		bResult	= Bench.Function(Items);
+
+		t	= SG_Profile_Get_Time() - t;
+
+		if( Wall < 0. || t < Wall )
+		{
+			Wall	= t;	CPU	= SG_Profile_Get_CPU_Time() - c;
+		}
+	}
+
+	Memory	= SG_Profile_Get_Memory() - Memory;
+
+	double	Throughput	= bResult && Wall > 0. ? Items / Wall : 0.;
+
+	//-----------------------------------------------------
+	SG_UI_Console_Print_StdOut(CSG_String::Format("%-16s %3d %12.4f %12.4f %14.0f %-8s %10lld %10lld%s",
+		CSG_String(Bench.ID).c_str(), nThreads, Wall, CPU, Throughput, CSG_String(Bench.Unit).c_str(),
+		Memory / N_MEGABYTE_BYTES, SG_Profile_Get_Memory_Peak() / N_MEGABYTE_BYTES, bResult ? SG_T("") : SG_T(" (failed)")
+	));
+
+	g_Results	+= CSG_String::Format("    { \"id\": \"%s\", \"threads\": %d, \"success\": %s, \"wall_time\": %f, \"cpu_time\": %f, \"items\": %.0f, \"unit\": \"%s\", \"throughput\": %f, \"memory_delta\": %lld, \"memory_peak\": %lld }",
+		CSG_String(Bench.ID).c_str(), nThreads, bResult ? SG_T("true") : SG_T("false"), bResult ? Wall : 0., bResult ? CPU : 0.,
+		Items, CSG_String(Bench.Unit).c_str(), Throughput, Memory, SG_Profile_Get_Memory_Peak()
+	);
+
+	return( bResult );
+}
+
+//---------------------------------------------------------
+bool		Write_Results	(void)
+{
+	if( g_Output.is_Empty() )
+	{
+		return( true );
+	}
+
+	CSG_File	Stream(g_Output.c_str(), SG_FILE_W, false);
+
+	if( !Stream.is_Writing() )
+	{
+		SG_UI_Console_Print_StdErr(CSG_String::Format("%s: %s", _TL("could not create file"), g_Output.c_str()));
+
+		return( false );
+	}
+
+	CSG_String	Label(g_Label); Label.Replace("\\", "\\\\"); Label.Replace("\"", "\\\"");
+
+	Stream.Write("{\n");
+	Stream.Write(CSG_String::Format("  \"version\": \"%s\",\n", SAGA_VERSION));
+	Stream.Write(CSG_String::Format("  \"label\": \"%s\",\n"  , Label.c_str()));
+	Stream.Write(CSG_String::Format("  \"date\": \"%s\",\n"   , SG_Get_CurrentTimeStr().c_str()));
+	Stream.Write(CSG_String::Format("  \"seed\": %llu,\n"     , BENCH_SEED));
+	Stream.Write(CSG_String::Format("  \"size\": %d,\n"       , g_Size));
+	Stream.Write(CSG_String::Format("  \"repeat\": %d,\n"     , g_Repeat));
+	Stream.Write(CSG_String::Format("  \"processors\": %d,\n" , SG_OMP_Get_Max_Num_Procs()));
+	Stream.Write("  \"results\": [");
+
+	for(int i=0; i<g_Results.Get_Count(); i++)
+	{
+		Stream.Write(CSG_String::Format("%s\n%s", i > 0 ? SG_T(",") : SG_T(""), g_Results[i].c_str()));
+	}
+
+	Stream.Write(g_Results.Get_Count() > 0 ? "\n  ]\n}\n" : "]\n}\n");
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void		Print_Help		(void)
+{
+	SG_UI_Console_Print_StdOut(
+		"Usage: saga_bench [options]\n"
+		"  --size=<n>           grid dimension (n x n cells), default 1024; n x n / 16 points and n x 4 polygons are generated\n"
+		"  --threads=<n,...>    comma separated thread counts, default 1, 2, 4, ... up to the number of processors\n"
+		"  --repeat=<n>         repetitions per run, the best wall time is reported, default 3\n"
+		"  --filter=<text>      run only benchmarks with an identifier containing text\n"
+		"  --label=<text>       label stored with the results, e.g. a commit hash\n"
+		"  --output=<file>      write results as JSON\n"
+		"  --list               print the benchmark identifiers\n"
+		"  --help               print this help\n"
+	);
+}
+
+//---------------------------------------------------------
+bool		Get_Options		(int argc, char *argv[])
+{
+	for(int i=1; i<argc; i++)
+	{
+		CSG_String	Option(argv[i]), Key(Option.BeforeFirst('=')), Value(Option.AfterFirst('='));
+
+		if( !Key.Cmp("--size"   ) && Value.asInt(g_Size  ) && g_Size   >= 16 ) { continue; }
+		if( !Key.Cmp("--repeat" ) && Value.asInt(g_Repeat) && g_Repeat >=  1 ) { continue; }
+		if( !Key.Cmp("--filter" ) ) { g_Filter = Value; continue; }
+		if( !Key.Cmp("--label"  ) ) { g_Label  = Value; continue; }
+		if( !Key.Cmp("--output" ) ) { g_Output = Value; continue; }
+
+		if( !Key.Cmp("--threads") )
+		{
+			CSG_Strings	Threads	= SG_String_Tokenize(Value, ",");
+
+			for(int j=0, n; j<Threads.Get_Count(); j++)
+			{
+				if( Threads[j].asInt(n) && n > 0 )
+				{
+					g_Threads	+= n;
+				}
+			}
+
+			continue;
+		}
+
+		if( !Key.Cmp("--list") )
+		{
+			for(int j=0; g_Benchmarks[j].ID; j++)
+			{
+				SG_UI_Console_Print_StdOut(g_Benchmarks[j].ID);
+			}
+
+			return( false );
+		}
+
+		if( Key.Cmp("--help") && Key.Cmp("-h") )
+		{
+			SG_UI_Console_Print_StdErr(CSG_String::Format("%s: %s", _TL("invalid option"), Option.c_str()));
+		}
+
+		Print_Help();
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	if( g_Threads.Get_Size() < 1 )
+	{
+		int	nMax	= SG_OMP_Get_Max_Num_Procs();
+
+		for(int n=1; n<nMax; n*=2)
+		{
+			g_Threads	+= n;
+		}
+
+		g_Threads	+= nMax;
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool		Run				(int argc, char *argv[])
+{
+	setlocale(LC_NUMERIC, "C");
+
+	if( !Get_Options(argc, argv) )
+	{
+		return( true );
+	}
+
+	SG_Initialize_Environment(false, false, NULL, false); // tool libraries are loaded on demand
+
+	SG_UI_ProgressAndMsg_Lock(true);
+
+	//-----------------------------------------------------
+	g_Temp	= SG_File_Make_Path(SG_Dir_Get_Temp(), CSG_String::Format("saga_bench_%llu", (unsigned long long)SG_Profile_Get_Time()));
+
+	if( !SG_Dir_Create(g_Temp, true) )
+	{
+		SG_UI_Console_Print_StdErr(CSG_String::Format("%s: %s", _TL("could not create directory"), g_Temp.c_str()));
+
+		return( false );
+	}
+
+	double	Time	= SG_Profile_Get_Time();
+
+	if( !Create_DEM(g_Size) || !Create_Polygons(4 * g_Size) || !Create_Points(g_Size * g_Size / 16) )
+	{
+		SG_UI_Console_Print_StdErr(_TL("could not create test data"));
+
+		return( false );
+	}
+
+	SG_UI_Console_Print_StdOut(CSG_String::Format("SAGA %s, %d processors, %dx%d cells, %lld points, %lld polygons, data created in %.2fs\n",
+		SAGA_VERSION, SG_OMP_Get_Max_Num_Procs(), g_Size, g_Size, g_Points.Get_Count(), g_Polygons.Get_Count(), SG_Profile_Get_Time() - Time
+	));
+
+	SG_UI_Console_Print_StdOut(CSG_String::Format("%-16s %3s %12s %12s %14s %-8s %10s %10s",
+		SG_T("benchmark"), SG_T("thr"), SG_T("wall [s]"), SG_T("cpu [s]"), SG_T("items/s"), SG_T("unit"), SG_T("mem [MB]"), SG_T("peak [MB]")
+	));
+
+	//-----------------------------------------------------
+	bool	bResult	= true;
+
+	for(int i=0; g_Benchmarks[i].ID; i++)
+	{
+		if( !g_Filter.is_Empty() && CSG_String(g_Benchmarks[i].ID).Find(g_Filter) < 0 )
+		{
+			continue;
+		}
+
+		if( !g_Benchmarks[i].bParallel )
+		{
+			bResult	&= Run_Benchmark(g_Benchmarks[i], g_Threads[g_Threads.Get_Size() - 1]);
+		}
+		else for(sLong j=0; j<g_Threads.Get_Size(); j++)
+		{
+			bResult	&= Run_Benchmark(g_Benchmarks[i], g_Threads[j]);
+		}
+	}
+
+	SG_OMP_Set_Max_Num_Threads(SG_OMP_Get_Max_Num_Procs());
+
+	//-----------------------------------------------------
+	SG_Dir_Delete(g_Temp, true);
+
+	bResult	&= Write_Results();
+
+	SG_UI_ProgressAndMsg_Lock(false);
+
+	SG_Uninitialize_Environment();
+
+	return( bResult );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+int		main	(int argc, char *argv[])
+{
+	if( !wxInitialize() )
+	{
+		fprintf(stderr, "initialisation failed\n");
+
+		return( 1 );
+	}
+
+	wxTheApp->SetVendorName("www.saga-gis.org");
+	wxTheApp->SetAppName   ("saga_bench");
+
+#if !defined(_DEBUG)
+	wxSetAssertHandler(NULL); // disable all wx asserts in SAGA release builds
+#endif
+
+	bool	bResult	= Run(argc, argv);
+
+	fflush(stdout);
+	fflush(stderr);
+
+	wxUninitialize();
+
+	return( bResult ? 0 : 1 );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -77,6 +77,7 @@ bool		Check_Flags		(const CSG_String &Argument);
 void		Print_Libraries	(void);
 void		Print_Tools		(const CSG_String &Library);
 void		Print_Execution	(CSG_Tool *pTool);
+void		Print_Profile	(CSG_Tool *pTool, const CSG_Profile &Profile, bool bResult);
 
 void		Print_Logo		(void);
 void		Print_Get_Help	(void);
@@ -89,7 +90,9 @@ void		Create_Batch	(const CSG_String &File);
 void		Create_Docs		(const CSG_String &Directory);
 
 //---------------------------------------------------------
-CSG_String	m_Config_File;
+CSG_String	m_Config_File, m_Profile_File;
+
+CSG_Strings	m_Profiles;
 
 
 ///////////////////////////////////////////////////////////
@@ -238,9 +241,21 @@ bool		Execute(int argc, char *argv[])
 	//-----------------------------------------------------
 	Print_Execution(pTool);
 
-	CCMD_Tool CMD_Tool(pTool);
+	CCMD_Tool CMD_Tool(pTool); CSG_Profile Profile;	// command profile includes loading inputs and saving outputs
+
+	if( SG_Profile_is_Enabled() )
+	{
+		Profile.Start(pTool->Get_Name());
+	}
+
+	bool bResult = CMD_Tool.Execute(argc - 3, argv + 3);
 
-	return( CMD_Tool.Execute(argc - 3, argv + 3) );
+	if( Profile.Stop() )
+	{
+		Print_Profile(pTool, Profile, bResult);
+	}
+
+	return( bResult );
 }
 
 
@@ -575,6 +590,29 @@ bool		Check_Flags		(const CSG_String &Argument)
 		return( true );
 	}
 
+	//-----------------------------------------------------
+	else if( !s.Cmp("-m") || !s.Cmp("--memory") )
+	{
+		double	Budget;
+
+		if( CSG_String(Argument).AfterFirst('=').asDouble(Budget) )
+		{
+			SG_Data_Memory_Set_Budget_MB(Budget);
+		}
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	else if( !s.Cmp("-p") || !s.Cmp("--profile") )
+	{
+		m_Profile_File = CSG_String(Argument).AfterFirst('=');
+
+		SG_Profile_Set_Enabled(true);
+
+		return( true );
+	}
+
 	//-----------------------------------------------------
 	else if( !s.Cmp("-u") || !s.Cmp("--utf8") )
 	{
@@ -678,6 +716,40 @@ void		Print_Execution	(CSG_Tool *pTool)
 	}
 }
 
+//---------------------------------------------------------
+void		Print_Profile	(CSG_Tool *pTool, const CSG_Profile &Profile, bool bResult)
+{
+	CSG_String JSON("{\n");
+
+	JSON += CSG_String::Format("\"library\": %s,\n"      , SG_Profile_JSON_String(pTool->Get_Library()).c_str());
+	JSON += CSG_String::Format("\"tool\": %s,\n"         , SG_Profile_JSON_String(pTool->Get_ID     ()).c_str());
+	JSON += CSG_String::Format("\"success\": %s,\n"      , bResult ? SG_T("true") : SG_T("false"));
+	JSON += CSG_String::Format("\"command\": %s,\n"      , Profile.to_JSON().c_str());
+	JSON += CSG_String::Format("\"execution\": %s\n"     , pTool->Get_Profile().to_JSON().c_str());
+	JSON += "}";
+
+	m_Profiles += JSON;
+
+	//-----------------------------------------------------
+	if( m_Profile_File.is_Empty() )	// enclosed in tags to separate it from progress and messages
+	{
+		SG_UI_Console_Print_StdOut("\n<profile>\n" + JSON + "\n</profile>", '\n', true);
+	}
+	else	// (re-)write all runs so far, scripts might execute more than one tool
+	{
+		CSG_File Stream(m_Profile_File.c_str(), SG_FILE_W, false);
+
+		Stream.Write("[\n");
+
+		for(int i=0; i<m_Profiles.Get_Count(); i++)
+		{
+			Stream.Write(m_Profiles[i] + (i < m_Profiles.Get_Count() - 1 ? ",\n" : "\n"));
+		}
+
+		Stream.Write("]\n");
+	}
+}
+
 
 ///////////////////////////////////////////////////////////
 //                                                       //
@@ -741,14 +813,14 @@ void		Print_Help		(void)
 		"saga_cmd [-h, --help][<LIBRARY> <TOOL>]\n"
 		"saga_cmd [-v, --version]\n"
 #ifdef _OPENMP
-		"saga_cmd [-C, --config][=#][-s, --story][=#][-c, --cores][=#][-f, --flags][=#]\n"
+		"saga_cmd [-C, --config][=#][-s, --story][=#][-c, --cores][=#][-f, --flags][=#][-m, --memory][=#][-p, --profile][=#]\n"
 		"  <LIBRARY> <TOOL> <OPTIONS>\n"
-		"saga_cmd [-C, --config][=#][-s, --story][=#][-c, --cores][=#][-f, --flags][=#]\n"
+		"saga_cmd [-C, --config][=#][-s, --story][=#][-c, --cores][=#][-f, --flags][=#][-m, --memory][=#][-p, --profile][=#]\n"
 		"  <SCRIPT>\n"
 #else
-		"saga_cmd [-C, --config][=#][-s, --story][=#][-f, --flags][=#]\n"
+		"saga_cmd [-C, --config][=#][-s, --story][=#][-f, --flags][=#][-m, --memory][=#][-p, --profile][=#]\n"
 		"  <LIBRARY> <TOOL> <OPTIONS>\n"
-		"saga_cmd [-C, --config][=#][-s, --story][=#][-f, --flags][=#]\n"
+		"saga_cmd [-C, --config][=#][-s, --story][=#][-f, --flags][=#][-m, --memory][=#][-p, --profile][=#]\n"
 		"  <SCRIPT>\n"
 #endif
 		"\n"
@@ -764,6 +836,12 @@ void		Print_Help		(void)
 #ifdef _OPENMP
 		"[-c], [--cores]  : number of physical processors to use for computation\n"
 #endif
+		"[-m], [--memory] : memory budget for data in megabytes, least recently used\n"
+		"                   grids and point clouds are spilled to disk, if exceeded\n"
+		"                   (default is 0, i.e. no limit)\n"
+		"[-p], [--profile]: report run time, memory and i/o statistics as JSON,\n"
+		"                   either to the given file or to standard output, enclosed\n"
+		"                   in <profile></profile> tags\n"
 		"[-f], [--flags]  : various flags for general usage [qrsilx]\n"
 		"  q              : no progress report\n"
 		"  r              : no messages report\n"
@@ -157,6 +157,11 @@ bool CCMD_Tool::Execute(int argc, char *argv[])
 		m_pTool->On_After_Execution();
 	}
 
+	if( SG_Data_Memory_Get_Budget() > 0 && CMD_Get_Show_Messages() )
+	{
+		CMD_Print(SG_Data_Memory_Get_Report());
+	}
+
 	CMD_Set_Tool(NULL);
 
 	//-----------------------------------------------------
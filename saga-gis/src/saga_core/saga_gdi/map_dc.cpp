@@ -271,6 +271,57 @@ bool CSG_Map_DC::Draw_Layer_End(double Transparency)
 	return( false );
 }
 
+//---------------------------------------------------------
+bool CSG_Map_DC::Draw_Layer_Get(wxBitmap &Layer, wxBitmap &Mask)
+{
+	if( !m_bmp_layer.IsOk() || !m_bmp_mask.IsOk() )
+	{
+		return( false );
+	}
+
+	m_dc.SelectObject(m_bmp); m_dc_mask.SelectObject(wxNullBitmap);
+
+	Layer = m_bmp_layer; m_bmp_layer = wxNullBitmap;
+	Mask  = m_bmp_mask ; m_bmp_mask  = wxNullBitmap;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CSG_Map_DC::Draw_Layer_Put(const wxBitmap &Layer, const wxBitmap &Mask, int x, int y)
+{
+	if( !Layer.IsOk() || !Mask.IsOk() || !m_dc_mask.IsOk() )
+	{
+		return( false );
+	}
+
+	m_dc     .DrawBitmap(Layer, x, y);
+	m_dc_mask.DrawBitmap(Mask , x, y);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+int CSG_Map_DC::_Get_Points(CSG_Shape *pShape, int iPart, wxPoint *Points, int xOffset, int yOffset)
+{
+	int n = 0;
+
+	for(int iPoint=0; iPoint<pShape->Get_Point_Count(iPart); iPoint++)
+	{
+		TSG_Point p = pShape->Get_Point(iPoint, iPart);
+
+		int x = xOffset + (int)xWorld2DC(p.x);
+		int y = yOffset + (int)yWorld2DC(p.y);
+
+		if( n == 0 || x != Points[n - 1].x || y != Points[n - 1].y ) // skip vertices falling onto the previous pixel
+		{
+			Points[n].x = x; Points[n].y = y; n++;
+		}
+	}
+
+	return( n );
+}
+
 //---------------------------------------------------------
 void CSG_Map_DC::Draw_Polygon(CSG_Shape_Polygon *pPolygon)
 {
@@ -281,45 +332,56 @@ void CSG_Map_DC::Draw_Polygon(CSG_Shape_Polygon *pPolygon)
 			(int)xWorld2DC(pPolygon->Get_Extent().Get_XCenter()),
 			(int)yWorld2DC(pPolygon->Get_Extent().Get_YCenter())
 		);
+
+		return;
 	}
 
 	//-----------------------------------------------------
-	else if( pPolygon->Get_Part_Count() == 1 && pPolygon->Get_Point_Count(0) > 2 )
+	m_Points .Set_Array(pPolygon->Get_Point_Count(), false); wxPoint *Points = (wxPoint *)m_Points .Get_Array();
+	m_nPoints.Set_Array(pPolygon->Get_Part_Count (), false); int    *nPoints = (int     *)m_nPoints.Get_Array();
+
+	int nParts = 0;
+
+	for(int iPart=0, n=0; iPart<pPolygon->Get_Part_Count(); iPart++)
 	{
-		wxPoint	*Points	= new wxPoint[pPolygon->Get_Point_Count()];
+		int nPoints_Part = _Get_Points(pPolygon, iPart, Points + n);
 
-		for(int iPoint=0; iPoint<pPolygon->Get_Point_Count(0); iPoint++)
+		if( nPoints_Part > 2 ) // rings collapsing to less than three pixels are not drawn
 		{
-			Points[iPoint].x = (int)xWorld2DC(pPolygon->Get_Point(iPoint, 0).x);
-			Points[iPoint].y = (int)yWorld2DC(pPolygon->Get_Point(iPoint, 0).y);
+			nPoints[nParts++] = nPoints_Part; n += nPoints_Part;
 		}
-
-		DrawPolygon(pPolygon->Get_Point_Count(), Points);
-
-		delete[](Points);
 	}
 
-	//-----------------------------------------------------
-	else if( pPolygon->Get_Part_Count() > 1 )
+	if( nParts == 1 )
+	{
+		DrawPolygon(nPoints[0], Points);
+	}
+	else if( nParts > 1 )
 	{
-		wxPoint *Points = new wxPoint[pPolygon->Get_Point_Count()];
-		int    *nPoints = new int    [pPolygon->Get_Part_Count ()];
+		DrawPolyPolygon(nParts, nPoints, Points, 0, 0, wxODDEVEN_RULE);
+	}
+}
 
-		for(int iPart=0, jPoint=0; iPart<pPolygon->Get_Part_Count(); iPart++)
+//---------------------------------------------------------
+void CSG_Map_DC::Draw_Line(CSG_Shape *pLine, int xOffset, int yOffset)
+{
+	for(int iPart=0; iPart<pLine->Get_Part_Count(); iPart++)
+	{
+		if( pLine->Get_Point_Count(iPart) > 1 )
 		{
-			nPoints[iPart] = pPolygon->Get_Point_Count(iPart);
+			m_Points.Set_Array(pLine->Get_Point_Count(iPart), false); wxPoint *Points = (wxPoint *)m_Points.Get_Array();
 
-			for(int iPoint=0; iPoint<pPolygon->Get_Point_Count(iPart); iPoint++, jPoint++)
+			int n = _Get_Points(pLine, iPart, Points, xOffset, yOffset);
+
+			if( n > 1 )
+			{
+				DrawLines(n, Points);
+			}
+			else
 			{
-				Points[jPoint].x = (int)xWorld2DC(pPolygon->Get_Point(iPoint, iPart).x);
-				Points[jPoint].y = (int)yWorld2DC(pPolygon->Get_Point(iPoint, iPart).y);
+				DrawPoint(Points[0].x, Points[0].y);
 			}
 		}
-
-		DrawPolyPolygon(pPolygon->Get_Part_Count(), nPoints, Points, 0, 0, wxODDEVEN_RULE);
-
-		delete[]( Points);
-		delete[](nPoints);
 	}
 }
 
@@ -554,6 +616,17 @@ void CSG_Map_DC::DrawPolyPolygon(int n, const int count[], const wxPoint points[
 	}
 }
 
+//---------------------------------------------------------
+void CSG_Map_DC::DrawLines(int n, const wxPoint points[], int xoffset, int yoffset)
+{
+	m_dc.DrawLines(n, points, xoffset, yoffset);
+
+	if( m_dc_mask.IsOk() )
+	{
+		m_dc_mask.DrawLines(n, points, xoffset, yoffset);
+	}
+}
+
 //---------------------------------------------------------
 void CSG_Map_DC::DrawBitmap(const wxBitmap &bitmap, int x, int y, bool useMask)
 {
@@ -105,6 +105,7 @@ public:
 	void						DrawArc					(int xStart, int yStart, int xEnd, int yEnd, int xc, int yc);
 	void						DrawPolygon				(int n, const wxPoint points[], int xoffset = 0, int yoffset = 0, wxPolygonFillMode fill_style = wxODDEVEN_RULE);
 	void						DrawPolyPolygon			(int n, const int count[], const wxPoint points[], int xoffset = 0, int yoffset = 0, wxPolygonFillMode fill_style = wxODDEVEN_RULE);
+	void						DrawLines				(int n, const wxPoint points[], int xoffset = 0, int yoffset = 0);
 	void						DrawBitmap				(const wxBitmap &bitmap, int x, int y, bool useMask = false);
 
 	void						DrawText				(int Align, int x, int y              , const wxString &Text);
@@ -163,8 +164,11 @@ public:
 	//-----------------------------------------------------
 	bool						Draw_Layer_Begin		(void);
 	bool						Draw_Layer_End			(double Transparency = 0.);
+	bool						Draw_Layer_Get			(wxBitmap &Layer, wxBitmap &Mask);
+	bool						Draw_Layer_Put			(const wxBitmap &Layer, const wxBitmap &Mask, int x, int y);
 
 	void						Draw_Polygon			(CSG_Shape_Polygon *pPolygon);
+	void						Draw_Line				(CSG_Shape         *pLine, int xOffset = 0, int yOffset = 0);
 
 	//-----------------------------------------------------
 	bool						Draw_Image_Begin		(double Transparency, Mode Mode = Mode::Transparent);
@@ -190,7 +194,9 @@ private:
 
 	double						m_World2DC { 1. }, m_DC2World { 1. }, m_Opacity { 1. }, m_Scale { 1. };
 
-	CSG_Array					m_Mask;
+	CSG_Array					m_Mask, m_Points { sizeof(wxPoint) };
+
+	CSG_Array_Int				m_nPoints;
 
 	CSG_Rect					m_rWorld;
 
@@ -203,6 +209,10 @@ private:
 	wxMemoryDC					m_dc, m_dc_mask;
 
 
+	//-----------------------------------------------------
+	int							_Get_Points				(CSG_Shape *pShape, int iPart, wxPoint *Points, int xOffset = 0, int yOffset = 0);
+
+
 	//-----------------------------------------------------
 	void						_Draw_Image_Pixel		(int i, int Color)
 	{
@@ -671,19 +671,19 @@ bool CSGDI_Classify::Classify_Natural(int Count)
 		return( false );
 	}
 
-	CSG_Natural_Breaks Breaks;
+	CSG_Natural_Breaks Breaks; int Histogram = m_nValues > 262144 ? 65536 : 0;	// exact up to 2^18 values, else use a fine weighted histogram
 
 	if( m_Field >= 0 )
 	{
-		Breaks.Create(m_pObject->asTable(true), m_Field, Count, m_nValues > 4096 ? 256 : 0);
+		Breaks.Create(m_pObject->asTable(true), m_Field, Count, Histogram);
 	}
 	else if( m_pObject->asGrid () )
 	{
-		Breaks.Create(m_pObject->asGrid (), Count, m_nValues > 4096 ? 256 : 0);
+		Breaks.Create(m_pObject->asGrid (), Count, Histogram);
 	}
 	else if( m_pObject->asGrids() )
 	{
-		Breaks.Create(m_pObject->asGrids(), Count, m_nValues > 4096 ? 256 : 0);
+		Breaks.Create(m_pObject->asGrids(), Count, Histogram);
 	}
 	else
 	{
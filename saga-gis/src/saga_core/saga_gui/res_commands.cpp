@@ -151,6 +151,7 @@ wxString CMD_Get_Name(int Cmd_ID)
 	case ID_CMD_DATA_PROJECT_COPY_DB         : return( _TL("Copy Project to Database") );
 
 	case ID_CMD_DATA_MANAGER_LIST            : return( _TL("Data Manager's Summary") );
+	case ID_CMD_DATA_MEMORY_REPORT           : return( _TL("Memory Report") );
 
 	case ID_CMD_DATA_LEGEND_COPY             : return( _TL("Copy Legend to Clipboard") );
 	case ID_CMD_DATA_LEGEND_SIZE_INC         : return( _TL("Increase Legend Size") );
@@ -153,6 +153,7 @@ enum ID_COMMANDS
 	ID_CMD_DATA_PROJECT_COPY_DB,
 
 	ID_CMD_DATA_MANAGER_LIST,
+	ID_CMD_DATA_MEMORY_REPORT,
 
 	ID_CMD_DATA_LEGEND_COPY,
 	ID_CMD_DATA_LEGEND_SIZE_INC,
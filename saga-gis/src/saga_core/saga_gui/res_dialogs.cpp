@@ -215,6 +215,7 @@ bool DLG_Get_FILE_Filter_GDAL_Read(int Type, wxString &Filter)
 	if( Type == 2 || Type == 1 )	// vector
 	{
 		ADD_FILTER("shp"     );
+		ADD_FILTER("sg-shp"  );
 		ADD_FILTER("json"    );
 		ADD_FILTER("geojson" );
 	}
@@ -254,6 +255,7 @@ wxString DLG_Get_FILE_Filter(int ID_DLG)
 			"%s (*.sgrd, *.sg-grd-z)|*.sgrd;*.sg-grd;*.sg-grd-z;*.dgm;*.grd|"
 			"%s (*.sg-gds, *.sg-gds-z)|*.sg-gds;*.sg-gds-z|"
 			"%s (*.shp)|*.shp|"
+			"%s (*.sg-shp)|*.sg-shp|"
 			"%s (*.sg-pts, *.sg-pts-z)|*.sg-pts;*.sg-pts-z;*.spc|"
 			"%s (*.txt, *.csv, *.dbf)|*.txt;*.csv;*.dbf|"
 			"%s|*.*",
@@ -263,6 +265,7 @@ wxString DLG_Get_FILE_Filter(int ID_DLG)
 			_TL("SAGA Grids"),
 			_TL("SAGA Grid Collections"),
 			_TL("ESRI Shape Files"),
+			_TL("SAGA Vector Files"),
 			_TL("SAGA Point Clouds"),
 			_TL("Tables"),
 			_TL("All Files")
@@ -403,9 +406,11 @@ wxString DLG_Get_FILE_Filter(int ID_DLG)
 		return( wxString::Format(
 			"%s|%s|"
 			"%s (*.shp)|*.shp|"
+			"%s (*.sg-shp)|*.sg-shp|"
 			"%s|*.*",
 			_TL("Recognized Files"), Recognized.c_str(),
 			_TL("ESRI Shape Files"),
+			_TL("SAGA Vector Files"),
 			_TL("All Files")
 		));
 
@@ -417,10 +422,12 @@ wxString DLG_Get_FILE_Filter(int ID_DLG)
 				"%s (*.shp)|*.shp|"
 				"%s (*.gpkg)|*.gpkg|"
 				"%s (*.geojson)|*.geojson|"
+				"%s (*.sg-shp)|*.sg-shp|"
 				"%s|*.*",
 				_TL("ESRI Shape Files"),
 				_TL("GeoPackage Files"),
 				_TL("GeoJSON Files"),
+				_TL("SAGA Vector Files"),
 				_TL("All Files")
 			));
 
@@ -429,10 +436,12 @@ wxString DLG_Get_FILE_Filter(int ID_DLG)
 				"%s (*.gpkg)|*.gpkg|"
 				"%s (*.shp)|*.shp|"
 				"%s (*.geojson)|*.geojson|"
+				"%s (*.sg-shp)|*.sg-shp|"
 				"%s|*.*",
 				_TL("GeoPackage Files"),
 				_TL("ESRI Shape Files"),
 				_TL("GeoJSON Files"),
+				_TL("SAGA Vector Files"),
 				_TL("All Files")
 			));
 
@@ -441,10 +450,26 @@ wxString DLG_Get_FILE_Filter(int ID_DLG)
 				"%s (*.geojson)|*.geojson|"
 				"%s (*.shp)|*.shp|"
 				"%s (*.gpkg)|*.gpkg|"
+				"%s (*.sg-shp)|*.sg-shp|"
 				"%s|*.*",
 				_TL("GeoJSON Files"),
 				_TL("ESRI Shape Files"),
 				_TL("GeoPackage Files"),
+				_TL("SAGA Vector Files"),
+				_TL("All Files")
+			));
+
+		case SHAPE_FILE_FORMAT_Native    :	// SAGA Vector (*.sg-shp)
+			return( wxString::Format(
+				"%s (*.sg-shp)|*.sg-shp|"
+				"%s (*.shp)|*.shp|"
+				"%s (*.gpkg)|*.gpkg|"
+				"%s (*.geojson)|*.geojson|"
+				"%s|*.*",
+				_TL("SAGA Vector Files"),
+				_TL("ESRI Shape Files"),
+				_TL("GeoPackage Files"),
+				_TL("GeoJSON Files"),
 				_TL("All Files")
 			));
 		}
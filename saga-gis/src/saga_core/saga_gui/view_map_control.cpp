@@ -51,6 +51,7 @@
 #include <wx/dcclient.h>
 
 #include <saga_gdi/sgdi_helper.h>
+#include <saga_gdi/map_dc.h>
 
 #include "res_images.h"
 
@@ -103,6 +104,8 @@ BEGIN_EVENT_TABLE(CVIEW_Map_Control, wxPanel)
 	EVT_MIDDLE_DOWN			(CVIEW_Map_Control::On_Mouse_MDown)
 	EVT_MIDDLE_UP			(CVIEW_Map_Control::On_Mouse_MUp)
 	EVT_MOUSE_CAPTURE_LOST	(CVIEW_Map_Control::On_Mouse_Lost)
+
+	EVT_TIMER				(wxID_ANY, CVIEW_Map_Control::On_Render_Timer)
 END_EVENT_TABLE()
 
 
@@ -123,11 +126,17 @@ CVIEW_Map_Control::CVIEW_Map_Control(CVIEW_Map *pParent, CWKSP_Map *pMap)
 	m_Drag_Mode = TOOL_INTERACTIVE_DRAG_NONE;
 
 	m_CrossHair.x = m_CrossHair.y = -1;
+
+	m_Render_Timer.SetOwner(this);
 }
 
 //---------------------------------------------------------
 CVIEW_Map_Control::~CVIEW_Map_Control(void)
-{}
+{
+	m_Render_Timer.Stop();
+
+	delete(m_pRender);
+}
 
 
 ///////////////////////////////////////////////////////////
@@ -561,9 +570,18 @@ bool CVIEW_Map_Control::_Update_Bitmap_Size(void)
 	{
 		if( !m_Bitmap.Ok() || m_Bitmap.GetWidth() != r.GetWidth() || m_Bitmap.GetHeight() != r.GetHeight() )
 		{
+			if( m_Render_bLock )
+			{
+				m_Render_bRestart = true;
+
+				return( m_Bitmap.Ok() );
+			}
+
+			wxBitmap Previous(m_Bitmap);
+
 			m_Bitmap.Create(r.GetWidth(), r.GetHeight());
 
-			Refresh_Map();
+			_Render_Start(Previous);
 		}
 
 		return( m_Bitmap.Ok() );
@@ -577,16 +595,169 @@ void CVIEW_Map_Control::Refresh_Map(void)
 {
 	if( m_Bitmap.Ok() )
 	{
-		wxMemoryDC dc(m_Bitmap);
+		_Render_Start(m_Bitmap);
+	}
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// The map is rendered layer by layer in short time slices,
+// returning to the event loop in between, so that the view
+// stays responsive. A refresh request cancels a running job
+// and starts over. Layers that did not change are restored
+// from the map's draw cache. Until the new image is ready,
+// the previous one is shown scaled to the new extent and,
+// for slow maps, partial results are shown progressively.
+//---------------------------------------------------------
+#define RENDER_SLICE	 50	// [ms] drawing time before giving control back to the event loop
+#define RENDER_PARTIAL	500	// [ms] jobs running longer show their partial results
+#define RENDER_SNAPSHOT	 20	// [ms] drawing time that makes a snapshot worth caching
+
+//---------------------------------------------------------
+void CVIEW_Map_Control::_Render_Start(const wxBitmap &Previous)
+{
+	if( m_Render_bLock )	// requested while drawing a layer, e.g. from a progress update
+	{
+		m_Render_bRestart = true;
+
+		return;
+	}
+
+	m_Render_Timer.Stop();
+
+	delete(m_pRender);	// cancel a running job
+
+	m_pRender = new CSG_Map_DC(m_pMap->Get_World(m_Bitmap.GetSize()), m_Bitmap.GetSize(), 1., m_pMap->Get_Background().GetRGB());
+
+	if( !m_Bitmap_World.is_Equal(m_pRender->rWorld()) )
+	{
+		_Render_Preview(Previous);
+	}
+
+	m_Render_Step = m_pMap->Draw_Cache_Restore(*m_pRender);
+	m_Render_Cost = 0;
+	m_Render_Time.Start();
+
+	m_pParent->Ruler_Refresh();
+
+	_Render();
+}
+
+//---------------------------------------------------------
+void CVIEW_Map_Control::_Render_Preview(const wxBitmap &Previous)
+{
+	const CSG_Rect &rWorld = m_pRender->rWorld();
+
+	wxBitmap Preview(m_Bitmap.GetSize()); wxMemoryDC dc(Preview);
+
+	dc.SetBackground(m_pMap->Get_Background()); dc.Clear();
+
+	CSG_Rect r(m_Bitmap_World);
+
+	if( Previous.IsOk() && m_Bitmap_World.Get_XRange() > 0. && r.Intersect(rWorld) )
+	{
+		double dPrevious = m_Bitmap_World.Get_XRange() / Previous.GetWidth(), dPreview = m_pRender->DC2World();
+
+		int xs = (int)((r.Get_XMin() - m_Bitmap_World.Get_XMin()) / dPrevious), ws = (int)(r.Get_XRange() / dPrevious);
+		int ys = (int)((m_Bitmap_World.Get_YMax() - r.Get_YMax()) / dPrevious), hs = (int)(r.Get_YRange() / dPrevious);
+		int xd = (int)((r.Get_XMin() - rWorld.Get_XMin()) / dPreview), wd = (int)(r.Get_XRange() / dPreview);
+		int yd = (int)((rWorld.Get_YMax() - r.Get_YMax()) / dPreview), hd = (int)(r.Get_YRange() / dPreview);
+
+		if( ws > 0 && hs > 0 && wd > 0 && hd > 0 )
+		{
+			wxMemoryDC dc_Previous; dc_Previous.SelectObjectAsSource(Previous);
+
+			dc.StretchBlit(xd, yd, wd, hd, &dc_Previous, xs, ys, ws, hs);
+		}
+	}
+
+	dc.SelectObject(wxNullBitmap);
+
+	m_Bitmap       = Preview;
+	m_Bitmap_World = rWorld;
+
+	Refresh(false);
+}
+
+//---------------------------------------------------------
+void CVIEW_Map_Control::_Render(void)
+{
+	if( !m_pRender )
+	{
+		return;
+	}
 
-		m_pMap->Draw_Map(dc, 1., m_Bitmap.GetSize());
+	//-----------------------------------------------------
+	wxStopWatch Slice;
+
+	while( m_Render_Step < m_pMap->Draw_Map_Steps() && Slice.Time() < RENDER_SLICE )
+	{
+		wxStopWatch Step;
+
+		m_Render_bLock = true;
+		m_pMap->Draw_Map_Step(*m_pRender, m_Render_Step);
+		m_Render_bLock = false;
+
+		if( m_Render_bRestart )
+		{
+			m_Render_bRestart = false;
 
-		m_pParent->Ruler_Refresh();
+			wxSize Size(GetClientSize());
+
+			if( Size.x > 0 && Size.y > 0 && Size != m_Bitmap.GetSize() )
+			{
+				_Update_Bitmap_Size();	// recreates the bitmap and restarts
+			}
+			else
+			{
+				_Render_Start(m_Bitmap);
+			}
+
+			return;
+		}
+
+		m_Render_Cost += Step.Time();
+
+		m_pMap->Draw_Cache_Store(*m_pRender, m_Render_Step++, 0, m_Render_Cost >= RENDER_SNAPSHOT);
+
+		if( m_Render_Cost >= RENDER_SNAPSHOT )
+		{
+			m_Render_Cost = 0;
+		}
+	}
+
+	//-----------------------------------------------------
+	if( m_Render_Step < m_pMap->Draw_Map_Steps() )
+	{
+		if( m_Render_Time.Time() > RENDER_PARTIAL )
+		{
+			m_Bitmap = m_pRender->Get_Bitmap(); m_Bitmap_World = m_pRender->rWorld();
+
+			Refresh(false);
+		}
+
+		m_Render_Timer.StartOnce(1);	// continue with the next slice after pending events have been processed
+	}
+	else
+	{
+		m_Bitmap = m_pRender->Get_Bitmap(); m_Bitmap_World = m_pRender->rWorld();
+
+		delete(m_pRender); m_pRender = NULL;
 
 		Refresh(false);
 	}
 }
 
+//---------------------------------------------------------
+void CVIEW_Map_Control::On_Render_Timer(wxTimerEvent &event)
+{
+	_Render();
+}
+
 
 ///////////////////////////////////////////////////////////
 //                                                       //
@@ -61,6 +61,8 @@
 //---------------------------------------------------------
 #include <wx/panel.h>
 #include <wx/bitmap.h>
+#include <wx/timer.h>
+#include <wx/stopwatch.h>
 
 #include <saga_api/saga_api.h>
 
@@ -194,6 +196,8 @@ public:
 
 	void						On_Mouse_Lost		(wxMouseCaptureLostEvent &event);
 
+	void						On_Render_Timer		(wxTimerEvent &event);
+
 	void						Set_CrossHair		(const TSG_Point &Point);
 	void						Set_CrossHair_Off	(void);
 
@@ -205,12 +209,24 @@ public:
 
 private:
 
-	int							m_Mode, m_Mode_Previous, m_Drag_Mode;
+	bool						m_Render_bLock { false }, m_Render_bRestart { false };
+
+	int							m_Mode, m_Mode_Previous, m_Drag_Mode, m_Render_Step { 0 };
+
+	long						m_Render_Cost { 0 };
 
 	wxPoint						m_Mouse_Down, m_Mouse_Move, m_CrossHair;
 	
 	wxBitmap					m_Bitmap;
 
+	CSG_Rect					m_Bitmap_World;
+
+	wxTimer						m_Render_Timer;
+
+	wxStopWatch					m_Render_Time;
+
+	class CSG_Map_DC			*m_pRender { NULL };
+
 	CMeasure					m_Measure;
 
 	class CVIEW_Map				*m_pParent;
@@ -222,6 +238,10 @@ private:
 
 	bool						_Update_Bitmap_Size	(void);
 
+	void						_Render_Start		(const wxBitmap &Previous);
+	void						_Render_Preview		(const wxBitmap &Previous);
+	void						_Render				(void);
+
 	void						_Set_StatusBar		(const TSG_Point &Point);
 
 	wxPoint						_Get_World2Client	(const TSG_Point &Point);
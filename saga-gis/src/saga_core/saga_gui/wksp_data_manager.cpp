@@ -308,6 +308,21 @@ CWKSP_Data_Manager::CWKSP_Data_Manager(void)
 		NULL, SG_Grid_Cache_Get_Directory(), true, true
 	);
 
+	//-----------------------------------------------------
+	m_Parameters.Add_Node("", "NODE_MEMORY", _TL("Memory"), _TL(""));
+
+	m_Parameters.Add_Double("NODE_MEMORY",
+		"MEMORY_BUDGET"         , _TL("Memory Budget [MB]"),
+		_TL("If the memory used by grids and point clouds exceeds this budget, the least recently used data sets, that are not in use by a running tool, are moved to temporary files (see grid file cache settings) and paged back in on access. Zero means no limit."),
+		SG_Data_Memory_Get_Budget_MB(), 0., true
+	);
+
+	m_Parameters.Add_Double("MEMORY_BUDGET",
+		"MEMORY_SPILL_SIZE"     , _TL("Minimum Size [MB]"),
+		_TL("Data sets smaller than this are never moved to temporary files."),
+		(double)SG_Data_Memory_Get_Spill_Size() / N_MEGABYTE_BYTES, 0., true
+	);
+
 	//-----------------------------------------------------
 	m_Parameters.Add_Node("", "NODE_TABLE", _TL("Tables"), _TL(""));
 
@@ -347,10 +362,11 @@ CWKSP_Data_Manager::CWKSP_Data_Manager(void)
 	m_Parameters.Add_Choice("NODE_SHAPES",
 		"SHAPES_FMT_DEFAULT"    , _TL("Default Output Format"),
 		_TL(""),
-		CSG_String::Format("%s|%s|%s",
+		CSG_String::Format("%s|%s|%s|%s",
 			_TL("ESRI Shape File (*.shp)"),
 			_TL("GeoPackage (*.gpkg)"),
-			_TL("GeoJSON (*.geojson)")
+			_TL("GeoJSON (*.geojson)"),
+			_TL("SAGA Vector (*.sg-shp)")
 		), 0
 	);
 
@@ -363,6 +379,9 @@ CWKSP_Data_Manager::CWKSP_Data_Manager(void)
 	SG_Grid_Cache_Set_Threshold_MB   (m_Parameters("GRID_CACHE_THRSHLD"  )->asDouble());
 	SG_Grid_Cache_Set_Directory      (m_Parameters("GRID_CACHE_TMPDIR"   )->asString());
 
+	SG_Data_Memory_Set_Budget_MB     (m_Parameters("MEMORY_BUDGET"       )->asDouble());
+	SG_Data_Memory_Set_Spill_Size    ((sLong)(m_Parameters("MEMORY_SPILL_SIZE")->asDouble() * N_MEGABYTE_BYTES));
+
 	CSG_Grid_System::Set_Precision   (m_Parameters("GRID_COORD_PRECISION")->asInt   ());
 
 	SG_Set_History_Depth             (m_Parameters("HISTORY_DEPTH"       )->asInt   ());
@@ -380,6 +399,7 @@ CWKSP_Data_Manager::CWKSP_Data_Manager(void)
 	default: SG_Shapes_Set_File_Format_Default(SHAPE_FILE_FORMAT_ESRI      ); break;
 	case  1: SG_Shapes_Set_File_Format_Default(SHAPE_FILE_FORMAT_GeoPackage); break;
 	case  2: SG_Shapes_Set_File_Format_Default(SHAPE_FILE_FORMAT_GeoJSON   ); break;
+	case  3: SG_Shapes_Set_File_Format_Default(SHAPE_FILE_FORMAT_Native    ); break;
 	}
 }
 
@@ -567,6 +587,18 @@ wxString CWKSP_Data_Manager::Get_Description(void)
 
 	s	+= wxT("</table>");
 
+	//-----------------------------------------------------
+	s	+= wxString::Format("<hr><h4>%s</h4>", _TL("Memory"));
+
+	s	+= "<table border=\"0\">";
+
+	DESC_ADD_STR(_TL("Memory Budget"), SG_Data_Memory_Get_Budget() > 0 ? Get_nBytes_asString((double)SG_Data_Memory_Get_Budget(), 2) : wxString(_TL("no limit")));
+	DESC_ADD_STR(_TL("Grids"       ), Get_nBytes_asString((double)(SG_Data_Memory_Get_Size(SG_DATAOBJECT_TYPE_Grid) + SG_Data_Memory_Get_Size(SG_DATAOBJECT_TYPE_Grids)), 2));
+	DESC_ADD_STR(_TL("Point Clouds"), Get_nBytes_asString((double)SG_Data_Memory_Get_Size(SG_DATAOBJECT_TYPE_PointCloud), 2));
+	DESC_ADD_STR(_TL("Spilled to Disk"), Get_nBytes_asString((double)SG_Data_Memory_Get_Spilled(), 2));
+
+	s	+= wxT("</table>");
+
 	return( s );
 }
 
@@ -614,6 +646,7 @@ wxMenu * CWKSP_Data_Manager::Get_Menu(void)
 	//	CMD_Menu_Add_Item(pMenu, false, ID_CMD_DATA_PROJECT_COPY_DB);
 		pMenu->AppendSeparator();
 		CMD_Menu_Add_Item(pMenu, false, ID_CMD_WKSP_ITEM_SEARCH);
+		CMD_Menu_Add_Item(pMenu, false, ID_CMD_DATA_MEMORY_REPORT);
 	}
 
 	//-----------------------------------------------------
@@ -692,6 +725,13 @@ bool CWKSP_Data_Manager::On_Command(int Cmd_ID)
 		MSG_General_Add_Line();
 		break; }
 
+	case ID_CMD_DATA_MEMORY_REPORT   : {
+		CSG_String s(SG_Data_Memory_Get_Report());
+		MSG_General_Add_Line();
+		MSG_General_Add(s.c_str());
+		MSG_General_Add_Line();
+		break; }
+
 	//-----------------------------------------------------
 	case ID_CMD_DATA_FORCE_UPDATE: {
 		{
@@ -790,6 +830,11 @@ void CWKSP_Data_Manager::Parameters_Changed(void)
 	SG_Grid_Cache_Set_Threshold_MB   (m_Parameters("GRID_CACHE_THRSHLD"  )->asDouble());
 	SG_Grid_Cache_Set_Directory      (m_Parameters("GRID_CACHE_TMPDIR"   )->asString());
 
+	SG_Data_Memory_Set_Budget_MB     (m_Parameters("MEMORY_BUDGET"       )->asDouble());
+	SG_Data_Memory_Set_Spill_Size    ((sLong)(m_Parameters("MEMORY_SPILL_SIZE")->asDouble() * N_MEGABYTE_BYTES));
+
+	SG_Data_Memory_Check();
+
 	CSG_Grid_System::Set_Precision   (m_Parameters("GRID_COORD_PRECISION")->asInt   ());
 
 	SG_Set_History_Depth             (m_Parameters("HISTORY_DEPTH"       )->asInt   ());
@@ -807,6 +852,7 @@ void CWKSP_Data_Manager::Parameters_Changed(void)
 	default: SG_Shapes_Set_File_Format_Default(SHAPE_FILE_FORMAT_ESRI      ); break;
 	case  1: SG_Shapes_Set_File_Format_Default(SHAPE_FILE_FORMAT_GeoPackage); break;
 	case  2: SG_Shapes_Set_File_Format_Default(SHAPE_FILE_FORMAT_GeoJSON   ); break;
+	case  3: SG_Shapes_Set_File_Format_Default(SHAPE_FILE_FORMAT_Native    ); break;
 	}
 
 	if( g_pData_Buttons ) { g_pData_Buttons->Update_Buttons(); }
@@ -967,7 +1013,8 @@ bool CWKSP_Data_Manager::Open(const wxString &File)
 		return( Open(File, SG_DATAOBJECT_TYPE_Table     ) != NULL );
 	}
 
-	if( SG_File_Cmp_Extension(&File, "shp"     ) )
+	if( SG_File_Cmp_Extension(&File, "shp"     )
+	||  SG_File_Cmp_Extension(&File, "sg-shp"  ) )
 	{
 		return( Open(File, SG_DATAOBJECT_TYPE_Shapes    ) != NULL );
 	}
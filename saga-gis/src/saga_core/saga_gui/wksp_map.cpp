@@ -192,6 +192,8 @@ CWKSP_Map::CWKSP_Map(void)
 	m_Img_bSave    = false;
 	m_Sync_bLock   = 0;
 
+	m_Cache_nSteps = 0;
+
 	On_Create_Parameters();
 }
 
@@ -203,6 +205,8 @@ CWKSP_Map::~CWKSP_Map(void)
 	if( m_pLayout  ) m_pLayout ->Do_Destroy();
 
 	delete(m_pLayout_Info);
+
+	Draw_Cache_Invalidate();
 }
 
 
@@ -822,6 +826,8 @@ bool CWKSP_Map::Update(CWKSP_Layer *pLayer, bool bMapOnly)
 			{
 				bRefresh = true;
 
+				Draw_Cache_Invalidate(pMapLayer);
+
 				if( pMapLayer->Get_Layer() == pLayer )
 				{
 					pMapLayer->Fit_Colors(Get_Extent());
@@ -839,7 +845,7 @@ bool CWKSP_Map::Update(CWKSP_Layer *pLayer, bool bMapOnly)
 	{
 		if( m_pView )
 		{
-			View_Refresh(bMapOnly);
+			_View_Refresh(bMapOnly);	// keeps the draw cache for unchanged layers
 		}
 
 		_Img_Save_On_Change();
@@ -1460,6 +1466,14 @@ void CWKSP_Map::View_Closes(MDI_ChildFrame *pView)
 
 //---------------------------------------------------------
 void CWKSP_Map::View_Refresh(bool bMapOnly)
+{
+	Draw_Cache_Invalidate();
+
+	_View_Refresh(bMapOnly);
+}
+
+//---------------------------------------------------------
+void CWKSP_Map::_View_Refresh(bool bMapOnly)
 {
 	if( m_pView    )	m_pView   ->Do_Update();
 	if( m_pView_3D )	m_pView_3D->Do_Update();
@@ -2195,56 +2209,240 @@ void CWKSP_Map::Draw_Map(wxDC &dc, const CSG_Rect &rWorld, double Zoom, const wx
 //---------------------------------------------------------
 void CWKSP_Map::Draw_Map(CSG_Map_DC &dc, int Flags)
 {
-	int Flag_Labels = !(Flags & LAYER_DRAW_FLAG_NOLABELS) ? 0 : LAYER_DRAW_FLAG_NOLABELS;
+	for(int Step=0; Step<Draw_Map_Steps(); Step++)
+	{
+		Draw_Map_Step(dc, Step, Flags);
+	}
+}
 
-	for(int i=Get_Count()-1; i>=0; i--)
+//---------------------------------------------------------
+// Layers are drawn bottom up, one per step. The last step
+// adds the map decorations (extent, scale bar, north arrow).
+//---------------------------------------------------------
+bool CWKSP_Map::Draw_Map_Step(CSG_Map_DC &dc, int Step, int Flags)
+{
+	if( Step < 0 || Step > Get_Count() )
 	{
-		switch( Get_Item(i)->Get_Type() )
+		return( false );
+	}
+
+	if( Step == Get_Count() )
+	{
+		if( (Flags & LAYER_DRAW_FLAG_THUMBNAIL) == 0 )
 		{
-		case WKSP_ITEM_Map_Layer    :
+			Draw_Extent     (dc);
+			Draw_ScaleBar   (dc);
+			Draw_North_Arrow(dc);
+		}
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	CWKSP_Base_Item *pItem = Get_Item(Get_Count() - 1 - Step);
+
+	switch( pItem->Get_Type() )
+	{
+	case WKSP_ITEM_Map_Layer    :
+	{
+		CWKSP_Map_Layer     *pLayer	= (CWKSP_Map_Layer     *)pItem;
+
+		if( pLayer->do_Show() )
 		{
-			CWKSP_Map_Layer     *pLayer	= (CWKSP_Map_Layer     *)Get_Item(i);
+			pLayer->Draw(dc, _Draw_Get_Flags(pItem, Flags));
+		}
+	}
+	break;
 
-			if( pLayer->do_Show() )
-			{
-				pLayer->Draw(dc, !(Flags & LAYER_DRAW_FLAG_NOEDITS) && pLayer->Get_Layer() == Get_Active_Layer() ? Flags : Flag_Labels);
-			}
+	case WKSP_ITEM_Map_Graticule: if( (Flags & LAYER_DRAW_FLAG_THUMBNAIL) == 0 )
+	{
+		CWKSP_Map_Graticule *pLayer	= (CWKSP_Map_Graticule *)pItem;
+
+		if( pLayer->do_Show() )//&& pLayer->Get_Graticule(Get_Extent()) )
+		{
+			pLayer->Draw(dc);
 		}
+	}
+	break;
+
+	case WKSP_ITEM_Map_BaseMap  : if( (Flags & LAYER_DRAW_FLAG_THUMBNAIL) == 0 )
+	{
+		CWKSP_Map_BaseMap   *pLayer	= (CWKSP_Map_BaseMap   *)pItem;
+
+		if( pLayer->do_Show() )
+		{
+			pLayer->Draw(dc);
+		}
+	}
+	break;
+
+	default:
 		break;
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+int CWKSP_Map::_Draw_Get_Flags(CWKSP_Base_Item *pItem, int Flags)
+{
+	if( pItem->Get_Type() == WKSP_ITEM_Map_Layer )
+	{
+		int Flag_Labels = !(Flags & LAYER_DRAW_FLAG_NOLABELS) ? 0 : LAYER_DRAW_FLAG_NOLABELS;
+
+		return( !(Flags & LAYER_DRAW_FLAG_NOEDITS) && ((CWKSP_Map_Layer *)pItem)->Get_Layer() == Get_Active_Layer() ? Flags : Flag_Labels );
+	}
+
+	return( Flags );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// The draw cache keeps snapshots of the map image taken
+// after single layer steps. As long as the map extent and
+// all layers up to a snapshot stay unchanged, drawing can
+// continue from there. Only steps that took a noticeable
+// time are stored and only the latest snapshots are kept,
+// limited in number and bytes, to keep the memory footprint
+// small.
+//---------------------------------------------------------
+#define MAP_CACHE_SNAPSHOTS	4						// maximum number of snapshots per map
+#define MAP_CACHE_BYTES		(64 * 1024 * 1024)		// maximum bytes of all snapshots of a map
+
+//---------------------------------------------------------
+struct SWKSP_Map_Cache
+{
+	CWKSP_Base_Item	*pItem; int Flags; wxBitmap Bitmap;
+};
 
-		case WKSP_ITEM_Map_Graticule: if( (Flags & LAYER_DRAW_FLAG_THUMBNAIL) == 0 )
+//---------------------------------------------------------
+int CWKSP_Map::Draw_Cache_Restore(CSG_Map_DC &dc, int Flags)
+{
+	if( !m_Cache_World.is_Equal(dc.rWorld()) || m_Cache_Size != dc.rDC().GetSize() )
+	{
+		Draw_Cache_Invalidate();
+
+		m_Cache_World = dc.rWorld();
+		m_Cache_Size  = dc.rDC().GetSize();
+
+		return( 0 );
+	}
+
+	//-----------------------------------------------------
+	int nValid = 0;
+
+	for(int Step=0; Step<m_Cache_nSteps && Step<Get_Count(); Step++, nValid++)
+	{
+		SWKSP_Map_Cache *pCache = (SWKSP_Map_Cache *)m_Cache[Step];
+		CWKSP_Base_Item *pItem  = Get_Item(Get_Count() - 1 - Step);
+
+		if( pCache->pItem != pItem || pCache->Flags != _Draw_Get_Flags(pItem, Flags) )
 		{
-			CWKSP_Map_Graticule *pLayer	= (CWKSP_Map_Graticule *)Get_Item(i);
+			break;
+		}
+	}
 
-			if( pLayer->do_Show() )//&& pLayer->Get_Graticule(Get_Extent()) )
-			{
-				pLayer->Draw(dc);
-			}
+	_Draw_Cache_Set_Steps(nValid);
+
+	//-----------------------------------------------------
+	for(int Step=m_Cache_nSteps-1; Step>=0; Step--)
+	{
+		SWKSP_Map_Cache *pCache = (SWKSP_Map_Cache *)m_Cache[Step];
+
+		if( pCache->Bitmap.IsOk() )
+		{
+			dc.DrawBitmap(pCache->Bitmap, 0, 0);
+
+			return( Step + 1 );
 		}
-		break;
+	}
+
+	return( 0 );
+}
+
+//---------------------------------------------------------
+void CWKSP_Map::Draw_Cache_Store(CSG_Map_DC &dc, int Step, int Flags, bool bSnapshot)
+{
+	if( Step != m_Cache_nSteps || Step >= Get_Count() || !m_Cache_World.is_Equal(dc.rWorld()) )
+	{
+		return;
+	}
+
+	if( (int)m_Cache.Get_Size() <= Step )
+	{
+		m_Cache += new SWKSP_Map_Cache;
+	}
+
+	SWKSP_Map_Cache *pCache = (SWKSP_Map_Cache *)m_Cache[Step];
+
+	pCache->pItem  = Get_Item(Get_Count() - 1 - Step);
+	pCache->Flags  = _Draw_Get_Flags(pCache->pItem, Flags);
+	pCache->Bitmap = bSnapshot ? dc.Get_Bitmap() : wxNullBitmap;
+
+	m_Cache_nSteps = Step + 1;
+
+	//-----------------------------------------------------
+	if( bSnapshot )	// release the oldest snapshots exceeding the limits
+	{
+		double Bytes = 4. * dc.rDC().GetWidth() * dc.rDC().GetHeight();
+
+		int nMax = Bytes > 0. ? (int)(MAP_CACHE_BYTES / Bytes) : MAP_CACHE_SNAPSHOTS;
+
+		if( nMax > MAP_CACHE_SNAPSHOTS ) { nMax = MAP_CACHE_SNAPSHOTS; } else if( nMax < 1 ) { nMax = 1; }
 
-		case WKSP_ITEM_Map_BaseMap  : if( (Flags & LAYER_DRAW_FLAG_THUMBNAIL) == 0 )
+		for(int i=Step, n=0; i>=0; i--)
 		{
-			CWKSP_Map_BaseMap   *pLayer	= (CWKSP_Map_BaseMap   *)Get_Item(i);
+			SWKSP_Map_Cache *pSnapshot = (SWKSP_Map_Cache *)m_Cache[i];
 
-			if( pLayer->do_Show() )
+			if( pSnapshot->Bitmap.IsOk() && ++n > nMax )
 			{
-				pLayer->Draw(dc);
+				pSnapshot->Bitmap = wxNullBitmap;
 			}
 		}
-		break;
+	}
+}
 
-		default:
-			break;
+//---------------------------------------------------------
+void CWKSP_Map::Draw_Cache_Invalidate(CWKSP_Base_Item *pItem)
+{
+	if( pItem == NULL )
+	{
+		for(sLong i=0; i<m_Cache.Get_Size(); i++)
+		{
+			delete((SWKSP_Map_Cache *)m_Cache[i]);
 		}
+
+		m_Cache.Destroy(); m_Cache_nSteps = 0;
+
+		return;
 	}
 
-	//-----------------------------------------------------
-	if( (Flags & LAYER_DRAW_FLAG_THUMBNAIL) == 0 )
+	for(int Step=0; Step<m_Cache_nSteps; Step++)
+	{
+		if( ((SWKSP_Map_Cache *)m_Cache[Step])->pItem == pItem )
+		{
+			_Draw_Cache_Set_Steps(Step);
+
+			return;
+		}
+	}
+}
+
+//---------------------------------------------------------
+void CWKSP_Map::_Draw_Cache_Set_Steps(int nSteps)
+{
+	if( nSteps < m_Cache_nSteps )
 	{
-		Draw_Extent     (dc);
-		Draw_ScaleBar   (dc);
-		Draw_North_Arrow(dc);
+		for(int Step=nSteps; Step<m_Cache_nSteps; Step++)	// release snapshots that became invalid
+		{
+			((SWKSP_Map_Cache *)m_Cache[Step])->Bitmap = wxNullBitmap;
+		}
+
+		m_Cache_nSteps = nSteps;
 	}
 }
 
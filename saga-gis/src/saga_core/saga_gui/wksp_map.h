@@ -188,6 +188,12 @@ public:
 	void						Draw_Map				(wxDC &dc                        , double Zoom, const wxRect &rClient, int Flags = 0, int Background = -1);
 	void						Draw_Map				(wxDC &dc, const CSG_Rect &rWorld, double Zoom, const wxRect &rClient, int Flags = 0, int Background = -1);
 	void						Draw_Map				(class CSG_Map_DC &dc, int Flags = 0);
+	int							Draw_Map_Steps			(void)	{	return( Get_Count() + 1 );	}
+	bool						Draw_Map_Step			(class CSG_Map_DC &dc, int Step, int Flags = 0);
+
+	int							Draw_Cache_Restore		(class CSG_Map_DC &dc, int Flags = 0);
+	void						Draw_Cache_Store		(class CSG_Map_DC &dc, int Step, int Flags, bool bSnapshot);
+	void						Draw_Cache_Invalidate	(CWKSP_Base_Item *pItem = NULL);
 
 	void						Draw_Frame				(wxDC &dc, wxRect rMap, int Width);
 	void						Draw_Frame				(wxDC &dc, const CSG_Rect &rWorld, wxRect rMap, int Width, bool bScaleBar, bool bUseDCFont = false);
@@ -220,7 +226,7 @@ private:
 
 	bool						m_Img_bSave;
 
-	int							m_Img_Type, m_Img_Count, m_Sync_bLock;
+	int							m_Img_Type, m_Img_Count, m_Sync_bLock, m_Cache_nSteps;
 
 	wxString					m_Name, m_Img_File;
 
@@ -232,6 +238,12 @@ private:
 
 	CWKSP_Map_Extents			m_Extents;
 
+	CSG_Rect					m_Cache_World;
+
+	wxSize						m_Cache_Size;
+
+	CSG_Array_Pointer			m_Cache;
+
 	class CVIEW_Map				*m_pView;
 
 	class CVIEW_Map_3D			*m_pView_3D;
@@ -243,6 +255,11 @@ private:
 
 	bool						_Set_Extent				(const CSG_Rect &Extent);
 
+	void						_View_Refresh			(bool bMapOnly);
+
+	int							_Draw_Get_Flags			(CWKSP_Base_Item *pItem, int Flags);
+	void						_Draw_Cache_Set_Steps	(int nSteps);
+
 	void						_Img_Save				(wxString file, int type);
 	void						_Img_Save_On_Change		(void);
 
@@ -48,6 +48,8 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <algorithm>
+
 #include <saga_gdi/sgdi_helper.h>
 
 #include "res_commands.h"
@@ -101,6 +103,8 @@ CWKSP_Shapes::CWKSP_Shapes(CSG_Shapes *pShapes)
 //---------------------------------------------------------
 CWKSP_Shapes::~CWKSP_Shapes(void)
 {
+	_Tiles_Clear();
+
 	delete(m_pTable);
 }
 
@@ -421,6 +425,12 @@ void CWKSP_Shapes::On_Create_Parameters(void)
 		"DISPLAY_CHART"   , _TL("Chart"), _TL("")
 	);
 
+	m_Parameters.Add_Bool("NODE_DISPLAY",
+		"DISPLAY_CACHE"   , _TL("Tile Cache"),
+		_TL("Keeps rendered map tiles in memory, so that panning and redrawing at the same scale does not need to draw all shapes again."),
+		true
+	);
+
 	//-----------------------------------------------------
 	// Classification...
 
@@ -573,6 +583,8 @@ void CWKSP_Shapes::On_DataObject_Changed(void)
 	m_Parameters.Set_Parameter("MAX_SAMPLES", (int)m_pObject->Get_Max_Samples());
 
 	//-----------------------------------------------------
+	m_Index.bValid = false; _Tiles_Clear();
+
 	CWKSP_Layer::On_DataObject_Changed();
 
 	m_pTable->DataObject_Changed();
@@ -583,6 +595,8 @@ void CWKSP_Shapes::On_Parameters_Changed(void)
 {
 	CWKSP_Layer::On_Parameters_Changed();
 
+	_Tiles_Clear();
+
 	//-----------------------------------------------------
 	m_pObject->Set_Max_Samples(m_Parameters("MAX_SAMPLES")->asInt());
 
@@ -743,6 +757,14 @@ int CWKSP_Shapes::On_Parameter_Changed(CSG_Parameters *pParameters, CSG_Paramete
 //                                                       //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+void CWKSP_Shapes::On_Update_Views(bool bAll)
+{
+	m_Index.bValid = false; _Tiles_Clear(); // shapes might have been edited
+
+	CWKSP_Layer::On_Update_Views(bAll);
+}
+
 //---------------------------------------------------------
 void CWKSP_Shapes::On_Update_Views(void)
 {
@@ -835,7 +857,15 @@ void CWKSP_Shapes::On_Draw(CSG_Map_DC &dc_Map, int Flags)
 	}
 
 	//-----------------------------------------------------
-	if( m_Parameters("DISPLAY_TRANSPARENCY")->asDouble() > 0. )
+	bool bPlain = (Flags & LAYER_DRAW_FLAG_NOEDITS) != 0 || (Get_Shapes()->Get_Selection_Count() < 1 && !m_Edit.pShape);
+
+	CSG_Array_Pointer Tiles; CSG_Points_Int Positions;
+
+	bool bTiles = bPlain && _Tiles_Update(dc_Map, Flags, Tiles, Positions);
+
+	bool bLayer = bTiles || m_Parameters("DISPLAY_TRANSPARENCY")->asDouble() > 0.;
+
+	if( bLayer )
 	{
 		dc_Map.Draw_Layer_Begin();
 	}
@@ -846,19 +876,33 @@ void CWKSP_Shapes::On_Draw(CSG_Map_DC &dc_Map, int Flags)
 
 	Draw_Initialize(dc_Map, Flags);
 
+	CSG_Array_sLong Shapes; _Index_Select(dc_Map.rWorld(), Shapes);
+
 	//-----------------------------------------------------
-	if( (Flags & LAYER_DRAW_FLAG_NOEDITS) != 0 || (Get_Shapes()->Get_Selection_Count() < 1 && !m_Edit.pShape) )
+	if( bPlain )
 	{
-		for(sLong i=0; i<Get_Shapes()->Get_Count(); i++)
+		if( bTiles )
 		{
-			_Draw_Shape(dc_Map, Get_Shapes()->Get_Shape(i));
+			for(sLong i=0; i<Tiles.Get_Size(); i++)
+			{
+				CTile *pTile = (CTile *)Tiles[i];
+
+				dc_Map.Draw_Layer_Put(pTile->Layer, pTile->Mask, Positions[i].x, Positions[i].y);
+			}
+		}
+		else
+		{
+			for(sLong i=0; i<Shapes.Get_Size(); i++)
+			{
+				_Draw_Shape(dc_Map, Get_Shapes()->Get_Shape(Shapes[i]));
+			}
 		}
 
 		if( _Chart_is_Valid() )
 		{
-			for(sLong i=0; i<Get_Shapes()->Get_Count(); i++)
+			for(sLong i=0; i<Shapes.Get_Size(); i++)
 			{
-				_Draw_Chart(dc_Map, Get_Shapes()->Get_Shape(i));
+				_Draw_Chart(dc_Map, Get_Shapes()->Get_Shape(Shapes[i]));
 			}
 		}
 	}
@@ -866,11 +910,11 @@ void CWKSP_Shapes::On_Draw(CSG_Map_DC &dc_Map, int Flags)
 	//-----------------------------------------------------
 	else // selection and/or editing
 	{
-		for(sLong i=0; i<Get_Shapes()->Get_Count(); i++)
+		for(sLong i=0; i<Shapes.Get_Size(); i++)
 		{
-			if( !Get_Shapes()->Get_Shape(i)->is_Selected() )
+			if( !Get_Shapes()->Get_Shape(Shapes[i])->is_Selected() )
 			{
-				_Draw_Shape(dc_Map, Get_Shapes()->Get_Shape(i));
+				_Draw_Shape(dc_Map, Get_Shapes()->Get_Shape(Shapes[i]));
 			}
 		}
 
@@ -927,13 +971,15 @@ void CWKSP_Shapes::On_Draw(CSG_Map_DC &dc_Map, int Flags)
 
 		if( iSize >= 0 && iSize < Get_Shapes()->Get_Field_Count() )	// size by attribute
 		{
-			for(sLong i=0; i<Get_Shapes()->Get_Count(); i++)
+			for(sLong i=0; i<Shapes.Get_Size(); i++)
 			{
-				int Size = (int)(0.5 + dSize * Get_Shapes()->Get_Shape(i)->asDouble(iSize));
+				CSG_Shape *pShape = Get_Shapes()->Get_Shape(Shapes[i]);
+
+				int Size = (int)(0.5 + dSize * pShape->asDouble(iSize));
 
 				if( Size > 0 )
 				{
-					_Draw_Label(dc_Map, Get_Shapes()->Get_Shape(i), Size);
+					_Draw_Label(dc_Map, pShape, Size);
 				}
 			}
 		}
@@ -943,16 +989,16 @@ void CWKSP_Shapes::On_Draw(CSG_Map_DC &dc_Map, int Flags)
 
 			if( Size > 0 )
 			{
-				for(sLong i=0; i<Get_Shapes()->Get_Count(); i++)
+				for(sLong i=0; i<Shapes.Get_Size(); i++)
 				{
-					_Draw_Label(dc_Map, Get_Shapes()->Get_Shape(i), Size);
+					_Draw_Label(dc_Map, Get_Shapes()->Get_Shape(Shapes[i]), Size);
 				}
 			}
 		}
 	}
 
 	//-----------------------------------------------------
-	if( m_Parameters("DISPLAY_TRANSPARENCY")->asDouble() > 0. ) // Transparency ?
+	if( bLayer ) // Transparency ?
 	{
 		dc_Map.Draw_Layer_End(m_Parameters("DISPLAY_TRANSPARENCY")->asDouble() / 100.);
 	}
@@ -1017,6 +1063,432 @@ void CWKSP_Shapes::_Draw_Label(CSG_Map_DC &dc_Map, CSG_Shape *pShape, int PointS
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define INDEX_MAX_CELLS	64	// shapes touching more cells are kept in a separate list
+
+//---------------------------------------------------------
+// The spatial index is a regular grid of cells, each holding
+// the indices of the shapes whose extent touches it. It is
+// built on demand and discarded whenever the views update.
+//---------------------------------------------------------
+bool CWKSP_Shapes::_Index_Update(void)
+{
+	if( m_Index.bValid )
+	{
+		return( true );
+	}
+
+	CSG_Shapes *pShapes = Get_Shapes(); sLong nShapes = pShapes->Get_Count();
+
+	m_Index.Extent   = pShapes->Get_Extent();
+	m_Index.Cellsize = M_GET_MAX(m_Index.Extent.Get_XRange(), m_Index.Extent.Get_YRange()) / 1024.;
+	m_Index.Cellsize = M_GET_MAX(m_Index.Cellsize, sqrt(m_Index.Extent.Get_Area() / M_GET_MAX(1., nShapes / 4.)));
+
+	if( m_Index.Cellsize <= 0. )
+	{
+		m_Index.Cellsize = 1.;
+	}
+
+	m_Index.nx = 1 + (int)(m_Index.Extent.Get_XRange() / m_Index.Cellsize);
+	m_Index.ny = 1 + (int)(m_Index.Extent.Get_YRange() / m_Index.Cellsize);
+
+	sLong nCells = (sLong)m_Index.nx * m_Index.ny;
+
+	//-----------------------------------------------------
+	m_Index.Cells.Create(nCells + 1); m_Index.Cells.Assign(0); m_Index.Large.Destroy();
+
+	sLong *Cells = m_Index.Cells.Get_Array();
+
+	for(int Pass=0; Pass<2; Pass++) // 1st pass counts the cell entries, 2nd pass fills them in
+	{
+		CSG_Array_sLong Next;
+
+		if( Pass == 1 )
+		{
+			for(sLong i=0; i<nCells; i++)
+			{
+				Cells[i + 1] += Cells[i];
+			}
+
+			m_Index.Items.Create(Cells[nCells]); Next.Create(nCells);
+
+			for(sLong i=0; i<nCells; i++)
+			{
+				Next[i] = Cells[i];
+			}
+		}
+
+		for(sLong i=0; i<nShapes; i++)
+		{
+			const CSG_Rect &r = pShapes->Get_Shape(i)->Get_Extent();
+
+			int ax = m_Index.Get_x(r.Get_XMin()), bx = m_Index.Get_x(r.Get_XMax());
+			int ay = m_Index.Get_y(r.Get_YMin()), by = m_Index.Get_y(r.Get_YMax());
+
+			if( (sLong)(bx - ax + 1) * (by - ay + 1) > INDEX_MAX_CELLS )
+			{
+				if( Pass == 0 )
+				{
+					m_Index.Large += i;
+				}
+			}
+			else for(int y=ay; y<=by; y++) for(int x=ax; x<=bx; x++)
+			{
+				sLong Cell = (sLong)y * m_Index.nx + x;
+
+				if( Pass == 0 )
+				{
+					Cells[Cell + 1]++;
+				}
+				else
+				{
+					m_Index.Items[Next[Cell]++] = i;
+				}
+			}
+		}
+	}
+
+	m_Index.Marks.Create(nShapes); m_Index.Marks.Assign(0);
+
+	m_Index.bValid = true;
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Collects the indices of all shapes whose extent might
+// intersect with the given rectangle in ascending order,
+// so that shapes are drawn in the order they are stored.
+//---------------------------------------------------------
+sLong CWKSP_Shapes::_Index_Select(const CSG_Rect &rWorld, CSG_Array_sLong &Shapes)
+{
+	Shapes.Destroy();
+
+	if( Get_Shapes()->is_Deferred() )	// native file, use its spatial index and read only what is needed
+	{
+		return( Get_Shapes()->Find_Shapes(rWorld, Shapes) );
+	}
+
+	if( !_Index_Update() || rWorld.Intersects(m_Index.Extent) == INTERSECTION_None )
+	{
+		return( 0 );
+	}
+
+	sLong nShapes = Get_Shapes()->Get_Count(), n = 0;
+
+	Shapes.Set_Array(nShapes); sLong *Selection = Shapes.Get_Array();
+
+	TSG_Intersection Intersection = rWorld.Intersects(m_Index.Extent);
+
+	if( Intersection == INTERSECTION_Contains || Intersection == INTERSECTION_Identical )
+	{
+		for(sLong i=0; i<nShapes; i++)
+		{
+			Selection[i] = i;
+		}
+
+		return( nShapes );
+	}
+
+	//-----------------------------------------------------
+	int *Marks = m_Index.Marks.Get_Array();
+
+	int ax = m_Index.Get_x(rWorld.Get_XMin()), bx = m_Index.Get_x(rWorld.Get_XMax());
+	int ay = m_Index.Get_y(rWorld.Get_YMin()), by = m_Index.Get_y(rWorld.Get_YMax());
+
+	for(int y=ay; y<=by; y++)
+	{
+		for(int x=ax; x<=bx; x++)
+		{
+			sLong Cell = (sLong)y * m_Index.nx + x;
+
+			for(sLong i=m_Index.Cells[Cell]; i<m_Index.Cells[Cell + 1]; i++)
+			{
+				sLong iShape = m_Index.Items[i];
+
+				if( !Marks[iShape] )
+				{
+					Marks[iShape] = 1; Selection[n++] = iShape;
+				}
+			}
+		}
+	}
+
+	for(sLong i=0; i<n; i++)
+	{
+		Marks[Selection[i]] = 0;
+	}
+
+	for(sLong i=0; i<m_Index.Large.Get_Size(); i++)
+	{
+		if( rWorld.Intersects(Get_Shapes()->Get_Shape(m_Index.Large[i])->Get_Extent()) != INTERSECTION_None )
+		{
+			Selection[n++] = m_Index.Large[i];
+		}
+	}
+
+	std::sort(Selection, Selection + n);
+
+	Shapes.Set_Array(n, false);
+
+	return( n );
+}
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define TILE_SIZE	256	// tile width and height in pixels
+#define TILE_MAX	96	// maximum number of tiles cached per layer
+#define TILE_BYTES	(128 * 1024 * 1024)	// maximum memory used by the cached tiles of all layers
+
+//---------------------------------------------------------
+sLong				CWKSP_Shapes::m_Tiles_Used   = 0;
+sLong				CWKSP_Shapes::m_Tiles_Bytes  = 0;
+CSG_Array_Pointer	CWKSP_Shapes::m_Tiles_Layers;
+
+//---------------------------------------------------------
+void CWKSP_Shapes::_Tiles_Clear(void)
+{
+	while( m_Tiles.Get_Size() > 0 )
+	{
+		_Tiles_Del(m_Tiles.Get_Size() - 1);
+	}
+}
+
+//---------------------------------------------------------
+void CWKSP_Shapes::_Tiles_Del(sLong Index)
+{
+	CTile *pTile = (CTile *)m_Tiles[Index];
+
+	m_Tiles_Bytes -= pTile->Bytes;
+
+	delete(pTile);
+
+	m_Tiles.Del(Index);
+
+	if( m_Tiles.Get_Size() < 1 )
+	{
+		m_Tiles_Layers.Del(this);
+	}
+}
+
+//---------------------------------------------------------
+// Releases the least recently used tiles of all layers until
+// the requested bytes fit into the budget. The tiles of the
+// running update are in use and never released.
+//---------------------------------------------------------
+bool CWKSP_Shapes::_Tiles_Reserve(sLong Bytes)
+{
+	while( m_Tiles_Bytes + Bytes > TILE_BYTES )
+	{
+		CWKSP_Shapes *pOldest = NULL; sLong Oldest = -1, Used = m_Tiles_Used;
+
+		for(sLong iLayer=0; iLayer<m_Tiles_Layers.Get_Size(); iLayer++)
+		{
+			CWKSP_Shapes *pLayer = (CWKSP_Shapes *)m_Tiles_Layers[iLayer];
+
+			for(sLong i=0; i<pLayer->m_Tiles.Get_Size(); i++)
+			{
+				if( ((CTile *)pLayer->m_Tiles[i])->Used < Used )
+				{
+					pOldest = pLayer; Oldest = i; Used = ((CTile *)pLayer->m_Tiles[i])->Used;
+				}
+			}
+		}
+
+		if( !pOldest )
+		{
+			return( false );
+		}
+
+		pOldest->_Tiles_Del(Oldest);
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Provides the cached tiles covering the map extent together
+// with their positions. The tile grid of a zoom level is kept
+// as long as it is aligned with the pixels of the map extent,
+// so that panning only renders the tiles that became visible.
+//---------------------------------------------------------
+bool CWKSP_Shapes::_Tiles_Update(CSG_Map_DC &dc_Map, int Flags, CSG_Array_Pointer &Tiles, CSG_Points_Int &Positions)
+{
+	if( !m_Parameters("DISPLAY_CACHE")->asBool() || m_bVertices == 2 )
+	{
+		return( false );
+	}
+
+	int Margin = Draw_Margin(dc_Map);
+
+	if( Margin < 0 || Margin > TILE_SIZE / 2 )
+	{
+		return( false );
+	}
+
+	if( m_bVertices )
+	{
+		Margin += 3;
+	}
+
+	//-----------------------------------------------------
+	double World2DC = dc_Map.World2DC(); CSG_Point Origin(dc_Map.rWorld().Get_XMin(), dc_Map.rWorld().Get_YMax());
+
+	for(sLong i=0; i<m_Tiles.Get_Size(); i++)
+	{
+		CTile *pTile = (CTile *)m_Tiles[i];
+
+		if( pTile->Scale == dc_Map.Scale() && fabs(pTile->World2DC - World2DC) <= 1e-9 * World2DC )
+		{
+			double dx = (pTile->Origin.x - Origin.x) * World2DC;
+			double dy = (Origin.y - pTile->Origin.y) * World2DC;
+
+			if( fabs(dx) < 1e8 && fabs(dx - floor(0.5 + dx)) < 0.001
+			&&  fabs(dy) < 1e8 && fabs(dy - floor(0.5 + dy)) < 0.001 )
+			{
+				Origin = pTile->Origin;
+
+				break;
+			}
+		}
+	}
+
+	int dx = (int)floor(0.5 + (Origin.x - dc_Map.rWorld().Get_XMin()) * World2DC);
+	int dy = (int)floor(0.5 + (dc_Map.rWorld().Get_YMax() - Origin.y) * World2DC);
+
+	int ax = (int)floor((double)(                         - dx    ) / TILE_SIZE);
+	int bx = (int)floor((double)(dc_Map.rDC().GetWidth () - dx - 1) / TILE_SIZE);
+	int ay = (int)floor((double)(                         - dy    ) / TILE_SIZE);
+	int by = (int)floor((double)(dc_Map.rDC().GetHeight() - dy - 1) / TILE_SIZE);
+
+	if( (bx - ax + 1) * (by - ay + 1) > TILE_MAX )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	m_Tiles_Used++;
+
+	for(int y=ay; y<=by; y++)
+	{
+		for(int x=ax; x<=bx; x++)
+		{
+			CTile *pTile = _Tiles_Get(dc_Map, Flags, Origin, x, y, Margin);
+
+			if( !pTile )
+			{
+				return( false );
+			}
+
+			Tiles += pTile; Positions.Add(dx + x * TILE_SIZE, dy + y * TILE_SIZE);
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+CWKSP_Shapes::CTile * CWKSP_Shapes::_Tiles_Get(CSG_Map_DC &dc_Map, int Flags, const CSG_Point &Origin, int x, int y, int Margin)
+{
+	double World2DC = dc_Map.World2DC();
+
+	for(sLong i=0; i<m_Tiles.Get_Size(); i++)
+	{
+		CTile *pTile = (CTile *)m_Tiles[i];
+
+		if( pTile->x == x && pTile->y == y && pTile->Origin == Origin
+		&&  pTile->Scale == dc_Map.Scale() && fabs(pTile->World2DC - World2DC) <= 1e-9 * World2DC )
+		{
+			pTile->Used = m_Tiles_Used;
+
+			return( pTile );
+		}
+	}
+
+	//-----------------------------------------------------
+	// the tile is rendered with a margin, so that line widths and
+	// symbols of shapes just outside of its extent are included
+
+	double Size = TILE_SIZE / World2DC;
+
+	CSG_Rect rTile(Origin.x + x * Size, Origin.y - (y + 1) * Size, Origin.x + (x + 1) * Size, Origin.y - y * Size);
+
+	rTile.Inflate(Margin / World2DC, false);
+
+	CSG_Map_DC dc_Tile(rTile, wxRect(0, 0, TILE_SIZE + 2 * Margin, TILE_SIZE + 2 * Margin), dc_Map.Scale());
+
+	dc_Tile.Draw_Layer_Begin();
+
+	Draw_Initialize(dc_Tile, Flags);
+
+	CSG_Array_sLong Shapes; _Index_Select(dc_Tile.rWorld(), Shapes);
+
+	for(sLong i=0; i<Shapes.Get_Size(); i++)
+	{
+		_Draw_Shape(dc_Tile, Get_Shapes()->Get_Shape(Shapes[i]));
+	}
+
+	wxBitmap Layer, Mask;
+
+	if( !dc_Tile.Draw_Layer_Get(Layer, Mask) )
+	{
+		return( NULL );
+	}
+
+	//-----------------------------------------------------
+	if( m_Tiles.Get_Size() >= TILE_MAX ) // release the least recently used tile of this layer
+	{
+		sLong Oldest = 0;
+
+		for(sLong i=1; i<m_Tiles.Get_Size(); i++)
+		{
+			if( ((CTile *)m_Tiles[Oldest])->Used > ((CTile *)m_Tiles[i])->Used )
+			{
+				Oldest = i;
+			}
+		}
+
+		_Tiles_Del(Oldest);
+	}
+
+	CTile *pTile = new CTile;
+
+	pTile->x        = x;
+	pTile->y        = y;
+	pTile->Used     = m_Tiles_Used;
+	pTile->World2DC = World2DC;
+	pTile->Scale    = dc_Map.Scale();
+	pTile->Origin   = Origin;
+	pTile->Layer    = Layer.GetSubBitmap(wxRect(Margin, Margin, TILE_SIZE, TILE_SIZE));
+	pTile->Mask     = Mask .GetSubBitmap(wxRect(Margin, Margin, TILE_SIZE, TILE_SIZE));
+	pTile->Bytes    = (sLong)TILE_SIZE * TILE_SIZE * ((pTile->Layer.GetDepth() > 0 ? pTile->Layer.GetDepth() : 32) + (pTile->Mask.GetDepth() > 0 ? pTile->Mask.GetDepth() : 32)) / 8;
+
+	if( !_Tiles_Reserve(pTile->Bytes) ) // all cached tiles are in use, draw without cache
+	{
+		delete(pTile);
+
+		return( NULL );
+	}
+
+	if( m_Tiles.Get_Size() < 1 )
+	{
+		m_Tiles_Layers += this;
+	}
+
+	m_Tiles += pTile; m_Tiles_Bytes += pTile->Bytes;
+
+	return( pTile );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 ///////////////////////////////////////////////////////////
@@ -151,6 +151,7 @@ protected:
 
 	virtual int					On_Parameter_Changed	(CSG_Parameters *pParameters, CSG_Parameter *pParameter, int Flags);
 
+	virtual void				On_Update_Views			(bool bAll);
 	virtual void				On_Update_Views			(void);
 
 	virtual void				On_Draw					(CSG_Map_DC &dc_Map, int Flags);
@@ -166,6 +167,7 @@ protected:
 	virtual void				Draw_Initialize			(CSG_Map_DC &dc_Map                   , int Flags)             = 0;
 	virtual void				Draw_Shape				(CSG_Map_DC &dc_Map, CSG_Shape *pShape, int Flags)             = 0;
 	virtual void				Draw_Label				(CSG_Map_DC &dc_Map, CSG_Shape *pShape, const wxString &Label) = 0;
+	virtual int					Draw_Margin				(CSG_Map_DC &dc_Map)	{	return( -1 );	}
 
 	virtual void				Edit_Shape_Draw_Move	(wxDC &dc, const CSG_Rect &rWorld, const wxPoint &Point, const TSG_Point &ptWorld);
 	virtual void				Edit_Shape_Draw_Move	(wxDC &dc, const CSG_Rect &rWorld, const wxPoint &Point);
@@ -182,6 +184,38 @@ private:
 	void						_Draw_Label				(CSG_Map_DC &dc_Map, CSG_Shape *pShape, int PointSize = 0);
 
 
+	//-----------------------------------------------------
+	// Spatial index and tile cache...
+
+	class CIndex
+	{
+	public:
+		bool bValid = false; int nx = 0, ny = 0; double Cellsize = 1.; CSG_Rect Extent; CSG_Array_sLong Cells, Items, Large; CSG_Array_Int Marks;
+
+		int Get_x(double x) const { x = (x - Extent.Get_XMin()) / Cellsize; return( x < 0. ? 0 : x < nx ? (int)x : nx - 1 ); }
+		int Get_y(double y) const { y = (y - Extent.Get_YMin()) / Cellsize; return( y < 0. ? 0 : y < ny ? (int)y : ny - 1 ); }
+	}
+	m_Index;
+
+	class CTile					{ public: int x, y; sLong Used, Bytes; double World2DC, Scale; CSG_Point Origin; wxBitmap Layer, Mask; };
+
+	static sLong				m_Tiles_Used, m_Tiles_Bytes;	// shared by the tile caches of all layers
+
+	static CSG_Array_Pointer	m_Tiles_Layers;
+
+	CSG_Array_Pointer			m_Tiles;
+
+
+	bool						_Index_Update			(void);
+	sLong						_Index_Select			(const CSG_Rect &rWorld, CSG_Array_sLong &Shapes);
+
+	void						_Tiles_Clear			(void);
+	void						_Tiles_Del				(sLong Index);
+	static bool					_Tiles_Reserve			(sLong Bytes);
+	bool						_Tiles_Update			(CSG_Map_DC &dc_Map, int Flags, CSG_Array_Pointer &Tiles, CSG_Points_Int &Positions);
+	CTile *						_Tiles_Get				(CSG_Map_DC &dc_Map, int Flags, const CSG_Point &Origin, int x, int y, int Margin);
+
+
 	//-----------------------------------------------------
 	// Charts...
 
@@ -412,22 +412,19 @@ void CWKSP_Shapes_Line::Draw_Shape(CSG_Map_DC &dc_Map, CSG_Shape *pShape, int Fl
 }
 
 //---------------------------------------------------------
-void CWKSP_Shapes_Line::_Draw_Shape(CSG_Map_DC &dc_Map, CSG_Shape *pShape, int xOffset, int yOffset)
+int CWKSP_Shapes_Line::Draw_Margin(CSG_Map_DC &dc_Map)
 {
-	for(int iPart=0; iPart<pShape->Get_Part_Count(); iPart++)
-	{
-		if( pShape->Get_Point_Count(iPart) > 1 )
-		{
-			TSG_Point_Int A = dc_Map.World2DC(pShape->Get_Point(0, iPart)); A.x += xOffset; A.y += yOffset;
+	double Size = m_iSize < 0 ? m_Size : m_Size + m_dSize * (Get_Shapes()->Get_Maximum(m_iSize) - m_Size_Min);
 
-			for(int iPoint=1; iPoint<pShape->Get_Point_Count(iPart); iPoint++)
-			{
-				TSG_Point_Int B = A; A = dc_Map.World2DC(pShape->Get_Point(iPoint, iPart)); A.x += xOffset; A.y += yOffset;
+	Size *= m_Size_Type == 1 ? dc_Map.World2DC() : dc_Map.Scale();
 
-				dc_Map.DrawLine(A.x, A.y, B.x, B.y);
-			}
-		}
-	}
+	return( Size < 1024. ? 2 + (int)(0.5 * Size) : -1 ); // half the maximum pen width plus effect offset
+}
+
+//---------------------------------------------------------
+void CWKSP_Shapes_Line::_Draw_Shape(CSG_Map_DC &dc_Map, CSG_Shape *pShape, int xOffset, int yOffset)
+{
+	dc_Map.Draw_Line(pShape, xOffset, yOffset);
 }
 
 //---------------------------------------------------------
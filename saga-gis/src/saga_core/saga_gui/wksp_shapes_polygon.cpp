@@ -231,6 +231,12 @@ void CWKSP_Shapes_Polygon::Draw_Shape(CSG_Map_DC &dc_Map, CSG_Shape *pShape, int
 	}
 }
 
+//---------------------------------------------------------
+int CWKSP_Shapes_Polygon::Draw_Margin(CSG_Map_DC &dc_Map)
+{
+	return( 3 + m_Pen.GetWidth() ); // outline width and centroid marker
+}
+
 //---------------------------------------------------------
 void CWKSP_Shapes_Polygon::Draw_Label(CSG_Map_DC &dc_Map, CSG_Shape *pShape, const wxString &Label)
 {
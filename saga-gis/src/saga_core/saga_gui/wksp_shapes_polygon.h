@@ -101,6 +101,7 @@ protected:
 	virtual void				Draw_Initialize			(CSG_Map_DC &dc_Map, int Flags);
 	virtual void				Draw_Shape				(CSG_Map_DC &dc_Map, CSG_Shape *pShape, int Flags);
 	virtual void				Draw_Label				(CSG_Map_DC &dc_Map, CSG_Shape *pShape, const wxString &Label);
+	virtual int					Draw_Margin				(CSG_Map_DC &dc_Map);
 
 	virtual void				Edit_Shape_Draw_Move	(wxDC &dc, const CSG_Rect &rWorld, const wxPoint &Point);
 	virtual void				Edit_Shape_Draw			(CSG_Map_DC &dc_Map);
@@ -171,6 +171,12 @@ CWKSP_Tool_Manager::CWKSP_Tool_Manager(void)
 		false
 	);
 
+	m_Parameters.Add_Bool("NODE_TOOLS",
+		"PROFILE"        , _TL("Profile Executions"),
+		_TL("Reports run time, memory usage, data input and output and the time spent in instrumented sections for each tool execution in the execution messages."),
+		false
+	);
+
 	m_Parameters.Add_Choice("NODE_TOOLS",
 		"HELP_SOURCE"    , _TL("Tool Description Source"),
 		_TL(""),
@@ -260,6 +266,8 @@ bool CWKSP_Tool_Manager::Initialise(void)
 
 	SG_Get_Projections().Set_UseInternalDB(m_Parameters("CRS_CODE_DB")->asInt() == 0);
 
+	SG_Profile_Set_Enabled(m_Parameters("PROFILE")->asBool());
+
 	#ifdef _OPENMP
 		SG_OMP_Set_Max_Num_Threads(m_Parameters("OMP_THREADS_MAX")->asInt());
 	#endif
@@ -452,6 +460,8 @@ void CWKSP_Tool_Manager::Parameters_Changed(void)
 
 	SG_Get_Projections().Set_UseInternalDB(m_Parameters("CRS_CODE_DB")->asInt() == 0);
 
+	SG_Profile_Set_Enabled(m_Parameters("PROFILE")->asBool());
+
 #ifdef _OPENMP
 	SG_OMP_Set_Max_Num_Threads(m_Parameters("OMP_THREADS_MAX")->asInt());
 #endif
@@ -910,118 +910,373 @@ bool CSG_PG_Connection::Table_Drop(const CSG_String &_Table_Name, bool bCommit)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CSG_PG_Connection::Table_Insert(const CSG_String &_Table_Name, const CSG_Table &Table, bool bCommit)
+// Streams records to the server with 'COPY ... FROM STDIN'.
+// The binary format is used if the types of all target
+// columns are supported, otherwise the text format is used.
+// Geometries are passed as (hex encoded) EWKB.
+// Binary values are sent in network byte order (big endian),
+// so bytes are swapped only on little endian hosts.
+//---------------------------------------------------------
+class CSG_PG_Copy
 {
-	if( !is_Connected() ) { _Error_Message(_TL("no database connection")); return( false ); }
+public:
+
+	enum
+	{
+		TYPE_Text = 0, TYPE_Bool, TYPE_Int2, TYPE_Int4, TYPE_Int8, TYPE_Float4, TYPE_Float8, TYPE_Bytea, TYPE_Date, TYPE_Geometry, TYPE_Other
+	};
+
+	CSG_PG_Copy(PGconn *pConnection) : m_pConnection(pConnection)
+	{
+		const int One = 1; m_bSwap = *((const char *)&One) == 1;	// little endian host
+	}
+
+	bool				is_Binary		(void)	const	{	return( m_bBinary );	}
 
 	//-----------------------------------------------------
-	CSG_String Table_Name(Make_Table_Name(_Table_Name));
+	bool				Begin			(const CSG_String &Table, const CSG_Table &Fields, const CSG_Strings &Columns)
+	{
+		m_Types.Create(Columns.Get_Count()); m_bBinary = true;
 
-	if( !Table_Exists(Table_Name) )
+		CSG_String Copy("COPY \"" + Table + "\" (");
+
+		for(int i=0; i<Columns.Get_Count(); i++)
+		{
+			m_Types[i] = TYPE_Other;
+
+			for(sLong j=0; j<Fields.Get_Count(); j++)
+			{
+				if( !Columns[i].Cmp(Fields[j].asString(0)) )
+				{
+					m_Types[i] = _Get_Type(Fields[j].asString(1)); break;
+				}
+			}
+
+			if( m_Types[i] == TYPE_Other )
+			{
+				m_bBinary = false;
+			}
+
+			Copy += CSG_String::Format("%s\"%s\"", i > 0 ? SG_T(",") : SG_T(""), Columns[i].c_str());
+		}
+
+		Copy += m_bBinary ? ") FROM STDIN (FORMAT binary)" : ") FROM STDIN";
+
+		CSG_Buffer SQL = Copy.to_UTF8(); PGresult *pResult = PQexec(m_pConnection, SQL.Get_Data());
+
+		bool bResult = PQresultStatus(pResult) == PGRES_COPY_IN;
+
+		PQclear(pResult);
+
+		if( !bResult )
+		{
+			_Error_Message(_TL("COPY command failed"), m_pConnection);
+
+			return( false );
+		}
+
+		m_Buffer.Clear();
+
+		if( m_bBinary )	// signature, flags, header extension length
+		{
+			m_Buffer.Add((void *)"PGCOPY\n\377\r\n\0", 11, false); m_Buffer.Add((int)0, m_bSwap); m_Buffer.Add((int)0, m_bSwap);
+		}
+
+		return( true );
+	}
+
+	//-----------------------------------------------------
+	bool				End				(bool bOkay)
 	{
-		return( false );
+		if( bOkay && m_bBinary )
+		{
+			m_Buffer.Add((short)-1, m_bSwap);	// file trailer
+		}
+
+		if( bOkay && !_Flush() )
+		{
+			bOkay = false;
+		}
+
+		PQputCopyEnd(m_pConnection, bOkay ? NULL : "cancelled");
+
+		PGresult *pResult;
+
+		while( (pResult = PQgetResult(m_pConnection)) != NULL )
+		{
+			if( PQresultStatus(pResult) != PGRES_COMMAND_OK && bOkay )
+			{
+				_Error_Message(_TL("COPY command failed"), m_pConnection);
+
+				bOkay = false;
+			}
+
+			PQclear(pResult);
+		}
+
+		return( bOkay );
+	}
+
+	//-----------------------------------------------------
+	void				Record_Begin	(void)
+	{
+		if( m_bBinary )
+		{
+			m_Buffer.Add((short)m_Types.Get_Size(), m_bSwap);
+		}
+
+		m_Column = 0;
 	}
 
-	if( Table.Get_Field_Count() <= 0 || Table.Get_Field_Count() != Get_Field_Desc(Table_Name).Get_Count() )
+	bool				Record_End		(void)
 	{
-		return( false );
+		if( !m_bBinary )
+		{
+			m_Buffer += (BYTE)'\n';
+		}
+
+		return( m_Buffer.Get_Count() < 256 * 1024 || _Flush() );
+	}
+
+	//-----------------------------------------------------
+	void				Add_Value		(CSG_Table_Record *pRecord, int Field)
+	{
+		int Type = m_Types[m_Column];
+
+		if( pRecord->is_NoData(Field) )
+		{
+			_Add_NULL();
+		}
+		else if( pRecord->Get_Table()->Get_Field_Type(Field) == SG_DATATYPE_Binary && (Type == TYPE_Bytea || Type == TYPE_Geometry) )
+		{
+			_Add_Bytes(pRecord->Get_Value(Field)->asBinary(), Type == TYPE_Bytea);
+		}
+		else if( !m_bBinary )
+		{
+			_Add_Text(pRecord->asString(Field));
+		}
+		else switch( Type )
+		{
+		case TYPE_Bool    : m_Buffer.Add((int)1, m_bSwap); m_Buffer += (BYTE)(pRecord->asInt(Field) ? 1 : 0); break;
+		case TYPE_Int2    : m_Buffer.Add((int)2, m_bSwap); m_Buffer.Add((short)pRecord->asInt(Field), m_bSwap); break;
+		case TYPE_Int4    : m_Buffer.Add((int)4, m_bSwap); m_Buffer.Add((int)pRecord->asInt(Field), m_bSwap); break;
+		case TYPE_Int8    : { sLong  Value = pRecord->asLong  (Field); m_Buffer.Add((int)8, m_bSwap); m_Buffer.Add(&Value, 8, m_bSwap); } break;
+		case TYPE_Float4  : m_Buffer.Add((int)4, m_bSwap); m_Buffer.Add((float)pRecord->asDouble(Field), m_bSwap); break;
+		case TYPE_Float8  : m_Buffer.Add((int)8, m_bSwap); m_Buffer.Add(pRecord->asDouble(Field), m_bSwap); break;
+		case TYPE_Date    : m_Buffer.Add((int)4, m_bSwap); m_Buffer.Add((int)floor(pRecord->asDouble(Field) + 0.5) - 2451545, m_bSwap); break;	// days since 2000-01-01
+		case TYPE_Geometry: { CSG_Bytes Bytes; Bytes.fromHexString(pRecord->asString(Field)); _Add_Bytes(Bytes, false); } break;
+		default           : _Add_Text(pRecord->asString(Field)); break;
+		}
+
+		m_Column++;
 	}
 
 	//-----------------------------------------------------
-	int nFields = Table.Get_Field_Count();
+	void				Add_Geometry	(CSG_Shape *pShape, int SRID)
+	{
+		CSG_Bytes WKB;
+
+		if( !CSG_Shapes_OGIS_Converter::to_WKBinary(pShape, WKB) )
+		{
+			_Add_NULL();
+		}
+		else if( SRID > 0 )	// EWKB: SRID flag in type and SRID following it (in the byte order of the WKB)
+		{
+			CSG_Bytes EWKB; EWKB += WKB.Get_Bytes()[0]; EWKB += (DWORD)(WKB.asDWord(1, false) | 0x20000000); EWKB += (int)SRID;
 
-	char **paramValues  = (char **)SG_Malloc(nFields * sizeof(char *));
-	int   *paramLengths = (int   *)SG_Malloc(nFields * sizeof(int   ));
-	int   *paramFormats = (int   *)SG_Malloc(nFields * sizeof(int   ));
-//	Oid   *paramTypes   = (Oid   *)SG_Malloc(nFields * sizeof(Oid   ));
+			EWKB.Add(WKB.Get_Bytes() + 5, WKB.Get_Count() - 5, false);
 
-	CSG_Buffer *Values = new CSG_Buffer[nFields];
+			_Add_Bytes(EWKB, false);
+		}
+		else				// plain WKB: PostGIS assigns the unknown SRID (0)
+		{
+			_Add_Bytes(WKB, false);
+		}
 
-	CSG_String Insert("INSERT INTO \"" + Table_Name + "\" VALUES(");
+		m_Column++;
+	}
 
-	for(int iField=0; iField<nFields; iField++)
+
+private:
+
+	bool				m_bBinary { true }, m_bSwap { true };
+
+	int					m_Column { 0 };
+
+	PGconn				*m_pConnection;
+
+	CSG_Array_Int		m_Types;
+
+	CSG_Bytes			m_Buffer;
+
+
+	//-----------------------------------------------------
+	static int			_Get_Type		(const CSG_String &Type)
 	{
-		Insert	+= CSG_String::Format("$%d%c", 1 + iField, iField < nFields - 1 ? SG_T(',') : SG_T(')'));
+		if( !Type.Cmp("bool"    ) ) { return( TYPE_Bool     ); }
+		if( !Type.Cmp("int2"    ) ) { return( TYPE_Int2     ); }
+		if( !Type.Cmp("int4"    ) ) { return( TYPE_Int4     ); }
+		if( !Type.Cmp("int8"    ) ) { return( TYPE_Int8     ); }
+		if( !Type.Cmp("float4"  ) ) { return( TYPE_Float4   ); }
+		if( !Type.Cmp("float8"  ) ) { return( TYPE_Float8   ); }
+		if( !Type.Cmp("bytea"   ) ) { return( TYPE_Bytea    ); }
+		if( !Type.Cmp("date"    ) ) { return( TYPE_Date     ); }
+		if( !Type.Cmp("geometry") ) { return( TYPE_Geometry ); }
+		if( !Type.Cmp("text"    )
+		||  !Type.Cmp("varchar" )
+		||  !Type.Cmp("bpchar"  ) ) { return( TYPE_Text     ); }
 
-		paramFormats[iField]	= Table.Get_Field_Type(iField) == SG_DATATYPE_Binary ? 1 : 0;
+		return( TYPE_Other );	// e.g. numeric, timestamp
+	}
 
-		switch( Table.Get_Field_Type(iField) )
+	//-----------------------------------------------------
+	bool				_Flush			(void)
+	{
+		if( m_Buffer.Get_Count() > 0 && PQputCopyData(m_pConnection, (const char *)m_Buffer.Get_Bytes(), m_Buffer.Get_Count()) != 1 )
 		{
-		case SG_DATATYPE_Binary:
-		case SG_DATATYPE_String:
-			break;
+			_Error_Message(_TL("COPY data transfer failed"), m_pConnection);
 
-		case SG_DATATYPE_Date  :
-			Values[iField].Set_Size(16);
-			break;
- 
-		default                :
-		case SG_DATATYPE_Byte  :
-		case SG_DATATYPE_Short :
-		case SG_DATATYPE_Int   :
-		case SG_DATATYPE_Color :
-		case SG_DATATYPE_Long  :
-		case SG_DATATYPE_Float :
-		case SG_DATATYPE_Double:
-			Values[iField].Set_Size(256);
-			break;
+			return( false );
 		}
+
+		m_Buffer.Clear();
+
+		return( true );
 	}
 
 	//-----------------------------------------------------
-	bool bResult = true;
+	void				_Add_Separator	(void)
+	{
+		if( !m_bBinary && m_Column > 0 )
+		{
+			m_Buffer += (BYTE)'\t';
+		}
+	}
 
-	for(sLong iRecord=0; iRecord<Table.Get_Count() && bResult && SG_UI_Process_Set_Progress(iRecord, Table.Get_Count()); iRecord++)
+	void				_Add_NULL		(void)
 	{
-		CSG_Table_Record *pRecord = Table.Get_Record(iRecord);
+		if( m_bBinary )
+		{
+			m_Buffer.Add((int)-1, m_bSwap);
+		}
+		else
+		{
+			_Add_Separator(); m_Buffer.Add((void *)"\\N", 2, false);
+		}
+	}
 
-		for(int iField=0; iField<Table.Get_Field_Count(); iField++)
+	void				_Add_Bytes		(const CSG_Bytes &Bytes, bool bBytea)
+	{
+		if( m_bBinary )
 		{
-			if( pRecord->is_NoData(iField) )
-			{
-				paramValues [iField] = NULL;
-			}
-			else if( Table.Get_Field_Type(iField) == SG_DATATYPE_Binary )
+			m_Buffer.Add((int)Bytes.Get_Count(), m_bSwap); m_Buffer.Add(Bytes.Get_Bytes(), Bytes.Get_Count(), false);
+		}
+		else
+		{
+			_Add_Separator(); CSG_String Hex(Bytes.toHexString());
+
+			if( bBytea )
 			{
-				paramValues [iField] = (char *)pRecord->Get_Value(iField)->asBinary().Get_Bytes();
-				paramLengths[iField] =         pRecord->Get_Value(iField)->asBinary().Get_Count();
+				m_Buffer.Add((void *)"\\\\x", 3, false);
 			}
-			else
-			{
-				CSG_String Value = pRecord->asString(iField);
 
-				if( Table.Get_Field_Type(iField) == SG_DATATYPE_String )
-				{
-					Values[iField] = Value.to_UTF8();
-				}
-				else
-				{
-					strcpy(Values[iField].Get_Data(), Value.b_str());
-				}
+			m_Buffer.Add((void *)Hex.b_str(), (int)Hex.Length(), false);
+		}
+	}
 
-				paramValues[iField] = Values[iField].Get_Data();
-			}
+	void				_Add_Text		(const CSG_String &Text)
+	{
+		CSG_Buffer UTF8 = Text.to_UTF8(); const char *s = UTF8.Get_Data(); int n = (int)strlen(s);
+
+		if( m_bBinary )
+		{
+			m_Buffer.Add(n, m_bSwap); m_Buffer.Add((void *)s, n, false);
+
+			return;
 		}
 
-		PGresult *pResult = PQexecParams(m_pgConnection, Insert, nFields, NULL, paramValues, paramLengths, paramFormats, 0);
+		_Add_Separator();
 
-		if( PQresultStatus(pResult) != PGRES_COMMAND_OK )
+		for(int i=0; i<n; i++)
 		{
-			_Error_Message(CSG_String::Format("%s (record: %d)", _TL("Record insertion failed"), 1 + iRecord), m_pgConnection);
+			switch( s[i] )
+			{
+			case '\\': m_Buffer.Add((void *)"\\\\", 2, false); break;
+			case '\t': m_Buffer.Add((void *)"\\t" , 2, false); break;
+			case '\n': m_Buffer.Add((void *)"\\n" , 2, false); break;
+			case '\r': m_Buffer.Add((void *)"\\r" , 2, false); break;
+			default  : m_Buffer += (BYTE)s[i]; break;
+			}
+		}
+	}
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CSG_PG_Connection::Table_Insert(const CSG_String &_Table_Name, const CSG_Table &Table, bool bCommit)
+{
+	if( !is_Connected() ) { _Error_Message(_TL("no database connection")); return( false ); }
 
+	//-----------------------------------------------------
+	CSG_String Table_Name(Make_Table_Name(_Table_Name));
+
+	if( !Table_Exists(Table_Name) )
+	{
+		return( false );
+	}
+
+	CSG_Table Fields(Get_Field_Desc(Table_Name));
+
+	if( Table.Get_Field_Count() <= 0 || Table.Get_Field_Count() != Fields.Get_Count() )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	CSG_Strings Columns;
+
+	for(int iField=0; iField<Table.Get_Field_Count(); iField++)
+	{
+		Columns += Fields[iField].asString(0);
+	}
+
+	CSG_PG_Copy Copy(m_pgConnection);
+
+	if( !Copy.Begin(Table_Name, Fields, Columns) )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	bool bResult = true;
+
+	for(sLong iRecord=0; iRecord<Table.Get_Count() && bResult; iRecord++)
+	{
+		if( !SG_UI_Process_Set_Progress(iRecord, Table.Get_Count()) )
+		{
 			bResult = false;
+
+			break;
 		}
 
-		PQclear(pResult);
+		CSG_Table_Record *pRecord = Table.Get_Record(iRecord);
+
+		Copy.Record_Begin();
+
+		for(int iField=0; iField<Table.Get_Field_Count(); iField++)
+		{
+			Copy.Add_Value(pRecord, iField);
+		}
+
+		bResult = Copy.Record_End();
 	}
 
 	//-----------------------------------------------------
-	delete[](Values);
-
-	SG_Free(paramValues );
-	SG_Free(paramLengths);
-	SG_Free(paramFormats);
-//	SG_Free(paramTypes  );
+	bResult = Copy.End(bResult);
 
 	SG_UI_Process_Set_Progress(0., 0.);
 
@@ -1067,6 +1322,104 @@ bool CSG_PG_Connection::Table_Save(const CSG_String &_Table_Name, const CSG_Tabl
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Selections are not fetched as a whole but streamed in
+// chunks of rows (or row by row with older libpq versions),
+// so that the client does not need to hold the complete
+// query result in memory in addition to the loaded data.
+//---------------------------------------------------------
+#ifdef LIBPQ_HAS_CHUNK_MODE
+#define PG_IS_TUPLES(pResult)	(PQresultStatus(pResult) == PGRES_TUPLES_OK || PQresultStatus(pResult) == PGRES_SINGLE_TUPLE || PQresultStatus(pResult) == PGRES_TUPLES_CHUNK)
+#else
+#define PG_IS_TUPLES(pResult)	(PQresultStatus(pResult) == PGRES_TUPLES_OK || PQresultStatus(pResult) == PGRES_SINGLE_TUPLE)
+#endif
+
+#define PG_CHUNK_SIZE	10000
+
+//---------------------------------------------------------
+void * CSG_PG_Connection::_Query_Begin(const CSG_String &Select) const
+{
+	if( !PQsendQuery(m_pgConnection, Select) )
+	{
+		_Error_Message(_TL("SQL execution failed"), m_pgConnection);
+
+		return( NULL );
+	}
+
+#ifdef LIBPQ_HAS_CHUNK_MODE
+	if( !PQsetChunkedRowsMode(m_pgConnection, PG_CHUNK_SIZE) )
+#endif
+	{
+		PQsetSingleRowMode(m_pgConnection);
+	}
+
+	//-----------------------------------------------------
+	PGresult *pResult = PQgetResult(m_pgConnection);
+
+	if( !pResult || !PG_IS_TUPLES(pResult) )
+	{
+		_Error_Message(_TL("SQL execution failed"), m_pgConnection);
+
+		bool bOkay = false; _Query_Next(pResult, bOkay);
+
+		return( NULL );
+	}
+
+	return( pResult );
+}
+
+//---------------------------------------------------------
+// Frees the given result and returns the next one or NULL
+// if the query has been completed. Cancels a running query
+// if bOkay is false and sets bOkay to false, if the server
+// reported an error.
+//---------------------------------------------------------
+void * CSG_PG_Connection::_Query_Next(void *_pResult, bool &bOkay) const
+{
+	PGresult *pResult = (PGresult *)_pResult;
+
+	bool bLast = !pResult || PQresultStatus(pResult) == PGRES_TUPLES_OK;	// the last result of a streamed query comes with zero rows and 'tuples okay'
+
+	PQclear(pResult);
+
+	if( !bLast )
+	{
+		if( !bOkay )
+		{
+			PGcancel *pCancel = PQgetCancel(m_pgConnection);
+
+			if( pCancel )
+			{
+				char Error[256]; PQcancel(pCancel, Error, sizeof(Error)); PQfreeCancel(pCancel);
+			}
+		}
+		else if( (pResult = PQgetResult(m_pgConnection)) != NULL )
+		{
+			if( PG_IS_TUPLES(pResult) )
+			{
+				return( pResult );
+			}
+
+			_Error_Message(_TL("SQL execution failed"), m_pgConnection);
+
+			PQclear(pResult); bOkay = false;
+		}
+	}
+
+	//-----------------------------------------------------
+	while( (pResult = PQgetResult(m_pgConnection)) != NULL )	// consume remaining results, connection is ready for the next command afterwards
+	{
+		PQclear(pResult);
+	}
+
+	return( NULL );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
@@ -1077,11 +1430,53 @@ bool CSG_PG_Connection::_Table_Load(CSG_Table &Table, const CSG_String &Select,
 	if( !is_Connected() ) { _Error_Message(_TL("no database connection")); return( false ); }
 
 	//-----------------------------------------------------
-	bool bResult = _Table_Load(Table, PQexec(m_pgConnection, Select));
+	PGresult *pResult = (PGresult *)_Query_Begin(Select);
+
+	if( !pResult )
+	{
+		return( false );
+	}
+
+	int nFields = PQnfields(pResult);
+
+	if( nFields <= 0 )
+	{
+		_Error_Message(_TL("no fields in selection"));
+
+		bool bOkay = false; _Query_Next(pResult, bOkay);
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	Table.Destroy();
+
+	for(int iField=0; iField<nFields; iField++)
+	{
+		Table.Add_Field(PQfname(pResult, iField), Get_Type_From_SQL(PQftype(pResult, iField)));
+	}
+
+	//-----------------------------------------------------
+	bool bOkay = true;
+
+	for(sLong n=0; pResult; pResult=(PGresult *)_Query_Next(pResult, bOkay))
+	{
+		for(int iRecord=0; bOkay && iRecord<PQntuples(pResult); iRecord++, n++)
+		{
+			if( n % 1000 == 0 && !SG_UI_Process_Get_Okay() )	// total number of records is unknown while streaming
+			{
+				bOkay = false;
+			}
+			else
+			{
+				_Table_Load_Record(Table, pResult, iRecord);
+			}
+		}
+	}
 
 	Table.Set_Name(Name);
 
-	return( bResult );
+	return( bOkay );
 }
 
 //---------------------------------------------------------
@@ -1121,31 +1516,7 @@ bool CSG_PG_Connection::_Table_Load(CSG_Table &Table, void *_pResult) const
 
 	for(int iRecord=0; iRecord<nRecords && SG_UI_Process_Set_Progress(iRecord, nRecords); iRecord++)
 	{
-		CSG_Table_Record *pRecord = Table.Add_Record();
-
-		for(int iField=0; pRecord && iField<nFields; iField++)
-		{
-			if( PQgetisnull(pResult, iRecord, iField) )
-			{
-				pRecord->Set_NoData(iField);
-			}
-			else switch( Table.Get_Field_Type(iField) )
-			{
-			default:
-				pRecord->Set_Value(iField, PQgetvalue(pResult, iRecord, iField));
-				break;
-
-			case SG_DATATYPE_String:
-				pRecord->Set_Value(iField, CSG_String::from_UTF8(PQgetvalue(pResult, iRecord, iField)));
-				break;
-
-			case SG_DATATYPE_Binary: {
-				CSG_Bytes	Binary; Binary.fromHexString(PQgetvalue(pResult, iRecord, iField) + 2);
-
-				pRecord->Set_Value(iField, Binary);
-				break; }
-			}
-		}
+		_Table_Load_Record(Table, pResult, iRecord);
 	}
 
 	//-----------------------------------------------------
@@ -1156,6 +1527,38 @@ bool CSG_PG_Connection::_Table_Load(CSG_Table &Table, void *_pResult) const
 	return( true );
 }
 
+//---------------------------------------------------------
+inline bool CSG_PG_Connection::_Table_Load_Record(CSG_Table &Table, void *_pResult, int iRecord) const
+{
+	PGresult *pResult = (PGresult *)_pResult; CSG_Table_Record *pRecord = Table.Add_Record();
+
+	for(int iField=0; pRecord && iField<Table.Get_Field_Count(); iField++)
+	{
+		if( PQgetisnull(pResult, iRecord, iField) )
+		{
+			pRecord->Set_NoData(iField);
+		}
+		else switch( Table.Get_Field_Type(iField) )
+		{
+		default:
+			pRecord->Set_Value(iField, PQgetvalue(pResult, iRecord, iField));
+			break;
+
+		case SG_DATATYPE_String:
+			pRecord->Set_Value(iField, CSG_String::from_UTF8(PQgetvalue(pResult, iRecord, iField)));
+			break;
+
+		case SG_DATATYPE_Binary: {
+			CSG_Bytes	Binary; Binary.fromHexString(PQgetvalue(pResult, iRecord, iField) + 2);
+
+			pRecord->Set_Value(iField, Binary);
+			break; }
+		}
+	}
+
+	return( pRecord != NULL );
+}
+
 //---------------------------------------------------------
 bool CSG_PG_Connection::Table_Load(CSG_Table &Table, const CSG_String &Table_Name)
 {
@@ -1296,35 +1699,27 @@ bool CSG_PG_Connection::_Shapes_Load(const CSG_String &geoTable, const CSG_Strin
 }
 
 //---------------------------------------------------------
-void * CSG_PG_Connection::_Shapes_Load(const CSG_String &Select, const CSG_String &geoFieldName, int &nFields, int &nRecords, int &geoField)
+void * CSG_PG_Connection::_Shapes_Load(const CSG_String &Select, const CSG_String &geoFieldName, int &nFields, int &geoField)
 {
 	if( !is_Connected() ) { _Error_Message(_TL("no database connection")); return( NULL ); }
 	if( !has_PostGIS () ) { _Error_Message(_TL("not a PostGIS database")); return( NULL ); }
 
 	//-----------------------------------------------------
-	PGresult *pResult = PQexec(m_pgConnection, Select);
+	PGresult *pResult = (PGresult *)_Query_Begin(Select);
 
-	if( PQresultStatus(pResult) != PGRES_TUPLES_OK )
+	if( !pResult )
 	{
-		_Error_Message(_TL("SQL execution failed"), m_pgConnection);
-
-		PQclear(pResult); return( NULL );
+		return( NULL );
 	}
 
+	bool bOkay = false;	// used to cancel the query on failure
+
 	//-----------------------------------------------------
 	if( (nFields = PQnfields(pResult)) <= 0 )
 	{
 		_Error_Message(_TL("no fields in selection"));
 
-		PQclear(pResult); return( NULL );
-	}
-
-	//-----------------------------------------------------
-	if( (nRecords = PQntuples(pResult)) <= 0 )
-	{
-		_Error_Message(_TL("no records in selection"));
-
-		PQclear(pResult); return( NULL );
+		_Query_Next(pResult, bOkay); return( NULL );
 	}
 
 	//-----------------------------------------------------
@@ -1342,7 +1737,7 @@ void * CSG_PG_Connection::_Shapes_Load(const CSG_String &Select, const CSG_Strin
 	{
 		_Error_Message(_TL("no geometry in selection"));
 
-		PQclear(pResult); return( NULL );
+		_Query_Next(pResult, bOkay); return( NULL );
 	}
 
 	//-----------------------------------------------------
@@ -1446,7 +1841,7 @@ bool CSG_PG_Connection::Shapes_Load(CSG_Shapes *pShapes, const CSG_String &Name,
 //---------------------------------------------------------
 bool CSG_PG_Connection::Shapes_Load(CSG_Shapes *pShapes, const CSG_String &Name, const CSG_String &Select, const CSG_String &geoFieldName, bool bBinary, int SRID)
 {
-	int nFields, nRecords, geoField; PGresult *pResult = (PGresult *)_Shapes_Load(Select, geoFieldName, nFields, nRecords, geoField);
+	int nFields, geoField; PGresult *pResult = (PGresult *)_Shapes_Load(Select, geoFieldName, nFields, geoField);
 
 	if( !pResult )
 	{
@@ -1454,8 +1849,16 @@ bool CSG_PG_Connection::Shapes_Load(CSG_Shapes *pShapes, const CSG_String &Name,
 	}
 
 	//-----------------------------------------------------
-	for(int iRecord=0; iRecord<nRecords && SG_UI_Process_Set_Progress(iRecord, nRecords); iRecord++)
+	bool bOkay = true; sLong n = 0;
+
+	for( ; pResult; pResult=(PGresult *)_Query_Next(pResult, bOkay))
+	for(int iRecord=0; bOkay && iRecord<PQntuples(pResult); iRecord++)
 	{
+		if( n++ % 1000 == 0 && !SG_UI_Process_Get_Okay() )
+		{
+			bOkay = false; break;
+		}
+
 		TSG_Shape_Type Geometry; TSG_Vertex_Type Vertex; _Shape_Get_Type(PQgetvalue(pResult, iRecord, geoField), bBinary, Geometry, Vertex);
 
 		if( Geometry == SHAPE_TYPE_Undefined || (Geometry != pShapes->Get_Type() && pShapes->Get_Type() != SHAPE_TYPE_Undefined) )
@@ -1479,12 +1882,13 @@ bool CSG_PG_Connection::Shapes_Load(CSG_Shapes *pShapes, const CSG_String &Name,
 		_Shape_Load_Record(pResult, iRecord, geoField, bBinary, pShapes);
 	}
 
-	SG_UI_Process_Set_Progress(0., 0.);
-
-	PQclear(pResult);
+	if( n == 0 )
+	{
+		_Error_Message(_TL("no records in selection"));
+	}
 
 	//-----------------------------------------------------
-	if( pShapes->is_Valid() )
+	if( bOkay && pShapes->is_Valid() )
 	{
 		Add_MetaData(*pShapes, Name, Select);
 
@@ -1519,7 +1923,7 @@ int CSG_PG_Connection::Shapes_Load(CSG_Shapes *pShapes[4], const CSG_String &Nam
 //---------------------------------------------------------
 int CSG_PG_Connection::Shapes_Load(CSG_Shapes *pShapes[4], const CSG_String &Name, const CSG_String &Select, const CSG_String &geoFieldName, bool bBinary, int SRID)
 {
-	int nFields, nRecords, geoField; PGresult *pResult = (PGresult *)_Shapes_Load(Select, geoFieldName, nFields, nRecords, geoField);
+	int nFields, geoField; PGresult *pResult = (PGresult *)_Shapes_Load(Select, geoFieldName, nFields, geoField);
 
 	if( !pResult )
 	{
@@ -1529,8 +1933,16 @@ int CSG_PG_Connection::Shapes_Load(CSG_Shapes *pShapes[4], const CSG_String &Nam
 	for(int i=0; i<4; i++) { pShapes[i] = NULL; }
 
 	//-----------------------------------------------------
-	for(int iRecord=0; iRecord<nRecords && SG_UI_Process_Set_Progress(iRecord, nRecords); iRecord++)
+	bool bOkay = true; sLong n = 0;
+
+	for( ; pResult; pResult=(PGresult *)_Query_Next(pResult, bOkay))
+	for(int iRecord=0; bOkay && iRecord<PQntuples(pResult); iRecord++)
 	{
+		if( n++ % 1000 == 0 && !SG_UI_Process_Get_Okay() )
+		{
+			bOkay = false; break;
+		}
+
 		TSG_Shape_Type Geometry; TSG_Vertex_Type Vertex; _Shape_Get_Type(PQgetvalue(pResult, iRecord, geoField), bBinary, Geometry, Vertex);
 
 		if( Geometry == SHAPE_TYPE_Undefined )
@@ -1559,9 +1971,10 @@ int CSG_PG_Connection::Shapes_Load(CSG_Shapes *pShapes[4], const CSG_String &Nam
 		_Shape_Load_Record(pResult, iRecord, geoField, bBinary, pShapes[i]);
 	}
 
-	SG_UI_Process_Set_Progress(0., 0.);
-
-	PQclear(pResult);
+	if( n == 0 )
+	{
+		_Error_Message(_TL("no records in selection"));
+	}
 
 	//-----------------------------------------------------
 	int nValid = 0;
@@ -1603,150 +2016,68 @@ bool CSG_PG_Connection::Shapes_Insert(CSG_Shapes *pShapes, const CSG_String &_ge
 		return( false );
 	}
 
-	//-----------------------------------------------------
-	int nFields = pShapes->Get_Field_Count();
-
-	char **paramValues  = (char **)SG_Malloc((1 + (size_t)nFields) * sizeof(char *));
-	int   *paramLengths = (int   *)SG_Malloc((1 + (size_t)nFields) * sizeof(int   ));
-	int   *paramFormats = (int   *)SG_Malloc((1 + (size_t)nFields) * sizeof(int   ));
-//	Oid   *paramTypes   = (Oid   *)SG_Malloc((1 + (size_t)nFields) * sizeof(Oid   ));
-
-	CSG_Buffer *Values = new CSG_Buffer[1 + (size_t)nFields];
-
-	CSG_String Insert("INSERT INTO \"" + geoTable + "\" (");
-
-	for(int iField=0; iField<nFields; iField++)
+	if( geoSRID <= 0 )	// column without SRID constraint, take the layer's EPSG code if there is one, else insert with unknown SRID
 	{
-		Insert += "\"" + Make_Table_Field_Name(pShapes, iField) + "\", ";
-	}
+		geoSRID = pShapes->Get_Projection().Get_EPSG();
 
-	Insert += "\"" + geoField + "\") VALUES (";
-
-	for(int iField=0; iField<nFields; iField++)
-	{
-		Insert += CSG_String::Format("$%d, ", 1 + iField);
-
-		paramFormats[iField] = pShapes->Get_Field_Type(iField) == SG_DATATYPE_Binary ? 1 : 0;
-
-		switch( pShapes->Get_Field_Type(iField) )
+		if( geoSRID <= 0 )
 		{
-		case SG_DATATYPE_Binary:
-		case SG_DATATYPE_String:
-			break;
-
-		case SG_DATATYPE_Date  :
-			Values[iField].Set_Size(16);
-			break;
-
-		default                :
-		case SG_DATATYPE_Byte  :
-		case SG_DATATYPE_Short :
-		case SG_DATATYPE_Int   :
-		case SG_DATATYPE_Color :
-		case SG_DATATYPE_Long  :
-		case SG_DATATYPE_Float :
-		case SG_DATATYPE_Double:
-			Values[iField].Set_Size(256);
-			break;
+			SG_UI_Msg_Add_Execution(CSG_String::Format("\n[PostGIS] %s: %s", geoTable.c_str(), _TL("no SRID, geometries are inserted with unknown SRID (0)")), false);
 		}
 	}
 
-	bool bBinary = has_Version(9);
+	//-----------------------------------------------------
+	CSG_Strings Columns;
 
-	if( bBinary )
+	for(int iField=0; iField<pShapes->Get_Field_Count(); iField++)
 	{
-		Insert += CSG_String::Format("ST_GeomFromWKB($%d, %d))" , 1 + nFields, geoSRID);
-
-		paramFormats[nFields] = 1;
+		Columns += Make_Table_Field_Name(pShapes, iField);
 	}
-	else
-	{
-		Insert += CSG_String::Format("ST_GeomFromText($%d, %d))", 1 + nFields, geoSRID);
 
-		paramFormats[nFields] = 0;
+	Columns += geoField;
+
+	CSG_PG_Copy Copy(m_pgConnection);
+
+	if( !Copy.Begin(geoTable, Get_Field_Desc(geoTable), Columns) )
+	{
+		return( false );
 	}
 
 	//-----------------------------------------------------
 	bool bResult = true;
 
-	for(sLong iShape=0; iShape<pShapes->Get_Count() && bResult && SG_UI_Process_Set_Progress(iShape, pShapes->Get_Count()); iShape++)
+	for(sLong iShape=0; iShape<pShapes->Get_Count() && bResult; iShape++)
 	{
-		CSG_Shape *pShape = pShapes->Get_Shape(iShape);
-
-		if( !pShape->is_Valid() )
+		if( !SG_UI_Process_Set_Progress(iShape, pShapes->Get_Count()) )
 		{
 			bResult = false;
 
-			continue;
-		}
-
-		//-------------------------------------------------
-		for(int iField=0; iField<pShapes->Get_Field_Count(); iField++)
-		{
-			if( pShape->is_NoData(iField) )
-			{
-				paramValues [iField] = NULL;
-			}
-			else if( pShapes->Get_Field_Type(iField) == SG_DATATYPE_Binary )
-			{
-				paramValues [iField] = (char *)pShape->Get_Value(iField)->asBinary().Get_Bytes();
-				paramLengths[iField] =         pShape->Get_Value(iField)->asBinary().Get_Count();
-			}
-			else
-			{
-				CSG_String Value = pShape->asString(iField);
-
-				if( pShapes->Get_Field_Type(iField) == SG_DATATYPE_String )
-				{
-					Values[iField] = Value.to_UTF8();
-				}
-				else
-				{
-					strcpy(Values[iField].Get_Data(), Value.b_str());
-				}
-
-				paramValues[iField] = Values[iField].Get_Data();
-			}
+			break;
 		}
 
-		//-------------------------------------------------
-		CSG_Bytes WKB; CSG_String WKT;
-
-		if( bBinary )
-		{
-			CSG_Shapes_OGIS_Converter::to_WKBinary(pShape, WKB);
+		CSG_Shape *pShape = pShapes->Get_Shape(iShape);
 
-			paramValues [nFields] = (char *)WKB.Get_Bytes();
-			paramLengths[nFields] =         WKB.Get_Count();
-		}
-		else
+		if( !pShape->is_Valid() )
 		{
-			CSG_Shapes_OGIS_Converter::to_WKText  (pShape, WKT);
+			bResult = false;
 
-			Values[nFields].Set_Data(WKT.b_str(), WKT.Length() + 1); WKT.Clear();
-			paramValues[nFields] = Values[nFields].Get_Data();
+			break;
 		}
 
-		//-------------------------------------------------
-		PGresult *pResult = PQexecParams(m_pgConnection, Insert, 1 + nFields, NULL, paramValues, paramLengths, paramFormats, 0);
+		Copy.Record_Begin();
 
-		if( PQresultStatus(pResult) != PGRES_COMMAND_OK )
+		for(int iField=0; iField<pShapes->Get_Field_Count(); iField++)
 		{
-			_Error_Message(CSG_String::Format("%s (record: %d)", _TL("Record insertion failed"), 1 + iShape), m_pgConnection);
-
-			bResult	= false;
+			Copy.Add_Value(pShape, iField);
 		}
 
-		PQclear(pResult);
+		Copy.Add_Geometry(pShape, geoSRID);
+
+		bResult = Copy.Record_End();
 	}
 
 	//-----------------------------------------------------
-	delete[](Values);
-
-	SG_Free(paramValues );
-	SG_Free(paramLengths);
-	SG_Free(paramFormats);
-//	SG_Free(paramTypes  );
+	bResult = Copy.End(bResult);
 
 	SG_UI_Process_Set_Progress(0., 0.);
 
@@ -163,10 +163,14 @@ private:
 
 	bool						_Table_Load				(CSG_Table &Data, const CSG_String &Select, const CSG_String &Name = "")	const;
 	bool						_Table_Load				(CSG_Table &Data, void *pResult)	const;
+	bool						_Table_Load_Record		(CSG_Table &Data, void *pResult, int iRecord)	const;
+
+	void *						_Query_Begin			(const CSG_String &Select)	const;
+	void *						_Query_Next				(void *pResult, bool &bOkay)	const;
 
 	bool						_Shapes_Load			(const CSG_String &geoTable, CSG_String &Fields);
 	bool						_Shapes_Load			(const CSG_String &geoTable, const CSG_String &Geometry, bool bBinary, const CSG_String &Tables, const CSG_String &Fields, const CSG_String &Where, const CSG_String &Group, const CSG_String &Having, const CSG_String &Order, bool bDistinct, int &SRID, CSG_String &Select, bool bVerbose);
-	void *						_Shapes_Load			(const CSG_String &Select, const CSG_String &geoFieldName, int &nFields, int &nRecords, int &geoField);
+	void *						_Shapes_Load			(const CSG_String &Select, const CSG_String &geoFieldName, int &nFields, int &geoField);
 	bool						_Shape_Get_Type			(const char *WKBytes, bool bBinary, TSG_Shape_Type &Geometry, TSG_Vertex_Type &Vertex);
 	TSG_Shape_Type				_Shape_Get_Type			(const char *WKBytes, bool bBinary);
 	bool						_Shape_Load_Record		(void *_pResult, int iRecord, int geoField, bool bBinary, CSG_Shapes *pShapes);
@@ -614,7 +614,7 @@ void CShapes2Grid::Set_Line_Fat(TSG_Point a, TSG_Point b, double Value)
 //---------------------------------------------------------
 void CShapes2Grid::Set_Polygon(CSG_Shape *pShape, bool bFat, double Value)
 {
-	Set_Polygon((CSG_Shape_Polygon *)pShape, Value);
+	Set_Polygon((CSG_Shape_Polygon *)pShape, Value, bFat);
 
 	if( bFat )	// all cells intersected have to be marked
 	{
@@ -623,82 +623,26 @@ void CShapes2Grid::Set_Polygon(CSG_Shape *pShape, bool bFat, double Value)
 }
 
 //---------------------------------------------------------
-void CShapes2Grid::Set_Polygon(CSG_Shape_Polygon *pPolygon, double Value)
+void CShapes2Grid::Set_Polygon(CSG_Shape_Polygon *pPolygon, double Value, bool bFat)
 {
-	bool *bCrossing = (bool *)SG_Malloc(m_pGrid->Get_NX() * sizeof(bool));
+	CSG_Shape_Polygon_Rasterizer Rasterizer(m_pGrid->Get_System());
 
-	CSG_Rect Extent(pPolygon->Get_Extent());
-
-	int xStart = (int)((Extent.Get_XMin() - m_pGrid->Get_XMin()) / m_pGrid->Get_Cellsize()) - 1; if( xStart < 0                 ) { xStart = 0;                     }
-	int xStop  = (int)((Extent.Get_XMax() - m_pGrid->Get_XMin()) / m_pGrid->Get_Cellsize()) + 1; if( xStop >= m_pGrid->Get_NX() ) { xStop  = m_pGrid->Get_NX() - 1; }
-
-	TSG_Point A, B;
-
-	A.y = m_pGrid->Get_YMin();
-	A.x = m_pGrid->Get_XMin() - 1.;
-	B.x = m_pGrid->Get_XMax() + 1.;
-
-	//-----------------------------------------------------
-	for(int y=0; y<m_pGrid->Get_NY(); y++, A.y+=m_pGrid->Get_Cellsize())
+	if( Rasterizer.Set_Polygon(pPolygon) )
 	{
-		if( A.y >= Extent.yMin && A.y <= Extent.yMax )
+		#pragma omp parallel for if(!bFat && Rasterizer.Get_yMax() - Rasterizer.Get_yMin() > 16)
+		for(int y=Rasterizer.Get_yMin(); y<=Rasterizer.Get_yMax(); y++)
 		{
-			B.y = A.y;
+			CSG_Array_Int Spans;
 
-			memset(bCrossing, 0, m_pGrid->Get_NX() * sizeof(bool));
-
-			for(int iPart=0; iPart<pPolygon->Get_Part_Count(); iPart++)
+			for(int i=0, n=Rasterizer.Get_Spans(y, Spans); i<n; i++)
 			{
-				if( pPolygon->Get_Part(iPart)->Get_Extent().Intersects(m_pGrid->Get_Extent(true)) )
-				{
-					TSG_Point b = pPolygon->Get_Point(pPolygon->Get_Point_Count(iPart) - 1, iPart);
-
-					for(int iPoint=0; iPoint<pPolygon->Get_Point_Count(iPart); iPoint++)
-					{
-						TSG_Point c, a = b; b = pPolygon->Get_Point(iPoint, iPart);
-
-						if(	((a.y <= A.y && A.y  < b.y)
-						||	 (a.y  > A.y && A.y >= b.y)) )
-						{
-							SG_Get_Crossing(c, a, b, A, B, false);
-
-							int x = (int)(1. + X_WORLD_TO_GRID(c.x));
-
-							if( x < 0 )
-							{
-								x = 0;
-							}
-							else if( x >= m_pGrid->Get_NX() )
-							{
-								continue;
-							}
-
-							bCrossing[x] = !bCrossing[x];
-						}
-					}
-				}
-			}
-
-			//---------------------------------------------
-			bool bFill = false;
-
-			for(int x=xStart; x<=xStop; x++)
-			{
-				if( bCrossing[x] )
-				{
-					bFill = !bFill;
-				}
-
-				if( bFill )
+				for(int x=Spans[2 * i]; x<=Spans[2 * i + 1]; x++)
 				{
-					Set_Value(x, y, Value);
+					Set_Value(x, y, Value, bFat);
 				}
 			}
 		}
 	}
-
-	//-----------------------------------------------------
-	SG_Free(bCrossing);
 }
 
 
@@ -971,44 +915,27 @@ inline void CPolygons2Grid::Set_Value(int x, int y, double Value, double Coverag
 //---------------------------------------------------------
 void CPolygons2Grid::Set_Polygon(CSG_Shape_Polygon *pPolygon, double Value)
 {
-	//-----------------------------------------------------
-	CSG_Grid_System	s(m_pGrid->Get_System());
-
-	int	xA	= s.Get_xWorld_to_Grid(pPolygon->Get_Extent().Get_XMin());	if( xA <  0          )	xA	= 0;
-	int	xB	= s.Get_xWorld_to_Grid(pPolygon->Get_Extent().Get_XMax());	if( xB >= s.Get_NX() )	xB	= s.Get_NX() - 1;
-	int	yA	= s.Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMin());	if( yA <  0          )	yA	= 0;
-	int	yB	= s.Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMax());	if( yB >= s.Get_NY() )	yB	= s.Get_NY() - 1;
-
-	//-----------------------------------------------------
-	CSG_Shapes	Intersect(SHAPE_TYPE_Polygon);
-
-	CSG_Shape_Polygon	*pCell	= (CSG_Shape_Polygon *)Intersect.Add_Shape();
-
-	TSG_Rect	r;
+	CSG_Shape_Polygon_Rasterizer Rasterizer(m_pGrid->Get_System());
 
-	r.yMax	= s.Get_yGrid_to_World(yA) - 0.5 * s.Get_Cellsize();
-
-	for(int y=yA; y<=yB; y++)
+	if( Rasterizer.Set_Polygon(pPolygon, true) )
 	{
-		r.yMin	= r.yMax;	r.yMax	+= s.Get_Cellsize();
-
-		r.xMax	= s.Get_xGrid_to_World(xA) - 0.5 * s.Get_Cellsize();
+		double Cellarea = m_pGrid->Get_Cellarea();
 
-		for(int x=xA; x<=xB; x++)
+		#pragma omp parallel for if(Rasterizer.Get_yMax() - Rasterizer.Get_yMin() > 16)
+		for(int y=Rasterizer.Get_yMin(); y<=Rasterizer.Get_yMax(); y++)
 		{
-			r.xMin	= r.xMax;	r.xMax	+= s.Get_Cellsize();
+			CSG_Vector Coverage;
 
-			pCell->Add_Point(r.xMin, r.yMin);
-			pCell->Add_Point(r.xMin, r.yMax);
-			pCell->Add_Point(r.xMax, r.yMax);
-			pCell->Add_Point(r.xMax, r.yMin);
-
-			if( SG_Shape_Get_Intersection(pCell, pPolygon) )
+			if( Rasterizer.Get_Coverage(y, Coverage) )
 			{
-				Set_Value(x, y, Value, pCell->Get_Area());
+				for(int x=Rasterizer.Get_xMin(), i=0; x<=Rasterizer.Get_xMax(); x++, i++)
+				{
+					if( Coverage[i] > 0. )
+					{
+						Set_Value(x, y, Value, Cellarea * Coverage[i]);
+					}
+				}
 			}
-
-			pCell->Del_Parts();
 		}
 	}
 }
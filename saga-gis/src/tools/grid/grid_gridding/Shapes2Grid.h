@@ -103,7 +103,7 @@ private:
 	void						Set_Line_Fat			(TSG_Point a, TSG_Point b, double Value);
 
 	void						Set_Polygon				(CSG_Shape *pShape, bool bFat, double Value);
-	void						Set_Polygon				(CSG_Shape_Polygon *pPolygon, double Value);
+	void						Set_Polygon				(CSG_Shape_Polygon *pPolygon, double Value, bool bFat);
 
 };
 
@@ -237,37 +237,29 @@ bool CGrid_Cell_Polygon_Coverage::On_Execute(void)
 //---------------------------------------------------------
 bool CGrid_Cell_Polygon_Coverage::Get_Area(CSG_Shape_Polygon *pPolygon, CSG_Grid *pArea)
 {
-	CSG_Grid_System	s(pArea->Get_System());
+	CSG_Shape_Polygon_Rasterizer Rasterizer(pArea->Get_System());
 
-	int	xMin = s.Get_xWorld_to_Grid(pPolygon->Get_Extent().Get_XMin()); if( xMin <  0          ) xMin = 0;
-	int	xMax = s.Get_xWorld_to_Grid(pPolygon->Get_Extent().Get_XMax()); if( xMax >= s.Get_NX() ) xMax = s.Get_NX() - 1;
-	int	yMin = s.Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMin()); if( yMin <  0          ) yMin = 0;
-	int	yMax = s.Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMax()); if( yMax >= s.Get_NY() ) yMax = s.Get_NY() - 1;
-
-	double	d	= 0.5 * s.Get_Cellsize();
-
-	#pragma omp parallel for
-	for(int y=yMin; y<=yMax; y++)
+	if( !Rasterizer.Set_Polygon(pPolygon, true) )
 	{
-		CSG_Shapes Cell(SHAPE_TYPE_Polygon); CSG_Shape_Polygon *pCell = (CSG_Shape_Polygon *)Cell.Add_Shape();
+		return( false );
+	}
 
-		TSG_Point	p;	p.y	= s.Get_YMin() + s.Get_Cellsize() * y;
+	double Cellarea = pArea->Get_Cellarea();
 
-		p.x	= s.Get_XMin() + s.Get_Cellsize() * xMin;
+	#pragma omp parallel for if(Rasterizer.Get_yMax() - Rasterizer.Get_yMin() > 16)
+	for(int y=Rasterizer.Get_yMin(); y<=Rasterizer.Get_yMax(); y++)
+	{
+		CSG_Vector Coverage;
 
-		for(int x=xMin; x<=xMax; x++, p.x+=s.Get_Cellsize())
+		if( Rasterizer.Get_Coverage(y, Coverage) )
 		{
-			pCell->Add_Point(p.x - d, p.y - d);
-			pCell->Add_Point(p.x - d, p.y + d);
-			pCell->Add_Point(p.x + d, p.y + d);
-			pCell->Add_Point(p.x + d, p.y - d);
-
-			if( SG_Shape_Get_Intersection(pCell, pPolygon) && pCell->Get_Area() > 0.0 )
+			for(int x=Rasterizer.Get_xMin(), i=0; x<=Rasterizer.Get_xMax(); x++, i++)
 			{
-				pArea->Add_Value(x, y, pCell->Get_Area());
+				if( Coverage[i] > 0. )
+				{
+					pArea->Add_Value(x, y, Cellarea * Coverage[i]);
+				}
 			}
-
-			pCell->Del_Parts();
 		}
 	}
 
@@ -68,7 +68,16 @@ CGridding_Spline_TPS_Local::CGridding_Spline_TPS_Local(void)
 		"Creates a 'Thin Plate Spline' function for each grid point "
 		"based on all of the scattered data points that are within a "
 		"given distance. The number of points can be limited to a "
-		"maximum number of closest points."
+		"maximum number of closest points. "
+		"\n\n"
+		"Alternatively the partition of unity approach can be used. "
+		"The points are split by a quadtree into partitions with a "
+		"limited number of points. A local spline is calculated only "
+		"once for each partition, using all points of a circular, "
+		"overlapping patch. The values of the patches covering a "
+		"location are blended with smooth, compactly supported weights. "
+		"This scales to large point sets that cannot be handled by a "
+		"global spline. "
 	));
 
 	Add_Reference("Donato G., Belongie S.", "2002",
@@ -90,6 +99,24 @@ CGridding_Spline_TPS_Local::CGridding_Spline_TPS_Local(void)
 		0.0001, 0., true
 	);
 
+	Parameters.Add_Bool(
+		"", "PARTITION"			, _TL("Partition of Unity"),
+		_TL("Blend local splines calculated once for each partition of a quadtree instead of calculating a spline for each cell."),
+		false
+	);
+
+	Parameters.Add_Int(
+		"PARTITION", "PARTITION_POINTS", _TL("Points per Partition"),
+		_TL("Maximum number of points in a quadtree partition."),
+		32, 8, true
+	);
+
+	Parameters.Add_Double(
+		"PARTITION", "PARTITION_OVERLAP", _TL("Overlap"),
+		_TL("Radius of the patches relative to half the diagonal of their partitions."),
+		1.5, 1.1, true
+	);
+
 	//-----------------------------------------------------
 	m_Search.Create(&Parameters, "NODE_SEARCH", 16);
 }
@@ -115,6 +142,13 @@ int CGridding_Spline_TPS_Local::On_Parameters_Enable(CSG_Parameters *pParameters
 {
 	m_Search.On_Parameters_Enable(pParameters, pParameter);
 
+	if( pParameter->Cmp_Identifier("PARTITION") )
+	{
+		pParameters->Set_Enabled("PARTITION_POINTS" , pParameter->asBool());
+		pParameters->Set_Enabled("PARTITION_OVERLAP", pParameter->asBool());
+		pParameters->Set_Enabled("NODE_SEARCH"      , pParameter->asBool() == false);
+	}
+
 	return( CGridding_Spline_Base::On_Parameters_Enable(pParameters, pParameter) );
 }
 
@@ -129,7 +163,42 @@ bool CGridding_Spline_TPS_Local::On_Execute(void)
 	double	Regularization	= Parameters("REGULARISATION")->asDouble();
 
 	//-----------------------------------------------------
-	if( m_Search.Do_Use_All(true) )	// global
+	if( Parameters("PARTITION")->asBool() )	// partition of unity
+	{
+		CSG_Thin_Plate_Spline_PU	Spline;
+
+		if( !Initialize(Spline.Get_Points()) || !Spline.Create(Regularization,
+			Parameters("PARTITION_POINTS" )->asInt   (),
+			Parameters("PARTITION_OVERLAP")->asDouble(), false) )
+		{
+			return( false );
+		}
+
+		Message_Fmt("\n%s: %d", _TL("partitions"), Spline.Get_Patch_Count());
+
+		for(int y=0; y<m_pGrid->Get_NY() && Set_Progress(y, m_pGrid->Get_NY()); y++)
+		{
+			double	yWorld	= m_pGrid->Get_YMin() + y * m_pGrid->Get_Cellsize();
+
+			#pragma omp parallel for
+			for(int x=0; x<m_pGrid->Get_NX(); x++)
+			{
+				double	xWorld	= m_pGrid->Get_XMin() + x * m_pGrid->Get_Cellsize(), Value;
+
+				if( Spline.Get_Value(xWorld, yWorld, Value) )
+				{
+					m_pGrid->Set_Value(x, y, Value);
+				}
+				else
+				{
+					m_pGrid->Set_NoData(x, y);
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	else if( m_Search.Do_Use_All(true) )	// global
 	{
 		CSG_Thin_Plate_Spline	Spline;
 
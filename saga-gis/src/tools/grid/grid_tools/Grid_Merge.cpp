@@ -79,6 +79,13 @@ CGrid_Merge::CGrid_Merge(void)
 		"is set automatically in this case (the extent is calculated from all "
 		"inputs and the cell size is set to the smallest one detected) and (ii) "
 		"the input grids must still fit into memory, i.e. are all loaded at once.\n\n"
+		"The second limitation can be overcome by streaming the mosaic directly to a "
+		"target file. The input files, which have to be SAGA grids in this case, are then "
+		"indexed by their headers only. The target is processed in blocks of rows, "
+		"which only load those input grids that overlap the block, and each "
+		"finished block is written to the target file at once. The block size is "
+		"chosen to fit the given memory budget. Histogram matching is not supported "
+		"by streamed mosaicking.\n\n"
 	));
 
 	//-----------------------------------------------------
@@ -97,6 +104,21 @@ CGrid_Merge::CGrid_Merge(void)
         ), NULL, false, false, false
 	)->Set_UseInGUI(false);
 
+	Parameters.Add_FilePath("FILE_LIST",
+		"FILE_TARGET", _TL("Streamed Target File"),
+		_TL("If set, the mosaic of the input file list is streamed block by block to this SAGA grid file instead of being created in memory."),
+		CSG_String::Format("%s|*.sgrd|%s|*.*",
+			_TL("SAGA Grid Files"),
+			_TL("All Files")
+		), NULL, true, false, false
+	)->Set_UseInGUI(false);
+
+	Parameters.Add_Int("FILE_LIST",
+		"MEMORY"	, _TL("Memory Budget"),
+		_TL("Maximum memory [MB] used for target blocks of streamed mosaicking."),
+		1024, 16, true
+	)->Set_UseInGUI(false);
+
 	Add_Parameters(Parameters);
 
 	//-----------------------------------------------------
@@ -217,6 +239,11 @@ int CGrid_Merge::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Parameter
 //---------------------------------------------------------
 bool CGrid_Merge::On_Execute(void)
 {
+	if( Parameters("GRIDS")->asGridList()->Get_Grid_Count() < 1 && *Parameters("FILE_TARGET")->asString() )
+	{
+		return( Stream_Mosaic() );
+	}
+
 	if( !Initialize() )
 	{
 		return( false );
@@ -227,95 +254,109 @@ bool CGrid_Merge::On_Execute(void)
 	{
 		CSG_Grid *pGrid = m_pGrids->Get_Grid(i);
 
-		Set_Weight(pGrid);
+		Set_Weight(pGrid, m_Weight);
 
 		Get_Match(i > 0 ? pGrid : NULL);
 
-		int ax = (int)((pGrid->Get_XMin() - m_pMosaic->Get_XMin()) / m_pMosaic->Get_Cellsize());
-		int ay = (int)((pGrid->Get_YMin() - m_pMosaic->Get_YMin()) / m_pMosaic->Get_Cellsize());
+		Process_Set_Text("[%d/%d] %s: %s", i + 1, m_pGrids->Get_Grid_Count(), is_Aligned(pGrid, m_pMosaic) ? _TL("copying") : _TL("resampling"), pGrid->Get_Name());
 
-		//-------------------------------------------------
-		if(	is_Aligned(pGrid) )
+		Add_Grid(pGrid, m_pMosaic, m_Weights, m_Weight, true);
+	}
+
+	//-----------------------------------------------------
+	Set_Mean(m_pMosaic, m_Weights, true);
+
+	//-----------------------------------------------------
+	m_Weight .Destroy();
+	m_Weights.Destroy();
+
+	if( m_bFileList )
+	{
+		for(int i=0; i<m_pGrids->Get_Grid_Count(); i++)
 		{
-			Process_Set_Text("[%d/%d] %s: %s", i + 1, m_pGrids->Get_Grid_Count(), _TL("copying"), pGrid->Get_Name());
+			delete(m_pGrids->Get_Grid(i));
+		}
+
+		m_pGrids->Del_Items();
+	}
 
-			int nx = pGrid->Get_NX(); if( nx > m_pMosaic->Get_NX() - ax ) nx = m_pMosaic->Get_NX() - ax;
-			int ny = pGrid->Get_NY(); if( ny > m_pMosaic->Get_NY() - ay ) ny = m_pMosaic->Get_NY() - ay;
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CGrid_Merge::Add_Grid(CSG_Grid *pGrid, CSG_Grid *pMosaic, CSG_Grid &Weights, CSG_Grid &Weight, bool bProgress)
+{
+	int ax = (int)((pGrid->Get_XMin() - pMosaic->Get_XMin()) / pMosaic->Get_Cellsize());
+	int ay = (int)((pGrid->Get_YMin() - pMosaic->Get_YMin()) / pMosaic->Get_Cellsize());
 
-			for(int y=0; y<ny && Set_Progress(y, ny); y++)
+	//-----------------------------------------------------
+	if(	is_Aligned(pGrid, pMosaic) )
+	{
+		int nx = pGrid->Get_NX(); if( nx > pMosaic->Get_NX() - ax ) nx = pMosaic->Get_NX() - ax;
+		int ny = pGrid->Get_NY(); if( ny > pMosaic->Get_NY() - ay ) ny = pMosaic->Get_NY() - ay;
+
+		for(int y=0; y<ny && (!bProgress || Set_Progress(y, ny)); y++)
+		{
+			if( ay + y >= 0 )
 			{
-				if( ay + y >= 0 )
+				#pragma omp parallel for
+				for(int x=0; x<nx; x++)
 				{
-					#pragma omp parallel for
-					for(int x=0; x<nx; x++)
+					if( ax + x >= 0 && !pGrid->is_NoData(x, y) )
 					{
-						if( ax + x >= 0 && !pGrid->is_NoData(x, y) )
-						{
-							Set_Value(ax + x, ay + y, pGrid->asDouble(x, y), Get_Weight(x, y));
-						}
+						Set_Value(pMosaic, Weights, ax + x, ay + y, pGrid->asDouble(x, y), Get_Weight(Weight, x, y));
 					}
 				}
 			}
 		}
+	}
 
-		//-------------------------------------------------
-		else
-		{
-			Process_Set_Text("[%d/%d] %s: %s", i + 1, m_pGrids->Get_Grid_Count(), _TL("resampling"), pGrid->Get_Name());
+	//-----------------------------------------------------
+	else
+	{
+		if( ax < 0 ) ax = 0;
+		if( ay < 0 ) ay = 0;
 
-			if( ax < 0 ) ax = 0;
-			if( ay < 0 ) ay = 0;
+		int nx = 1 + pMosaic->Get_System().Get_xWorld_to_Grid(pGrid->Get_XMax()); if( nx > pMosaic->Get_NX() ) nx = pMosaic->Get_NX();
+		int ny = 1 + pMosaic->Get_System().Get_yWorld_to_Grid(pGrid->Get_YMax()); if( ny > pMosaic->Get_NY() ) ny = pMosaic->Get_NY();
 
-			int nx = 1 + m_pMosaic->Get_System().Get_xWorld_to_Grid(pGrid->Get_XMax()); if( nx > m_pMosaic->Get_NX() ) nx = m_pMosaic->Get_NX();
-			int ny = 1 + m_pMosaic->Get_System().Get_yWorld_to_Grid(pGrid->Get_YMax()); if( ny > m_pMosaic->Get_NY() ) ny = m_pMosaic->Get_NY();
+		for(int y=ay; y<ny && (!bProgress || Set_Progress(y-ay, ny-ay)); y++)
+		{
+			double py = pMosaic->Get_YMin() + y * pMosaic->Get_Cellsize();
 
-			for(int y=ay; y<ny && Set_Progress(y-ay, ny-ay); y++)
+			#pragma omp parallel for
+			for(int x=ax; x<nx; x++)
 			{
-				double py = m_pMosaic->Get_YMin() + y * m_pMosaic->Get_Cellsize();
-
-				#pragma omp parallel for
-				for(int x=ax; x<nx; x++)
-				{
-					double px = m_pMosaic->Get_XMin() + x * m_pMosaic->Get_Cellsize();
+				double px = pMosaic->Get_XMin() + x * pMosaic->Get_Cellsize();
 
-					Set_Value(x, y, pGrid, px, py);
-				}
+				Set_Value(pMosaic, Weights, Weight, x, y, pGrid, px, py);
 			}
 		}
 	}
 
-	//-----------------------------------------------------
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CGrid_Merge::Set_Mean(CSG_Grid *pMosaic, CSG_Grid &Weights, bool bProgress)
+{
 	if( m_Overlap == 4 )	// mean
 	{
-		for(int y=0; y<m_pMosaic->Get_NY() && Set_Progress(y, m_pMosaic->Get_NY()); y++)
+		for(int y=0; y<pMosaic->Get_NY() && (!bProgress || Set_Progress(y, pMosaic->Get_NY())); y++)
 		{
 			#pragma omp parallel for
-			for(int x=0; x<m_pMosaic->Get_NX(); x++)
+			for(int x=0; x<pMosaic->Get_NX(); x++)
 			{
-				double w = m_Weights.asDouble(x, y);
+				double w = Weights.asDouble(x, y);
 
 				if( w > 0. )
 				{
-					m_pMosaic->Mul_Value(x, y, 1.0 / w);
+					pMosaic->Mul_Value(x, y, 1.0 / w);
 				}
 			}
 		}
 	}
 
-	//-----------------------------------------------------
-	m_Weight .Destroy();
-	m_Weights.Destroy();
-
-	if( m_bFileList )
-	{
-		for(int i=0; i<m_pGrids->Get_Grid_Count(); i++)
-		{
-			delete(m_pGrids->Get_Grid(i));
-		}
-
-		m_pGrids->Del_Items();
-	}
-
 	return( true );
 }
 
@@ -403,10 +444,16 @@ bool CGrid_Merge::Initialize(void)
 	m_pMosaic->Assign_NoData();
 
 	//-----------------------------------------------------
+	return( Initialize(m_Weights, m_pMosaic->Get_System(), m_pGrids->Get_Grid_Count()) );
+}
+
+//---------------------------------------------------------
+bool CGrid_Merge::Initialize(CSG_Grid &Weights, const CSG_Grid_System &System, int nGrids)
+{
 	switch( m_Overlap )
 	{
 	case 4:	// mean
-		if( !m_Weights.Create(m_pMosaic->Get_System(), m_pGrids->Get_Grid_Count() < 256 ? SG_DATATYPE_Byte : SG_DATATYPE_Word) )
+		if( !Weights.Create(System, nGrids < 256 ? SG_DATATYPE_Byte : SG_DATATYPE_Word) )
 		{
 			Error_Set(_TL("could not create weights grid"));
 
@@ -416,14 +463,14 @@ bool CGrid_Merge::Initialize(void)
 		break;
 
 	case 6:	// feathering
-		if( !m_Weights.Create(m_pMosaic->Get_System(), SG_DATATYPE_Word) )
+		if( !Weights.Create(System, SG_DATATYPE_Word) )
 		{
 			Error_Set(_TL("could not create weights grid"));
 
 			return( false );
 		}
 
-		m_Weights.Set_Scaling(m_pMosaic->Get_Cellsize());
+		Weights.Set_Scaling(System.Get_Cellsize());
 
 		break;
 	}
@@ -477,16 +524,16 @@ void CGrid_Merge::Set_Target(CSG_Parameters *pParameters, CSG_Parameter_List *pL
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CGrid_Merge::is_Aligned(CSG_Grid *pGrid)
+bool CGrid_Merge::is_Aligned(CSG_Grid *pGrid, CSG_Grid *pMosaic)
 {
-	return(	pGrid->Get_Cellsize() == m_pMosaic->Get_Cellsize()
-		&&	fabs(fmod(pGrid->Get_XMin() - m_pMosaic->Get_XMin(), m_pMosaic->Get_Cellsize())) <= 0.001 * m_pMosaic->Get_Cellsize()
-		&&	fabs(fmod(pGrid->Get_YMin() - m_pMosaic->Get_YMin(), m_pMosaic->Get_Cellsize())) <= 0.001 * m_pMosaic->Get_Cellsize()
+	return(	pGrid->Get_Cellsize() == pMosaic->Get_Cellsize()
+		&&	fabs(fmod(pGrid->Get_XMin() - pMosaic->Get_XMin(), pMosaic->Get_Cellsize())) <= 0.001 * pMosaic->Get_Cellsize()
+		&&	fabs(fmod(pGrid->Get_YMin() - pMosaic->Get_YMin(), pMosaic->Get_Cellsize())) <= 0.001 * pMosaic->Get_Cellsize()
 	);
 }
 
 //---------------------------------------------------------
-inline void CGrid_Merge::Set_Value(int x, int y, double Value, double Weight)
+inline void CGrid_Merge::Set_Value(CSG_Grid *pMosaic, CSG_Grid &Weights, int x, int y, double Value, double Weight)
 {
 	if( m_Match.Get_N() == 2 )		// regression
 	{
@@ -500,80 +547,80 @@ inline void CGrid_Merge::Set_Value(int x, int y, double Value, double Weight)
 	switch( m_Overlap )
 	{
 	case 0:	// first
-		if( m_pMosaic->is_NoData(x, y) )
+		if( pMosaic->is_NoData(x, y) )
 		{
-			m_pMosaic->Set_Value(x, y, Value);
+			pMosaic->Set_Value(x, y, Value);
 		}
 		break;
 
 	case 1:	// last
 		{
-			m_pMosaic->Set_Value(x, y, Value);
+			pMosaic->Set_Value(x, y, Value);
 		}
 		break;
 
 	case 2:	// minimum
-		if( m_pMosaic->is_NoData(x, y) || m_pMosaic->asDouble(x, y) > Value )
+		if( pMosaic->is_NoData(x, y) || pMosaic->asDouble(x, y) > Value )
 		{
-			m_pMosaic->Set_Value(x, y, Value);
+			pMosaic->Set_Value(x, y, Value);
 		}
 		break;
 
 	case 3:	// maximum
-		if( m_pMosaic->is_NoData(x, y) || m_pMosaic->asDouble(x, y) < Value )
+		if( pMosaic->is_NoData(x, y) || pMosaic->asDouble(x, y) < Value )
 		{
-			m_pMosaic->Set_Value(x, y, Value);
+			pMosaic->Set_Value(x, y, Value);
 		}
 		break;
 
 	case 4:	// mean
-		if( m_pMosaic->is_NoData(x, y) )
+		if( pMosaic->is_NoData(x, y) )
 		{
-			m_pMosaic->Set_Value(x, y, Value);
-			m_Weights .Set_Value(x, y, 1);
+			pMosaic->Set_Value(x, y, Value);
+			Weights .Set_Value(x, y, 1);
 		}
 		else
 		{
-			m_pMosaic->Add_Value(x, y, Value);
-			m_Weights .Add_Value(x, y, 1);
+			pMosaic->Add_Value(x, y, Value);
+			Weights .Add_Value(x, y, 1);
 		}
 		break;
 
 	case 5:	// blend
-		if( m_pMosaic->is_NoData(x, y) )
+		if( pMosaic->is_NoData(x, y) )
 		{
-			m_pMosaic->Set_Value(x, y, Value);
+			pMosaic->Set_Value(x, y, Value);
 		}
 		else
 		{
-			m_pMosaic->Set_Value(x, y, (1.0 - Weight) * m_pMosaic->asDouble(x, y) + Weight * Value);
+			pMosaic->Set_Value(x, y, (1.0 - Weight) * pMosaic->asDouble(x, y) + Weight * Value);
 		}
 		break;
 
 	case 6:	// feathering
-		if( m_pMosaic->is_NoData(x, y) )
+		if( pMosaic->is_NoData(x, y) )
 		{
-			m_pMosaic->Set_Value(x, y, Value);
-			m_Weights .Set_Value(x, y, Weight);
+			pMosaic->Set_Value(x, y, Value);
+			Weights .Set_Value(x, y, Weight);
 		}
 		else
 		{
-			double	d	= (Weight - m_Weights.asDouble(x, y)) / m_dBlend;
+			double	d	= (Weight - Weights.asDouble(x, y)) / m_dBlend;
 
 			if( d >= 1.0 )
 			{
-				m_pMosaic->Set_Value(x, y, Value);
-				m_Weights .Set_Value(x, y, Weight);
+				pMosaic->Set_Value(x, y, Value);
+				Weights .Set_Value(x, y, Weight);
 			}
 			else if( d > -1.0 )
 			{
 				d	= 0.5 * (1.0 + d);
 
-				m_pMosaic->Set_Value(x, y, (1.0 - d) * m_pMosaic->asDouble(x, y) + d * Value);
+				pMosaic->Set_Value(x, y, (1.0 - d) * pMosaic->asDouble(x, y) + d * Value);
 
 				if( d > 0.5 )
 				{
-					m_Weights .Set_Value(x, y, Weight);
+					Weights .Set_Value(x, y, Weight);
 				}
 			}
 		}
@@ -582,24 +629,24 @@ inline void CGrid_Merge::Set_Value(int x, int y, double Value, double Weight)
 }
 
 //---------------------------------------------------------
-inline void CGrid_Merge::Set_Value(int x, int y, CSG_Grid *pGrid, double px, double py)
+inline void CGrid_Merge::Set_Value(CSG_Grid *pMosaic, CSG_Grid &Weights, CSG_Grid &Weight, int x, int y, CSG_Grid *pGrid, double px, double py)
 {
 	double	z;
 
 	if( pGrid->Get_Value(px, py, z, m_Resampling) )
 	{
-		if( m_Weight.is_Valid() )
+		if( Weight.is_Valid() )
 		{
 			double	w;
 
-			if( m_Weight.Get_Value(px, py, w) )
+			if( Weight.Get_Value(px, py, w) )
 			{
-				Set_Value(x, y, z, w);
+				Set_Value(pMosaic, Weights, x, y, z, w);
 			}
 		}
 		else
 		{
-			Set_Value(x, y, z, 1.0);
+			Set_Value(pMosaic, Weights, x, y, z, 1.0);
 		}
 	}
 }
@@ -610,13 +657,13 @@ inline void CGrid_Merge::Set_Value(int x, int y, CSG_Grid *pGrid, double px, dou
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-inline double CGrid_Merge::Get_Weight(int x, int y)
+inline double CGrid_Merge::Get_Weight(CSG_Grid &Weight, int x, int y)
 {
-	return( m_Weight.is_Valid() ? m_Weight.asDouble(x, y) : 1.0 );
+	return( Weight.is_Valid() ? Weight.asDouble(x, y) : 1.0 );
 }
 
 //---------------------------------------------------------
-bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
+bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid, CSG_Grid &Weight)
 {
 	int	dBlend;
 
@@ -635,9 +682,9 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 	}
 
 	//-----------------------------------------------------
-	if( !m_Weight.Get_System().is_Equal(pGrid->Get_System()) )
+	if( !Weight.Get_System().is_Equal(pGrid->Get_System()) )
 	{
-		if( !m_Weight.Create(pGrid->Get_System(), dBlend > 0 && dBlend < 255 ? SG_DATATYPE_Byte : SG_DATATYPE_Word) )
+		if( !Weight.Create(pGrid->Get_System(), dBlend > 0 && dBlend < 255 ? SG_DATATYPE_Byte : SG_DATATYPE_Word) )
 		{
 			Error_Set(_TL("could not create distance grid"));
 
@@ -655,10 +702,10 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 			{
 				int	d	= 1 + (ix < iy ? ix : iy);	if( dBlend > 0 && d > dBlend )	{	d = dBlend;	}
 
-				m_Weight.Set_Value(ix, iy, d);
-				m_Weight.Set_Value(ix, jy, d);
-				m_Weight.Set_Value(jx, iy, d);
-				m_Weight.Set_Value(jx, jy, d);
+				Weight.Set_Value(ix, iy, d);
+				Weight.Set_Value(ix, jy, d);
+				Weight.Set_Value(jx, iy, d);
+				Weight.Set_Value(jx, jy, d);
 			}
 		}
 	} break;
@@ -671,8 +718,8 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 
 			for(int y=0; y<pGrid->Get_NY(); y++)
 			{
-				m_Weight.Set_Value(ix, y, d);
-				m_Weight.Set_Value(jx, y, d);
+				Weight.Set_Value(ix, y, d);
+				Weight.Set_Value(jx, y, d);
 			}
 		}
 	} break;
@@ -685,8 +732,8 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 
 			for(int x=0; x<pGrid->Get_NX(); x++)
 			{
-				m_Weight.Set_Value(x, iy, d);
-				m_Weight.Set_Value(x, jy, d);
+				Weight.Set_Value(x, iy, d);
+				Weight.Set_Value(x, jy, d);
 			}
 		}
 	} break;
@@ -700,9 +747,9 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 			for(x=0, d=1; x<pGrid->Get_NX(); x++)
 			{
 				if( pGrid->is_NoData(x, y) )
-					m_Weight.Set_Value(x, y, d = 0);
-				else //if( m_Weight.asInt(x, y) > d )
-					m_Weight.Set_Value(x, y, d);
+					Weight.Set_Value(x, y, d = 0);
+				else //if( Weight.asInt(x, y) > d )
+					Weight.Set_Value(x, y, d);
 
 				if( dBlend <= 0 || d < dBlend )	d++;
 			}
@@ -710,11 +757,11 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 			for(x=pGrid->Get_NX()-1, d=1; x>=0; x--)
 			{
 				if( pGrid->is_NoData(x, y) )
-					m_Weight.Set_Value(x, y, d = 0);
-				else if( m_Weight.asInt(x, y) > d )
-					m_Weight.Set_Value(x, y, d);
+					Weight.Set_Value(x, y, d = 0);
+				else if( Weight.asInt(x, y) > d )
+					Weight.Set_Value(x, y, d);
 				else
-					d	= m_Weight.asInt(x, y);
+					d	= Weight.asInt(x, y);
 
 				if( dBlend <= 0 || d < dBlend )	d++;
 			}
@@ -725,11 +772,11 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 			for(y=0, d=1; y<pGrid->Get_NY(); y++)
 			{
 				if( pGrid->is_NoData(x, y) )
-					m_Weight.Set_Value(x, y, d = 0);
-				else if( m_Weight.asInt(x, y) > d )
-					m_Weight.Set_Value(x, y, d);
+					Weight.Set_Value(x, y, d = 0);
+				else if( Weight.asInt(x, y) > d )
+					Weight.Set_Value(x, y, d);
 				else
-					d	= m_Weight.asInt(x, y);
+					d	= Weight.asInt(x, y);
 
 				if( dBlend <= 0 || d < dBlend )	d++;
 			}
@@ -737,11 +784,11 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 			for(y=pGrid->Get_NY()-1, d=1; y>=0; y--)
 			{
 				if( pGrid->is_NoData(x, y) )
-					m_Weight.Set_Value(x, y, d = 0);
-				else if( m_Weight.asInt(x, y) > d )
-					m_Weight.Set_Value(x, y, d);
+					Weight.Set_Value(x, y, d = 0);
+				else if( Weight.asInt(x, y) > d )
+					Weight.Set_Value(x, y, d);
 				else
-					d	= m_Weight.asInt(x, y);
+					d	= Weight.asInt(x, y);
 
 				if( dBlend <= 0 || d < dBlend )	d++;
 			}
@@ -753,11 +800,11 @@ bool CGrid_Merge::Set_Weight(CSG_Grid *pGrid)
 	switch( m_Overlap )
 	{
 	case 5:	// blending
-		m_Weight.Set_Scaling(1.0 / dBlend);	// normalize (0 <= z <= 1)
+		Weight.Set_Scaling(1.0 / dBlend);	// normalize (0 <= z <= 1)
 		break;
 
 	case 6:	// feathering
-		m_Weight.Set_Scaling(m_Weight.Get_Cellsize());
+		Weight.Set_Scaling(Weight.Get_Cellsize());
 		break;
 	}
 
@@ -859,6 +906,257 @@ void CGrid_Merge::Get_Match(CSG_Grid *pGrid)
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CGrid_Merge::Stream_Mosaic(void)
+{
+	m_Overlap = Parameters("OVERLAP"   )->asInt();
+	m_dBlend  = Parameters("BLEND_DIST")->asDouble();
+
+	switch( Parameters("RESAMPLING")->asInt() )
+	{
+	default: m_Resampling = GRID_RESAMPLING_NearestNeighbour; break;
+	case  1: m_Resampling = GRID_RESAMPLING_Bilinear        ; break;
+	case  2: m_Resampling = GRID_RESAMPLING_BicubicSpline   ; break;
+	case  3: m_Resampling = GRID_RESAMPLING_BSpline         ; break;
+	}
+
+	m_Match.Destroy();
+
+	if( Parameters("MATCH")->asInt() != 0 )
+	{
+		Message_Add(_TL("histogram matching is not supported by streamed mosaicking"));
+	}
+
+	//-----------------------------------------------------
+	// the tile footprint index is built from the grid file headers only
+
+	CSG_Table List;
+
+	if( !List.Create(Parameters("FILE_LIST")->asString(), TABLE_FILETYPE_Text_NoHeadLine) || List.Get_Count() < 1 )
+	{
+		Error_Set(_TL("input file list could not be opened or is empty!"));
+
+		return( false );
+	}
+
+	CSG_Strings Files; CSG_Vector yMin, yMax; CSG_Grid_File_Info Target; double Tile_Bytes = 0.;
+
+	for(sLong i=0; i<List.Get_Count() && Set_Progress(i, List.Get_Count()); i++)
+	{
+		CSG_Grid_File_Info Info;
+
+		if( !Info.Create(CSG_String(List[i].asString(0))) || !Info.m_System.is_Valid() )
+		{
+			Error_Fmt("%s: %s", _TL("failed to read grid file header"), List[i].asString(0));
+
+			return( false );
+		}
+
+		if( Files.Get_Count() == 0 )
+		{
+			Target.Create(Info);
+		}
+		else
+		{
+			CSG_Rect Extent(Target.m_System.Get_Extent()); Extent.Union(Info.m_System.Get_Extent());
+
+			double Cellsize = M_GET_MIN(Target.m_System.Get_Cellsize(), Info.m_System.Get_Cellsize());
+
+			Target.m_System.Create(Cellsize, Extent.Get_XMin(), Extent.Get_YMin(),
+				1 + (int)(Extent.Get_XRange() / Cellsize),
+				1 + (int)(Extent.Get_YRange() / Cellsize)
+			);
+		}
+
+		Files += List[i].asString(0); yMin.Add_Row(Info.m_System.Get_YMin(true)); yMax.Add_Row(Info.m_System.Get_YMax(true));
+
+		double Bytes = (double)Info.m_System.Get_NCells() * (SG_Data_Type_Get_Size(Info.m_Type) + (m_Overlap == 5 || m_Overlap == 6 ? 2 : 0)); // tile and its distance weights
+
+		if( Tile_Bytes < Bytes )
+		{
+			Tile_Bytes = Bytes;
+		}
+	}
+
+	CSG_Grid_System System(Target.m_System);
+
+	//-----------------------------------------------------
+	TSG_Data_Type Type = Parameters("TYPE")->asDataType()->Get_Data_Type(Target.m_Type);
+
+	if( Type == SG_DATATYPE_Bit )
+	{
+		Type = SG_DATATYPE_Byte;
+	}
+
+	if( Type != Target.m_Type )
+	{
+		Target.m_Type = Type; Target.m_zScale = 1.; Target.m_zOffset = 0.;
+
+		double NoData = -99999.; SG_Data_Type_Range_Check(Type, NoData);
+
+		Target.m_NoData[0] = Target.m_NoData[1] = NoData;
+	}
+
+	Target.m_Name = Parameters("NAME")->asString();
+
+	//-----------------------------------------------------
+	// the row block size is derived from the memory budget, which
+	// is shared between the block and the largest tile
+
+	double Bytes = (double)System.Get_NX() * (SG_Data_Type_Get_Size(Type) + (m_Overlap == 4 || m_Overlap == 6 ? 2 : 0));
+
+	double Budget = Parameters("MEMORY")->asDouble() * 1024. * 1024.;
+
+	int nRows = (int)((Budget - Tile_Bytes) / Bytes);
+
+	if( nRows < 1 ) { nRows = 1; } else if( nRows > System.Get_NY() ) { nRows = System.Get_NY(); }
+
+	int nBlocks = 1 + (System.Get_NY() - 1) / nRows;
+
+	CSG_Array_Int *Tiles = new CSG_Array_Int[nBlocks];
+
+	for(int i=0; i<Files.Get_Count(); i++) // assign tiles to the row blocks they overlap, keeping list order
+	{
+		int ay = (int)floor((yMin[i] - System.Get_YMin(true)) / System.Get_Cellsize()) - 2; // margin for resampling
+		int by = (int)ceil ((yMax[i] - System.Get_YMin(true)) / System.Get_Cellsize()) + 2;
+
+		for(int iBlock=M_GET_MAX(0, ay / nRows); iBlock<=by / nRows && iBlock<nBlocks; iBlock++)
+		{
+			Tiles[iBlock] += i;
+		}
+	}
+
+	Message_Fmt("\n%s: %d x %d, %d %s, %d %s", _TL("streamed mosaic"), System.Get_NX(), System.Get_NY(), nBlocks, _TL("blocks"), nRows, _TL("rows"));
+
+	//-----------------------------------------------------
+	CSG_String File(Parameters("FILE_TARGET")->asString()); SG_File_Set_Extension(File, "sgrd");
+
+	CSG_File Stream;
+
+	if( !Target.Save(File) || !Stream.Open(SG_File_Make_Path("", File, "sdat"), SG_FILE_W, true) )
+	{
+		Error_Fmt("%s: %s", _TL("failed to create target file"), File.c_str());
+
+		delete[](Tiles);
+
+		return( false );
+	}
+
+	CSG_Projection Projection; Projection.Load(SG_File_Make_Path("", Files[0], "prj"));
+
+	if( Projection.is_Okay() )
+	{
+		Projection.Save(SG_File_Make_Path("", File, "prj"));
+	}
+
+	//-----------------------------------------------------
+	// blocks are processed one after the other, because loading
+	// tiles reports to the user interface, copying the tiles'
+	// rows to the block is done in parallel
+
+	bool bOkay = true;
+
+	for(int iBlock=0; bOkay && iBlock<nBlocks && Set_Progress(iBlock, nBlocks); iBlock++)
+	{
+		bOkay = Stream_Block(Files, Tiles[iBlock], Target, iBlock * nRows, M_GET_MIN(nRows, System.Get_NY() - iBlock * nRows), Stream);
+	}
+
+	delete[](Tiles);
+
+	return( bOkay && Process_Get_Okay() );
+}
+
+//---------------------------------------------------------
+bool CGrid_Merge::Stream_Block(const CSG_Strings &Files, const CSG_Array_Int &Tiles, const CSG_Grid_File_Info &Target, int yOffset, int nRows, CSG_File &Stream)
+{
+	const CSG_Grid_System &System = Target.m_System;
+
+	CSG_Grid Mosaic, Weights, Weight;
+
+	if( !Mosaic.Create(Target.m_Type, System.Get_NX(), nRows, System.Get_Cellsize(), System.Get_XMin(), System.Get_YMin() + yOffset * System.Get_Cellsize()) )
+	{
+		Error_Fmt("%s (%s %d)", _TL("failed to allocate memory for target data."), _TL("row"), yOffset + 1);
+
+		return( false );
+	}
+
+	if( !Initialize(Weights, Mosaic.Get_System(), (int)Files.Get_Count()) )
+	{
+		return( false );
+	}
+
+	Mosaic.Set_Scaling(Target.m_zScale, Target.m_zOffset);
+	Mosaic.Set_NoData_Value_Range(Target.m_NoData[0], Target.m_NoData[1]);
+	Mosaic.Assign_NoData();
+
+	//-----------------------------------------------------
+	for(sLong i=0; i<Tiles.Get_Size(); i++)
+	{
+		bool bCached = m_Overlap != 5 && m_Overlap != 6; // blending and feathering need the tile completely loaded
+
+		CSG_Grid Grid;
+
+		if( !Grid.Create(Files[Tiles[i]], SG_DATATYPE_Undefined, bCached) )
+		{
+			Error_Fmt("%s: %s", _TL("failed to load grid file"), Files[Tiles[i]].c_str());
+
+			return( false );
+		}
+
+		if( !Set_Weight(&Grid, Weight) )
+		{
+			return( false );
+		}
+
+		Add_Grid(&Grid, &Mosaic, Weights, Weight, false);
+	}
+
+	Set_Mean(&Mosaic, Weights, false);
+
+	//-----------------------------------------------------
+	// write the block's rows with the file's data type at their final position
+
+	size_t nBytes = SG_Data_Type_Get_Size(Mosaic.Get_Type()); CSG_Array Line(nBytes, Mosaic.Get_NX());
+
+	for(int y=0; y<Mosaic.Get_NY(); y++)
+	{
+		char *pValue = (char *)Line.Get_Array();
+
+		for(int x=0; x<Mosaic.Get_NX(); x++, pValue+=nBytes)
+		{
+			double Value = Mosaic.asDouble(x, y, false);
+
+			switch( Mosaic.Get_Type() )
+			{
+			case SG_DATATYPE_Byte  : *((BYTE   *)pValue) = (BYTE  )Value; break;
+			case SG_DATATYPE_Char  : *((char   *)pValue) = (char  )Value; break;
+			case SG_DATATYPE_Word  : *((WORD   *)pValue) = (WORD  )Value; break;
+			case SG_DATATYPE_Short : *((short  *)pValue) = (short )Value; break;
+			case SG_DATATYPE_DWord : *((DWORD  *)pValue) = (DWORD )Value; break;
+			case SG_DATATYPE_Int   : *((int    *)pValue) = (int   )Value; break;
+			case SG_DATATYPE_ULong : *((uLong  *)pValue) = (uLong )Value; break;
+			case SG_DATATYPE_Long  : *((sLong  *)pValue) = (sLong )Value; break;
+			case SG_DATATYPE_Float : *((float  *)pValue) = (float )Value; break;
+			default                : *((double *)pValue) = (double)Value; break;
+			}
+		}
+
+		if( !Stream.Seek((sLong)(yOffset + y) * Mosaic.Get_NX() * nBytes) || Stream.Write(Line.Get_Array(), nBytes, Mosaic.Get_NX()) != nBytes * Mosaic.Get_NX() )
+		{
+			Error_Fmt("%s (%s %d)", _TL("failed to write target file"), _TL("row"), yOffset + y + 1);
+
+			return( false );
+		}
+	}
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -108,17 +108,24 @@ private:
 
 
 	bool						Initialize				(void);
+	bool						Initialize				(CSG_Grid &Weights, const CSG_Grid_System &System, int nGrids);
 
-	bool						is_Aligned				(CSG_Grid *pGrid);
+	bool						Add_Grid				(CSG_Grid *pGrid, CSG_Grid *pMosaic, CSG_Grid &Weights, CSG_Grid &Weight, bool bProgress);
+	bool						Set_Mean				(CSG_Grid *pMosaic, CSG_Grid &Weights, bool bProgress);
 
-	void						Set_Value				(int x, int y, double Value, double Weight);
-	void						Set_Value				(int x, int y, CSG_Grid *pGrid, double px, double py);
+	bool						is_Aligned				(CSG_Grid *pGrid, CSG_Grid *pMosaic);
 
-	bool						Set_Weight				(CSG_Grid *pGrid);
-	double						Get_Weight				(int x, int y);
+	void						Set_Value				(CSG_Grid *pMosaic, CSG_Grid &Weights, int x, int y, double Value, double Weight);
+	void						Set_Value				(CSG_Grid *pMosaic, CSG_Grid &Weights, CSG_Grid &Weight, int x, int y, CSG_Grid *pGrid, double px, double py);
+
+	bool						Set_Weight				(CSG_Grid *pGrid, CSG_Grid &Weight);
+	double						Get_Weight				(CSG_Grid &Weight, int x, int y);
 
 	void						Get_Match				(CSG_Grid *pGrid);
 
+	bool						Stream_Mosaic			(void);
+	bool						Stream_Block			(const CSG_Strings &Files, const CSG_Array_Int &Tiles, const CSG_Grid_File_Info &Target, int yOffset, int nRows, CSG_File &Stream);
+
 };
 
 
@@ -102,13 +102,20 @@ CGrid_Cluster_Analysis::CGrid_Cluster_Analysis(void)
 	Parameters.Add_Choice("",
 		"METHOD"		, _TL("Method"),
 		_TL(""),
-		CSG_String::Format("%s|%s|%s",
+		CSG_String::Format("%s|%s|%s|%s",
 			_TL("Iterative Minimum Distance (Forgy 1965)"),
 			_TL("Hill-Climbing (Rubin 1967)"),
-			_TL("Combined Minimum Distance / Hillclimbing") 
+			_TL("Combined Minimum Distance / Hillclimbing"),
+			_TL("Mini-Batch Minimum Distance (Sculley 2010)")
 		), 1
 	);
 
+	Parameters.Add_Int("METHOD",
+		"BATCH_SIZE"	, _TL("Batch Size"),
+		_TL("Number of randomly sampled elements used per iteration by the mini-batch method."),
+		1000, 10, true
+	);
+
 	Parameters.Add_Int("",
 		"NCLUSTER"		, _TL("Clusters"),
 		_TL("Number of clusters"),
@@ -162,6 +169,11 @@ int CGrid_Cluster_Analysis::On_Parameters_Enable(CSG_Parameters *pParameters, CS
 		pParameters->Set_Enabled("UPDATEVIEW", pParameter->asBool() == true );
 	}
 
+	if( pParameter->Cmp_Identifier("METHOD") )
+	{
+		pParameters->Set_Enabled("BATCH_SIZE", pParameter->asInt() == 3);
+	}
+
 	if( pParameter->Cmp_Identifier("GRIDS") )
 	{
 		pParameters->Set_Enabled("RGB_COLORS", pParameter->asGridList()->Get_Grid_Count() >= 3);
@@ -244,7 +256,8 @@ bool CGrid_Cluster_Analysis::On_Execute(void)
 		Parameters("METHOD"    )->asInt(),
 		Parameters("NCLUSTER"  )->asInt(),
 		Parameters("MAXITER"   )->asInt(),
-		Parameters("INITIALIZE")->asInt()
+		Parameters("INITIALIZE")->asInt(),
+		Parameters("BATCH_SIZE")->asInt()
 	);
 
 	for(sLong iElement=0, nElements=0; iElement<Get_NCells(); iElement++)
@@ -414,6 +427,13 @@ bool CGrid_Cluster_Analysis::_On_Execute(void)
 		return( false );
 	}
 
+	if( Parameters("METHOD")->asInt() == 3 )
+	{
+		Error_Set(_TL("mini-batch method is not supported by the old version"));
+
+		return( false );
+	}
+
 	//-----------------------------------------------------
 	Grids		= (CSG_Grid **)SG_Malloc(pGrids->Get_Grid_Count() * sizeof(CSG_Grid *));
 
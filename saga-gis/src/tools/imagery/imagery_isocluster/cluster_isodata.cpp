@@ -457,22 +457,26 @@ bool CCluster_ISODATA::Run(int Initialization)
 			cl_m[iCluster]	= 0;
 		}
 
-		for(iSample=0; iSample<Get_Sample_Count(); iSample++)
+		#pragma omp parallel for
+		for(sLong i=0; i<(sLong)Get_Sample_Count(); i++)	// nearest centroid, samples are independent
 		{
-			data_d [iSample]	=  _Get_Sample_Distance(iSample, 0);
-			data_cl[iSample]	= 0;
+			data_d [i]	=  _Get_Sample_Distance(i, 0);
+			data_cl[i]	= 0;
 
-			for(iCluster=1; iCluster<m_nCluster; iCluster++)
+			for(size_t jCluster=1; jCluster<m_nCluster; jCluster++)
 			{
-				double	Distance	= _Get_Sample_Distance(iSample, iCluster);
+				double	Distance	= _Get_Sample_Distance(i, jCluster);
 
-				if( Distance < data_d[iSample] )
+				if( Distance < data_d[i] )
 				{
-					data_d [iSample]	= Distance;
-					data_cl[iSample]	= iCluster;
+					data_d [i]	= Distance;
+					data_cl[i]	= jCluster;
 				}
 			}
+		}
 
+		for(iSample=0; iSample<Get_Sample_Count(); iSample++)
+		{
 			cl_m[data_cl[iSample]]++;
 		}
 
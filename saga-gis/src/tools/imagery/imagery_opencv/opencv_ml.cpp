@@ -435,28 +435,42 @@ bool COpenCV_ML::_Get_Features(int x, int y, CSG_Vector &Features)
 //---------------------------------------------------------
 bool COpenCV_ML::_Get_Prediction(const Ptr<StatModel> &Model)
 {
+	int nFeatures = m_pFeatures->Get_Grid_Count();
+
 	for(int y=0; y<m_pClasses->Get_NY() && Set_Progress(y, m_pClasses->Get_NY()); y++)
 	{
+		// collect the row's valid cells and let the model predict
+		// them in one call, OpenCV parallelizes batch predictions
+
+		Mat Samples(m_pClasses->Get_NX(), nFeatures, CV_32FC1); CSG_Array_Int Cells(m_pClasses->Get_NX());
+
 		#pragma omp parallel for
 		for(int x=0; x<m_pClasses->Get_NX(); x++)
 		{
-			CSG_Vector Features(m_pFeatures->Get_Grid_Count());
+			CSG_Vector Features(nFeatures);
 
-			if( _Get_Features(x, y, Features) )
+			if( (Cells[x] = _Get_Features(x, y, Features) ? 1 : 0) != 0 )
 			{
-				Mat	Sample(1, m_pFeatures->Get_Grid_Count(), CV_32FC1);
-
-				for(int i=0; i<m_pFeatures->Get_Grid_Count(); i++)
+				for(int i=0; i<nFeatures; i++)
 				{
-					Sample.at<float>(i)	= (float)Features[i];
+					Samples.at<float>(x, i) = (float)Features[i];
 				}
+			}
+		}
 
-				m_pClasses->Set_Value(x, y, Model->predict(Sample));
+		//-------------------------------------------------
+		int nSamples = 0;
 
-				if( m_pProbability )
+		for(int x=0; x<m_pClasses->Get_NX(); x++)
+		{
+			if( Cells[x] )
+			{
+				if( nSamples < x )
 				{
-					m_pProbability->Set_Value(x, y, Get_Probability(Model, Sample));
+					Samples.row(x).copyTo(Samples.row(nSamples));
 				}
+
+				Cells[nSamples++] = x;
 			}
 			else
 			{
@@ -468,6 +482,45 @@ bool COpenCV_ML::_Get_Prediction(const Ptr<StatModel> &Model)
 				}
 			}
 		}
+
+		if( nSamples < 1 )
+		{
+			continue;
+		}
+
+		//-------------------------------------------------
+		Mat Predictions; Model->predict(Samples.rowRange(0, nSamples), Predictions);
+
+		if( Predictions.type() != CV_32FC1 )	// e.g. logistic regression returns integer labels
+		{
+			Predictions.convertTo(Predictions, CV_32FC1);
+		}
+
+		#pragma omp parallel for
+		for(int i=0; i<nSamples; i++)
+		{
+			float Prediction = Predictions.at<float>(i, 0);
+
+			if( Predictions.cols > 1 )	// neural network returns the outputs, single sample prediction returns the index of the maximum
+			{
+				Prediction = 0.f;
+
+				for(int j=1; j<Predictions.cols; j++)
+				{
+					if( Predictions.at<float>(i, j) > Predictions.at<float>(i, (int)Prediction) )
+					{
+						Prediction = (float)j;
+					}
+				}
+			}
+
+			m_pClasses->Set_Value(Cells[i], y, Prediction);
+
+			if( m_pProbability )
+			{
+				m_pProbability->Set_Value(Cells[i], y, Get_Probability(Model, Samples.row(i)));
+			}
+		}
 	}
 
 	return( true );
@@ -372,31 +372,84 @@ bool CSVM_Grids::Predict(void)
 {
 	Process_Set_Text(_TL("prediction"));
 
-	struct svm_node	*Features = (struct svm_node *)SG_Malloc((m_pGrids->Get_Grid_Count() + 1) * sizeof(struct svm_node));
+	int nFeatures = m_pGrids->Get_Grid_Count();
 
-	Features[m_pGrids->Get_Grid_Count()].index = -1;
+	CSVM_Predictor Predictor;
+
+	if( !Predictor.Create(m_pModel, nFeatures) )	// e.g. precomputed kernel, fall back to libsvm's own prediction
+	{
+		struct svm_node	*Features = (struct svm_node *)SG_Malloc((nFeatures + 1) * sizeof(struct svm_node));
+
+		Features[nFeatures].index = -1;
+
+		for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
+		{
+			for(int x=0; x<Get_NX(); x++)
+			{
+				if( !m_pClasses->is_NoData(x, y) )
+				{
+					for(int iGrid=0; iGrid<nFeatures; iGrid++)
+					{
+						Features[iGrid].index = iGrid;
+						Features[iGrid].value = Get_Value(x, y, iGrid);
+					}
+
+					m_pClasses->Set_Value(x, y, svm_predict(m_pModel, Features) - 1);
+				}
+			}
+		}
+
+		SG_Free(Features);
+
+		return( true );
+	}
 
 	//-----------------------------------------------------
+	int nBlocks = 1 + (Get_NX() - 1) / CSVM_Predictor::Get_Block_Size();
+
+	CSVM_Predictor_Buffer *Buffers = new CSVM_Predictor_Buffer[SG_OMP_Get_Max_Num_Threads()];	// kernel buffers are reused by each thread
+
 	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 	{
-		for(int x=0; x<Get_NX(); x++)
+		#pragma omp parallel for schedule(dynamic)
+		for(int iBlock=0; iBlock<nBlocks; iBlock++)
 		{
-			if( !m_pClasses->is_NoData(x, y) )
+			int xMin = iBlock * CSVM_Predictor::Get_Block_Size(), xMax = M_GET_MIN(Get_NX(), xMin + CSVM_Predictor::Get_Block_Size());
+
+			CSG_Matrix Samples(nFeatures, xMax - xMin); CSG_Array_Int Cells;
+
+			for(int x=xMin; x<xMax; x++)
 			{
-				for(int iGrid=0; iGrid<m_pGrids->Get_Grid_Count(); iGrid++)
+				if( !m_pClasses->is_NoData(x, y) )
 				{
-					Features[iGrid].index = iGrid;
-					Features[iGrid].value = Get_Value(x, y, iGrid);
+					double *Sample = Samples[Cells.Get_Size()];
+
+					for(int iGrid=0; iGrid<nFeatures; iGrid++)
+					{
+						Sample[iGrid] = Get_Value(x, y, iGrid);
+					}
+
+					Cells.Add(x);
 				}
+			}
+
+			if( Cells.Get_Size() > 0 )
+			{
+				CSG_Vector Predictions(Cells.Get_Size());
+
+				Predictor.Predict(Samples, (int)Cells.Get_Size(), Predictions.Get_Data(), Buffers[SG_OMP_Get_Thread_Num()]);
 
-				m_pClasses->Set_Value(x, y, svm_predict(m_pModel, Features) - 1);
+				for(sLong i=0; i<Cells.Get_Size(); i++)
+				{
+					m_pClasses->Set_Value(Cells[i], y, Predictions[i] - 1);
+				}
 			}
 		}
 	}
 
-	//-----------------------------------------------------
-	SG_Free(Features);
+	delete[](Buffers);
 
+	//-----------------------------------------------------
 	return( true );
 }
 
@@ -60,11 +60,7 @@
 #include <saga_api/saga_api.h>
 
 //---------------------------------------------------------
-#if defined(SYSTEM_SVM)
-	#include <libsvm/svm.h>
-#else
-	#include "svm/svm.h"
-#endif
+#include "svm_predictor.h"
 
 
 ///////////////////////////////////////////////////////////
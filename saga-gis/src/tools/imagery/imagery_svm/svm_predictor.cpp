@@ -0,0 +1,363 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                         svm                           //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                  svm_predictor.cpp                    //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//                         agent                         //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "svm_predictor.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define SV_CHUNK	512	// support vectors per tile, keeps a block's kernel tile in cache
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+static inline double SVM_powi(double base, int times)	// same as libsvm's powi()
+{
+	double tmp = base, ret = 1.;
+
+	for(int t=times; t>0; t/=2)
+	{
+		if( t % 2 == 1 ) { ret *= tmp; }
+
+		tmp = tmp * tmp;
+	}
+
+	return( ret );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CSVM_Predictor::CSVM_Predictor(void)
+{
+	m_pModel    = NULL;
+	m_nFeatures = 0;
+}
+
+//---------------------------------------------------------
+bool CSVM_Predictor::Destroy(void)
+{
+	m_pModel    = NULL;
+	m_nFeatures = 0;
+
+	m_SV   .Destroy();
+	m_Start.Destroy();
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Takes a reference to the model, which has to stay valid
+// as long as the predictor is used. Fails for precomputed
+// kernels and for support vectors referring to features
+// beyond nFeatures, svm_predict() has to be used then.
+//---------------------------------------------------------
+bool CSVM_Predictor::Create(const struct svm_model *pModel, int nFeatures)
+{
+	Destroy();
+
+	if( !pModel || pModel->l < 1 || nFeatures < 1 )
+	{
+		return( false );
+	}
+
+	switch( pModel->param.kernel_type )
+	{
+	case LINEAR: case POLY: case RBF: case SIGMOID:
+		break;
+
+	default:
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	if( !m_SV.Create(pModel->l, nFeatures) )
+	{
+		return( false );
+	}
+
+	for(int i=0; i<pModel->l; i++)
+	{
+		for(const struct svm_node *pNode=pModel->SV[i]; pNode->index!=-1; pNode++)
+		{
+			if( pNode->index < 0 || pNode->index >= nFeatures )
+			{
+				m_SV.Destroy();
+
+				return( false );
+			}
+
+			m_SV[pNode->index][i] = pNode->value;	// missing entries are zero, as for the sparse nodes
+		}
+	}
+
+	//-----------------------------------------------------
+	if( pModel->param.svm_type == C_SVC || pModel->param.svm_type == NU_SVC )
+	{
+		m_Start.Create(pModel->nr_class);
+
+		m_Start[0] = 0;
+
+		for(int i=1; i<pModel->nr_class; i++)
+		{
+			m_Start[i] = m_Start[i - 1] + pModel->nSV[i - 1];
+		}
+	}
+
+	m_pModel    = pModel;
+	m_nFeatures = nFeatures;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Expects one sample per matrix row with Get_Feature_Count()
+// columns, writes the predicted labels (classification) or
+// values (regression) to Predictions. Can be called from
+// several threads concurrently, as long as each thread uses
+// its own buffer.
+//---------------------------------------------------------
+bool CSVM_Predictor::Predict(const CSG_Matrix &Samples, int nSamples, double *Predictions)	const
+{
+	CSVM_Predictor_Buffer Buffer;
+
+	return( Predict(Samples, nSamples, Predictions, Buffer) );
+}
+
+//---------------------------------------------------------
+bool CSVM_Predictor::Predict(const CSG_Matrix &Samples, int nSamples, double *Predictions, CSVM_Predictor_Buffer &Buffer)	const
+{
+	if( !is_Okay() || Samples.Get_NCols() < m_nFeatures || Samples.Get_NRows() < nSamples )
+	{
+		return( false );
+	}
+
+	int nClasses = m_pModel->nr_class, nPairs = M_GET_MAX(1, nClasses * (nClasses - 1) / 2);
+
+	CSG_Matrix &Kernels = Buffer.m_Kernels; CSG_Vector &Decision = Buffer.m_Decision; CSG_Array_Int &Votes = Buffer.m_Votes;
+
+	if( Kernels.Get_NCols() != m_pModel->l || Kernels.Get_NRows() < Get_Block_Size() || Decision.Get_N() < nPairs || Votes.Get_Size() < nClasses )	// first use or another model
+	{
+		if( !Kernels.Create(m_pModel->l, Get_Block_Size()) || !Decision.Create(nPairs) || !Votes.Create(M_GET_MAX(1, nClasses)) )
+		{
+			return( false );
+		}
+	}
+
+	for(int iSample=0; iSample<nSamples; iSample+=Get_Block_Size())
+	{
+		int n = M_GET_MIN(Get_Block_Size(), nSamples - iSample);
+
+		_Get_Kernels(Samples, iSample, n, Kernels);
+
+		for(int i=0; i<n; i++)
+		{
+			Predictions[iSample + i] = _Get_Prediction(Kernels[i], Decision.Get_Data(), Votes.Get_Array());
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Evaluates the kernels of nSamples samples against all
+// support vectors. The features are added in ascending order
+// for each kernel, as libsvm does with its sparse nodes.
+//---------------------------------------------------------
+void CSVM_Predictor::_Get_Kernels(const CSG_Matrix &Samples, int iSample, int nSamples, CSG_Matrix &Kernels)	const
+{
+	const struct svm_parameter &Param = m_pModel->param; int nSVs = m_pModel->l;
+
+	for(int jSV=0; jSV<nSVs; jSV+=SV_CHUNK)
+	{
+		int nChunk = M_GET_MIN(SV_CHUNK, nSVs - jSV);
+
+		for(int i=0; i<nSamples; i++)
+		{
+			double *K = Kernels[i] + jSV; for(int j=0; j<nChunk; j++) { K[j] = 0.; }
+		}
+
+		//-------------------------------------------------
+		for(int iFeature=0; iFeature<m_nFeatures; iFeature++)
+		{
+			const double *SV = m_SV[iFeature] + jSV;
+
+			for(int i=0; i<nSamples; i++)
+			{
+				double *K = Kernels[i] + jSV, x = Samples[iSample + i][iFeature];
+
+				if( Param.kernel_type == RBF )
+				{
+					for(int j=0; j<nChunk; j++)
+					{
+						double d = x - SV[j]; K[j] += d * d;
+					}
+				}
+				else
+				{
+					for(int j=0; j<nChunk; j++)
+					{
+						K[j] += x * SV[j];
+					}
+				}
+			}
+		}
+
+		//-------------------------------------------------
+		for(int i=0; i<nSamples; i++)
+		{
+			double *K = Kernels[i] + jSV;
+
+			switch( Param.kernel_type )
+			{
+			case RBF    : for(int j=0; j<nChunk; j++) { K[j] = exp(-Param.gamma * K[j]); } break;
+			case POLY   : for(int j=0; j<nChunk; j++) { K[j] = SVM_powi(Param.gamma * K[j] + Param.coef0, Param.degree); } break;
+			case SIGMOID: for(int j=0; j<nChunk; j++) { K[j] = tanh(Param.gamma * K[j] + Param.coef0); } break;
+			default     : break;
+			}
+		}
+	}
+}
+
+//---------------------------------------------------------
+// Decision functions and one-against-one voting as done by
+// svm_predict_values().
+//---------------------------------------------------------
+double CSVM_Predictor::_Get_Prediction(const double *Kernel, double *Decision, int *Votes)	const
+{
+	const struct svm_model &Model = *m_pModel;
+
+	if( Model.param.svm_type == ONE_CLASS || Model.param.svm_type == EPSILON_SVR || Model.param.svm_type == NU_SVR )
+	{
+		double Sum = 0.; const double *Coef = Model.sv_coef[0];
+
+		for(int i=0; i<Model.l; i++)
+		{
+			Sum += Coef[i] * Kernel[i];
+		}
+
+		Sum -= Model.rho[0];
+
+		return( Model.param.svm_type == ONE_CLASS ? (Sum > 0. ? 1. : -1.) : Sum );
+	}
+
+	//-----------------------------------------------------
+	int nClasses = Model.nr_class;
+
+	for(int i=0; i<nClasses; i++)
+	{
+		Votes[i] = 0;
+	}
+
+	for(int i=0, p=0; i<nClasses; i++)
+	{
+		for(int j=i+1; j<nClasses; j++, p++)
+		{
+			int si = m_Start[i], ci = Model.nSV[i];
+			int sj = m_Start[j], cj = Model.nSV[j];
+
+			const double *Coef1 = Model.sv_coef[j - 1];
+			const double *Coef2 = Model.sv_coef[i    ];
+
+			double Sum = 0.;
+
+			for(int k=0; k<ci; k++)
+			{
+				Sum += Coef1[si + k] * Kernel[si + k];
+			}
+
+			for(int k=0; k<cj; k++)
+			{
+				Sum += Coef2[sj + k] * Kernel[sj + k];
+			}
+
+			Decision[p] = Sum -= Model.rho[p];
+
+			if( Decision[p] > 0. )
+			{
+				Votes[i]++;
+			}
+			else
+			{
+				Votes[j]++;
+			}
+		}
+	}
+
+	int iMax = 0;
+
+	for(int i=1; i<nClasses; i++)
+	{
+		if( Votes[i] > Votes[iMax] )
+		{
+			iMax = i;
+		}
+	}
+
+	return( Model.label[iMax] );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -0,0 +1,147 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                         svm                           //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                   svm_predictor.h                     //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//                         agent                         //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef HEADER_INCLUDED__svm_predictor_H
+#define HEADER_INCLUDED__svm_predictor_H
+
+
+///////////////////////////////////////////////////////////
+//                                                       //												
+//                                                       //												
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <saga_api/saga_api.h>
+
+//---------------------------------------------------------
+#if defined(SYSTEM_SVM)
+	#include <libsvm/svm.h>
+#else
+	#include "svm/svm.h"
+#endif
+
+
+///////////////////////////////////////////////////////////
+//                                                       //												
+//                                                       //												
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Working memory of CSVM_Predictor::Predict(), allocated on
+// first use. Keep one instance per thread and pass it to all
+// predictions of this thread.
+//---------------------------------------------------------
+class CSVM_Predictor_Buffer
+{
+	friend class CSVM_Predictor;
+
+private:
+
+	CSG_Matrix					m_Kernels;
+
+	CSG_Vector					m_Decision;
+
+	CSG_Array_Int				m_Votes;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Evaluates a libsvm model for blocks of dense samples.
+// The support vectors are stored feature by feature, so that
+// the kernels of a sample against all support vectors are
+// accumulated in contiguous, vectorizable loops. Summation
+// order follows libsvm, predictions are identical to those
+// of svm_predict().
+//---------------------------------------------------------
+class CSVM_Predictor
+{
+public:
+	CSVM_Predictor(void);
+	virtual ~CSVM_Predictor(void)	{	Destroy();	}
+
+	bool						Create					(const struct svm_model *pModel, int nFeatures);
+	bool						Destroy					(void);
+
+	bool						is_Okay					(void)	const	{	return( m_pModel != NULL );	}
+
+	int							Get_Feature_Count		(void)	const	{	return( m_nFeatures );	}
+
+	static int					Get_Block_Size			(void)	{	return( 64 );	}
+
+	bool						Predict					(const CSG_Matrix &Samples, int nSamples, double *Predictions)	const;
+	bool						Predict					(const CSG_Matrix &Samples, int nSamples, double *Predictions, CSVM_Predictor_Buffer &Buffer)	const;
+
+
+private:
+
+	int							m_nFeatures;
+
+	const struct svm_model		*m_pModel;
+
+	CSG_Matrix					m_SV;
+
+	CSG_Array_Int				m_Start;
+
+
+	void						_Get_Kernels			(const CSG_Matrix &Samples, int iSample, int nSamples, CSG_Matrix &Kernels)	const;
+
+	double						_Get_Prediction			(const double *Kernel, double *Decision, int *Votes)	const;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//                                                       //												
+//                                                       //												
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef HEADER_INCLUDED__svm_predictor_H
@@ -46,6 +46,8 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <atomic>
+
 #include "textural_features.h"
 
 
@@ -206,66 +208,38 @@ bool CTextural_Features::On_Execute(void)
 	int	Direction	= Parameters("DIRECTION")->asInt();
 
 	//-----------------------------------------------------
-	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
+	// rows are processed in parallel, each thread slides its
+	// own co-occurrence window along the rows it gets
+
+	int nCells = SG_Get_Square(1 + 2 * m_Radius), nSlots = M_GET_MIN(m_MaxCats, nCells);
+
+	int nPairs = (int)M_GET_MIN((sLong)nSlots * (nSlots + 1) / 2, (sLong)nCells);	// distinct pairs of a direction within the window
+
+	std::atomic<int> nDone(0); std::atomic<bool> bOkay(true);	// shared between the main thread and the workers
+
+	#pragma omp parallel
 	{
-		#pragma omp parallel for
-		for(int x=0; x<Get_NX(); x++)
-		{
-			CSG_Matrix	P[4];
+		CTextural_GLCM GLCM(m_MaxCats, nSlots, nPairs);
 
-			if( !Get_Matrices(x, y, Distance, P) )
+		#pragma omp for schedule(dynamic)
+		for(int y=0; y<Get_NY(); y++)
+		{
+			if( SG_OMP_Get_Thread_Num() == 0 && !Set_Progress(nDone, Get_NY()) )	// user interaction only on the main thread
 			{
-				for(int i=0; i<g_nFeatures; i++)
-				{
-					if( pFeatures[i] )
-					{
-						pFeatures[i]->Set_NoData(x, y);
-					}
-				}
+				bOkay = false;
 			}
-			else
-			{
-				CSG_Vector	Features(g_nFeatures);
-
-				switch( Direction )
-				{
-				default: // all
-					Get_Features(Features, P[0]);
-					Get_Features(Features, P[1]);
-					Get_Features(Features, P[2]);
-					Get_Features(Features, P[3]);
-					break;
-
-				case  1: // N-S
-					Get_Features(Features, P[0]);
-					break;
-
-				case  2: // NE-SW
-					Get_Features(Features, P[1]);
-					break;
-
-				case  3: // E-W
-					Get_Features(Features, P[2]);
-					break;
-
-				case  4: // SE-NW
-					Get_Features(Features, P[3]);
-					break;
-				}
 
-				for(int i=0; i<g_nFeatures; i++)
-				{
-					if( pFeatures[i] )
-					{
-						pFeatures[i]->Set_Value(x, y, Direction ? Features[i] : Features[i] / 4);
-					}
-				}
+			if( bOkay )
+			{
+				Set_Row(GLCM, y, Distance, Direction, pFeatures);
 			}
+
+			nDone++;
 		}
 	}
 
 	//-----------------------------------------------------
-	return( true );
+	return( bOkay );
 }
 
 
@@ -285,109 +259,126 @@ inline int CTextural_Features::Get_Value(int x, int y)
 }
 
 //---------------------------------------------------------
-bool CTextural_Features::Get_Matrices(int x, int y, int d, CSG_Matrix P[4])
+// Pairs of a direction connect an anchor cell (x, y) with
+// (x + dx, y + dy). Adds (Sign = 1) or removes (Sign = -1)
+// column x and all pairs within the window involving it, so
+// that each pair is counted once.
+//---------------------------------------------------------
+void CTextural_Features::Set_Column(CTextural_GLCM &GLCM, int x, int xMin, int xMax, int yMin, int yMax, int Distance, bool bDirection[4], int Sign)
 {
-	if( m_pGrid->is_NoData(x, y) )
-	{
-		return( false );
-	}
-
-	//-----------------------------------------------------
-	CSG_Array_Int	Tones(m_MaxCats);
+	const int dx[4] = { Distance, -Distance, 0, Distance };
+	const int dy[4] = { 0, Distance, Distance, Distance };
 
-	for(sLong iTone=0; iTone<Tones.Get_Size(); iTone++)
+	if( Sign > 0 )	// tones first, pairs refer to their slots
 	{
-		Tones[iTone] = -1;
+		for(int y=yMin; y<=yMax; y++)
+		{
+			GLCM.Add_Tone(Get_Value(x, y), Sign);
+		}
 	}
 
-	// Determine the number of different gray scales (not maxval)
-	for(int iy=y-m_Radius; iy<=y+m_Radius; iy++)
+	for(int i=0; i<4; i++)
 	{
-		for(int ix=x-m_Radius; ix<=x+m_Radius; ix++)
+		if( bDirection[i] )
 		{
-			int	Value	= Get_Value(ix, iy);
-
-			if( Value < 0 )
+			if( xMin <= x + dx[i] && x + dx[i] <= xMax )	// anchor in column x
 			{
-				return( false );
+				for(int y=yMin; y<=yMax-dy[i]; y++)
+				{
+					GLCM.Add_Pair(i, Get_Value(x, y), Get_Value(x + dx[i], y + dy[i]), Sign);
+				}
 			}
 
-			Tones[Value] = Value;
+			if( dx[i] != 0 && xMin <= x - dx[i] && x - dx[i] <= xMax )	// partner in column x
+			{
+				for(int y=yMin; y<=yMax-dy[i]; y++)
+				{
+					GLCM.Add_Pair(i, Get_Value(x - dx[i], y), Get_Value(x, y + dy[i]), Sign);
+				}
+			}
 		}
 	}
 
-	// Collapse array, taking out all zero values
-	int nTones = 0;
-
-	for(sLong iTone=0; iTone<Tones.Get_Size(); iTone++)
+	if( Sign < 0 )
 	{
-		if( Tones[iTone] >= 0 )
+		for(int y=yMin; y<=yMax; y++)
 		{
-			Tones[nTones++]	= Tones[iTone];
+			GLCM.Add_Tone(Get_Value(x, y), Sign);
 		}
 	}
+}
+
+//---------------------------------------------------------
+// Instead of building the co-occurrence matrices for each
+// cell, the window slides along the row, removing the pairs
+// of the leaving and adding those of the entering column.
+//---------------------------------------------------------
+void CTextural_Features::Set_Row(CTextural_GLCM &GLCM, int y, int Distance, int Direction, CSG_Grid *pFeatures[])
+{
+	bool bDirection[4]; for(int i=0; i<4; i++) { bDirection[i] = Direction == 0 || Direction == i + 1; }
 
-	Tones.Set_Array(nTones);
+	int n = 1 + 2 * m_Radius;
+
+	const double Norm[4] =	// as used by the original implementation
+	{
+		2. * (n    ) * (n - 1),
+		2. * (n - 1) * (n - 1),
+		2. * (n - 1) * (n    ),
+		2. * (n - 1) * (n - 1)
+	};
 
 	//-----------------------------------------------------
-	P[0].Create(nTones, nTones);
-	P[1].Create(nTones, nTones);
-	P[2].Create(nTones, nTones);
-	P[3].Create(nTones, nTones);
+	GLCM.Clear();
+
+	int xMin = -m_Radius, xMax = -m_Radius - 1, yMin = y - m_Radius, yMax = y + m_Radius;
+
+	while( xMax < m_Radius )
+	{
+		xMax++; Set_Column(GLCM, xMax, xMin, xMax, yMin, yMax, Distance, bDirection, 1);
+	}
 
 	//-----------------------------------------------------
-	// Find gray-Tones spatial dependence matrix
-	for(int iy=y-m_Radius; iy<=y+m_Radius; iy++)
+	for(int x=0; x<Get_NX(); x++)
 	{
-		for(int ix=x-m_Radius; ix<=x+m_Radius; ix++)
+		if( x > 0 )
 		{
-			int j = 0; while(Tones[j] != Get_Value(ix, iy)) j++;
+			Set_Column(GLCM, xMin, xMin, xMax, yMin, yMax, Distance, bDirection, -1); xMin++;
+			xMax++; Set_Column(GLCM, xMax, xMin, xMax, yMin, yMax, Distance, bDirection,  1);
+		}
 
-			if( ix + d <= x + m_Radius )
+		if( m_pGrid->is_NoData(x, y) || GLCM.Get_Invalid() > 0 )
+		{
+			for(int i=0; i<g_nFeatures; i++)
 			{
-				int i = 0; while(Tones[i] != Get_Value(ix + d, iy    )) i++;
-
-				P[0][j][i]++;
-				P[0][i][j]++;
+				if( pFeatures[i] )
+				{
+					pFeatures[i]->Set_NoData(x, y);
+				}
 			}
+		}
+		else
+		{
+			CSG_Vector Features(g_nFeatures);
 
-			if( iy + d <= y + m_Radius )
-			{
-				int i = 0; while(Tones[i] != Get_Value(ix   , iy + d)) i++;
-
-				P[2][j][i]++;
-				P[2][i][j]++;
-			}
+			GLCM.Set_Ranks();
 
-			if( iy + d <= y + m_Radius && ix - d >= x - m_Radius )
+			for(int i=0; i<4; i++)
 			{
-				int i = 0; while(Tones[i] != Get_Value(ix - d, iy + d)) i++;
-
-				P[1][j][i]++;
-				P[1][i][j]++;
+				if( bDirection[i] )
+				{
+					GLCM.Get_Features(Features, i, Norm[i]);
+				}
 			}
 
-			if( iy + d <= y + m_Radius && ix + d <= x + m_Radius )
+			for(int i=0; i<g_nFeatures; i++)
 			{
-				int i = 0; while(Tones[i] != Get_Value(ix + d, iy + d)) i++;
-
-				P[3][j][i]++;
-				P[3][i][j]++;
+				if( pFeatures[i] )
+				{
+					pFeatures[i]->Set_Value(x, y, Direction ? Features[i] : Features[i] / 4);
+				}
 			}
 		}
 	}
-
-	//-----------------------------------------------------
-	// Normalize gray-Tones spatial dependence matrix
-	int	n	= 1 + 2 * m_Radius;
-
-	P[0]	*= 1. / (2. * (n    ) * (n - 1));
-	P[1]	*= 1. / (2. * (n - 1) * (n - 1));
-	P[2]	*= 1. / (2. * (n - 1) * (n    ));
-	P[3]	*= 1. / (2. * (n - 1) * (n - 1));
-
-	//-----------------------------------------------------
-	return( true );
 }
 
 
@@ -398,278 +389,318 @@ bool CTextural_Features::Get_Matrices(int x, int y, int d, CSG_Matrix P[4])
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-// in the following are those parts of the original grass implementation
-// (r.texture/h_measure.c) responsible for the calculation of the 'measures' from the
-// occurrence/co-occurrence matrices:
-//
-// MODULE:       r.texture
-// AUTHOR(S):    Carmine Basco - basco@unisannio.it
-//               with hints from: 
-// 			prof. Giulio Antoniol - antoniol@ieee.org
-// 			prof. Michele Ceccarelli - ceccarelli@unisannio.it
-// 
-//---------------------------------------------------------
-
 #define EPSILON 0.000000001
 
-double f1_asm(const double **P, int Ng)
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CTextural_GLCM::CTextural_GLCM(int nTones, int nSlots, int nPairs)
 {
-    double	sum	= 0.0;
+	m_nTones = nTones; m_nSlots = nSlots; m_nRanks = 0; m_nInvalid = 0;
 
-    for(int i=0; i<Ng; i++)
-		for(int j=0; j<Ng; j++)
-			sum	+= P[i][j] * P[i][j];
+	m_nTone.Create(m_nTones); m_nTone.Assign( 0);
+	m_Slot .Create(m_nTones); m_Slot .Assign(-1);
+	m_Rank .Create(m_nSlots);
+	m_Free .Create(m_nSlots);
 
-    return sum;
-}
+	int Bits = 1; while( (1ll << Bits) < 2ll * nPairs ) { Bits++; }	// load factor of the hash table stays below 0.5
 
-double f2_contrast(const double **P, int Ng)
-{
-    int i, j, n;
-    double sum, bigsum = 0;
-
-    for (n = 0; n < Ng; n++) {
-	sum = 0;
-	for (i = 0; i < Ng; i++) {
-	    for (j = 0; j < Ng; j++) {
-		if ((i - j) == n || (j - i) == n) {
-		    sum += P[i][j];
-		}
-	    }
+	m_Shift = 64 - Bits; m_Mask = (1ll << Bits) - 1;
+
+	for(int i=0; i<4; i++)
+	{
+		m_Table [i].Create(m_Mask + 1); m_Table[i].Assign(-1);
+		m_Count [i].Create(0, TSG_Array_Growth::SG_ARRAY_GROWTH_1);
+		m_Active[i].Create(0, TSG_Array_Growth::SG_ARRAY_GROWTH_1);
 	}
-	bigsum += n * n * sum;
-    }
-    return bigsum;
-}
 
-double f3_corr(const double **P, int Ng, const double *px)
-{
-    int i, j;
-    double sum_sqrx = 0, sum_sqry = 0, tmp = 0;
-    double meanx = 0, meany = 0, stddevx, stddevy;
+	m_px   .Create(m_nSlots);
+	m_Pxpys.Create(m_nSlots * 2);
+	m_Pxpyd.Create(m_nSlots * 2);
 
+	Clear();
+}
 
-    /* Now calculate the means and standard deviations of px and py */
+//---------------------------------------------------------
+void CTextural_GLCM::Clear(void)
+{
+	for(int i=0; i<4; i++)
+	{
+		for(sLong j=0; j<m_Active[i].Get_Size(); j++)
+		{
+			m_Table[i][_Find(i, m_Active[i][j])] = -1;
+		}
 
-    /*- fix supplied by J. Michael Christensen, 21 Jun 1991 */
+		m_Active[i].Set_Array(0, false); m_Count[i].Set_Array(0, false);
+	}
 
-    /*- further modified by James Darrell McCauley, 16 Aug 1991
-     *     after realizing that meanx=meany and stddevx=stddevy
-     */
-    for (i = 0; i < Ng; i++) {
-	meanx += px[i] * i;
-	sum_sqrx += px[i] * i * i;
+	for(int i=0; i<m_nTones; i++)
+	{
+		m_nTone[i] = 0; m_Slot[i] = -1;
+	}
 
-	for (j = 0; j < Ng; j++)
-	    tmp += i * j * P[i][j];
-    }
-    meany = meanx;
-    sum_sqry = sum_sqrx;
-    stddevx = sqrt(sum_sqrx - (meanx * meanx));
-    stddevy = stddevx;
+	for(int i=0; i<m_nSlots; i++)
+	{
+		m_Free[i] = m_nSlots - 1 - i;
+	}
 
-    return (tmp - meanx * meany) / (stddevx * stddevy);
+	m_nInvalid = 0;
 }
 
-/* Sum of Squares: Variance */
-double f4_var(const double **P, int Ng)
+//---------------------------------------------------------
+void CTextural_GLCM::Add_Tone(int Tone, int Sign)
 {
-    int i, j;
-    double mean = 0, var = 0;
-
-    /*- Corrected by James Darrell McCauley, 16 Aug 1991
-     *  calculates the mean intensity level instead of the mean of
-     *  cooccurrence matrix elements
-     */
-    for (i = 0; i < Ng; i++)
-	for (j = 0; j < Ng; j++)
-	    mean += i * P[i][j];
-
-    for (i = 0; i < Ng; i++)
-	for (j = 0; j < Ng; j++)
-	    var += (i + 1 - mean) * (i + 1 - mean) * P[i][j];
-
-    return var;
+	if( Tone < 0 )
+	{
+		m_nInvalid += Sign;
+	}
+	else if( Sign > 0 )
+	{
+		if( m_nTone[Tone]++ == 0 )
+		{
+			m_Slot[Tone] = m_Free[m_Free.Get_Size() - 1]; m_Free.Dec_Array(false);
+		}
+	}
+	else
+	{
+		if( --m_nTone[Tone] == 0 )
+		{
+			m_Free.Add(m_Slot[Tone]); m_Slot[Tone] = -1;
+		}
+	}
 }
 
-/* Inverse Difference Moment */
-double f5_idm(const double **P, int Ng)
+//---------------------------------------------------------
+// Returns the hash table position holding the key or, if
+// the key is not stored, the empty position ending its
+// probe sequence (linear probing).
+//---------------------------------------------------------
+sLong CTextural_GLCM::_Find(int Direction, sLong Key)
 {
-    int i, j;
-    double idm = 0;
+	const int *Table = m_Table[Direction].Get_Array(); const sLong *Active = m_Active[Direction].Get_Array();
+
+	sLong i = _Get_Hash(Key);
 
-    for (i = 0; i < Ng; i++)
-	for (j = 0; j < Ng; j++)
-	    idm += P[i][j] / (1 + (i - j) * (i - j));
+	while( Table[i] >= 0 && Active[Table[i]] != Key )
+	{
+		i = (i + 1) & m_Mask;
+	}
 
-    return idm;
+	return( i );
 }
 
-/* Sum Average */
-double f6_savg(const double **P, int Ng, const double *Pxpys)
+//---------------------------------------------------------
+// Empties the table position and shifts following entries
+// of the probe sequence back, so that no tombstones remain.
+//---------------------------------------------------------
+void CTextural_GLCM::_Remove(int Direction, sLong i)
 {
-    int i;
-    double savg = 0;
+	int *Table = m_Table[Direction].Get_Array(); const sLong *Active = m_Active[Direction].Get_Array();
 
-    for (i = 0; i < 2 * Ng - 1; i++)
-	savg += (i + 2) * Pxpys[i];
+	for(sLong j=i; ; )
+	{
+		Table[i] = -1;
 
-    return savg;
-}
+		do
+		{
+			if( Table[j = (j + 1) & m_Mask] < 0 )
+			{
+				return;
+			}
 
-/* Sum Variance */
-double f7_svar(const double **P, int Ng, double S, const double *Pxpys)
-{
-    int i;
-    double var = 0;
+			sLong h = _Get_Hash(Active[Table[j]]);	// entry has to stay, if its home lies cyclically in (i, j]
 
-    for (i = 0; i < 2 * Ng - 1; i++)
-	var += (i + 2 - S) * (i + 2 - S) * Pxpys[i];
+			if( i <= j ? (i < h && h <= j) : (i < h || h <= j) )
+			{
+				continue;
+			}
 
-    return var;
+			break;
+		}
+		while( true );
+
+		Table[i] = Table[j]; i = j;
+	}
 }
 
-/* Sum Entropy */
-double f8_sentropy(const double **P, int Ng, const double *Pxpys)
+//---------------------------------------------------------
+// The matrix is symmetric, so only the entry (a <= b) is
+// stored. It holds P[a][b] (= P[b][a]) in counts, each pair
+// increments both, which doubles the diagonal entries.
+//---------------------------------------------------------
+void CTextural_GLCM::Add_Pair(int Direction, int a, int b, int Sign)
 {
-    int i;
-    double sentr = 0;
+	if( a < 0 || b < 0 )
+	{
+		return;
+	}
 
-    for (i = 0; i < 2 * Ng - 1; i++)
-	sentr -= Pxpys[i] * log10(Pxpys[i] + EPSILON);
+	a = m_Slot[a]; b = m_Slot[b];
 
-    return sentr;
-}
+	sLong Key = a < b ? (sLong)a * m_nSlots + b : (sLong)b * m_nSlots + a, Position = _Find(Direction, Key);
 
-/* Entropy */
-double f9_entropy(const double **P, int Ng)
-{
-    int i, j;
-    double entropy = 0;
+	int Entry = m_Table[Direction][Position], Inc = a == b ? 2 : 1;
+
+	CSG_Array_sLong &Active = m_Active[Direction]; CSG_Array_Int &Count = m_Count[Direction];
 
-    for (i = 0; i < Ng; i++) {
-	for (j = 0; j < Ng; j++) {
-	    entropy += P[i][j] * log10(P[i][j] + EPSILON);
+	if( Sign > 0 )
+	{
+		if( Entry < 0 )
+		{
+			m_Table[Direction][Position] = Entry = (int)Active.Get_Size(); Active.Add(Key); Count.Add(0);
+		}
+
+		Count[Entry] += Inc;
 	}
-    }
+	else if( Entry >= 0 && (Count[Entry] -= Inc) == 0 )
+	{
+		sLong Last = Active.Get_Size() - 1;
 
-    return -entropy;
-}
+		if( Entry < Last )	// move the last active entry to the free place
+		{
+			m_Table[Direction][_Find(Direction, Active[Last])] = Entry; Active[Entry] = Active[Last]; Count[Entry] = Count[Last];
+		}
 
-/* Difference Variance */
-double f10_dvar(const double **P, int Ng, const double *Pxpyd)
-{
-    int i, tmp;
-    double sum = 0, sum_sqr = 0, var = 0;
-
-    /* Now calculate the variance of Pxpy (Px-y) */
-    for (i = 0; i < Ng; i++) {
-	sum += Pxpyd[i];
-	sum_sqr += Pxpyd[i] * Pxpyd[i];
-    }
-    tmp = Ng * Ng;
-    var = ((tmp * sum_sqr) - (sum * sum)) / (tmp * tmp);
-
-    return var;
+		Active.Dec_Array(false); Count.Dec_Array(false);
+
+		_Remove(Direction, Position);
+	}
 }
 
-/* Difference Entropy */
-double f11_dentropy(const double **P, int Ng, const double *Pxpyd)
+//---------------------------------------------------------
+// Like the original implementation, the features refer to
+// the ranks of the tones present in the window.
+//---------------------------------------------------------
+void CTextural_GLCM::Set_Ranks(void)
 {
-    int i;
-    double sum = 0;
-
-    for (i = 0; i < Ng; i++)
-	sum += Pxpyd[i] * log10(Pxpyd[i] + EPSILON);
+	m_nRanks = 0;
 
-    return -sum;
+	for(int i=0; i<m_nTones; i++)
+	{
+		if( m_nTone[i] > 0 )
+		{
+			m_Rank[m_Slot[i]] = m_nRanks++;
+		}
+	}
 }
 
-/* Information Measures of Correlation */
-double f12_icorr(const double **P, int Ng, const double *px, const double *py)
+//---------------------------------------------------------
+// in the following are those parts of the original grass implementation
+// (r.texture/h_measure.c) responsible for the calculation of the 'measures' from the
+// occurrence/co-occurrence matrices:
+//
+// MODULE:       r.texture
+// AUTHOR(S):    Carmine Basco - basco@unisannio.it
+//               with hints from: 
+// 			prof. Giulio Antoniol - antoniol@ieee.org
+// 			prof. Michele Ceccarelli - ceccarelli@unisannio.it
+// 
+// The measures are evaluated from the non-zero matrix entries
+// only. Off-diagonal entries stand for both P[i][j] and P[j][i].
+//---------------------------------------------------------
+void CTextural_GLCM::Get_Features(CSG_Vector &Features, int Direction, double Norm)
 {
-    int i, j;
-    double hx = 0, hy = 0, hxy = 0, hxy1 = 0;
+	int Ng = m_nRanks; CSG_Array_sLong &Active = m_Active[Direction]; CSG_Array_Int &Count = m_Count[Direction];
 
-    for (i = 0; i < Ng; i++)
-	for (j = 0; j < Ng; j++) {
-	    hxy1 -= P[i][j] * log10(px[i] * py[j] + EPSILON);
-	    hxy -= P[i][j] * log10(P[i][j] + EPSILON);
+	for(int i=0; i<Ng; i++)
+	{
+		m_px[i] = 0.; m_Pxpys[i] = m_Pxpys[Ng + i] = m_Pxpyd[i] = 0.;
 	}
 
-    /* Calculate entropies of px and py - is this right? */
-    for (i = 0; i < Ng; i++) {
-	hx -= px[i] * log10(px[i] + EPSILON);
-	hy -= py[i] * log10(py[i] + EPSILON);
-    }
+	//-----------------------------------------------------
+	double Asm = 0., Contrast = 0., ij = 0., Mean = 0., Idm = 0., Entropy = 0.;
 
-    /* fprintf(stderr,"hxy1=%f\thxy=%f\thx=%f\thy=%f\n",hxy1,hxy,hx,hy); */
-    return ((hxy - hxy1) / (hx > hy ? hx : hy));
-}
+	for(sLong k=0; k<Active.Get_Size(); k++)
+	{
+		sLong Key = Active[k]; int i = m_Rank[Key / m_nSlots], j = m_Rank[Key % m_nSlots], d = abs(i - j);
 
-/* Information Measures of Correlation */
-double f13_icorr(const double **P, int Ng, const double *px, const double *py)
-{
-    int i, j;
-    double hxy = 0, hxy2 = 0;
+		double p = Count[k] / Norm, n = i == j ? 1. : 2.;
+
+		Asm       += n * p * p;
+		Contrast  += n * p * d * d;
+		ij        += n * p * i * j;
+		Mean      += p * (i == j ? i : i + j);
+		Idm       += n * p / (1. + d * d);
+		Entropy   += n * p * log10(p + EPSILON);
 
-    for (i = 0; i < Ng; i++) {
-	for (j = 0; j < Ng; j++) {
-	    hxy2 -= px[i] * py[j] * log10(px[i] * py[j] + EPSILON);
-	    hxy -= P[i][j] * log10(P[i][j] + EPSILON);
+		m_px   [i    ] += p; if( i != j ) { m_px[j] += p; }
+		m_Pxpys[i + j] += n * p;
+		m_Pxpyd[d    ] += n * p;
 	}
-    }
 
-    /* fprintf(stderr,"hx=%f\thxy2=%f\n",hx,hxy2); */
-    return (sqrt(fabs(1 - exp(-2.0 * (hxy2 - hxy)))));
-}
+	//-----------------------------------------------------
+	double Variance = 0., hxy1 = 0.;
 
+	for(sLong k=0; k<Active.Get_Size(); k++)
+	{
+		sLong Key = Active[k]; int i = m_Rank[Key / m_nSlots], j = m_Rank[Key % m_nSlots];
 
-///////////////////////////////////////////////////////////
-//                                                       //
-///////////////////////////////////////////////////////////
+		double p = Count[k] / Norm, n = i == j ? 1. : 2.;
 
-//---------------------------------------------------------
-bool CTextural_Features::Get_Features(CSG_Vector &Features, const CSG_Matrix &P)
-{
-	//-----------------------------------------------------
-	int	nTones	= P.Get_NCols();
+		Variance += p * SG_Get_Square(i + 1 - Mean); if( i != j ) { Variance += p * SG_Get_Square(j + 1 - Mean); }
+		hxy1     -= n * p * log10(m_px[i] * m_px[j] + EPSILON);
+	}
 
-	CSG_Vector	px   (nTones    );
-	CSG_Vector	py   (nTones    );
-	CSG_Vector	Pxpys(nTones * 2);
-	CSG_Vector	Pxpyd(nTones * 2);
+	//-----------------------------------------------------
+	double meanx = 0., sum_sqrx = 0., hx = 0., hxy2 = 0.;
 
-	for(int i=0; i<nTones; i++)
+	for(int i=0; i<Ng; i++)
 	{
-		for(int j=0; j<nTones; j++)
+		meanx    += m_px[i] * i;
+		sum_sqrx += m_px[i] * i * i;
+		hx       -= m_px[i] * log10(m_px[i] + EPSILON);
+
+		for(int j=0; j<Ng; j++)
 		{
-			px[i]				+= P[i][j];
-			py[j]				+= P[i][j];
-			Pxpys[i + j]		+= P[i][j];
-			Pxpyd[abs(i - j)]	+= P[i][j];
+			double pxy = m_px[i] * m_px[j];	// py equals px for a symmetric matrix
+
+			hxy2 -= pxy * log10(pxy + EPSILON);
 		}
 	}
 
+	double stddev = sqrt(sum_sqrx - meanx * meanx);
+
+	//-----------------------------------------------------
+	double Sum_Average = 0., Sum_Entropy = 0., Sum_Variance = 0.;
+
+	for(int i=0; i<2*Ng-1; i++)
+	{
+		Sum_Average += (i + 2) * m_Pxpys[i];
+		Sum_Entropy -= m_Pxpys[i] * log10(m_Pxpys[i] + EPSILON);
+	}
+
+	for(int i=0; i<2*Ng-1; i++)
+	{
+		Sum_Variance += SG_Get_Square(i + 2 - Sum_Entropy) * m_Pxpys[i];	// sic, as in the original
+	}
+
 	//-----------------------------------------------------
-	double	Sum_Entropy;
-
-	Features[ASM         ]	+= f1_asm      (P, nTones);
-	Features[CONTRAST    ]	+= f2_contrast (P, nTones);
-	Features[CORRELATION ]	+= f3_corr     (P, nTones, px);
-	Features[VARIANCE    ]	+= f4_var      (P, nTones);
-	Features[IDM         ]	+= f5_idm      (P, nTones);
-	Features[SUM_AVERAGE ]	+= f6_savg     (P, nTones, Pxpys);
-	Features[SUM_ENTROPY ]	+= Sum_Entropy	= f8_sentropy (P, nTones, Pxpys);
-	Features[SUM_VARIANCE]	+= f7_svar     (P, nTones, Sum_Entropy, Pxpys);
-	Features[ENTROPY     ]	+= f9_entropy  (P, nTones);
-	Features[DIF_VARIANCE]	+= f10_dvar    (P, nTones, Pxpyd);
-	Features[DIF_ENTROPY ]	+= f11_dentropy(P, nTones, Pxpyd);
-	Features[MOC_1       ]	+= f12_icorr   (P, nTones, px, py);
-	Features[MOC_2       ]	+= f13_icorr   (P, nTones, px, py);
+	double Sum = 0., Sum_Sqr = 0., Dif_Entropy = 0., tmp = Ng * Ng;
+
+	for(int i=0; i<Ng; i++)
+	{
+		Sum         += m_Pxpyd[i];
+		Sum_Sqr     += m_Pxpyd[i] * m_Pxpyd[i];
+		Dif_Entropy -= m_Pxpyd[i] * log10(m_Pxpyd[i] + EPSILON);
+	}
 
 	//-----------------------------------------------------
-	return( true );
+	Features[ASM         ]	+= Asm;
+	Features[CONTRAST    ]	+= Contrast;
+	Features[CORRELATION ]	+= (ij - meanx * meanx) / (stddev * stddev);
+	Features[VARIANCE    ]	+= Variance;
+	Features[IDM         ]	+= Idm;
+	Features[SUM_AVERAGE ]	+= Sum_Average;
+	Features[SUM_ENTROPY ]	+= Sum_Entropy;
+	Features[SUM_VARIANCE]	+= Sum_Variance;
+	Features[ENTROPY     ]	+= -Entropy;
+	Features[DIF_VARIANCE]	+= ((tmp * Sum_Sqr) - (Sum * Sum)) / (tmp * tmp);
+	Features[DIF_ENTROPY ]	+= Dif_Entropy;
+	Features[MOC_1       ]	+= (-Entropy - hxy1) / hx;
+	Features[MOC_2       ]	+= sqrt(fabs(1. - exp(-2. * (hxy2 + Entropy))));
 }
 
 
@@ -66,6 +66,57 @@
 //                                                       //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+// Grey level co-occurrence counts of a moving window. Tones
+// present in the window are mapped to slots. Non-zero pairs
+// are kept in an active list per direction, which is found
+// through an open addressing hash table, so that memory is
+// bound by the number of pairs in the window.
+//---------------------------------------------------------
+class CTextural_GLCM
+{
+public:
+	CTextural_GLCM(int nTones, int nSlots, int nPairs);
+
+	void					Clear			(void);
+
+	void					Add_Tone		(int Tone, int Sign);
+	void					Add_Pair		(int Direction, int a, int b, int Sign);
+
+	int						Get_Invalid		(void)	const	{	return( m_nInvalid );	}
+
+	void					Set_Ranks		(void);
+
+	void					Get_Features	(CSG_Vector &Features, int Direction, double Norm);
+
+
+private:
+
+	sLong					_Get_Hash		(sLong Key)	const	{	return( (sLong)(((unsigned long long)Key * 0x9E3779B97F4A7C15ull) >> m_Shift) );	}
+
+	sLong					_Find			(int Direction, sLong Key);
+	void					_Remove			(int Direction, sLong Position);
+
+
+private:
+
+	int						m_nTones, m_nSlots, m_nRanks, m_nInvalid, m_Shift;
+
+	sLong					m_Mask;
+
+	CSG_Array_Int			m_nTone, m_Slot, m_Free, m_Rank, m_Table[4], m_Count[4];
+
+	CSG_Array_sLong			m_Active[4];
+
+	CSG_Vector				m_px, m_Pxpys, m_Pxpyd;
+
+};
+
+
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
 //---------------------------------------------------------
 class CTextural_Features : public CSG_Tool_Grid
 {
@@ -89,8 +140,8 @@ private:
 
 	int						Get_Value		(int x, int y);
 
-	bool					Get_Matrices	(int x, int y, int d, CSG_Matrix P[4]);
-	bool					Get_Features	(CSG_Vector &Features, const CSG_Matrix &P);
+	void					Set_Column		(CTextural_GLCM &GLCM, int x, int xMin, int xMax, int yMin, int yMax, int Distance, bool bDirection[4], int Sign);
+	void					Set_Row			(CTextural_GLCM &GLCM, int y, int Distance, int Direction, CSG_Grid *pFeatures[]);
 
 };
 
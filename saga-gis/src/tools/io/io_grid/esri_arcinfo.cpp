@@ -200,12 +200,12 @@ bool CESRI_ArcInfo_Import::On_Execute(void)
 	case  3: Datatype = SG_DATATYPE_Double; break;
 	}
 
-	CSG_Grid *pGrid = NULL; CSG_File Stream;
+	CSG_Grid *pGrid = NULL; CSG_Text_Reader Header; CSG_File Stream;
 
 	//-----------------------------------------------------
 	// Binary...
 
-	if( Stream.Open(SG_File_Make_Path("", Parameters("FILE")->asString(), "hdr"), SG_FILE_R, false) && (pGrid = Read_Header(Stream)) != NULL )
+	if( Header.Open(SG_File_Make_Path("", Parameters("FILE")->asString(), "hdr")) && (pGrid = Read_Header(Header)) != NULL )
 	{
 		if( Stream.Open(SG_File_Make_Path("", Parameters("FILE")->asString(), "flt"), SG_FILE_R, true) )
 		{
@@ -228,22 +228,9 @@ bool CESRI_ArcInfo_Import::On_Execute(void)
 	//-----------------------------------------------------
 	// ASCII...
 
-	else if( Stream.Open(Parameters("FILE")->asString(), SG_FILE_R, false) && (pGrid = Read_Header(Stream, Datatype)) != NULL )
+	else if( Header.Open(Parameters("FILE")->asString()) && (pGrid = Read_Header(Header, Datatype)) != NULL )
 	{
-		for(int iy=0, y=pGrid->Get_NY()-1; iy<pGrid->Get_NY() && !Stream.is_EOF() && Set_Progress(iy, pGrid->Get_NY()); iy++, y--)
-		{
-			for(int x=0; x<pGrid->Get_NX(); x++)
-			{
-				double Value = Read_Value(Stream);
-
-				if( iNoData == 1 && Value == pGrid->Get_NoData_Value() )
-				{
-					Value = dNoData;
-				}
-
-				pGrid->Set_Value(x, y, Value);
-			}
-		}
+		Read_Values(Header, pGrid, iNoData, dNoData);
 
 		if( iNoData == 1 )
 		{
@@ -273,41 +260,77 @@ bool CESRI_ArcInfo_Import::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-double CESRI_ArcInfo_Import::Read_Value(CSG_File &Stream)
+// The values are read block-wise and parsed in parallel. Each
+// line's values are counted first, so that every line knows
+// the cell position of its first value, which is independent
+// from the line length (i.e. lines need not to match rows).
+//---------------------------------------------------------
+bool CESRI_ArcInfo_Import::Read_Values(CSG_Text_Reader &Stream, CSG_Grid *pGrid, int NoData_Type, double NoData)
 {
-	CSG_String s; int c;
+	Stream.Set_Separators(" \t", true); Stream.Set_Decimal_Comma(true); Stream.Set_Quotes(false);
 
-	while( !Stream.is_EOF() && !SG_is_Character_Numeric(c = Stream.Read_Char()) );	// ignore leading white space...
+	sLong nCells = pGrid->Get_NCells(), nRead = 0; CSG_Array_sLong Offset;
 
-	if( !Stream.is_EOF() && SG_is_Character_Numeric(c) )
+	while( nRead < nCells && Stream.Read_Block() && Set_Progress((double)Stream.Tell(), (double)Stream.Length()) )
 	{
-		do
+		sLong nLines = Stream.Get_Line_Count(); Offset.Create(nLines + 1);
+
+		#pragma omp parallel for
+		for(sLong iLine=0; iLine<nLines; iLine++)
+		{
+			Offset[iLine + 1] = Stream.Get_Fields(iLine, NULL, 0);
+		}
+
+		Offset[0] = nRead;
+
+		for(sLong iLine=0; iLine<nLines; iLine++)
+		{
+			Offset[iLine + 1] += Offset[iLine];
+		}
+
+		//-------------------------------------------------
+		#pragma omp parallel
 		{
-			if( c == ',' )
+			CSG_Array Fields(sizeof(TSG_Text_Field));
+
+			#pragma omp for
+			for(sLong iLine=0; iLine<nLines; iLine++)
 			{
-				c = '.';
-			}
+				int n = (int)(Offset[iLine + 1] - Offset[iLine]);
 
-			s += (char)c;
+				if( n > 0 && Offset[iLine] < nCells )
+				{
+					Fields.Set_Array(n, false); TSG_Text_Field *Field = (TSG_Text_Field *)Fields.Get_Array(); Stream.Get_Fields(iLine, Field, n);
+
+					for(sLong i=0, Cell=Offset[iLine]; i<n && Cell<nCells; i++, Cell++)
+					{
+						int x = (int)(Cell % pGrid->Get_NX()), y = pGrid->Get_NY() - 1 - (int)(Cell / pGrid->Get_NX());
+
+						double Value;
+
+						if( !Stream.Get_Value(Field[i], Value) || (NoData_Type == 1 && Value == pGrid->Get_NoData_Value()) )
+						{
+							Value = NoData_Type == 1 ? NoData : pGrid->Get_NoData_Value();
+						}
+
+						pGrid->Set_Value(x, y, Value);
+					}
+				}
+			}
 		}
-		while( !Stream.is_EOF() && SG_is_Character_Numeric(c = Stream.Read_Char()) );
+
+		nRead = Offset[nLines];
 	}
 
-	return( s.asDouble() );
+	return( nRead >= nCells );
 }
 
 //---------------------------------------------------------
-CSG_String CESRI_ArcInfo_Import::Read_Header_Line(CSG_File &Stream)
+CSG_String CESRI_ArcInfo_Import::Read_Header_Line(CSG_Text_Reader &Stream)
 {
-	CSG_String s; int c;
+	CSG_String s;
 
-	while( !Stream.is_EOF() && (c = Stream.Read_Char()) != 0x0A )
-	{
-		if( c != 0x0D )
-		{
-			s += (char)c;
-		}
-	}
+	Stream.Read_Line(s);
 
 	s.Make_Upper();	s.Replace(",", ".");
 
@@ -315,9 +338,9 @@ CSG_String CESRI_ArcInfo_Import::Read_Header_Line(CSG_File &Stream)
 }
 
 //---------------------------------------------------------
-bool CESRI_ArcInfo_Import::Read_Header_Value(CSG_File &Stream, const CSG_String &sKey, int &Value)
+bool CESRI_ArcInfo_Import::Read_Header_Value(CSG_Text_Reader &Stream, const CSG_String &sKey, int &Value)
 {
-	CSG_String sLine(Read_Header_Line(Stream));
+	sLong Position = Stream.Tell(); CSG_String sLine(Read_Header_Line(Stream));
 
 	if( sLine.Contains(sKey) )
 	{
@@ -326,13 +349,15 @@ bool CESRI_ArcInfo_Import::Read_Header_Value(CSG_File &Stream, const CSG_String
 		return( sValue.asInt(Value) );
 	}
 
+	Stream.Seek(Position); // not the requested key, leave line for next request
+
 	return( false );
 }
 
 //---------------------------------------------------------
-bool CESRI_ArcInfo_Import::Read_Header_Value(CSG_File &Stream, const CSG_String &sKey, double &Value)
+bool CESRI_ArcInfo_Import::Read_Header_Value(CSG_Text_Reader &Stream, const CSG_String &sKey, double &Value)
 {
-	CSG_String sLine(Read_Header_Line(Stream));
+	sLong Position = Stream.Tell(); CSG_String sLine(Read_Header_Line(Stream));
 
 	if( sLine.Contains(sKey) )
 	{
@@ -341,11 +366,13 @@ bool CESRI_ArcInfo_Import::Read_Header_Value(CSG_File &Stream, const CSG_String
 		return( sValue.asDouble(Value) );
 	}
 
+	Stream.Seek(Position); // not the requested key, leave line for next request
+
 	return( false );
 }
 
 //---------------------------------------------------------
-CSG_Grid * CESRI_ArcInfo_Import::Read_Header(CSG_File &Stream, TSG_Data_Type Datatype)
+CSG_Grid * CESRI_ArcInfo_Import::Read_Header(CSG_Text_Reader &Stream, TSG_Data_Type Datatype)
 {
 	if( Stream.is_EOF() )
 	{
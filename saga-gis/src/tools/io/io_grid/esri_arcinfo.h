@@ -93,12 +93,12 @@ private:
 	CSG_Parameters_CRSPicker	m_CRS;
 
 
-	double						Read_Value			(CSG_File &Stream);
+	bool						Read_Values			(CSG_Text_Reader &Stream, CSG_Grid *pGrid, int NoData_Type, double NoData);
 
-	CSG_String					Read_Header_Line	(CSG_File &Stream);
-	bool						Read_Header_Value	(CSG_File &Stream, const CSG_String &sKey, int    &Value);
-	bool						Read_Header_Value	(CSG_File &Stream, const CSG_String &sKey, double &Value);
-	CSG_Grid *					Read_Header			(CSG_File &Stream, TSG_Data_Type Datatype = SG_DATATYPE_Float);
+	CSG_String					Read_Header_Line	(CSG_Text_Reader &Stream);
+	bool						Read_Header_Value	(CSG_Text_Reader &Stream, const CSG_String &sKey, int    &Value);
+	bool						Read_Header_Value	(CSG_Text_Reader &Stream, const CSG_String &sKey, double &Value);
+	CSG_Grid *					Read_Header			(CSG_Text_Reader &Stream, TSG_Data_Type Datatype = SG_DATATYPE_Float);
 
 };
 
@@ -362,9 +362,9 @@ int CXYZ_Import::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Parameter
 //---------------------------------------------------------
 bool CXYZ_Import::On_Execute(void)
 {
-	CSG_File Stream;
+	CSG_Text_Reader Stream;
 
-	if( !Stream.Open(Parameters("FILENAME")->asString(), SG_FILE_R, false) )
+	if( !Stream.Open(Parameters("FILENAME")->asString()) )
 	{
 		Error_Fmt("%s\n[%s]", _TL("could not open file"), Parameters("FILENAME")->asString());
 
@@ -372,36 +372,57 @@ bool CXYZ_Import::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
+	CSG_String Delimiters;
+
 	switch( Parameters("SEPARATOR")->asInt() )
 	{
-	default: m_Delimiters = " \t\r\n";	break;
-	case  1: m_Delimiters =       " ";	break;
-	case  2: m_Delimiters =       ",";	break;
-	case  3: m_Delimiters =       ";";	break;
-	case  4: m_Delimiters =      "\t";	break;
-	case  5: m_Delimiters = Parameters("USER")->asString();	break;
+	default: Delimiters = " \t\r\n";	break;
+	case  1: Delimiters =       " ";	break;
+	case  2: Delimiters =       ",";	break;
+	case  3: Delimiters =       ";";	break;
+	case  4: Delimiters =      "\t";	break;
+	case  5: Delimiters = Parameters("USER")->asString();	break;
 	}
 
-	//-----------------------------------------------------
-	CSG_String sLine;
+	bool bMerge = true; // consecutive white space delimiters are treated as one
 
-	for(int Skip=Parameters("SKIP")->asInt(); Skip>0; Skip--)
+	for(size_t i=0; bMerge && i<Delimiters.Length(); i++)
 	{
-		Stream.Read_Line(sLine);
+		bMerge = Delimiters[i] == ' ' || Delimiters[i] == '\t' || Delimiters[i] == '\r' || Delimiters[i] == '\n';
 	}
 
+	Stream.Set_Separators(Delimiters, bMerge);
+
+	Stream.Skip_Lines(Parameters("SKIP")->asInt());
+
 	//-----------------------------------------------------
 	Process_Set_Text(CSG_String::Format("%s...", _TL("Reading")));
 
-	CSG_PointCloud Points; double Length = (double)Stream.Length();
+	CSG_PointCloud Points; CSG_Vector Values; CSG_Array_Int bValid;
 
-	while( !Stream.is_EOF() && Set_Progress((double)Stream.Tell(), Length) )
+	while( Stream.Read_Block() && Set_Progress((double)Stream.Tell(), (double)Stream.Length()) )
 	{
-		TSG_Point p; double z;
+		sLong nLines = Stream.Get_Line_Count(); Values.Create(3 * nLines); bValid.Create(nLines);
+
+		#pragma omp parallel for
+		for(sLong iLine=0; iLine<nLines; iLine++)
+		{
+			TSG_Text_Field Fields[3]; double *xyz = Values.Get_Data() + 3 * iLine;
+
+			bValid[iLine] = Stream.Get_Fields(iLine, Fields, 3) > 2
+				&& Stream.Get_Value(Fields[0], xyz[0])
+				&& Stream.Get_Value(Fields[1], xyz[1])
+				&& Stream.Get_Value(Fields[2], xyz[2]);
+		}
 
-		if( Read_Values(Stream, p.x, p.y, z) )
+		for(sLong iLine=0; iLine<nLines; iLine++)
 		{
-			Points.Add_Point(p.x, p.y, z);
+			if( bValid[iLine] )
+			{
+				double *xyz = Values.Get_Data() + 3 * iLine;
+
+				Points.Add_Point(xyz[0], xyz[1], xyz[2]);
+			}
 		}
 	}
 
@@ -519,26 +540,6 @@ bool CXYZ_Import::On_Execute(void)
 }
 
 
-///////////////////////////////////////////////////////////
-//                                                       //
-///////////////////////////////////////////////////////////
-
-//---------------------------------------------------------
-inline bool CXYZ_Import::Read_Values(CSG_File &Stream, double &x, double &y, double &z)
-{
-	CSG_String sLine;
-
-	if( Stream.Read_Line(sLine) )
-	{
-		CSG_Strings Values(SG_String_Tokenize(sLine, m_Delimiters));
-
-		return( Values.Get_Count() > 2 && Values[0].asDouble(x) && Values[1].asDouble(y) && Values[2].asDouble(z) );
-	}
-
-	return( false );
-}
-
-
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                                                       //
@@ -111,13 +111,8 @@ protected:
 
 private:
 
-	CSG_String					m_Delimiters;
-
 	CSG_Parameters_CRSPicker	m_CRS;
 
-
-	bool						Read_Values				(CSG_File &Stream, double &x, double &y, double &z);
-
 };
 
 
@@ -54,6 +54,7 @@
 #include <pdal/Options.hpp>
 #include <pdal/PointTable.hpp>
 #include <pdal/PointLayout.hpp>
+#include <pdal/Stage.hpp>
 #include <pdal/StageFactory.hpp>
 #include <pdal/filters/StreamCallbackFilter.hpp>
 
@@ -113,6 +114,10 @@ CPDAL_Reader::CPDAL_Reader(void)
         "\"Point Data Abstraction Library\" (PDAL).\n"
         "By default, all supported attributes will be imported. Note that the list of attributes "
         "supported by the tool is currently based on the attributes defined in the ASPRS LAS specification.\n"
+        "Extent and class filters are applied within the PDAL pipeline and files whose header extent "
+        "does not intersect the requested extent are skipped without being read. Multiple files are "
+        "read concurrently. Optionally the imported point clouds can be saved as tiles of a virtual "
+        "point cloud dataset (SPCVF) instead of being loaded into memory.\n"
     );
 
     Description += CSG_String::Format("\nPDAL %s\n", SG_Get_PDAL_Drivers().Get_Version().c_str());
@@ -202,6 +207,22 @@ CPDAL_Reader::CPDAL_Reader(void)
 		_TL(""),
 		0., 0., true
 	);
+
+	//-----------------------------------------------------
+	Parameters.Add_Bool("",
+		"PARALLEL"     , _TL("Read Files in Parallel"),
+		_TL("Read multiple files concurrently, each into its own point cloud."),
+		true
+	);
+
+	Parameters.Add_FilePath("",
+		"SPCVF"        , _TL("Virtual Point Cloud"),
+		_TL("If set, each imported point cloud is saved as tile (*.sg-pts) in the directory of this virtual point cloud dataset (*.spcvf) instead of being added to the output list."),
+		CSG_String::Format("%s (*.spcvf)|*.spcvf|%s|*.*",
+			_TL("SAGA Point Cloud Virtual Format"),
+			_TL("All Files")
+		), NULL, true
+	);
 }
 
 
@@ -299,10 +320,30 @@ bool CPDAL_Reader::On_Execute(void)
 		break;
 	}
 
-    //-----------------------------------------------------
-    for(int i=0; i<Files.Get_Count() && Process_Get_Okay(); i++)
+	//-----------------------------------------------------
+	CSG_String SPCVF_File(Parameters("SPCVF")->asString()); CSG_MetaData SPCVF;
+
+	bool bVar_All   = Parameters("VARS"     )->asBool();
+	bool bVar_Color = Parameters("VAR_COLOR")->asBool();
+	int  RGB_Range  = Parameters("RGB_RANGE")->asInt ();
+
+	// files are read concurrently in batches, each into its own point cloud,
+	// results are passed on in the order of the file list by the main thread
+
+	int nBatch = Parameters("PARALLEL")->asBool() ? SG_OMP_Get_Max_Num_Threads() : 1;
+
+    for(int iBatch=0; iBatch<Files.Get_Count() && Process_Get_Okay(); iBatch+=nBatch)
     {
-        Process_Set_Text("[%d/%d] %s: %s", i + 1, Files.Get_Count(), _TL("File"), SG_File_Get_Name(Files[i], true).c_str());
+		int n = M_GET_MIN(nBatch, Files.Get_Count() - iBatch);
+
+		if( n == 1 )
+		{
+			Process_Set_Text("[%d/%d] %s: %s", iBatch + 1, Files.Get_Count(), _TL("File"), SG_File_Get_Name(Files[iBatch], true).c_str());
+		}
+		else
+		{
+			Process_Set_Text("[%d-%d/%d] %s", iBatch + 1, iBatch + n, Files.Get_Count(), _TL("Files"));
+		}
 
         if( Files.Get_Count() == 1 )
         {
@@ -310,24 +351,59 @@ bool CPDAL_Reader::On_Execute(void)
         }
         else
         {
-            Set_Progress(i + 1, Files.Get_Count());
+            Set_Progress(iBatch + n, Files.Get_Count());
         }
 
-		CSG_PointCloud *pPoints = _Read_Points(Files[i], Extent, Classes,
-			Parameters("VARS"     )->asBool(),
-			Parameters("VAR_COLOR")->asBool(),
-			Parameters("RGB_RANGE")->asInt ()
-		);
+		CSG_Array_Pointer Points; Points.Set_Array(n); CSG_Strings Messages, WKTs; Messages.Set_Count(n); WKTs.Set_Count(n);
 
-		if( !pPoints->Get_Projection().is_Okay() && Projection.is_Okay() )
+		#pragma omp parallel for schedule(dynamic) num_threads(n)
+		for(int i=0; i<n; i++)
 		{
-			pPoints->Get_Projection() = Projection;
+			Points[i] = _Read_Points(Files[iBatch + i], Extent, Classes, bVar_All, bVar_Color, RGB_Range, WKTs[i], Messages[i]);
 		}
 
-		Parameters("POINTS")->asPointCloudList()->Add_Item(pPoints);
+		//-------------------------------------------------
+		for(int i=0; i<n; i++)
+		{
+			if( !Messages[i].is_Empty() )
+			{
+				Message_Add(Messages[i], false);
+			}
+
+			CSG_PointCloud *pPoints = (CSG_PointCloud *)Points[i];
+
+			if( pPoints )
+			{
+				if( !WKTs[i].is_Empty() )	// not thread-safe, the projection parser runs a tool
+				{
+					pPoints->Get_Projection().Create(WKTs[i]);
+				}
+
+				if( !pPoints->Get_Projection().is_Okay() && Projection.is_Okay() )
+				{
+					pPoints->Get_Projection() = Projection;
+				}
+
+				if( SPCVF_File.is_Empty() )
+				{
+					Parameters("POINTS")->asPointCloudList()->Add_Item(pPoints);
+				}
+				else
+				{
+					_Add_Tile(SPCVF, SPCVF_File, pPoints);
+
+					delete(pPoints);
+				}
+			}
+		}
     }
 
     //-----------------------------------------------------
+	if( !SPCVF_File.is_Empty() )
+	{
+		return( _Save_SPCVF(SPCVF, SPCVF_File) );
+	}
+
     return( Parameters("POINTS")->asInt() > 0 );
 }
 
@@ -337,32 +413,20 @@ bool CPDAL_Reader::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CPDAL_Reader::_Find_Class(const CSG_Array_Int &Classes, int ID)
-{
-	for(sLong i=0; i<Classes.Get_Size(); i++)
-	{
-		if( ID  < Classes[i] ) // list is sorted ascending!
-		{
-			return( false );
-		}
-
-		if( ID == Classes[i] )
-		{
-			return( true );
-		}
-	}
-
-	return( false );
-}
-
+// Reads a single file into a new point cloud. Spatial and
+// class filters become part of the PDAL pipeline, so that
+// only requested points reach the point cloud. Might run
+// concurrently for different files, hence messages are
+// collected and not reported directly and the spatial
+// reference is returned as WKT to be set by the caller.
 //---------------------------------------------------------
-CSG_PointCloud * CPDAL_Reader::_Read_Points(const CSG_String &File, const CSG_Rect &Extent, const CSG_Array_Int &Classes, bool bVar_All, bool bVar_Color, int RGB_Range)
+CSG_PointCloud * CPDAL_Reader::_Read_Points(const CSG_String &File, const CSG_Rect &Extent, const CSG_Array_Int &Classes, bool bVar_All, bool bVar_Color, int RGB_Range, CSG_String &WKT, CSG_String &Messages)
 {
     pdal::StageFactory Factory; std::string Driver = Factory.inferReaderDriver(File.b_str());
 
     if( Driver.empty() )
     {
-        Message_Fmt("\n%s, %s: %s", _TL("Warning"), _TL("could not infer input file type"), File.c_str());
+        Messages += CSG_String::Format("\n%s, %s: %s", _TL("Warning"), _TL("could not infer input file type"), File.c_str());
 
         return( NULL );
     }
@@ -371,43 +435,96 @@ CSG_PointCloud * CPDAL_Reader::_Read_Points(const CSG_String &File, const CSG_Re
 
     if( !pReader )
     {
-        Message_Fmt("\n%s, %s: %s", _TL("Warning"), _TL("PDAL reader creation failed"), File.c_str());
+        Messages += CSG_String::Format("\n%s, %s: %s", _TL("Warning"), _TL("PDAL reader creation failed"), File.c_str());
 
         return( NULL );
     }
 
 	pdal::Options Options; Options.add(pdal::Option("filename", File.b_str())); pReader->setOptions(Options);
 
-    //-----------------------------------------------------
-    CSG_PointCloud *pPoints = SG_Create_PointCloud();
+	CSG_PointCloud *pPoints = NULL;
 
-    pPoints->Set_Name(SG_File_Get_Name(File, false));
+	try
+	{
+		//-------------------------------------------------
+		pdal::QuickInfo Info = pReader->preview(); sLong nPoints = 0;
 
-	CSG_Array_Int Fields; int Field_RGB = 0;
+		if( Info.valid() )
+		{
+			if( Extent.Get_Area() > 0. && !Info.m_bounds.empty() && (Info.m_bounds.maxx < Extent.Get_XMin() || Info.m_bounds.minx > Extent.Get_XMax()
+			                                                      ||  Info.m_bounds.maxy < Extent.Get_YMin() || Info.m_bounds.miny > Extent.Get_YMax()) )
+			{
+				return( NULL ); // file header tells us that no point is inside
+			}
 
-	//-----------------------------------------------------
-    if( pReader->pipelineStreamable() )
-    {
-        pdal::StreamCallbackFilter StreamFilter; StreamFilter.setInput(*pReader);
-        pdal::FixedPointTable Table(10000); StreamFilter.prepare(Table);
+			if( Extent.Get_Area() <= 0. && Classes.Get_Size() < 1 )
+			{
+				nPoints = (sLong)Info.m_pointCount; // no filter, so we know the final number of points
+			}
+		}
+
+		//-------------------------------------------------
+		pdal::Stage *pLast = pReader;
+
+		if( Extent.Get_Area() > 0. )
+		{
+			pdal::Stage *pCrop = Factory.createStage("filters.crop");
 
-		bool bClasses = Classes.Get_Size() && Table.layout()->hasDim(pdal::Dimension::Id::Classification);
+			pdal::Options Options; Options.add(pdal::Option("bounds", CSG_String::Format("([%.*f, %.*f], [%.*f, %.*f])",
+				16, Extent.Get_XMin(), 16, Extent.Get_XMax(), 16, Extent.Get_YMin(), 16, Extent.Get_YMax()).b_str()
+			));
 
-        _Init_PointCloud(pPoints, Table, bVar_All, bVar_Color, Fields, Field_RGB);
+			pCrop->setOptions(Options); pCrop->setInput(*pLast); pLast = pCrop;
+		}
 
-        //-------------------------------------------------
-		auto CallbackReadPoint = [=](pdal::PointRef &point)->bool
+		if( Classes.Get_Size() > 0 )
 		{
-			double x = point.getFieldAs<double>(pdal::Dimension::Id::X);
-			double y = point.getFieldAs<double>(pdal::Dimension::Id::Y);
+			CSG_String Limits;
 
-			if( (!Extent.Get_Area() || Extent.Contains(x, y)) && (!bClasses || _Find_Class(Classes, point.getFieldAs<int>(pdal::Dimension::Id::Classification))) )
+			for(sLong i=0; i<Classes.Get_Size(); i++)
 			{
-				pPoints->Add_Point(x, y, point.getFieldAs<double>(pdal::Dimension::Id::Z));
+				Limits += CSG_String::Format("%sClassification[%d:%d]", i > 0 ? SG_T(",") : SG_T(""), Classes[i], Classes[i]);
+			}
+
+			pdal::Stage *pRange = Factory.createStage("filters.range");
+
+			pdal::Options Options; Options.add(pdal::Option("limits", Limits.b_str()));
+
+			pRange->setOptions(Options); pRange->setInput(*pLast); pLast = pRange;
+		}
+
+		//-------------------------------------------------
+		pPoints = SG_Create_PointCloud();
+
+		pPoints->Set_Name(SG_File_Get_Name(File, false));
+
+		CSG_Array_Int Fields; int Field_RGB = 0;
+
+		//-------------------------------------------------
+		if( pLast->pipelineStreamable() )
+		{
+			pdal::StreamCallbackFilter StreamFilter; StreamFilter.setInput(*pLast);
+			pdal::FixedPointTable Table(10000); StreamFilter.prepare(Table);
+
+			_Init_PointCloud(pPoints, Table, bVar_All, bVar_Color, Fields, Field_RGB, WKT, Messages);
+
+			pPoints->Set_Count(nPoints); nPoints = 0; // pre-sized, if the number of points is known, else grows block-wise
+
+			//---------------------------------------------
+			auto CallbackReadPoint = [&](pdal::PointRef &point)->bool
+			{
+				if( nPoints >= pPoints->Get_Count() && !pPoints->Set_Count(nPoints + 0x10000) )
+				{
+					return( false );
+				}
+
+				pPoints->Set_Value(nPoints, 0, point.getFieldAs<double>(pdal::Dimension::Id::X));
+				pPoints->Set_Value(nPoints, 1, point.getFieldAs<double>(pdal::Dimension::Id::Y));
+				pPoints->Set_Value(nPoints, 2, point.getFieldAs<double>(pdal::Dimension::Id::Z));
 
 				for(int Field=0; Field<Fields.Get_Size(); Field++)
 				{
-					pPoints->Set_Value(3 + Field, point.getFieldAs<double>(g_Attributes[Fields[Field]].PDAL_ID));
+					pPoints->Set_Value(nPoints, 3 + Field, point.getFieldAs<double>(g_Attributes[Fields[Field]].PDAL_ID));
 				}
 
 				if( Field_RGB )
@@ -416,64 +533,75 @@ CSG_PointCloud * CPDAL_Reader::_Read_Points(const CSG_String &File, const CSG_Re
 					double g = point.getFieldAs<double>(pdal::Dimension::Id::Green); if( RGB_Range ) { g *= 255. / 65535.; }
 					double b = point.getFieldAs<double>(pdal::Dimension::Id::Blue ); if( RGB_Range ) { b *= 255. / 65535.; }
 
-					pPoints->Set_Value(Field_RGB, SG_GET_RGB(r, g, b));
+					pPoints->Set_Value(nPoints, Field_RGB, SG_GET_RGB(r, g, b));
 				}
-			}
 
-			return( true );
-		};
-    
-        StreamFilter.setCallback(CallbackReadPoint);
-        StreamFilter.execute(Table);
-    }
+				nPoints++;
 
-	//-----------------------------------------------------
-	else // not streamable
-    {
-        pdal::PointTable   Table;    pReader->prepare(Table);
-        pdal::PointViewSet ViewSet = pReader->execute(Table);
-        pdal::PointViewPtr pView   = *ViewSet.begin();
+				return( true );
+			};
 
-        if( pView->size() < 1 )
-        {
-            Message_Fmt("\n%s, %s: %s", _TL("Warning"), _TL("invalid or empty file"), File.c_str());
+			StreamFilter.setCallback(CallbackReadPoint);
+			StreamFilter.execute(Table);
 
-			return( NULL );
-        }
+			pPoints->Set_Count(nPoints); // remove unused pre-allocated points
+		}
 
-		bool bClasses = Classes.Get_Size() && Table.layout()->hasDim(pdal::Dimension::Id::Classification);
+		//-------------------------------------------------
+		else // not streamable
+		{
+			pdal::PointTable   Table;    pLast->prepare(Table);
+			pdal::PointViewSet ViewSet = pLast->execute(Table);
+			pdal::PointViewPtr pView   = *ViewSet.begin();
 
-		_Init_PointCloud(pPoints, Table, bVar_All, bVar_Color, Fields, Field_RGB);
+			_Init_PointCloud(pPoints, Table, bVar_All, bVar_Color, Fields, Field_RGB, WKT, Messages);
 
-        //-----------------------------------------------------
-        for(pdal::PointId i=0; i<pView->size() && Set_Progress((sLong)i, (sLong)pView->size()); i++)
-        {
-			double x = pView->getFieldAs<double>(pdal::Dimension::Id::X, i);
-			double y = pView->getFieldAs<double>(pdal::Dimension::Id::Y, i);
+			nPoints = (sLong)pView->size();
 
-			if( (!Extent.Get_Area() || Extent.Contains(x, y)) && (!bClasses || _Find_Class(Classes, pView->getFieldAs<int>(pdal::Dimension::Id::Classification, i))) )
+			if( nPoints > 0 && pPoints->Set_Count(nPoints) ) // copy column by column into the pre-sized point cloud
 			{
-				pPoints->Add_Point(x, y, pView->getFieldAs<double>(pdal::Dimension::Id::Z, i));
+				for(sLong i=0; i<nPoints; i++) { pPoints->Set_Value(i, 0, pView->getFieldAs<double>(pdal::Dimension::Id::X, i)); }
+				for(sLong i=0; i<nPoints; i++) { pPoints->Set_Value(i, 1, pView->getFieldAs<double>(pdal::Dimension::Id::Y, i)); }
+				for(sLong i=0; i<nPoints; i++) { pPoints->Set_Value(i, 2, pView->getFieldAs<double>(pdal::Dimension::Id::Z, i)); }
 
 				for(int Field=0; Field<Fields.Get_Size(); Field++)
 				{
-					pPoints->Set_Value(3 + Field, pView->getFieldAs<double>(g_Attributes[Fields[Field]].PDAL_ID, i));
+					pdal::Dimension::Id ID = g_Attributes[Fields[Field]].PDAL_ID;
+
+					for(sLong i=0; i<nPoints; i++)
+					{
+						pPoints->Set_Value(i, 3 + Field, pView->getFieldAs<double>(ID, i));
+					}
 				}
 
 				if( Field_RGB )
 				{
-					double r = pView->getFieldAs<double>(pdal::Dimension::Id::Red  , i); if( RGB_Range ) { r *= 255. / 65535.; }
-					double g = pView->getFieldAs<double>(pdal::Dimension::Id::Green, i); if( RGB_Range ) { g *= 255. / 65535.; }
-					double b = pView->getFieldAs<double>(pdal::Dimension::Id::Blue , i); if( RGB_Range ) { b *= 255. / 65535.; }
+					double Scale = RGB_Range ? 255. / 65535. : 1.;
 
-					pPoints->Set_Value(Field_RGB, SG_GET_RGB(r, g, b));
+					for(sLong i=0; i<nPoints; i++)
+					{
+						double r = Scale * pView->getFieldAs<double>(pdal::Dimension::Id::Red  , i);
+						double g = Scale * pView->getFieldAs<double>(pdal::Dimension::Id::Green, i);
+						double b = Scale * pView->getFieldAs<double>(pdal::Dimension::Id::Blue , i);
+
+						pPoints->Set_Value(i, Field_RGB, SG_GET_RGB(r, g, b));
+					}
 				}
 			}
-        }
-    }
+		}
+	}
+	catch( const std::exception &e )
+	{
+		Messages += CSG_String::Format("\n%s, %s: %s [%s]", _TL("Warning"), _TL("PDAL failed to read file"), File.c_str(), CSG_String(e.what()).c_str());
+
+		if( pPoints )
+		{
+			pPoints->Del_Points();
+		}
+	}
 
     //-----------------------------------------------------
-    if( pPoints->Get_Count() < 1 )
+    if( pPoints && pPoints->Get_Count() < 1 )
     {
         delete( pPoints );
 
@@ -484,13 +612,13 @@ CSG_PointCloud * CPDAL_Reader::_Read_Points(const CSG_String &File, const CSG_Re
 }
 
 //---------------------------------------------------------
-void CPDAL_Reader::_Init_PointCloud(CSG_PointCloud *pPoints, pdal::BasePointTable &Table, bool bVar_All, bool bVar_Color, CSG_Array_Int &Fields, int &Field_RGB)
+void CPDAL_Reader::_Init_PointCloud(CSG_PointCloud *pPoints, pdal::BasePointTable &Table, bool bVar_All, bool bVar_Color, CSG_Array_Int &Fields, int &Field_RGB, CSG_String &WKT, CSG_String &Messages)
 {
 	pdal::SpatialReference SpatialRef = Table.spatialReference();
 
 	if( !SpatialRef.empty() )
 	{
-		pPoints->Get_Projection().Create(SpatialRef.getWKT().c_str());
+		WKT = SpatialRef.getWKT().c_str();
 	}
 
 	pdal::PointLayoutPtr Layout = Table.layout();
@@ -505,7 +633,7 @@ void CPDAL_Reader::_Init_PointCloud(CSG_PointCloud *pPoints, pdal::BasePointTabl
 			}
 			else
 			{
-				SG_UI_Msg_Add_Execution(CSG_String::Format("\n%s, %s %s: %s", _TL("Warning"), _TL("file does not provide requested dimension"), g_Attributes[Field].Name.c_str(), pPoints->Get_Name()), true);
+				Messages += CSG_String::Format("\n%s, %s %s: %s", _TL("Warning"), _TL("file does not provide requested dimension"), g_Attributes[Field].Name.c_str(), pPoints->Get_Name());
 			}
 		}
 	}
@@ -524,6 +652,177 @@ void CPDAL_Reader::_Init_PointCloud(CSG_PointCloud *pPoints, pdal::BasePointTabl
 }
 
 
+///////////////////////////////////////////////////////////
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Saves the point cloud as tile in the directory of the
+// virtual point cloud file (SPCVF) and adds it to the
+// dataset list. The first tile defines projection, no-data
+// value and attribute structure, incompatible tiles are
+// skipped.
+//---------------------------------------------------------
+bool CPDAL_Reader::_Add_Tile(CSG_MetaData &SPCVF, const CSG_String &SPCVF_File, CSG_PointCloud *pPoints)
+{
+	if( !SPCVF("Datasets") ) // first tile
+	{
+		SPCVF.Destroy();
+		SPCVF.Set_Name("SPCVFDataset");
+		SPCVF.Add_Property("Version", "1.1");
+		SPCVF.Add_Property("Paths"  , "relative");
+
+		CSG_MetaData *pHeader = SPCVF.Add_Child("Header");
+
+		pHeader->Add_Child("Datasets");
+		pHeader->Add_Child("Points"  );
+
+		CSG_MetaData *pSRS = pHeader->Add_Child("SRS");
+
+		if( pPoints->Get_Projection().is_Okay() )
+		{
+			pSRS->Add_Property("Projection", pPoints->Get_Projection().Get_Name());
+			pSRS->Add_Property("WKT"       , pPoints->Get_Projection().Get_WKT ());
+		}
+		else
+		{
+			pSRS->Add_Property("Projection", "Undefined Coordinate System");
+		}
+
+		pHeader->Add_Child("BBox"  );
+		pHeader->Add_Child("ZStats");
+		pHeader->Add_Child("NoData")->Add_Property("Value", pPoints->Get_NoData_Value());
+
+		CSG_MetaData *pAttributes = pHeader->Add_Child("Attributes");
+
+		pAttributes->Add_Property("Count", pPoints->Get_Field_Count());
+
+		for(int Field=0; Field<pPoints->Get_Field_Count(); Field++)
+		{
+			CSG_MetaData *pField = pAttributes->Add_Child(CSG_String::Format("Field_%d", Field + 1));
+
+			pField->Add_Property("Name", pPoints->Get_Field_Name(Field));
+			pField->Add_Property("Type", gSG_Data_Type_Identifier[pPoints->Get_Field_Type(Field)]);
+		}
+
+		SPCVF.Add_Child("Datasets");
+	}
+
+	//-----------------------------------------------------
+	CSG_MetaData &Attributes = *SPCVF["Header"]("Attributes"); bool bCompatible = Attributes.Get_Children_Count() == pPoints->Get_Field_Count();
+
+	for(int Field=0; bCompatible && Field<pPoints->Get_Field_Count(); Field++)
+	{
+		bCompatible = Attributes[Field].Cmp_Property("Name", pPoints->Get_Field_Name(Field))
+		           && Attributes[Field].Cmp_Property("Type", gSG_Data_Type_Identifier[pPoints->Get_Field_Type(Field)]);
+	}
+
+	if( !bCompatible )
+	{
+		Message_Fmt("\n%s, %s: %s", _TL("Warning"), _TL("skipping point cloud because its attributes differ from the first tile"), pPoints->Get_Name());
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	CSG_MetaData &Datasets = *SPCVF("Datasets"); CSG_String Name(pPoints->Get_Name());
+
+	for(int i=0, n=1; i<Datasets.Get_Children_Count(); i++) // make tile names unique
+	{
+		if( !SG_File_Get_Name(Datasets[i].Get_Property("File"), false).CmpNoCase(Name) )
+		{
+			Name.Printf("%s_%d", pPoints->Get_Name(), ++n); i = -1;
+		}
+	}
+
+	CSG_String File(SG_File_Make_Path(SG_File_Get_Path(SPCVF_File), Name, "sg-pts"));
+
+	if( !pPoints->Save(File) )
+	{
+		Message_Fmt("\n%s, %s: %s", _TL("Warning"), _TL("failed to save tile"), File.c_str());
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	CSG_MetaData *pDataset = Datasets.Add_Child("PointCloud");
+
+	pDataset->Add_Property("File"  , SG_File_Get_Name(File, true));
+	pDataset->Add_Property("Points", (int)pPoints->Get_Count());
+	pDataset->Add_Property("ZMin"  , pPoints->Get_ZMin());
+	pDataset->Add_Property("ZMax"  , pPoints->Get_ZMax());
+
+	CSG_MetaData *pBBox = pDataset->Add_Child("BBox");
+
+	pBBox->Add_Property("XMin", pPoints->Get_Extent().Get_XMin());
+	pBBox->Add_Property("YMin", pPoints->Get_Extent().Get_YMin());
+	pBBox->Add_Property("XMax", pPoints->Get_Extent().Get_XMax());
+	pBBox->Add_Property("YMax", pPoints->Get_Extent().Get_YMax());
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CPDAL_Reader::_Save_SPCVF(CSG_MetaData &SPCVF, const CSG_String &SPCVF_File)
+{
+	CSG_MetaData *pDatasets = SPCVF("Datasets");
+
+	if( !pDatasets || pDatasets->Get_Children_Count() < 1 )
+	{
+		Error_Set(_TL("no points have been imported"));
+
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	CSG_Rect Extent; double ZMin = 0., ZMax = 0., nPoints = 0.;
+
+	for(int i=0; i<pDatasets->Get_Children_Count(); i++)
+	{
+		CSG_MetaData &Dataset = (*pDatasets)[i], &BBox = *Dataset("BBox"); double x[2], y[2], z[2]; int n;
+
+		BBox.Get_Property("XMin", x[0]); BBox.Get_Property("XMax", x[1]);
+		BBox.Get_Property("YMin", y[0]); BBox.Get_Property("YMax", y[1]);
+
+		Dataset.Get_Property("ZMin", z[0]); Dataset.Get_Property("ZMax", z[1]); Dataset.Get_Property("Points", n);
+
+		if( i == 0 )
+		{
+			Extent.Assign(x[0], y[0], x[1], y[1]); ZMin = z[0]; ZMax = z[1];
+		}
+		else
+		{
+			Extent.Union(CSG_Rect(x[0], y[0], x[1], y[1])); ZMin = M_GET_MIN(ZMin, z[0]); ZMax = M_GET_MAX(ZMax, z[1]);
+		}
+
+		nPoints += n;
+	}
+
+	CSG_MetaData &Header = *SPCVF("Header");
+
+	Header("Datasets")->Add_Property("Count", pDatasets->Get_Children_Count());
+	Header("Points"  )->Add_Property("Count", CSG_String::Format("%.0f", nPoints));
+	Header("BBox"    )->Add_Property("XMin" , Extent.Get_XMin());
+	Header("BBox"    )->Add_Property("YMin" , Extent.Get_YMin());
+	Header("BBox"    )->Add_Property("XMax" , Extent.Get_XMax());
+	Header("BBox"    )->Add_Property("YMax" , Extent.Get_YMax());
+	Header("ZStats"  )->Add_Property("ZMin" , ZMin);
+	Header("ZStats"  )->Add_Property("ZMax" , ZMax);
+
+	//-----------------------------------------------------
+	if( !SPCVF.Save(SPCVF_File) )
+	{
+		Error_Fmt("%s: %s", _TL("failed to save virtual point cloud"), SPCVF_File.c_str());
+
+		return( false );
+	}
+
+	Message_Fmt("\n%s: %s [%d %s]", _TL("virtual point cloud created"), SPCVF_File.c_str(), pDatasets->Get_Children_Count(), _TL("tiles"));
+
+	return( true );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                                                       //
@@ -89,11 +89,12 @@ protected:
 
 private:
 
-	bool				_Find_Class				(const CSG_Array_Int &Classes, int ID);
+	CSG_PointCloud *    _Read_Points			(const CSG_String &File, const CSG_Rect &Extent, const CSG_Array_Int &Classes, bool bVar_All, bool bVar_Color, int iRGB_Range, CSG_String &WKT, CSG_String &Messages);
 
-	CSG_PointCloud *    _Read_Points			(const CSG_String &File, const CSG_Rect &Extent, const CSG_Array_Int &Classes, bool bVar_All, bool bVar_Color, int iRGB_Range);
+	void                _Init_PointCloud		(CSG_PointCloud *pPoints, pdal::BasePointTable &Table, bool bVar_All, bool bVar_Color, CSG_Array_Int &Fields, int &Field_RGB, CSG_String &WKT, CSG_String &Messages);
 
-	void                _Init_PointCloud		(CSG_PointCloud *pPoints, pdal::BasePointTable &Table, bool bVar_All, bool bVar_Color, CSG_Array_Int &Fields, int &Field_RGB);
+	bool				_Add_Tile				(CSG_MetaData &SPCVF, const CSG_String &SPCVF_File, CSG_PointCloud *pPoints);
+	bool				_Save_SPCVF				(CSG_MetaData &SPCVF, const CSG_String &SPCVF_File);
 
 };
 
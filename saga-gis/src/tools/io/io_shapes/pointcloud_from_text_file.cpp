@@ -264,25 +264,15 @@ int CPointCloud_From_Text_File::On_Parameter_Changed(CSG_Parameters *pParameters
 //---------------------------------------------------------
 bool CPointCloud_From_Text_File::On_Execute(void)
 {
-	CSG_File Stream;
+	CSG_Text_Reader Stream;
 
-	if( !Stream.Open(Parameters("FILE")->asString(), SG_FILE_R, false) )
+	if( !Stream.Open(Parameters("FILE")->asString()) )
 	{
 		Error_Set(_TL("Unable to open input file!"));
 
 		return( false );
 	}
 
-    //-----------------------------------------------------
-	CSG_String sLine;
-
-	if( !Stream.Read_Line(sLine) )
-	{
-		Error_Set(_TL("Empty file!"));
-
-		return( false );
-	}
-
 	//-----------------------------------------------------
 	char Separator;
 
@@ -294,14 +284,39 @@ bool CPointCloud_From_Text_File::On_Execute(void)
 	case  3: Separator =  ';'; break;
 	}
 
+	Stream.Set_Separators(CSG_String(Separator), Separator == '\t' || Separator == ' '); // merge white space separators
+
 	//-----------------------------------------------------
-	CSG_Strings Values = SG_String_Tokenize(sLine, Separator); // read first line to retrieve the number of fields
+	if( !Stream.Read_Block() )
+	{
+		Error_Set(_TL("Empty file!"));
+
+		return( false );
+	}
 
-	int nFields = Values.Get_Count();
+	CSG_Array Tokens(sizeof(TSG_Text_Field)); CSG_Strings Values;
 
-	if( !Parameters("SKIP_HEADER")->asBool() )
+	int nFields = Stream.Get_Fields(0, NULL, 0); // read first line to retrieve the number of fields
+
+	if( nFields < 1 )
 	{
-		Stream.Seek_Start(); Values.Clear();
+		Error_Set(_TL("Empty file!"));
+
+		return( false );
+	}
+
+	sLong iFirst = 0; // first line with data in current block
+
+	if( Parameters("SKIP_HEADER")->asBool() )
+	{
+		TSG_Text_Field *Token = (TSG_Text_Field *)Tokens.Get_Array(nFields); Stream.Get_Fields(0, Token, nFields);
+
+		for(int i=0; i<nFields; i++)
+		{
+			Values += CSG_Text_Reader::To_String(Token[i]);
+		}
+
+		iFirst = 1;
 	}
 
 	//-----------------------------------------------------
@@ -356,7 +371,7 @@ bool CPointCloud_From_Text_File::On_Execute(void)
 
 			Fields += Index - 1;
 
-			CSG_String Name(i < Names.Get_Count() ? Names[i] : i < nFields ? Values[i] : CSG_String("")); Name.Trim_Both();
+			CSG_String Name(i < Names.Get_Count() ? Names[i] : Index - 1 < Values.Get_Count() ? Values[Index - 1] : CSG_String("")); Name.Trim_Both();
 
 			if( Name.is_Empty() )
 			{
@@ -383,63 +398,87 @@ bool CPointCloud_From_Text_File::On_Execute(void)
 	}
 
     //-----------------------------------------------------
+	// lines are tokenized and parsed in parallel block by block,
+	// then appended to the point cloud in the original order
+
 	Process_Set_Text(_TL("Importing data ..."));
 
-	sLong nLines = 0, Length = Stream.Length();
+	int nValues = 3 + pPoints->Get_Attribute_Count(); sLong nLines = 0; CSG_Vector Data; CSG_Array_Int bValid;
 
-	while( Stream.Read_Line(sLine) )
-    {
-		nLines++;
+	do
+	{
+		sLong nBlock = Stream.Get_Line_Count();
+
+		Tokens.Set_Array(nBlock * nFields, false); TSG_Text_Field *Token = (TSG_Text_Field *)Tokens.Get_Array();
 
-		if( pPoints->Get_Count() % 10000 == 0 && !Set_Progress(Stream.Tell(), Length) )
+		Data.Create(nBlock * nValues); bValid.Create(nBlock);
+
+		#pragma omp parallel for
+		for(sLong iLine=iFirst; iLine<nBlock; iLine++)
 		{
-			break; // user break
-		}
+			TSG_Text_Field *pToken = Token + iLine * nFields; double *pData = Data.Get_Data() + iLine * nValues;
 
-	    //-------------------------------------------------
-		Values = SG_String_Tokenize(sLine, Separator); // read every column in this line and fill vector
+			int n = Stream.Get_Fields(iLine, pToken, nFields); if( n > nFields ) { n = nFields; }
 
-		double x, y, z;
+			bValid[iLine] = xField < n && Stream.Get_Value(pToken[xField], pData[0])
+			             && yField < n && Stream.Get_Value(pToken[yField], pData[1])
+			             && zField < n && Stream.Get_Value(pToken[zField], pData[2]);
 
-		if( xField >= Values.Get_Count() || !Values[xField].asDouble(x)
-		||  yField >= Values.Get_Count() || !Values[yField].asDouble(y)
-		||  zField >= Values.Get_Count() || !Values[zField].asDouble(z) )
-		{
-			Message_Fmt("\n%s: %s [%d]", _TL("Warning"), _TL("Skipping misformatted line"), nLines);
+			for(int iAttribute=0; bValid[iLine] && iAttribute<nValues-3; iAttribute++)
+			{
+				double &Value = pData[3 + iAttribute];
 
-			continue;
+				if( Fields[iAttribute] >= n )
+				{
+					Value = NAN; // no data
+				}
+				else if( pPoints->Get_Attribute_Type(iAttribute) == SG_DATATYPE_String )
+				{
+					Value = 0.;
+				}
+				else if( !Stream.Get_Value(pToken[Fields[iAttribute]], Value) )
+				{
+					Value = NAN;
+				}
+			}
 		}
 
-        pPoints->Add_Point(x, y, z);
-
-	    //-------------------------------------------------
-		for(int iAttribute=0; iAttribute<pPoints->Get_Attribute_Count(); iAttribute++)
+		//-------------------------------------------------
+		for(sLong iLine=iFirst; iLine<nBlock; iLine++)
 		{
-			if( Fields[iAttribute] >= Values.Get_Count() )
+			nLines++;
+
+			if( !bValid[iLine] )
 			{
-				pPoints->Set_NoData(3 + iAttribute);
+				Message_Fmt("\n%s: %s [%lld]", _TL("Warning"), _TL("Skipping misformatted line"), Stream.Get_Line_Number(iLine));
+
+				continue;
 			}
-			else switch( pPoints->Get_Attribute_Type(iAttribute) )
-			{
-			case SG_DATATYPE_String:
-				pPoints->Set_Attribute(iAttribute, Values[Fields[iAttribute]]);
-				break;
 
-			default: {
-				double Value;
+			double *pData = Data.Get_Data() + iLine * nValues;
+
+			pPoints->Add_Point(pData[0], pData[1], pData[2]);
 
-				if( Values[Fields[iAttribute]].asDouble(Value) )
+			for(int iAttribute=0; iAttribute<nValues-3; iAttribute++)
+			{
+				if( std::isnan(pData[3 + iAttribute]) )
 				{
-					pPoints->Set_Attribute(iAttribute, Value);
+					pPoints->Set_NoData(3 + iAttribute);
+				}
+				else if( pPoints->Get_Attribute_Type(iAttribute) == SG_DATATYPE_String )
+				{
+					pPoints->Set_Attribute(iAttribute, CSG_Text_Reader::To_String(Token[iLine * nFields + Fields[iAttribute]]));
 				}
 				else
 				{
-					pPoints->Set_NoData(3 + iAttribute);
+					pPoints->Set_Attribute(iAttribute, pData[3 + iAttribute]);
 				}
-				break; }
 			}
 		}
-    }
+
+		iFirst = 0;
+	}
+	while( Set_Progress((double)Stream.Tell(), (double)Stream.Length()) && Stream.Read_Block() );
 
     //-----------------------------------------------------
 	DataObject_Set_Parameter(pPoints, "DISPLAY_VALUE_AGGREGATE", 3); // highest z
@@ -452,34 +452,9 @@ bool CTable_Text_Import_Numbers::On_Execute(void)
 //---------------------------------------------------------
 bool CTable_Text_Import_Numbers::Import(const CSG_String &File)
 {
-	CSG_String	sHead, sLine, Separator;
-	CSG_File	Stream;
-
-	//-----------------------------------------------------
-	if( !Stream.Open(File, SG_FILE_R, false) )
-	{
-		return( false );
-	}
-
-	sLong	fLength	= Stream.Length();
+	CSG_Text_Reader	Stream;
 
-	if( Parameters("SKIP")->asInt() > 0 )
-	{
-		int	i	= Parameters("SKIP")->asInt();
-
-		while( i > 0 && Stream.Read_Line(sLine) )	{ i--; }
-	}
-
-	if( !Stream.Read_Line(sHead) || sHead.Length() == 0 )
-	{
-		return( false );
-	}
-
-	if( !Parameters("HEADLINE")->asBool() )
-	{
-		sLine	= sHead;
-	}
-	else if( !Stream.Read_Line(sLine) || sLine.Length() == 0 )
+	if( !Stream.Open(File) || !Stream.Skip_Lines(Parameters("SKIP")->asInt()) )
 	{
 		return( false );
 	}
@@ -487,72 +462,99 @@ bool CTable_Text_Import_Numbers::Import(const CSG_String &File)
 	//-----------------------------------------------------
 	switch( Parameters("SEPARATOR")->asInt() )
 	{
-	case  0:	Separator	= "\t";	break;
-	case  1:	Separator	=  ";";	break;
-	case  2:	Separator	=  ",";	break;
-	case  3:	Separator	=  " ";	break;
-	default:	Separator	= Parameters("SEP_OTHER")->asString();	break;
+	case  0:	Stream.Set_Separators("\t", true);	break;
+	case  1:	Stream.Set_Separators( ";", true);	break;
+	case  2:	Stream.Set_Separators( ",", true);	break;
+	case  3:	Stream.Set_Separators( " ", true);	break;
+	default:	Stream.Set_Separators(Parameters("SEP_OTHER")->asString(), true);	break;
 	}
 
+	Stream.Set_Quotes(false);
+
 	//-----------------------------------------------------
 	CSG_Table	*pTable	= SG_Create_Table();
 
 	pTable->Set_Name(SG_File_Get_Name(File, false));
 
-	sHead.Trim(true);
-	sHead.Replace(Separator, "\t");
+	int		nFields	= 0;	CSG_Array Fields(sizeof(TSG_Text_Field));	CSG_Vector Values;	CSG_Array_Int bValid;
 
-	while( sHead.Length() > 0 )
+	bool	bOkay	= true;
+
+	while( bOkay && Stream.Read_Block() && Set_Progress((double)Stream.Tell(), (double)Stream.Length()) )
 	{
-		sHead.Trim();
+		sLong	iFirst	= 0, nLines = Stream.Get_Line_Count();
 
-		if( Parameters("HEADLINE")->asBool() )
-		{
-			pTable->Add_Field(sHead.BeforeFirst('\t'), SG_DATATYPE_Double);
-		}
-		else
+		//-------------------------------------------------
+		if( nFields == 0 )	// first line defines the fields
 		{
-			pTable->Add_Field(CSG_String::Format("FIELD%02d", 1 + pTable->Get_Field_Count()), SG_DATATYPE_Double);
-		}
+			while( iFirst < nLines && (nFields = Stream.Get_Fields(iFirst, NULL, 0)) == 0 )	{ iFirst++; }
 
-		sHead	= sHead.AfterFirst('\t');
-	}
+			if( nFields < 1 )
+			{
+				continue;
+			}
 
-	if( pTable->Get_Field_Count() <= 0 )
-	{
-		delete(pTable);
+			TSG_Text_Field	*Field	= (TSG_Text_Field *)Fields.Get_Array(nFields);	Stream.Get_Fields(iFirst, Field, nFields);
 
-		return( false );
-	}
+			for(int i=0; i<nFields; i++)
+			{
+				if( Parameters("HEADLINE")->asBool() )
+				{
+					pTable->Add_Field(CSG_Text_Reader::To_String(Field[i]), SG_DATATYPE_Double);
+				}
+				else
+				{
+					pTable->Add_Field(CSG_String::Format("FIELD%02d", 1 + pTable->Get_Field_Count()), SG_DATATYPE_Double);
+				}
+			}
 
-	//-----------------------------------------------------
-	bool	bOkay	= true;
+			if( Parameters("HEADLINE")->asBool() )
+			{
+				iFirst++;
+			}
+		}
 
-	do
-	{
-		sLine.Replace(Separator, "\t");
+		//-------------------------------------------------
+		Fields.Set_Array(nLines * nFields, false);	TSG_Text_Field *Field = (TSG_Text_Field *)Fields.Get_Array();
 
-		CSG_Table_Record	*pRecord	= pTable->Add_Record();
+		Values.Create(nLines * nFields);	bValid.Create(nLines);
 
-		for(int i=0; bOkay && i<pTable->Get_Field_Count(); i++)
+		#pragma omp parallel for
+		for(sLong iLine=iFirst; iLine<nLines; iLine++)
 		{
-			double	Value;
+			TSG_Text_Field	*pField	= Field + iLine * nFields;	double *pValue = Values.Get_Data() + iLine * nFields;
+
+			int	n	= Stream.Get_Fields(iLine, pField, nFields);
 
-			sLine.Trim();
+			bValid[iLine]	= n > 0 ? 1 : -1;	// -1 = empty line
 
-			if( (bOkay = sLine.asDouble(Value)) == true )
+			for(int i=0; i<nFields && bValid[iLine]>0; i++)
 			{
-				pRecord->Set_Value(i, Value);
+				if( i >= n || !Stream.Get_Value(pField[i], pValue[i]) )
+				{
+					bValid[iLine]	= 0;
+				}
+			}
+		}
 
-				sLine	= sLine.AfterFirst('\t');
+		//-------------------------------------------------
+		for(sLong iLine=iFirst; bOkay && iLine<nLines; iLine++)
+		{
+			if( bValid[iLine] == 0 )	// stop reading at the first line not providing a number for each field
+			{
+				bOkay	= false;
 			}
-			else
+			else if( bValid[iLine] > 0 )
 			{
-				pTable->Del_Record(pTable->Get_Count() - 1);
+				CSG_Table_Record	*pRecord	= pTable->Add_Record();	double *pValue = Values.Get_Data() + iLine * nFields;
+
+				for(int i=0; i<nFields; i++)
+				{
+					pRecord->Set_Value(i, pValue[i]);
+				}
 			}
 		}
 	}
-	while( bOkay && Stream.Read_Line(sLine) && Set_Progress((double)Stream.Tell(), (double)fLength) );
 
 	//-----------------------------------------------------
 	if( pTable->Get_Count() > 0 )
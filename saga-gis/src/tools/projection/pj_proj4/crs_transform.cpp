@@ -510,6 +510,50 @@ bool CSG_CRSProjector::Get_Projection(CSG_Point_3D &Point) const
 }
 
 
+//---------------------------------------------------------
+// Transforms n coordinates in place with one call per PROJ
+// operation, which is much faster than projecting each point
+// on its own. Coordinates that cannot be projected are set to
+// HUGE_VAL. Returns the number of successfully projected points.
+//---------------------------------------------------------
+size_t CSG_CRSProjector::Get_Projection(double *x, double *y, size_t n) const
+{
+	if( !m_pSource || !m_pTarget || !x || !y || n < 1 ) { return( 0 ); }
+
+	PJ *pSource = (PJ *)(m_bInverse ? m_pTarget : m_pSource);
+	PJ *pTarget = (PJ *)(m_bInverse ? m_pSource : m_pTarget);
+
+	if( proj_angular_input(pSource, PJ_INV) )
+	{
+		for(size_t i=0; i<n; i++) { x[i] *= M_DEG_TO_RAD; y[i] *= M_DEG_TO_RAD; }
+	}
+
+	proj_trans_generic(pSource, PJ_INV, x, sizeof(double), n, y, sizeof(double), n, NULL, 0, 0, NULL, 0, 0); proj_errno_reset(pSource);
+	proj_trans_generic(pTarget, PJ_FWD, x, sizeof(double), n, y, sizeof(double), n, NULL, 0, 0, NULL, 0, 0); proj_errno_reset(pTarget);
+
+	bool bDegree = proj_angular_output(pTarget, PJ_FWD) != 0; size_t nOkay = 0;
+
+	for(size_t i=0; i<n; i++)
+	{
+		if( x[i] == HUGE_VAL || y[i] == HUGE_VAL )
+		{
+			x[i] = y[i] = HUGE_VAL;
+		}
+		else
+		{
+			if( bDegree )
+			{
+				x[i] *= M_RAD_TO_DEG; y[i] *= M_RAD_TO_DEG;
+			}
+
+			nOkay++;
+		}
+	}
+
+	return( nOkay );
+}
+
+
 ///////////////////////////////////////////////////////////
 //                                                       //
 //                   CRS Operation                       //
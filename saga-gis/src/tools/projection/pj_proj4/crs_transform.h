@@ -118,6 +118,8 @@ public:
 	bool					Get_Projection				(TSG_Point_3D &Point)             const;
 	bool					Get_Projection				(CSG_Point_3D &Point)             const;
 
+	size_t					Get_Projection				(double *x, double *y, size_t n)  const;
+
 
 private:
 
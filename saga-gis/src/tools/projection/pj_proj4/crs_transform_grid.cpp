@@ -131,6 +131,14 @@ CCRS_Transform_Grid::CCRS_Transform_Grid(bool bList)
 		false
 	);
 
+	Parameters.Add_Double("TARGET_NODE",
+		"APPROXIMATE"	, _TL("Approximation Error"),
+		_TL("If greater than zero, source coordinates are only transformed exactly for control points along each target row and linearly interpolated in between. "
+		    "Row segments are refined recursively until the interpolation error falls below this threshold, measured in source grid cells. "
+		    "Much faster for large grids. Use the x/y coordinate outputs to compare the result with the exact transformation (zero)."),
+		0., 0., true
+	);
+
 	//-----------------------------------------------------
 	m_Grid_Target.Create(&Parameters, false, "TARGET_NODE", "TARGET_");
 
@@ -358,9 +366,13 @@ bool CCRS_Transform_Grid::Transform(CSG_Grid *pGrid, CSG_Grid *pTarget)
 	m_Projector.Set_Copies(SG_OMP_Get_Max_Num_Threads());
 	#endif
 
+	m_Approximate = Parameters("APPROXIMATE")->asDouble() * pGrid->Get_Cellsize();
+
+	CSG_Vector X(pTarget->Get_NX()), Y(pTarget->Get_NX());
+
 	for(int y=0; y<pTarget->Get_NY() && Set_Progress(y, pTarget->Get_NY()); y++)
 	{
-		double yTarget = pTarget->Get_YMin() + y * pTarget->Get_Cellsize();
+		Get_Source_Row(pTarget->Get_System(), y, X.Get_Data(), Y.Get_Data());
 
 		#ifndef _DEBUG
 		#pragma omp parallel for
@@ -372,10 +384,10 @@ bool CCRS_Transform_Grid::Transform(CSG_Grid *pGrid, CSG_Grid *pTarget)
 				continue;
 			}
 
-			double z, ySource, xSource = pTarget->Get_XMin() + x * pTarget->Get_Cellsize();
+			double z, ySource = Y[x], xSource = X[x];
 
 			//---------------------------------------------------------
-			if( !m_Projector[SG_OMP_Get_Thread_Num()].Get_Projection(xSource, ySource = yTarget) )
+			if( xSource == HUGE_VAL || ySource == HUGE_VAL )
 			{
 				continue;
 			}
@@ -514,9 +526,13 @@ bool CCRS_Transform_Grid::Transform(const CSG_Array_Pointer &Grids, CSG_Paramete
 	m_Projector.Set_Copies(SG_OMP_Get_Max_Num_Threads());
 	#endif
 
+	m_Approximate = Parameters("APPROXIMATE")->asDouble() * Source_System.Get_Cellsize();
+
+	CSG_Vector X(Target_System.Get_NX()), Y(Target_System.Get_NX());
+
 	for(int y=0; y<Target_System.Get_NY() && Set_Progress(y, Target_System.Get_NY()); y++)
 	{
-		double yTarget = Target_System.Get_YMin() + y * Target_System.Get_Cellsize();
+		Get_Source_Row(Target_System, y, X.Get_Data(), Y.Get_Data());
 
 		#ifndef _DEBUG
 		#pragma omp parallel for
@@ -528,9 +544,9 @@ bool CCRS_Transform_Grid::Transform(const CSG_Array_Pointer &Grids, CSG_Paramete
 				continue;
 			}
 
-			double z, ySource, xSource = Target_System.Get_XMin() + x * Target_System.Get_Cellsize();
+			double z, ySource = Y[x], xSource = X[x];
 
-			if( !m_Projector[SG_OMP_Get_Thread_Num()].Get_Projection(xSource, ySource = yTarget) )
+			if( xSource == HUGE_VAL || ySource == HUGE_VAL )
 			{
 				continue;
 			}
@@ -588,6 +604,139 @@ bool CCRS_Transform_Grid::Transform(const CSG_Array_Pointer &Grids, CSG_Paramete
 }
 
 
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Fills X and Y with the source coordinates of all cells of
+// the target grid's row y. The row is split into one span per
+// thread, each of which is processed with its own projector copy.
+//---------------------------------------------------------
+void CCRS_Transform_Grid::Get_Source_Row(const CSG_Grid_System &Target, int y, double *X, double *Y)
+{
+	#ifndef _DEBUG
+	int nSpans = SG_OMP_Get_Max_Num_Threads();
+	#else
+	int nSpans = 1;
+	#endif
+
+	#ifndef _DEBUG
+	#pragma omp parallel for
+	#endif
+	for(int iSpan=0; iSpan<nSpans; iSpan++)
+	{
+		int ax = (int)(((sLong)Target.Get_NX() * (iSpan    )) / nSpans);
+		int bx = (int)(((sLong)Target.Get_NX() * (iSpan + 1)) / nSpans) - 1;
+
+		if( ax <= bx )
+		{
+			Get_Source_Span(m_Projector[SG_OMP_Get_Thread_Num()], Target, y, ax, bx, X, Y);
+		}
+	}
+}
+
+//---------------------------------------------------------
+// Without approximation all coordinates of the span are
+// transformed exactly with one batched call. Otherwise only
+// the span's end points are transformed exactly and the span
+// is recursively bisected: the coordinates of a segment's
+// center are transformed exactly, too, and if linear
+// interpolation between the segment's end points reproduces
+// them within the error threshold, both halves are filled by
+// interpolation. Segments that are too inaccurate are bisected
+// again. The centers of all segments of one level are
+// transformed with a single batched call.
+//---------------------------------------------------------
+void CCRS_Transform_Grid::Get_Source_Span(const CSG_CRSProjector &Projector, const CSG_Grid_System &Target, int y, int ax, int bx, double *X, double *Y)
+{
+	double yWorld = Target.Get_yGrid_to_World(y);
+
+	//-----------------------------------------------------
+	if( m_Approximate <= 0. || bx - ax < 2 )
+	{
+		for(int x=ax; x<=bx; x++)
+		{
+			X[x] = Target.Get_xGrid_to_World(x); Y[x] = yWorld;
+		}
+
+		Projector.Get_Projection(X + ax, Y + ax, 1 + bx - ax);
+
+		return;
+	}
+
+	//-----------------------------------------------------
+	double xEnds[2] = { Target.Get_xGrid_to_World(ax), Target.Get_xGrid_to_World(bx) };
+	double yEnds[2] = { yWorld, yWorld };
+
+	Projector.Get_Projection(xEnds, yEnds, 2);
+
+	X[ax] = xEnds[0]; Y[ax] = yEnds[0];
+	X[bx] = xEnds[1]; Y[bx] = yEnds[1];
+
+	//-----------------------------------------------------
+	CSG_Array_Int Segments; Segments += ax; Segments += bx; CSG_Vector xCenter, yCenter;
+
+	while( Segments.Get_Size() > 0 )
+	{
+		sLong nSegments = Segments.Get_Size() / 2;
+
+		xCenter.Create(nSegments); yCenter.Create(nSegments);
+
+		for(sLong i=0; i<nSegments; i++)
+		{
+			xCenter[i] = Target.Get_xGrid_to_World((Segments[2 * i] + Segments[2 * i + 1]) / 2); yCenter[i] = yWorld;
+		}
+
+		Projector.Get_Projection(xCenter.Get_Data(), yCenter.Get_Data(), (size_t)nSegments);
+
+		//-------------------------------------------------
+		CSG_Array_Int Refine;
+
+		for(sLong i=0; i<nSegments; i++)
+		{
+			int a = Segments[2 * i], b = Segments[2 * i + 1], c = (a + b) / 2;
+
+			X[c] = xCenter[i]; Y[c] = yCenter[i];
+
+			bool bAccept = X[a] != HUGE_VAL && X[b] != HUGE_VAL && X[c] != HUGE_VAL;
+
+			if( bAccept )
+			{
+				double d = (c - a) / (double)(b - a);
+
+				bAccept = fabs(X[a] + d * (X[b] - X[a]) - X[c]) <= m_Approximate
+				       && fabs(Y[a] + d * (Y[b] - Y[a]) - Y[c]) <= m_Approximate;
+			}
+
+			if( bAccept )
+			{
+				for(int x=a+1; x<c; x++)
+				{
+					double d = (x - a) / (double)(c - a);
+
+					X[x] = X[a] + d * (X[c] - X[a]); Y[x] = Y[a] + d * (Y[c] - Y[a]);
+				}
+
+				for(int x=c+1; x<b; x++)
+				{
+					double d = (x - c) / (double)(b - c);
+
+					X[x] = X[c] + d * (X[b] - X[c]); Y[x] = Y[c] + d * (Y[b] - Y[c]);
+				}
+			}
+			else
+			{
+				if( c - a > 1 ) { Refine += a; Refine += c; }
+				if( b - c > 1 ) { Refine += c; Refine += b; }
+			}
+		}
+
+		Segments = Refine;
+	}
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 ///////////////////////////////////////////////////////////
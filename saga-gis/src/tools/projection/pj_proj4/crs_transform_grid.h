@@ -87,6 +87,8 @@ private:
 
 	bool						m_bList, m_bByteWise;
 
+	double						m_Approximate = 0.;
+
 	TSG_Grid_Resampling			m_Resampling;
 
 	CSG_Parameters_Grid_Target	m_Grid_Target;
@@ -100,6 +102,9 @@ private:
 	bool						Transform					(CSG_Grid                *pGrid , CSG_Shapes *pPoints);
 	bool						Transform					(CSG_Parameter_Grid_List *pGrids, CSG_Shapes *pPoints);
 
+	void						Get_Source_Row				(const CSG_Grid_System &Target, int y, double *X, double *Y);
+	void						Get_Source_Span				(const CSG_CRSProjector &Projector, const CSG_Grid_System &Target, int y, int ax, int bx, double *X, double *Y);
+
 	void						Get_MinMax					(TSG_Rect &r, double x, double y);
 	bool						Get_Target_System			(const CSG_Grid_System &System, bool bEdge);
 
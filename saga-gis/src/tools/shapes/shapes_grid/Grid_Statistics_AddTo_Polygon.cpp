@@ -70,7 +70,9 @@ CGrid_Statistics_AddTo_Polygon::CGrid_Statistics_AddTo_Polygon(void)
 	Set_Author		("O.Conrad (c) 2003, Quantile Calculation (c) 2007 by Johan Van de Wauw");
 
 	Set_Description	(_TW(
-		"Zonal grid statistics. For each polygon statistics based on all covered grid cells will be calculated."
+		"Zonal grid statistics. For each polygon statistics based on all covered grid cells will be calculated. "
+		"The grids are processed in a single pass of row blocks, percentiles and Gini coefficient are estimated "
+		"with t-digests, so that even grids not fitting into memory (file cached grids) can be analysed."
 	));
 
 	//-----------------------------------------------------
@@ -144,7 +146,7 @@ int CGrid_Statistics_AddTo_Polygon::On_Parameters_Enable(CSG_Parameters *pParame
 {
 	if( pParameter->Cmp_Identifier("METHOD") )
 	{
-		pParameters->Set_Enabled("PARALLELIZED", pParameter->asInt() != 0 && SG_OMP_Get_Max_Num_Threads() > 1);
+		pParameters->Set_Enabled("PARALLELIZED", SG_OMP_Get_Max_Num_Threads() > 1);
 	}
 
 	return( CSG_Tool_Grid::On_Parameters_Enable(pParameters, pParameter) );
@@ -236,16 +238,6 @@ bool CGrid_Statistics_AddTo_Polygon::On_Execute(void)
 	int		Naming			= Parameters("NAMING")->asInt();
 	int		Method			= Parameters("METHOD")->asInt();
 
-	//-----------------------------------------------------
-	CSG_Grid	Index;
-
-	if( Method == 0 && !Get_Simple_Index(pPolygons, Index) )
-	{
-		Error_Set(_TL("no grids in selection"));
-
-		return( false );
-	}
-
 	//-----------------------------------------------------
 	if( Parameters("RESULT")->asShapes() != NULL && Parameters("RESULT")->asShapes() != pPolygons )
 	{
@@ -254,76 +246,78 @@ bool CGrid_Statistics_AddTo_Polygon::On_Execute(void)
 		pPolygons	->Fmt_Name("%s [%s]", Parameters("POLYGONS")->asShapes()->Get_Name(), _TL("Grid Statistics"));
 	}
 
-	CSG_Simple_Statistics	*Statistics	= new CSG_Simple_Statistics[pPolygons->Get_Count()];
+	int	nGrids	= pGrids->Get_Grid_Count();
+
+	CSG_Simple_Statistics	*Statistics	= new CSG_Simple_Statistics[pPolygons->Get_Count() * nGrids];
+
+	CSG_TDigest	*Digests	= Percentiles.Get_N() > 0 || fGINI >= 0 ? new CSG_TDigest[pPolygons->Get_Count() * nGrids] : NULL;
+
+	bool	bOkay	= Get_Statistics(pGrids, pPolygons, Statistics, Digests, Method, bParallelized);
 
 	//-----------------------------------------------------
-	for(int iGrid=0; iGrid<pGrids->Get_Grid_Count() && Process_Get_Okay(); iGrid++)
+	for(int iGrid=0; bOkay && iGrid<nGrids; iGrid++)
 	{
-		Process_Set_Text("[%d/%d] %s", 1 + iGrid, pGrids->Get_Grid_Count(), pGrids->Get_Grid(iGrid)->Get_Name());
-
-		if( (Method == 0 && Get_Simple (pGrids->Get_Grid(iGrid), pPolygons, Statistics, Percentiles.Get_N() > 0 || fGINI > 0, Index        ))
-		||  (Method != 0 && Get_Precise(pGrids->Get_Grid(iGrid), pPolygons, Statistics, Percentiles.Get_N() > 0 || fGINI > 0, bParallelized)) )
+		nFields	= pPolygons->Get_Field_Count();
+
+		if( fCOUNT    >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("CELLS"   )), SG_DATATYPE_Int   );
+		if( fMIN      >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("MIN"     )), SG_DATATYPE_Double);
+		if( fMAX      >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("MAX"     )), SG_DATATYPE_Double);
+		if( fRANGE    >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("RANGE"   )), SG_DATATYPE_Double);
+		if( fSUM      >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("SUM"     )), SG_DATATYPE_Double);
+		if( fMEAN     >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("MEAN"    )), SG_DATATYPE_Double);
+		if( fVAR      >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("VARIANCE")), SG_DATATYPE_Double);
+		if( fSTDDEV   >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("STDDEV"  )), SG_DATATYPE_Double);
+		if (fGINI     >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("GINI"    )), SG_DATATYPE_Double);
+		if( fQUANTILE >= 0 )
 		{
-			nFields	= pPolygons->Get_Field_Count();
-
-			if( fCOUNT    >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("CELLS"   )), SG_DATATYPE_Int   );
-			if( fMIN      >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("MIN"     )), SG_DATATYPE_Double);
-			if( fMAX      >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("MAX"     )), SG_DATATYPE_Double);
-			if( fRANGE    >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("RANGE"   )), SG_DATATYPE_Double);
-			if( fSUM      >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("SUM"     )), SG_DATATYPE_Double);
-			if( fMEAN     >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("MEAN"    )), SG_DATATYPE_Double);
-			if( fVAR      >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("VARIANCE")), SG_DATATYPE_Double);
-			if( fSTDDEV   >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("STDDEV"  )), SG_DATATYPE_Double);
-			if (fGINI     >= 0 )	pPolygons->Add_Field(GET_FIELD_NAME(_TL("GINI"    )), SG_DATATYPE_Double);
-			if( fQUANTILE >= 0 )
+			for(int iPercentile=0; iPercentile<Percentiles.Get_N(); iPercentile++)
 			{
-				for(int iPercentile=0; iPercentile<Percentiles.Get_N(); iPercentile++)
-				{
-					pPolygons->Add_Field(GET_FIELD_NAME(CSG_String::Format("Q%02d", (int)Percentiles[iPercentile]).c_str()), SG_DATATYPE_Double);
-				}
+				pPolygons->Add_Field(GET_FIELD_NAME(CSG_String::Format("Q%02d", (int)Percentiles[iPercentile]).c_str()), SG_DATATYPE_Double);
 			}
+		}
 
-			//---------------------------------------------
-			for(sLong i=0; i<pPolygons->Get_Count() && Set_Progress(i, pPolygons->Get_Count()); i++)
-			{
-				CSG_Shape	*pPolygon	= pPolygons->Get_Shape(i);
+		//---------------------------------------------
+		for(sLong i=0; i<pPolygons->Get_Count(); i++)
+		{
+			CSG_Shape	*pPolygon	= pPolygons->Get_Shape(i);
+
+			CSG_Simple_Statistics	&s	= Statistics[i * nGrids + iGrid];
 
-				if( Statistics[i].Get_Count() == 0 )
+			if( s.Get_Count() == 0 )
+			{
+				if( fCOUNT    >= 0 )	pPolygon->Set_NoData(nFields + fCOUNT );
+				if( fMIN      >= 0 )	pPolygon->Set_NoData(nFields + fMIN   );
+				if( fMAX      >= 0 )	pPolygon->Set_NoData(nFields + fMAX   );
+				if( fRANGE    >= 0 )	pPolygon->Set_NoData(nFields + fRANGE );
+				if( fSUM      >= 0 )	pPolygon->Set_NoData(nFields + fSUM   );
+				if( fMEAN     >= 0 )	pPolygon->Set_NoData(nFields + fMEAN  );
+				if( fVAR      >= 0 )	pPolygon->Set_NoData(nFields + fVAR   );
+				if( fSTDDEV   >= 0 )	pPolygon->Set_NoData(nFields + fSTDDEV);
+				if( fGINI     >= 0 )	pPolygon->Set_NoData(nFields + fGINI  );
+				if( fQUANTILE >= 0 )
 				{
-					if( fCOUNT    >= 0 )	pPolygon->Set_NoData(nFields + fCOUNT );
-					if( fMIN      >= 0 )	pPolygon->Set_NoData(nFields + fMIN   );
-					if( fMAX      >= 0 )	pPolygon->Set_NoData(nFields + fMAX   );
-					if( fRANGE    >= 0 )	pPolygon->Set_NoData(nFields + fRANGE );
-					if( fSUM      >= 0 )	pPolygon->Set_NoData(nFields + fSUM   );
-					if( fMEAN     >= 0 )	pPolygon->Set_NoData(nFields + fMEAN  );
-					if( fVAR      >= 0 )	pPolygon->Set_NoData(nFields + fVAR   );
-					if( fSTDDEV   >= 0 )	pPolygon->Set_NoData(nFields + fSTDDEV);
-					if( fGINI     >= 0 )	pPolygon->Set_NoData(nFields + fGINI  );
-					if( fQUANTILE >= 0 )
+					for(int iPercentile=0, iField=nFields + fQUANTILE; iPercentile<Percentiles.Get_N(); iPercentile++, iField++)
 					{
-						for(int iPercentile=0, iField=nFields + fQUANTILE; iPercentile<Percentiles.Get_N(); iPercentile++, iField++)
-						{
-							pPolygon->Set_NoData(iField);
-						}
+						pPolygon->Set_NoData(iField);
 					}
 				}
-				else
+			}
+			else
+			{
+				if( fCOUNT    >= 0 )	pPolygon->Set_Value(nFields + fCOUNT , s.Get_Count   ());
+				if( fMIN      >= 0 )	pPolygon->Set_Value(nFields + fMIN   , s.Get_Minimum ());
+				if( fMAX      >= 0 )	pPolygon->Set_Value(nFields + fMAX   , s.Get_Maximum ());
+				if( fRANGE    >= 0 )	pPolygon->Set_Value(nFields + fRANGE , s.Get_Range   ());
+				if( fSUM      >= 0 )	pPolygon->Set_Value(nFields + fSUM   , s.Get_Sum     ());
+				if( fMEAN     >= 0 )	pPolygon->Set_Value(nFields + fMEAN  , s.Get_Mean    ());
+				if( fVAR      >= 0 )	pPolygon->Set_Value(nFields + fVAR   , s.Get_Variance());
+				if( fSTDDEV   >= 0 )	pPolygon->Set_Value(nFields + fSTDDEV, s.Get_StdDev  ());
+				if( fGINI     >= 0 )	pPolygon->Set_Value(nFields + fGINI  , Digests[i * nGrids + iGrid].Get_Gini());
+				if( fQUANTILE >= 0 )
 				{
-					if( fCOUNT    >= 0 )	pPolygon->Set_Value(nFields + fCOUNT , Statistics[i].Get_Count   ());
-					if( fMIN      >= 0 )	pPolygon->Set_Value(nFields + fMIN   , Statistics[i].Get_Minimum ());
-					if( fMAX      >= 0 )	pPolygon->Set_Value(nFields + fMAX   , Statistics[i].Get_Maximum ());
-					if( fRANGE    >= 0 )	pPolygon->Set_Value(nFields + fRANGE , Statistics[i].Get_Range   ());
-					if( fSUM      >= 0 )	pPolygon->Set_Value(nFields + fSUM   , Statistics[i].Get_Sum     ());
-					if( fMEAN     >= 0 )	pPolygon->Set_Value(nFields + fMEAN  , Statistics[i].Get_Mean    ());
-					if( fVAR      >= 0 )	pPolygon->Set_Value(nFields + fVAR   , Statistics[i].Get_Variance());
-					if( fSTDDEV   >= 0 )	pPolygon->Set_Value(nFields + fSTDDEV, Statistics[i].Get_StdDev  ());
-					if( fGINI     >= 0 )	pPolygon->Set_Value(nFields + fGINI  , Statistics[i].Get_Gini    ());
-					if( fQUANTILE >= 0 )
+					for(int iPercentile=0, iField=nFields + fQUANTILE; iPercentile<Percentiles.Get_N(); iPercentile++, iField++)
 					{
-						for(int iPercentile=0, iField=nFields + fQUANTILE; iPercentile<Percentiles.Get_N(); iPercentile++, iField++)
-						{
-							pPolygon->Set_Value(iField, Statistics[i].Get_Percentile(Percentiles[iPercentile]));
-						}
+						pPolygon->Set_Value(iField, Digests[i * nGrids + iGrid].Get_Percentile(Percentiles[iPercentile]));
 					}
 				}
 			}
@@ -333,9 +327,14 @@ bool CGrid_Statistics_AddTo_Polygon::On_Execute(void)
 	//-----------------------------------------------------
 	delete[](Statistics);
 
+	if( Digests )
+	{
+		delete[](Digests);
+	}
+
 	DataObject_Update(pPolygons);
 
-	return( true );
+	return( bOkay );
 }
 
 
@@ -344,214 +343,145 @@ bool CGrid_Statistics_AddTo_Polygon::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CGrid_Statistics_AddTo_Polygon::Get_Precise(CSG_Grid *pGrid, CSG_Shapes *pPolygons, CSG_Simple_Statistics *Statistics, bool bHoldValues, bool bParallelized)
+// Zonal statistics for all grids in a single pass. The grid
+// rows are processed in blocks. For each block the polygons
+// touching it are rasterized and the block's grid values are
+// accumulated to block local (i.e. thread local) statistics,
+// which finally are merged to the polygons' statistics.
+// Percentiles and Gini are derived from t-digests, so that
+// no cell values need to be kept in memory.
+//---------------------------------------------------------
+bool CGrid_Statistics_AddTo_Polygon::Get_Statistics(CSG_Parameter_Grid_List *pGrids, CSG_Shapes *pPolygons, CSG_Simple_Statistics *Statistics, CSG_TDigest *Digests, int Method, bool bParallelized)
 {
-	int	Method	= Parameters("METHOD")->asInt();
+	int	nRows	= M_GET_MAX(1, M_GET_MIN(Get_NY(), 0x100000 / Get_NX()));	// about one million cells per block
 
-	if( bParallelized )
+	int	nBlocks	= 1 + (Get_NY() - 1) / nRows;
+
+	//-----------------------------------------------------
+	CSG_Array_Int	*Blocks	= new CSG_Array_Int[nBlocks];
+
+	for(sLong i=0; i<pPolygons->Get_Count(); i++)
 	{
-		#pragma omp parallel for
-		for(sLong i=0; i<pPolygons->Get_Count(); i++)
+		CSG_Rect	r(pPolygons->Get_Shape(i)->Get_Extent());
+
+		if( r.Intersects(Get_System().Get_Extent(true)) )
 		{
-			Get_Precise(pGrid, (CSG_Shape_Polygon *)pPolygons->Get_Shape(i), Statistics[i], bHoldValues, Method);
+			int	ay	= (int)floor(0.5 + (r.yMin - Get_YMin()) / Get_Cellsize());	if( ay <  0         )	ay	= 0;
+			int	by	= (int)floor(0.5 + (r.yMax - Get_YMin()) / Get_Cellsize());	if( by >= Get_NY() )	by	= Get_NY() - 1;
+
+			for(int iBlock=ay/nRows; iBlock<=by/nRows; iBlock++)
+			{
+				Blocks[iBlock].Add((int)i);
+			}
 		}
 	}
-	else
+
+	//-----------------------------------------------------
+	for(sLong i=0; i<pPolygons->Get_Count() * pGrids->Get_Grid_Count(); i++)
+	{
+		Statistics[i].Create(false);
+	}
+
+	int	nDone	= 0;	bool	bOkay	= true;
+
+	#pragma omp parallel for schedule(dynamic) if(bParallelized)
+	for(int iBlock=0; iBlock<nBlocks; iBlock++)
 	{
-		for(sLong i=0; i<pPolygons->Get_Count() && Set_Progress(i, pPolygons->Get_Count()); i++)
+		if( bOkay )
 		{
-			Get_Precise(pGrid, (CSG_Shape_Polygon *)pPolygons->Get_Shape(i), Statistics[i], bHoldValues, Method);
+			Get_Block(pGrids, pPolygons, Blocks[iBlock], iBlock * nRows, M_GET_MIN(Get_NY(), (iBlock + 1) * nRows) - 1, Statistics, Digests, Method);
+
+			#pragma omp atomic
+			nDone++;
+
+			if( SG_OMP_Get_Thread_Num() == 0 && !Set_Progress(nDone, nBlocks) )
+			{
+				bOkay	= false;
+			}
 		}
 	}
 
-	return( true );
+	delete[](Blocks);
+
+	return( bOkay );
 }
 
 //---------------------------------------------------------
-bool CGrid_Statistics_AddTo_Polygon::Get_Precise(CSG_Grid *pGrid, CSG_Shape_Polygon *pPolygon, CSG_Simple_Statistics &Statistics, bool bHoldValues, int Method)
+bool CGrid_Statistics_AddTo_Polygon::Get_Block(CSG_Parameter_Grid_List *pGrids, CSG_Shapes *pPolygons, const CSG_Array_Int &Zones, int yMin, int yMax, CSG_Simple_Statistics *Statistics, CSG_TDigest *Digests, int Method)
 {
-	//-----------------------------------------------------
-	CSG_Shapes	Intersect(SHAPE_TYPE_Polygon);
+	int	nZones	= (int)Zones.Get_Size(), nGrids = pGrids->Get_Grid_Count();
 
-	CSG_Shape_Polygon	*pCell, *pArea;
-
-	if( Method == 3 )	// polygon wise (cell area weighted)
+	if( nZones < 1 )
 	{
-		pCell	= (CSG_Shape_Polygon *)Intersect.Add_Shape();
-		pArea	= (CSG_Shape_Polygon *)Intersect.Add_Shape();
+		return( true );
 	}
 
-	//-----------------------------------------------------
-	Statistics.Create(bHoldValues);
+	CSG_Simple_Statistics	*s	= new CSG_Simple_Statistics[nZones * nGrids];
+	CSG_TDigest				*d	= Digests ? new CSG_TDigest[nZones * nGrids] : NULL;
 
-	int	ax	= Get_System().Get_xWorld_to_Grid(pPolygon->Get_Extent().Get_XMin()) - 1;	if( ax < 0         )	ax	= 0;
-	int	bx	= Get_System().Get_xWorld_to_Grid(pPolygon->Get_Extent().Get_XMax()) + 1;	if( bx >= Get_NX() )	bx	= Get_NX() - 1;
-	int	ay	= Get_System().Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMin()) - 1;	if( ay < 0         )	ay	= 0;
-	int	by	= Get_System().Get_yWorld_to_Grid(pPolygon->Get_Extent().Get_YMax()) + 1;	if( by >= Get_NY() )	by	= Get_NY() - 1;
+	CSG_Shape_Polygon_Rasterizer	Rasterizer(Get_System());
 
-	TSG_Point	Center;
-	TSG_Rect	Cell;
+	CSG_Array_Int	Spans;	CSG_Vector	Coverage;
 
 	//-----------------------------------------------------
-	Center.y	= Get_System().Get_yGrid_to_World(ay);
-	Cell.yMin	= Center.y - 0.5 * Get_Cellsize();
-	Cell.yMax	= Cell.yMin + Get_Cellsize();
-		
-	for(int y=ay; y<=by; y++, Center.y+=Get_Cellsize(), Cell.yMin+=Get_Cellsize(), Cell.yMax+=Get_Cellsize())
+	if( Method == 0 )	// simple and fast, each cell belongs to one polygon only (the last one)
 	{
-		Center.x	= Get_System().Get_xGrid_to_World(ax);
-		Cell.xMin	= Center.x - 0.5 * Get_Cellsize();
-		Cell.xMax	= Cell.xMin + Get_Cellsize();
+		CSG_Array_Int	Index((sLong)Get_NX() * (yMax - yMin + 1));	Index.Assign(-1);
 
-		for(int x=ax; x<=bx; x++, Center.x+=Get_Cellsize(), Cell.xMin+=Get_Cellsize(), Cell.xMax+=Get_Cellsize())
+		for(int iZone=0; iZone<nZones; iZone++)
 		{
-			if( !pGrid->is_NoData(x, y) )
+			if( Rasterizer.Set_Polygon((CSG_Shape_Polygon *)pPolygons->Get_Shape(Zones[iZone]), false, yMin, yMax) )
 			{
-				switch( Method )
+				for(int y=Rasterizer.Get_yMin(); y<=Rasterizer.Get_yMax(); y++)
 				{
-				//-----------------------------------------
-				default:	// polygon wise (cell centers)
-					if( pPolygon->Contains(Center) )
-					{
-						Statistics	+= pGrid->asDouble(x, y);
-					}
-					break;
-
-				//-----------------------------------------
-				case  2:	// polygon wise (cell area)
-					if( pPolygon->Intersects(Cell) )
-					{
-						Statistics	+= pGrid->asDouble(x, y);
-					}
-					break;
-
-				//-----------------------------------------
-				case  3:	// polygon wise (cell area weighted)
-					switch( pPolygon->Intersects(Cell) )
+					for(int i=0, n=Rasterizer.Get_Spans(y, Spans); i<n; i++)
 					{
-					case INTERSECTION_None     :	break;
-					case INTERSECTION_Identical:
-					case INTERSECTION_Contains :	Statistics.Add_Value(pGrid->asDouble(x, y),       Get_Cellarea());	break;
-					case INTERSECTION_Contained:	Statistics.Add_Value(pGrid->asDouble(x, y), pPolygon->Get_Area());	break;
-					case INTERSECTION_Overlaps :
-						pCell->Del_Parts();
-
-						pCell->Add_Point(Cell.xMin, Cell.yMin);	pCell->Add_Point(Cell.xMin, Cell.yMax);
-						pCell->Add_Point(Cell.xMax, Cell.yMax);	pCell->Add_Point(Cell.xMax, Cell.yMin);
-
-						if( SG_Shape_Get_Intersection(pPolygon, pCell, pArea) )
+						for(int x=Spans[2 * i]; x<=Spans[2 * i + 1]; x++)
 						{
-							Statistics.Add_Value(pGrid->asDouble(x, y), pArea->Get_Area());
+							Index[(sLong)(y - yMin) * Get_NX() + x]	= iZone;
 						}
-						break;
 					}
-					break;
 				}
 			}
 		}
-	}
-
-	return( true );
-}
-
 
-///////////////////////////////////////////////////////////
-//														 //
-///////////////////////////////////////////////////////////
-
-//---------------------------------------------------------
-bool CGrid_Statistics_AddTo_Polygon::Get_Simple(CSG_Grid *pGrid, CSG_Shapes *pPolygons, CSG_Simple_Statistics *Statistics, bool bHoldValues, CSG_Grid &Index)
-{
-	for(sLong i=0; i<pPolygons->Get_Count(); i++)
-	{
-		Statistics[i].Create(bHoldValues);
-	}
-
-	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
-	{
-		for(int x=0, i; x<Get_NX(); x++)
+		for(int y=yMin, i=0; y<=yMax; y++)
 		{
-			if( !pGrid->is_NoData(x, y) && (i = Index.asInt(x, y)) >= 0 && i < pPolygons->Get_Count() )
+			for(int x=0, iZone; x<Get_NX(); x++, i++)
 			{
-				Statistics[i] += pGrid->asDouble(x, y);
+				if( (iZone = Index[i]) >= 0 )
+				{
+					Add_Value(pGrids, x, y, s + iZone * nGrids, d ? d + iZone * nGrids : NULL);
+				}
 			}
 		}
 	}
 
-	return( true );
-}
-
-//---------------------------------------------------------
-bool CGrid_Statistics_AddTo_Polygon::Get_Simple_Index(CSG_Shapes *pPolygons, CSG_Grid &Index)
-{
-	Index.Create(Get_System(), pPolygons->Get_Count() < 32767 ? SG_DATATYPE_Short : SG_DATATYPE_Int);
-	Index.Assign(-1.);
-
-	bool *bCrossing = (bool *)SG_Malloc(Get_NX() * sizeof(bool));
-
 	//-----------------------------------------------------
-	for(sLong iShape=0; iShape<pPolygons->Get_Count() && Set_Progress(iShape, pPolygons->Get_Count()); iShape++)
+	else for(int iZone=0; iZone<nZones; iZone++)	// polygon wise
 	{
-		CSG_Shape *pPolygon = pPolygons->Get_Shape(iShape); TSG_Rect Extent = pPolygon->Get_Extent();
-
-		int xStart = Get_System().Get_xWorld_to_Grid(Extent.xMin) - 1;	if( xStart < 0 )		xStart	= 0;
-		int xStop  = Get_System().Get_xWorld_to_Grid(Extent.xMax) + 1;	if( xStop >= Get_NX() )	xStop	= Get_NX() - 1;
-
-		CSG_Point Left (Get_XMin() - 1., 0.);
-		CSG_Point Right(Get_XMax() + 1., 0.);
-
-		//-------------------------------------------------
-		for(int y=0; y<Get_NY(); y++)
+		if( Rasterizer.Set_Polygon((CSG_Shape_Polygon *)pPolygons->Get_Shape(Zones[iZone]), Method != 1, yMin, yMax) )
 		{
-			double yPos = Get_YMin() + y * Get_Cellsize();
-
-			if( yPos >= Extent.yMin && yPos <= Extent.yMax )
+			for(int y=Rasterizer.Get_yMin(); y<=Rasterizer.Get_yMax(); y++)
 			{
-				memset(bCrossing, 0, Get_NX() * sizeof(bool));
-
-				Left.y = Right.y = yPos;
-
-				//-----------------------------------------
-				for(int iPart=0; iPart<pPolygon->Get_Part_Count(); iPart++)
+				if( Method == 1 )	// polygon wise (cell centers)
 				{
-					CSG_Point B = pPolygon->Get_Point(pPolygon->Get_Point_Count(iPart) - 1, iPart);
-
-					for(int iPoint=0; iPoint<pPolygon->Get_Point_Count(iPart); iPoint++)
+					for(int i=0, n=Rasterizer.Get_Spans(y, Spans); i<n; i++)
 					{
-						CSG_Point A = B; B = pPolygon->Get_Point(iPoint, iPart);
-
-						if( ((A.y <= yPos && yPos <  B.y)
-						||   (A.y >  yPos && yPos >= B.y)) )
+						for(int x=Spans[2 * i]; x<=Spans[2 * i + 1]; x++)
 						{
-							TSG_Point C; SG_Get_Crossing(C, A, B, Left, Right, false);
-
-							int ix = (int)((C.x - Get_XMin()) / Get_Cellsize() + 1.);
-
-							if( ix < 0 )
-							{
-								ix = 0;
-							}
-							else if( ix >= Get_NX() )
-							{
-								continue;
-							}
-
-							bCrossing[ix] = !bCrossing[ix];
+							Add_Value(pGrids, x, y, s + iZone * nGrids, d ? d + iZone * nGrids : NULL);
 						}
 					}
 				}
-
-				//-----------------------------------------
-				for(int x=xStart, bFill=0; x<=xStop; x++)
+				else if( Rasterizer.Get_Coverage(y, Coverage) )	// polygon wise (cell area), (cell area weighted)
 				{
-					if( bCrossing[x] )
-					{
-						bFill = bFill ? 0 : 1;
-					}
-
-					if( bFill )
+					for(int x=Rasterizer.Get_xMin(), i=0; x<=Rasterizer.Get_xMax(); x++, i++)
 					{
-						Index.Set_Value(x, y, (double)iShape);
+						if( Coverage[i] > 0. )
+						{
+							Add_Value(pGrids, x, y, s + iZone * nGrids, d ? d + iZone * nGrids : NULL, Method == 3 ? Coverage[i] * Get_Cellarea() : 1.);
+						}
 					}
 				}
 			}
@@ -559,11 +489,51 @@ bool CGrid_Statistics_AddTo_Polygon::Get_Simple_Index(CSG_Shapes *pPolygons, CSG
 	}
 
 	//-----------------------------------------------------
-	SG_Free(bCrossing);
+	#pragma omp critical
+	{
+		for(int iZone=0; iZone<nZones; iZone++)
+		{
+			for(int iGrid=0, i=iZone*nGrids, j=Zones[iZone]*nGrids; iGrid<nGrids; iGrid++, i++, j++)
+			{
+				Statistics[j]	+= s[i];
+
+				if( d )
+				{
+					Digests[j]	+= d[i];
+				}
+			}
+		}
+	}
+
+	delete[](s);
+
+	if( d )
+	{
+		delete[](d);
+	}
 
 	return( true );
 }
 
+//---------------------------------------------------------
+inline void CGrid_Statistics_AddTo_Polygon::Add_Value(CSG_Parameter_Grid_List *pGrids, int x, int y, CSG_Simple_Statistics *s, CSG_TDigest *d, double Weight)
+{
+	for(int iGrid=0; iGrid<pGrids->Get_Grid_Count(); iGrid++)
+	{
+		CSG_Grid	*pGrid	= pGrids->Get_Grid(iGrid);
+
+		if( !pGrid->is_NoData(x, y) )
+		{
+			s[iGrid].Add_Value(pGrid->asDouble(x, y), Weight);
+
+			if( d )
+			{
+				d[iGrid].Add_Value(pGrid->asDouble(x, y));
+			}
+		}
+	}
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -86,11 +86,10 @@ protected:
 
 private:
 
-	bool					Get_Simple				(CSG_Grid *pGrid, CSG_Shapes *pPolygons, CSG_Simple_Statistics *Statistics, bool bQuantiles, CSG_Grid &Index);
-	bool					Get_Simple_Index		(CSG_Shapes *pPolygons, CSG_Grid &Index);
+	bool					Get_Statistics			(CSG_Parameter_Grid_List *pGrids, CSG_Shapes *pPolygons, CSG_Simple_Statistics *Statistics, CSG_TDigest *Digests, int Method, bool bParallelized);
+	bool					Get_Block				(CSG_Parameter_Grid_List *pGrids, CSG_Shapes *pPolygons, const CSG_Array_Int &Zones, int yMin, int yMax, CSG_Simple_Statistics *Statistics, CSG_TDigest *Digests, int Method);
 
-	bool					Get_Precise				(CSG_Grid *pGrid, CSG_Shapes *pPolygons, CSG_Simple_Statistics *Statistics, bool bQuantiles, bool bParallelized);
-	bool					Get_Precise				(CSG_Grid *pGrid, CSG_Shape_Polygon *pPolygon, CSG_Simple_Statistics &Statistics, bool bQuantiles, int Method);
+	void					Add_Value				(CSG_Parameter_Grid_List *pGrids, int x, int y, CSG_Simple_Statistics *s, CSG_TDigest *d, double Weight = 1.);
 
 };
 
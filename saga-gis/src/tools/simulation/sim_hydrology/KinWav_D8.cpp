@@ -135,6 +135,28 @@ CKinWav_D8::CKinWav_D8(void)
 		1.0, 0.0, true
 	);
 
+	//-----------------------------------------------------
+	Parameters.Add_FilePath("",
+		"CHECKPOINT"	, _TL("Checkpoint"),
+		_TL("If set, the simulation state is stored regularly to this file, so that an interrupted simulation can be resumed."),
+		CSG_String::Format("%s|*.sg-state|%s|*.*",
+			_TL("Simulation State"),
+			_TL("All Files")
+		), NULL, true
+	);
+
+	Parameters.Add_Double("CHECKPOINT",
+		"CHECKPOINT_UPDATE", _TL("Checkpoint Interval"),
+		_TL("Minimum time in minutes (processing time, not simulation time) between two checkpoints."),
+		10.0, 0.0, true
+	);
+
+	Parameters.Add_Bool("CHECKPOINT",
+		"CHECKPOINT_RESUME", _TL("Resume"),
+		_TL("Resume the simulation from the checkpoint, if it exists."),
+		false
+	);
+
 	//-----------------------------------------------------
 	Parameters.Add_Node("",
 		"MODEL"			, _TL("Model Options"),
@@ -237,6 +259,11 @@ int CKinWav_D8::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Parameter
 		pParameters->Set_Enabled("GAUGES"     , pParameter->asPointer() != NULL);
 	}
 
+	if( pParameter->Cmp_Identifier("CHECKPOINT") )
+	{
+		pParameter->Set_Children_Enabled(*pParameter->asString() != '\0');
+	}
+
 	return( CSG_Tool_Grid::On_Parameters_Enable(pParameters, pParameter) );
 }
 
@@ -265,9 +292,13 @@ CSG_String	Get_Time_String(double Hour)
 //---------------------------------------------------------
 bool CKinWav_D8::On_Execute(void)
 {
+	double	Time;
+
 	//-----------------------------------------------------
-	if( !Initialize() )
+	if( !Initialize() || !Initialize_State(Time) )
 	{
+		Finalize();
+
 		return( false );
 	}
 
@@ -275,11 +306,11 @@ bool CKinWav_D8::On_Execute(void)
 	double	Time_Span	= Parameters("TIME_SPAN"  )->asDouble();
 	double	Time_Step	= Parameters("TIME_STEP"  )->asDouble() / 60.;	// from minutes to hours
 	double	Update		= Parameters("TIME_UPDATE")->asDouble() / 60.;	// from minutes to hours
-	double	Update_Last	= 0.0;
+	double	Update_Last	= Time;
 
 	m_dt	=  Time_Step * 60;	// minutes >> seconds
 
-	for(double Time=0.0; Time<=Time_Span && Set_Progress(Time, Time_Span); Time+=Time_Step)
+	for( ; Time<=Time_Span && Set_Progress(Time, Time_Span); Time+=Time_Step)
 	{
 		Process_Set_Text("%s: %s (%sh)", _TL("Simulation Time"), Get_Time_String(Time).c_str(), Get_Time_String(Time_Span).c_str());
 
@@ -299,9 +330,13 @@ bool CKinWav_D8::On_Execute(void)
 
 		Gauges_Set_Flow(Time);
 
+		m_State.Save_Checkpoint(Time + Time_Step);	// state after this time step
+
 		SG_UI_ProgressAndMsg_Lock(false);
 	}
 
+	m_State.Save_Checkpoint(Time, true);
+
 	//-----------------------------------------------------
 	Finalize();
 
@@ -402,9 +437,35 @@ bool CKinWav_D8::Initialize(void)
 	return( true );
 }
 
+//---------------------------------------------------------
+bool CKinWav_D8::Initialize_State(double &Time)
+{
+	m_State.Destroy();
+
+	m_State.Add_State("FLOW"    , m_pFlow    );
+	m_State.Add_State("FLOW_OUT", &m_Flow_Out);
+	m_State.Add_State("FLOW_SUM", &m_Flow_Sum);	// initial flow, keeps the balance of a resumed simulation
+
+	m_State.Set_Checkpoint(Parameters("CHECKPOINT")->asString(), Parameters("CHECKPOINT_UPDATE")->asDouble());
+
+	if( !m_State.Initialize(Parameters("CHECKPOINT_RESUME")->asBool(), Time) )
+	{
+		return( false );
+	}
+
+	if( Time > 0.0 )
+	{
+		DataObject_Update(m_pFlow);
+	}
+
+	return( true );
+}
+
 //---------------------------------------------------------
 bool CKinWav_D8::Finalize(void)
 {
+	m_State.Destroy();
+
 	for(int i=0; i<8; i++)
 	{
 		m_dFlow[i].Destroy();
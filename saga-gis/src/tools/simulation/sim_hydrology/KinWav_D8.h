@@ -97,8 +97,11 @@ private:
 
 	CSG_Shapes			*m_pGauges;
 
+	CSG_Simulation_State	m_State;
+
 
 	bool				Initialize				(void);
+	bool				Initialize_State		(double &Time);
 	bool				Finalize				(void);
 
 	void				Set_Flow				(void);
@@ -173,6 +173,12 @@ COverland_Flow::COverland_Flow(void)
 		0.5, 0.01, true, 1., true
 	);
 
+	Parameters.Add_Int("TIME_STEP",
+		"TIME_LEVELS"      , _TL("Local Time Step Levels"),
+		_TL("Number of velocity classes used for local time stepping. Each class takes twice the time step of the next faster one, so that slow cells are updated less often than fast ones. A single level uses the same time step for all cells."),
+		1, 1, true, 8, true
+	);
+
 //	Parameters.Add_Double("",
 //		"V_MIN"            , _TL("Minimum Velocity [m/h]"),
 //		_TL(""),
@@ -233,6 +239,40 @@ COverland_Flow::COverland_Flow(void)
 		_TL(""),
 		false
 	);
+
+	//-----------------------------------------------------
+	Parameters.Add_FilePath("",
+		"CHECKPOINT"       , _TL("Checkpoint"),
+		_TL("If set, the simulation state is stored regularly to this file, so that an interrupted simulation can be resumed."),
+		CSG_String::Format("%s|*.sg-state|%s|*.*",
+			_TL("Simulation State"),
+			_TL("All Files")
+		), NULL, true
+	);
+
+	Parameters.Add_Double("CHECKPOINT",
+		"CHECKPOINT_UPDATE", _TL("Checkpoint Interval"),
+		_TL("Minimum time in minutes (processing time, not simulation time) between two checkpoints."),
+		10., 0., true
+	);
+
+	Parameters.Add_Bool("CHECKPOINT",
+		"CHECKPOINT_RESUME", _TL("Resume"),
+		_TL("Resume the simulation from the checkpoint, if it exists."),
+		false
+	);
+
+	Parameters.Add_FilePath("",
+		"STREAM"           , _TL("Time Series Output"),
+		_TL("If set, flow (and velocity) are appended to grid collections in this folder at the given interval without being kept in memory."),
+		NULL, NULL, true, true
+	);
+
+	Parameters.Add_Double("STREAM",
+		"STREAM_UPDATE"    , _TL("Output Frequency"),
+		_TL("Output frequency in minutes simulation time. Set to zero to write each simulation time step."),
+		10., 0., true
+	);
 }
 
 
@@ -294,6 +334,11 @@ int COverland_Flow::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Parame
 		pParameter->Set_Children_Enabled(pParameter->asShapes());
 	}
 
+	if( pParameter->Cmp_Identifier("CHECKPOINT") || pParameter->Cmp_Identifier("STREAM") )
+	{
+		pParameter->Set_Children_Enabled(*pParameter->asString() != '\0');
+	}
+
 	return( CSG_Tool_Grid::On_Parameters_Enable(pParameters, pParameter) );
 }
 
@@ -305,7 +350,9 @@ int COverland_Flow::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Parame
 //---------------------------------------------------------
 bool COverland_Flow::On_Execute(void)
 {
-	if( !Initialize() )
+	double Time;
+
+	if( !Initialize() || !Initialize_State(Time) )
 	{
 		Finalize();
 
@@ -317,15 +364,17 @@ bool COverland_Flow::On_Execute(void)
 
 	double Monitor_Last = 0., Monitor = Parameters("MONITOR_UPDATE")->asDouble() / 60., Monitor_Time = 0.;
 
-	if( m_pMonitor_Points && m_pMonitor_Series->Get_Count() > 0 )
+	if( m_pMonitor_Points && m_pMonitor_Series->Get_Count() > 0 && Time <= 0. ) // a resumed simulation continues with its own time
 	{
 		Monitor_Time = m_pMonitor_Series->Get_Record(m_pMonitor_Series->Get_Count() - 1)->asDouble(0);
 	}
 
+	double Stream_Last  = Time, Stream  = Parameters("STREAM_UPDATE" )->asDouble() / 60.;
+
 	//-----------------------------------------------------
-	double Time, Time_Stop = Parameters("TIME_STOP")->asDouble();
+	double Time_Stop = Parameters("TIME_STOP")->asDouble();
 
-	for(Time=0.; Time<=Time_Stop && Set_Time_Stamp(Time); Time+=m_dTime)
+	for( ; Time<=Time_Stop && Set_Time_Stamp(Time); Time+=m_dTime)
 	{
 		SG_UI_ProgressAndMsg_Lock(true);
 
@@ -351,9 +400,23 @@ bool COverland_Flow::On_Execute(void)
 			Do_Monitor(Monitor_Time + Time);
 		}
 
+		if( m_State.Get_Output_Count() > 0 && Time >= Stream_Last )
+		{
+			if( Stream > 0. )
+			{
+				Stream_Last = Stream * (1. + floor(Time / Stream));
+			}
+
+			m_State.Set_Output(Time);
+		}
+
+		m_State.Save_Checkpoint(Time + m_dTime); // state after this time step
+
 		SG_UI_ProgressAndMsg_Lock(false);
 	}
 
+	m_State.Save_Checkpoint(Time, true);
+
 	//-----------------------------------------------------
 	double s = Time;
 	int    h = (int)s; s = 60. * (s - h);
@@ -413,6 +476,8 @@ bool COverland_Flow::Initialize(void)
 
 	m_vMin  = 0.; // = Parameters("V_MIN"    )->asDouble();
 
+	m_nLevels        = Parameters("TIME_LEVELS")->asInt ();
+
 	m_bFlow_Out      = Parameters("FLOW_OUT" )->asBool  ();
 	m_Flow_Out       = 0.;
 
@@ -461,6 +526,23 @@ bool COverland_Flow::Initialize(void)
 	m_Flow.Create(Get_System()       , SG_DATATYPE_Float);
 	m_v   .Create(Get_System(), 9, 0., SG_DATATYPE_Float);
 
+	m_Level .Create(Get_System(), SG_DATATYPE_Char); m_Level .Assign(-1.);
+	m_Gather.Create(Get_System(), SG_DATATYPE_Char); m_Gather.Assign(-1.);
+
+	Set_Wet();
+
+	m_Rain.Set_Array(0, false); m_Rain.Set_Growth(TSG_Array_Growth::SG_ARRAY_GROWTH_2);
+
+	for(int y=0; y<Get_NY(); y++) for(int x=0; x<Get_NX(); x++)	// cells receiving precipitation, precipitation does not change with time
+	{
+		double P; if( !m_pPrecipitation || !m_pPrecipitation->Get_Value(Get_System().Get_Grid_to_World(x, y), P) ) { P = m_Precipitation; }
+
+		if( P > 0. && !m_pDEM->is_NoData(x, y) )
+		{
+			m_Rain += (sLong)y * Get_NX() + x;
+		}
+	}
+
 	//-----------------------------------------------------
 	m_pMonitor_Points = Parameters("MONITOR_POINTS")->asShapes();
 	m_pMonitor_Series = Parameters("MONITOR_SERIES")->asTable ();
@@ -493,12 +575,73 @@ bool COverland_Flow::Initialize(void)
 	return( true );
 }
 
+//---------------------------------------------------------
+bool COverland_Flow::Initialize_State(double &Time)
+{
+	m_State.Destroy();
+
+	m_State.Add_State("FLOW"     , m_pFlow     );
+	if( m_pIntercept ) m_State.Add_State("INTERCEPT", m_pIntercept);
+	if( m_pPonding   ) m_State.Add_State("PONDING"  , m_pPonding  );
+	if( m_pInfiltrat ) m_State.Add_State("INFILTRAT", m_pInfiltrat);
+	m_State.Add_State("FLOW_OUT" , &m_Flow_Out );
+
+	m_State.Set_Checkpoint(Parameters("CHECKPOINT")->asString(), Parameters("CHECKPOINT_UPDATE")->asDouble());
+
+	//-----------------------------------------------------
+	CSG_String Folder(Parameters("STREAM")->asString());
+
+	if( !Folder.is_Empty() )
+	{
+		if( !SG_Dir_Exists(Folder) && !SG_Dir_Create(Folder, true) )
+		{
+			Error_Fmt("%s [%s]", _TL("failed to create directory"), Folder.c_str());
+
+			return( false );
+		}
+
+		m_State.Add_Output(SG_File_Make_Path(Folder, "flow"), m_pFlow);
+
+		if( m_pVelocity )
+		{
+			m_State.Add_Output(SG_File_Make_Path(Folder, "velocity"), m_pVelocity);
+		}
+	}
+
+	//-----------------------------------------------------
+	if( !m_State.Initialize(Parameters("CHECKPOINT_RESUME")->asBool(), Time) )
+	{
+		return( false );
+	}
+
+	if( Time > 0. )
+	{
+		Set_Wet(); // the wet cells of the restored state
+
+		DataObject_Update(m_pFlow);
+	}
+
+	return( true );
+}
+
 //---------------------------------------------------------
 bool COverland_Flow::Finalize(void)
 {
+	m_State.Destroy();
+
 	m_Flow.Destroy();
 	m_v   .Destroy();
 
+	m_Level .Destroy();
+	m_Gather.Destroy();
+
+	m_Wet.Destroy(); m_Rain.Destroy();
+
+	for(int i=0; i<8; i++)
+	{
+		m_Cells[i].Destroy(); m_Cells_Gather[i].Destroy();
+	}
+
 	if( !Process_Get_Okay() )
 	{
 		SG_UI_Process_Set_Okay();
@@ -648,26 +791,82 @@ bool COverland_Flow::Set_Time_Stamp(double Time)
 //														 //
 ///////////////////////////////////////////////////////////
 
+//---------------------------------------------------------
+// Only wet cells and their neighbours are processed. With
+// more than one time step level, the global time step is
+// divided into sub-steps, in which cells are updated with
+// the time step of their velocity class (local time stepping).
+// Lateral flow is computed from the donor cell's state and
+// time step, so that mass is exchanged consistently between
+// cells of different classes.
 //---------------------------------------------------------
 bool COverland_Flow::Do_Time_Step(void)
 {
-	m_vMax = 0.;
+	CSG_Vector v(M_GET_MAX(1, m_Wet.Get_Size())); double vMax = 0.;
 
-	#pragma omp parallel for
-	for(int y=0; y<Get_NY(); y++) for(int x=0; x<Get_NX(); x++)
+	#pragma omp parallel for reduction(max:vMax)
+	for(sLong i=0; i<m_Wet.Get_Size(); i++)
 	{
-		Get_Velocity(x, y);
+		v[i] = Get_Velocity((int)(m_Wet[i] % Get_NX()), (int)(m_Wet[i] / Get_NX()));
+
+		if( vMax < v[i] )
+		{
+			vMax = v[i];
+		}
 	}
 
+	m_vMax = vMax;
+
 	//-----------------------------------------------------
-	if( m_vMax > 0. )
+	if( Set_Levels(v) )
 	{
-		m_dTime = Parameters("TIME_STEP")->asDouble() * Get_Cellsize() / m_vMax; // Courant–Friedrichs–Lewy (CFL) condition
+		int nSteps = 1 << (m_nLevels - 1);
 
-		#pragma omp parallel for
-		for(int y=0; y<Get_NY(); y++) for(int x=0; x<Get_NX(); x++)
+		m_dTime = nSteps * Parameters("TIME_STEP")->asDouble() * Get_Cellsize() / m_vMax; // Courant–Friedrichs–Lewy (CFL) condition, applied to the fastest level's sub-step
+
+		for(int Step=0; Step<nSteps; Step++)
 		{
-			Set_Flow_Lateral(x, y);
+			int Level = m_nLevels - 1; for(int s=Step; Level>0 && s%2==0; s/=2) { Level--; }	// lowest level updated in this sub-step
+
+			for(int k=Level; Step>0 && k<m_nLevels; k++)	// velocities of the first sub-step are already known
+			{
+				#pragma omp parallel for
+				for(sLong i=0; i<m_Cells[k].Get_Size(); i++)
+				{
+					Get_Velocity((int)(m_Cells[k][i] % Get_NX()), (int)(m_Cells[k][i] / Get_NX()));
+				}
+			}
+
+			for(int k=Level; k<m_nLevels; k++)
+			{
+				#pragma omp parallel for
+				for(sLong i=0; i<m_Cells_Gather[k].Get_Size(); i++)
+				{
+					Set_Flow_Lateral((int)(m_Cells_Gather[k][i] % Get_NX()), (int)(m_Cells_Gather[k][i] / Get_NX()), Level);
+				}
+			}
+
+			for(int k=Level; k<m_nLevels; k++)
+			{
+				#pragma omp parallel for
+				for(sLong i=0; i<m_Cells_Gather[k].Get_Size(); i++)
+				{
+					int x = (int)(m_Cells_Gather[k][i] % Get_NX()), y = (int)(m_Cells_Gather[k][i] / Get_NX());
+
+					m_pFlow->Set_Value(x, y, m_Flow.asDouble(x, y));
+				}
+			}
+
+			for(int k=Level; k<m_nLevels; k++)
+			{
+				for(sLong i=0, n=m_Cells_Gather[k].Get_Size(); i<n; i++)
+				{
+					if( m_Level.asInt(m_Cells_Gather[k][i]) < 0 && m_pFlow->asDouble(m_Cells_Gather[k][i]) > 0. )
+					{
+						Set_Level_Wetted(m_Cells_Gather[k][i], k);
+					}
+				}
+			}
 		}
 	}
 	else
@@ -676,13 +875,175 @@ bool COverland_Flow::Do_Time_Step(void)
 	}
 
 	//-----------------------------------------------------
+	CSG_Array_sLong Cells;	// cells receiving lateral flow, wet cells storing water and cells receiving precipitation
+
+	for(int k=0; k<m_nLevels; k++)
+	{
+		Cells += m_Cells_Gather[k];
+	}
+
+	for(sLong i=0; i<m_Wet.Get_Size(); i++)
+	{
+		if( m_Gather.asInt(m_Wet[i]) == -1 )
+		{
+			Cells += m_Wet[i]; m_Gather.Set_Value(m_Wet[i], -2.);	// listed
+		}
+	}
+
+	for(sLong i=0; i<m_Rain.Get_Size(); i++)
+	{
+		if( m_Gather.asInt(m_Rain[i]) == -1 )
+		{
+			Cells += m_Rain[i];
+		}
+	}
+
 	#pragma omp parallel for
-	for(int y=0; y<Get_NY(); y++) for(int x=0; x<Get_NX(); x++)
+	for(sLong i=0; i<Cells.Get_Size(); i++)
 	{
-		Set_Flow_Vertical(x, y);
+		Set_Flow_Vertical((int)(Cells[i] % Get_NX()), (int)(Cells[i] / Get_NX()));
+	}
+
+	for(sLong i=0; i<Cells.Get_Size(); i++)
+	{
+		m_Level.Set_Value(Cells[i], -1.); m_Gather.Set_Value(Cells[i], -1.);
+	}
+
+	return( Set_Wet(&Cells) );
+}
+
+//---------------------------------------------------------
+// Assigns each wet cell with flow to a velocity class. Level
+// (m_nLevels - 1) takes the time step of the fastest cells,
+// each lower level twice the time step of the next higher.
+// Cells receive lateral flow from their own and neighbouring
+// levels, they are collected by the highest of these. The
+// level of a collected cell is kept as (-2 - level).
+//---------------------------------------------------------
+bool COverland_Flow::Set_Levels(const CSG_Vector &v)
+{
+	for(int k=0; k<8; k++)
+	{
+		m_Cells[k].Set_Array(0, false); m_Cells_Gather[k].Set_Array(0, false);
+	}
+
+	if( m_vMax <= 0. )
+	{
+		return( false );
 	}
 
 	//-----------------------------------------------------
+	for(sLong i=0; i<m_Wet.Get_Size(); i++)
+	{
+		int x = (int)(m_Wet[i] % Get_NX()), y = (int)(m_Wet[i] / Get_NX());
+
+		if( m_pFlow->asDouble(x, y) > 0. )
+		{
+			int Level = m_nLevels - 1; for(double vLevel=m_vMax/2.; Level>0 && v[i]<=vLevel; vLevel/=2.) { Level--; }
+
+			m_Level.Set_Value(x, y, Level); m_Cells[Level] += m_Wet[i];
+
+			for(int j=-1; j<8; j++)
+			{
+				int ix = j < 0 ? x : Get_xTo(j, x), iy = j < 0 ? y : Get_yTo(j, y);
+
+				if( m_pDEM->is_InGrid(ix, iy) && m_Gather.asInt(ix, iy) < Level )
+				{
+					m_Gather.Set_Value(ix, iy, Level);
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	for(int k=0; k<m_nLevels; k++)
+	{
+		for(sLong i=0; i<m_Cells[k].Get_Size(); i++)
+		{
+			int x = (int)(m_Cells[k][i] % Get_NX()), y = (int)(m_Cells[k][i] / Get_NX());
+
+			for(int j=-1; j<8; j++)
+			{
+				int ix = j < 0 ? x : Get_xTo(j, x), iy = j < 0 ? y : Get_yTo(j, y), Gather;
+
+				if( m_pDEM->is_InGrid(ix, iy) && (Gather = m_Gather.asInt(ix, iy)) >= 0 )
+				{
+					m_Cells_Gather[Gather] += (sLong)iy * Get_NX() + ix;
+
+					m_Gather.Set_Value(ix, iy, -2. - Gather);	// collected
+				}
+			}
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// A cell that gets wet during the sub-steps of a time step
+// becomes a donor itself. It takes the lowest level of the
+// cells collecting it and its neighbours, so that all of its
+// receivers are updated whenever it passes water on. Its
+// neighbours, that are not collected yet, are added to the
+// cells collected by this level.
+//---------------------------------------------------------
+bool COverland_Flow::Set_Level_Wetted(sLong Cell, int Level)
+{
+	int x = (int)(Cell % Get_NX()), y = (int)(Cell / Get_NX());
+
+	for(int j=0; j<8; j++)
+	{
+		int ix = Get_xTo(j, x), iy = Get_yTo(j, y), Gather;
+
+		if( m_pDEM->is_InGrid(ix, iy) && (Gather = -2 - m_Gather.asInt(ix, iy)) >= 0 && Level > Gather )
+		{
+			Level = Gather;
+		}
+	}
+
+	m_Level.Set_Value(x, y, Level); m_Cells[Level] += Cell;
+
+	for(int j=0; j<8; j++)
+	{
+		int ix = Get_xTo(j, x), iy = Get_yTo(j, y);
+
+		if( m_pDEM->is_InGrid(ix, iy) && m_Gather.asInt(ix, iy) == -1 )
+		{
+			m_Cells_Gather[Level] += (sLong)iy * Get_NX() + ix;
+
+			m_Gather.Set_Value(ix, iy, -2. - Level);	// collected
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool COverland_Flow::Set_Wet(const CSG_Array_sLong *pCells)
+{
+	m_Wet.Set_Array(0, false); m_Wet.Set_Growth(TSG_Array_Growth::SG_ARRAY_GROWTH_2);
+
+	sLong nCells = pCells ? pCells->Get_Size() : Get_NCells();
+
+	for(sLong i=0; i<nCells; i++)
+	{
+		sLong n = pCells ? (*pCells)[i] : i;
+
+		if( !m_pDEM->is_NoData(n) )
+		{
+			if( m_pFlow->asDouble(n) > 0.
+			|| (m_pIntercept && m_pIntercept->asDouble(n) > 0.)
+			|| (m_pPonding   && m_pPonding  ->asDouble(n) > 0.) )
+			{
+				m_Wet += n;
+			}
+			else if( m_pVelocity )
+			{
+				m_pVelocity->Set_Value(n, 0.);
+			}
+		}
+	}
+
 	return( true );
 }
 
@@ -813,18 +1174,18 @@ inline double COverland_Flow::Get_Velocity(double Flow, double Slope, double Rou
 }
 
 //---------------------------------------------------------
-bool COverland_Flow::Get_Velocity(int x, int y)
+double COverland_Flow::Get_Velocity(int x, int y)
 {
 	if( m_pDEM->is_NoData(x, y) )
 	{
-		return( false );
+		return( 0. );
 	}
 
-	double	Flow = m_pFlow->asDouble(x, y);
+	double	Flow = m_pFlow->asDouble(x, y), vMax = 0.;
 
 	if( Flow > 0. )
 	{
-		double	vMax = 0., vSum = 0.;
+		double	vSum = 0.;
 
 		for(int i=0; i<8; i++)
 		{
@@ -849,17 +1210,6 @@ bool COverland_Flow::Get_Velocity(int x, int y)
 			}
 		}
 
-		if( m_vMax < vMax )
-		{
-			#pragma omp critical
-			{
-				if( m_vMax < vMax )	// could have been changed by another thread after the comparison outside the critical section
-				{
-					m_vMax = vMax;
-				}
-			}
-		}
-
 		//-------------------------------------------------
 		m_v[8].Set_Value(x, y, vSum);
 
@@ -876,7 +1226,7 @@ bool COverland_Flow::Get_Velocity(int x, int y)
 		}
 	}
 
-	return( true );
+	return( vMax );
 }
 
 
@@ -885,7 +1235,7 @@ bool COverland_Flow::Get_Velocity(int x, int y)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-inline double COverland_Flow::Get_Flow_Lateral(int x, int y, int i, bool bInverse)
+inline double COverland_Flow::Get_Flow_Lateral(int x, int y, int i, bool bInverse, int Level)
 {
 	if( bInverse )
 	{
@@ -897,11 +1247,18 @@ inline double COverland_Flow::Get_Flow_Lateral(int x, int y, int i, bool bInvers
 		i	= (i + 4) % 8;
 	}
 
-	double	Flow, v;
+	int	Level_Donor = m_Level.asInt(x, y);
+
+	if( Level_Donor < Level )	// donor is not updated in this sub-step
+	{
+		return( 0. );
+	}
+
+	double	Flow, v, dTime = m_dTime / (1 << Level_Donor);
 
 	if( (Flow = m_pFlow->asDouble(x, y)) > 0. && (v = m_v[i].asDouble(x, y)) > 0. )
 	{
-		Flow	= Flow * v / m_v[8].asDouble(x, y) * m_dTime * v / Get_Length(i);
+		Flow	= Flow * v / m_v[8].asDouble(x, y) * dTime * v / Get_Length(i);
 
 		if( m_bFlow_Out && !bInverse && !is_InGrid(Get_xTo(i, x), Get_yTo(i, y)) )
 		{
@@ -916,17 +1273,17 @@ inline double COverland_Flow::Get_Flow_Lateral(int x, int y, int i, bool bInvers
 }
 
 //---------------------------------------------------------
-bool COverland_Flow::Set_Flow_Lateral(int x, int y)
+bool COverland_Flow::Set_Flow_Lateral(int x, int y, int Level)
 {
 	double	iFlow, Flow = m_pFlow->asDouble(x, y);
 
 	for(int i=0; i<8; i++)
 	{
-		if     ( (iFlow = Get_Flow_Lateral(x, y, i, false)) > 0. )	// downslope flow leaving cell
+		if     ( (iFlow = Get_Flow_Lateral(x, y, i, false, Level)) > 0. )	// downslope flow leaving cell
 		{
 			Flow	-= iFlow;
 		}
-		else if( (iFlow = Get_Flow_Lateral(x, y, i,  true)) > 0. )	// upslope flow entering cell
+		else if( (iFlow = Get_Flow_Lateral(x, y, i,  true, Level)) > 0. )	// upslope flow entering cell
 		{
 			Flow	+= iFlow;
 		}
@@ -972,7 +1329,7 @@ bool COverland_Flow::Set_Flow_Vertical(int x, int y)
 		}
 	}
 
-	double	Q    = P + m_Flow.asDouble(x, y) + (m_pPonding ? m_pPonding->asDouble(x, y) : 0.);
+	double	Q    = P + m_pFlow->asDouble(x, y) + (m_pPonding ? m_pPonding->asDouble(x, y) : 0.);
 
 	//-----------------------------------------------------
 	if( Q > 0. )
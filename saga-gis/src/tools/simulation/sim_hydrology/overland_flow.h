@@ -85,6 +85,8 @@ private:
 
 	bool					m_bStrickler, m_bFlow_Out;
 
+	int						m_nLevels;
+
 	double					m_dTime, m_vMax, m_vMin, m_Flow_Out;
 
 	CSG_Grid				*m_pDEM, m_Flow, *m_pFlow, *m_pVelocity, *m_pIntercept, *m_pPonding, *m_pInfiltrat;
@@ -94,13 +96,20 @@ private:
 
 	CSG_Grids				m_v;
 
+	CSG_Grid				m_Level, m_Gather;
+
+	CSG_Array_sLong			m_Wet, m_Rain, m_Cells[8], m_Cells_Gather[8];
+
 	CSG_Shapes				*m_pMonitor_Points;
 
 	CSG_Table				*m_pMonitor_Series;
 
+	CSG_Simulation_State	m_State;
+
 
 	bool					Initialize				(void);
 	bool					Finalize				(void);
+	bool					Initialize_State		(double &Time);
 
 	bool					Do_Updates				(void);
 	bool					Do_Monitor				(double Time);
@@ -108,6 +117,9 @@ private:
 	bool					Set_Time_Stamp			(double Time);
 
 	bool					Do_Time_Step			(void);
+	bool					Set_Levels				(const CSG_Vector &v);
+	bool					Set_Level_Wetted		(sLong Cell, int Level);
+	bool					Set_Wet					(const CSG_Array_sLong *pCells = NULL);
 
 	double					Get_Precipitation		(int x, int y);
 	double					Get_ETpot				(int x, int y);
@@ -122,10 +134,10 @@ private:
 	double					Get_Slope				(int x, int y, int i);
 
 	double					Get_Velocity			(double Flow, double Slope, double Roughness);
-	bool					Get_Velocity			(int x, int y);
+	double					Get_Velocity			(int x, int y);
 
-	double					Get_Flow_Lateral		(int x, int y, int i, bool bInverse);
-	bool					Set_Flow_Lateral		(int x, int y);
+	double					Get_Flow_Lateral		(int x, int y, int i, bool bInverse, int Level);
+	bool					Set_Flow_Lateral		(int x, int y, int Level);
 
 	bool					Set_Flow_Vertical		(int x, int y);
 
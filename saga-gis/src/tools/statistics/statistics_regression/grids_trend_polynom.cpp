@@ -252,19 +252,38 @@ bool CGrids_Trend::On_Execute(void)
 	CSG_Grid *pP      = Parameters("P"     )->is_Enabled() ? Parameters("P"     )->asGrid() : NULL;
 	CSG_Grid *pStdErr = Parameters("STDERR")->is_Enabled() ? Parameters("STDERR")->asGrid() : NULL;
 
+	//-----------------------------------------------------
+	CSG_Grids *pYCube = pYGrids->Get_Item_Count() == 1 && pYGrids->Get_Item(0)->Get_ObjectType() == SG_DATAOBJECT_TYPE_Grids
+		? pYGrids->Get_Item(0)->asGrids() : NULL;	// a single grid collection provides contiguous z-profiles
+
+	if( pYCube && !pYCube->Set_Profiles() )
+	{
+		pYCube = NULL;
+	}
+
+	double Offset  = pYCube && pYCube->is_Scaled() ? pYCube->Get_Offset () : 0.;	// profiles provide unscaled values
+	double Scaling = pYCube && pYCube->is_Scaled() ? pYCube->Get_Scaling() : 1.;
+
 	//-----------------------------------------------------
 	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 	{
+		if( pYCube )
+		{
+			pYCube->Set_Profiles_Row(y);	// without it the layers are read
+		}
+
 		#pragma omp parallel for
 		for(int x=0; x<Get_NX(); x++)
 		{
 			CSG_Vector	Samples[2];
 
+			const double *Profile = pYCube ? pYCube->Get_Profile(x, y) : NULL;
+
 			for(int i=0; i<nGrids; i++)
 			{
-				if( !pYGrids->Get_Grid(i)->is_NoData(x, y) )
+				if( Profile ? !pYCube->is_NoData_Value(Profile[i]) : !pYGrids->Get_Grid(i)->is_NoData(x, y) )
 				{
-					CSG_Vector Sample; Sample.Add_Row(pYGrids->Get_Grid(i)->asDouble(x, y));
+					CSG_Vector Sample; Sample.Add_Row(Profile ? Offset + Scaling * Profile[i] : pYGrids->Get_Grid(i)->asDouble(x, y));
 
 					switch( xSource )
 					{
@@ -344,6 +363,16 @@ bool CGrids_Trend::On_Execute(void)
 				if( pP      ) pP     ->Set_NoData(x, y);
 			}
 		}
+
+		if( pYCube )
+		{
+			pYCube->Set_Profiles_Row(y, false);
+		}
+	}
+
+	if( pYCube )
+	{
+		pYCube->Set_Profiles(false);
 	}
 
 	//-----------------------------------------------------
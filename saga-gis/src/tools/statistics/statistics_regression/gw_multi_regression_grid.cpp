@@ -46,6 +46,8 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <atomic>
+
 #include "gw_multi_regression_grid.h"
 
 
@@ -362,6 +364,25 @@ bool CGW_Multi_Regression_Grid::Initialize(CSG_Shapes *pPoints, int iDependent,
 		}
 	}
 
+	//-----------------------------------------------------
+	// sample values in a plain matrix for fast access:
+	// dependent, predictors, x, y
+
+	m_Samples.Create(3 + m_nPredictors, m_Points.Get_Count());
+
+	for(sLong iPoint=0; iPoint<m_Points.Get_Count(); iPoint++)
+	{
+		CSG_Shape *pPoint = m_Points.Get_Shape(iPoint); double *Sample = m_Samples[iPoint];
+
+		for(iPredictor=0; iPredictor<=m_nPredictors; iPredictor++)
+		{
+			Sample[iPredictor] = pPoint->asDouble(iPredictor);
+		}
+
+		Sample[1 + m_nPredictors] = pPoint->Get_Point().x;
+		Sample[2 + m_nPredictors] = pPoint->Get_Point().y;
+	}
+
 	//-----------------------------------------------------
 	m_Weighting.Set_Parameters(Parameters);
 
@@ -373,6 +394,7 @@ void CGW_Multi_Regression_Grid::Finalize(void)
 {
 	m_Search.Finalize();
 	m_Points.Destroy();
+	m_Samples.Destroy();
 }
 
 
@@ -386,86 +408,88 @@ bool CGW_Multi_Regression_Grid::Get_Model(void)
 	bool bLogistic = Parameters("LOGISTIC")->asBool();
 
 	//-----------------------------------------------------
-	for(int y=0; y<m_dimModel.Get_NY() && Set_Progress(y, m_dimModel.Get_NY()); y++)
+	// each thread reuses its own solver and search buffers
+
+	std::atomic<int> nDone(0); std::atomic<bool> bOkay(true);	// shared between the main thread and the workers
+
+	#pragma omp parallel
 	{
-		#pragma omp parallel for
-		for(int x=0; x<m_dimModel.Get_NX(); x++)
+		CGWR_Solver Model; Model.Create(m_nPredictors, bLogistic); CSG_Array_sLong Index; CSG_Vector Distance;
+
+		#pragma omp for schedule(dynamic)
+		for(int y=0; y<m_dimModel.Get_NY(); y++)
 		{
-			CSG_Regression_Weighted	Model;
+			if( SG_OMP_Get_Thread_Num() == 0 && !Set_Progress(nDone, m_dimModel.Get_NY()) )	// user interaction only on the main thread
+			{
+				bOkay = false;
+			}
 
-			if( Get_Model(x, y, Model, bLogistic) )
+			for(int x=0; x<m_dimModel.Get_NX() && bOkay; x++)
 			{
-				m_pQuality->Set_Value(x, y, Model.Get_R2());
+				if( Get_Model(x, y, Model, Index, Distance) )
+				{
+					m_pQuality->Set_Value(x, y, Model.Get_R2());
 
-				m_pModel[m_nPredictors]->Set_Value(x, y, Model[0]);
+					m_pModel[m_nPredictors]->Set_Value(x, y, Model[0]);
 
-				for(int i=0; i<m_nPredictors; i++)
-				{
-					m_pModel[i]->Set_Value(x, y, Model[i + 1]);
+					for(int i=0; i<m_nPredictors; i++)
+					{
+						m_pModel[i]->Set_Value(x, y, Model[i + 1]);
+					}
 				}
-			}
-			else
-			{
-				m_pQuality->Set_NoData(x, y);
-
-				for(int i=0; i<=m_nPredictors; i++)
+				else
 				{
-					m_pModel[i]->Set_NoData(x, y);
+					m_pQuality->Set_NoData(x, y);
+
+					for(int i=0; i<=m_nPredictors; i++)
+					{
+						m_pModel[i]->Set_NoData(x, y);
+					}
 				}
 			}
+
+			nDone++;
 		}
 	}
 
 	//-----------------------------------------------------
-	return( true );
+	return( bOkay );
 }
 
 //---------------------------------------------------------
-bool CGW_Multi_Regression_Grid::Get_Model(int x, int y, CSG_Regression_Weighted &Model, bool bLogistic)
+bool CGW_Multi_Regression_Grid::Get_Model(int x, int y, CGWR_Solver &Model, CSG_Array_sLong &Index, CSG_Vector &Distance)
 {
-	Model.Destroy(); TSG_Point Point = m_dimModel.Get_Grid_to_World(x, y); CSG_Vector Predictors(m_nPredictors);
+	Model.Clear(); TSG_Point Point = m_dimModel.Get_Grid_to_World(x, y);
 
 	//-----------------------------------------------------
 	if( m_Search.Do_Use_All() )
 	{
-		for(sLong iPoint=0; iPoint<m_Points.Get_Count(); iPoint++)
+		for(sLong iPoint=0; iPoint<m_Samples.Get_NRows(); iPoint++)
 		{
-			CSG_Shape *pPoint = m_Points.Get_Shape(iPoint);
-
-			for(int iPredictor=0; iPredictor<m_nPredictors; iPredictor++)
-			{
-				Predictors[iPredictor] = pPoint->asDouble(1 + iPredictor);
-			}
+			double *Sample = m_Samples[iPoint];
 
-			Model.Add_Sample(m_Weighting.Get_Weight(SG_Get_Distance(Point, pPoint->Get_Point())), pPoint->asDouble(0), Predictors);
+			Model.Add_Sample(m_Weighting.Get_Weight(SG_Get_Distance(Point.x, Point.y, Sample[1 + m_nPredictors], Sample[2 + m_nPredictors])), Sample[0], Sample + 1);
 		}
 	}
 
 	//-----------------------------------------------------
 	else
 	{
-		CSG_Array_sLong Index; CSG_Vector Distance;
-
 		if( !m_Search.Get_Points(Point, Index, Distance) )
 		{
 			return( false );
 		}
 
-		for(sLong iPoint=0; iPoint<Index.Get_Size(); iPoint++)
+		for(sLong i=0; i<Index.Get_Size(); i++)
 		{
-			CSG_Shape *pPoint = m_Points.Get_Shape(Index[iPoint]);
-
-			for(int iPredictor=0; iPredictor<m_nPredictors; iPredictor++)
-			{
-				Predictors[iPredictor] = pPoint->asDouble(1 + iPredictor);
-			}
+			double *Sample = m_Samples[Index[i]];
 
-			Model.Add_Sample(m_Weighting.Get_Weight(Distance[iPoint]), pPoint->asDouble(0), Predictors);
+			Model.Add_Sample(m_Weighting.Get_Weight(Distance[i]), Sample[0], Sample + 1);
 		}
 	}
 
 	//-----------------------------------------------------
-	return( Model.Calculate(bLogistic) );
+	return( Model.Calculate() );
 }
 
 
@@ -57,7 +57,7 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-#include "MLB_Interface.h"
+#include "gwr_solver.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -97,12 +97,14 @@ private:
 
 	CSG_Shapes						m_Points;
 
+	CSG_Matrix						m_Samples;
+
 
 	bool							Initialize				(CSG_Shapes *pPoints, int iDependent, CSG_Parameter_Grid_List *pPredictors);
 	void							Finalize				(void);
 
 	bool							Get_Model				(void);
-	bool							Get_Model				(int x, int y, CSG_Regression_Weighted &Model, bool bLogistic);
+	bool							Get_Model				(int x, int y, CGWR_Solver &Model, CSG_Array_sLong &Index, CSG_Vector &Distance);
 
 	bool							Set_Model				(void);
 	bool							Set_Model				(double x, double y, double &Value);
@@ -46,6 +46,8 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <atomic>
+
 #include "gw_regression_grid.h"
 
 
@@ -182,7 +184,7 @@ bool CGW_Regression_Grid::On_Execute(void)
 	m_Weighting.Set_Parameters(Parameters);
 
 	//-----------------------------------------------------
-	if( !m_Search.Initialize(m_pPoints, -1) )
+	if( !Set_Samples() || !m_Search.Initialize(m_pPoints, -1) )
 	{
 		return( false );
 	}
@@ -198,32 +200,55 @@ bool CGW_Regression_Grid::On_Execute(void)
 	bool	bLogistic	= Parameters("LOGISTIC")->asBool();
 
 	//-----------------------------------------------------
-	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
+	// each thread reuses its own solver and search buffers
+
+	std::atomic<int> nDone(0); std::atomic<bool> bOkay(true);	// shared between the main thread and the workers
+
+	#pragma omp parallel
 	{
-		#pragma omp parallel for
-		for(int x=0; x<Get_NX(); x++)
-		{
-			CSG_Regression_Weighted	Model;
+		CGWR_Solver Model; Model.Create(1, bLogistic); CSG_Array_sLong Index; CSG_Vector Distance;
 
-			if( !m_pPredictor->is_NoData(x, y) && Get_Model(x, y, Model, bLogistic) )
+		#pragma omp for schedule(dynamic)
+		for(int y=0; y<Get_NY(); y++)
+		{
+			if( SG_OMP_Get_Thread_Num() == 0 && !Set_Progress(nDone, Get_NY()) )	// user interaction only on the main thread
 			{
-				double	Value	= Model[0] + Model[1] * m_pPredictor->asDouble(x, y);
-
-				SG_GRID_PTR_SAFE_SET_VALUE(m_pRegression, x, y, bLogistic ? 1. / (1. + exp(-Value)) : Value);
-				SG_GRID_PTR_SAFE_SET_VALUE(m_pIntercept , x, y, Model[0]);
-				SG_GRID_PTR_SAFE_SET_VALUE(m_pSlope     , x, y, Model[1]);
-				SG_GRID_PTR_SAFE_SET_VALUE(m_pQuality   , x, y, Model.Get_CV_R2());
+				bOkay = false;
 			}
-			else
+
+			for(int x=0; x<Get_NX() && bOkay; x++)
 			{
-				SG_GRID_PTR_SAFE_SET_NODATA(m_pRegression, x, y);
-				SG_GRID_PTR_SAFE_SET_NODATA(m_pIntercept , x, y);
-				SG_GRID_PTR_SAFE_SET_NODATA(m_pSlope     , x, y);
-				SG_GRID_PTR_SAFE_SET_NODATA(m_pQuality   , x, y);
+				if( !m_pPredictor->is_NoData(x, y) && Get_Model(x, y, Model, Index, Distance) )
+				{
+					double	Value	= Model[0] + Model[1] * m_pPredictor->asDouble(x, y);
+
+					SG_GRID_PTR_SAFE_SET_VALUE(m_pRegression, x, y, bLogistic ? 1. / (1. + exp(-Value)) : Value);
+					SG_GRID_PTR_SAFE_SET_VALUE(m_pIntercept , x, y, Model[0]);
+					SG_GRID_PTR_SAFE_SET_VALUE(m_pSlope     , x, y, Model[1]);
+					SG_GRID_PTR_SAFE_SET_VALUE(m_pQuality   , x, y, Model.Get_R2());
+				}
+				else
+				{
+					SG_GRID_PTR_SAFE_SET_NODATA(m_pRegression, x, y);
+					SG_GRID_PTR_SAFE_SET_NODATA(m_pIntercept , x, y);
+					SG_GRID_PTR_SAFE_SET_NODATA(m_pSlope     , x, y);
+					SG_GRID_PTR_SAFE_SET_NODATA(m_pQuality   , x, y);
+				}
 			}
+
+			nDone++;
 		}
 	}
 
+	m_Samples.Destroy(); m_bSample.Destroy();
+
+	if( !bOkay )
+	{
+		m_Search.Finalize();
+
+		return( false );
+	}
+
 	//-----------------------------------------------------
 	Set_Residuals();
 
@@ -242,20 +267,49 @@ bool CGW_Regression_Grid::On_Execute(void)
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-bool CGW_Regression_Grid::Get_Model(int x, int y, CSG_Regression_Weighted &Model, bool bLogistic)
+// Dependent and predictor values are looked up only once for
+// each point, not for each cell that uses the point.
+//---------------------------------------------------------
+bool CGW_Regression_Grid::Set_Samples(void)
+{
+	m_bSample.Create(m_pPoints->Get_Count());
+	m_Samples.Create(4, m_pPoints->Get_Count());	// dependent, predictor, x, y
+
+	sLong nSamples = 0;
+
+	for(sLong iPoint=0; iPoint<m_pPoints->Get_Count(); iPoint++)
+	{
+		CSG_Shape *pPoint = m_pPoints->Get_Shape(iPoint); double Value;
+
+		if( (m_bSample[iPoint] = !pPoint->is_NoData(m_iDependent) && m_pPredictor->Get_Value(pPoint->Get_Point(), Value)) != 0 )
+		{
+			m_Samples[iPoint][0] = pPoint->asDouble(m_iDependent);
+			m_Samples[iPoint][1] = Value;
+			m_Samples[iPoint][2] = pPoint->Get_Point().x;
+			m_Samples[iPoint][3] = pPoint->Get_Point().y;
+
+			nSamples++;
+		}
+	}
+
+	return( nSamples > 1 );
+}
+
+//---------------------------------------------------------
+bool CGW_Regression_Grid::Get_Model(int x, int y, CGWR_Solver &Model, CSG_Array_sLong &Index, CSG_Vector &Distance)
 {
-	Model.Destroy(); TSG_Point Point = Get_System().Get_Grid_to_World(x, y);
+	Model.Clear(); TSG_Point Point = Get_System().Get_Grid_to_World(x, y);
 
 	//-----------------------------------------------------
 	if( m_Search.Do_Use_All() )
 	{
 		for(sLong iPoint=0; iPoint<m_pPoints->Get_Count(); iPoint++)
 		{
-			CSG_Shape *pPoint = m_pPoints->Get_Shape(iPoint); double Value;
-
-			if( !pPoint->is_NoData(m_iDependent) && m_pPredictor->Get_Value(pPoint->Get_Point(), Value) )
+			if( m_bSample[iPoint] )
 			{
-				Model.Add_Sample(m_Weighting.Get_Weight(SG_Get_Distance(Point, pPoint->Get_Point())), pPoint->asDouble(m_iDependent), CSG_Vector(1, &Value));
+				double *Sample = m_Samples[iPoint];
+
+				Model.Add_Sample(m_Weighting.Get_Weight(SG_Get_Distance(Point.x, Point.y, Sample[2], Sample[3])), Sample[0], Sample + 1);
 			}
 		}
 	}
@@ -263,26 +317,22 @@ bool CGW_Regression_Grid::Get_Model(int x, int y, CSG_Regression_Weighted &Model
 	//-----------------------------------------------------
 	else
 	{
-		CSG_Array_sLong Index; CSG_Vector Distance;
-
 		if( !m_Search.Get_Points(Point, Index, Distance) )
 		{
 			return( false );
 		}
 
-		for(sLong iPoint=0; iPoint<Index.Get_Size(); iPoint++)
+		for(sLong i=0; i<Index.Get_Size(); i++)
 		{
-			CSG_Shape *pPoint = m_pPoints->Get_Shape(Index[iPoint]); double Value;
-
-			if( !pPoint->is_NoData(m_iDependent) && m_pPredictor->Get_Value(pPoint->Get_Point(), Value) )
+			if( m_bSample[Index[i]] )
 			{
-				Model.Add_Sample(m_Weighting.Get_Weight(Distance[iPoint]), pPoint->asDouble(m_iDependent), CSG_Vector(1, &Value));
+				Model.Add_Sample(m_Weighting.Get_Weight(Distance[i]), m_Samples[Index[i]][0], m_Samples[Index[i]] + 1);
 			}
 		}
 	}
 
 	//-----------------------------------------------------
-	return( Model.Calculate(bLogistic) );
+	return( Model.Calculate() );
 }
 
 
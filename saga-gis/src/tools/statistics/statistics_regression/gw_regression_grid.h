@@ -57,7 +57,7 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-#include "MLB_Interface.h"
+#include "gwr_solver.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -95,8 +95,14 @@ private:
 
 	CSG_Grid						*m_pPredictor, *m_pRegression, *m_pQuality, *m_pIntercept, *m_pSlope;
 
+	CSG_Array_Int					m_bSample;
 
-	bool							Get_Model				(int x, int y, CSG_Regression_Weighted &Model, bool bLogistic);
+	CSG_Matrix						m_Samples;
+
+
+	bool							Set_Samples				(void);
+
+	bool							Get_Model				(int x, int y, CGWR_Solver &Model, CSG_Array_sLong &Index, CSG_Vector &Distance);
 
 	bool							Set_Residuals			(void);
 
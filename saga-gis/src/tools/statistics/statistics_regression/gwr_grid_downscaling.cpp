@@ -46,6 +46,8 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
+#include <atomic>
+
 #include "gwr_grid_downscaling.h"
 
 
@@ -130,6 +132,15 @@ CGWR_Grid_Downscaling::CGWR_Grid_Downscaling(void)
 		false
 	);
 
+	Parameters.Add_Choice("",
+		"INTERPOLATION"	, _TL("Parameter Interpolation"),
+		_TL("Interpolation method used to transfer the regression parameters and residuals from the coarse resolution of the dependent variable to the target resolution."),
+		CSG_String::Format("%s|%s",
+			_TL("Bilinear Interpolation"),
+			_TL("B-Spline Interpolation")
+		), 1
+	);
+
 	//-----------------------------------------------------
 	Parameters.Add_Choice("",
 		"SEARCH_RANGE"	, _TL("Search Range"),
@@ -287,50 +298,60 @@ bool CGWR_Grid_Downscaling::Get_Model(void)
 
 	CSG_Grid_System	System(m_pDependent->Get_System());
 
-	for(int y=0; y<System.Get_NY() && Set_Progress(y, System.Get_NY()); y++)
+	std::atomic<int> nDone(0); std::atomic<bool> bOkay(true);	// shared between the main thread and the workers
+
+	#pragma omp parallel
 	{
-		#pragma omp parallel for
-		for(int x=0; x<System.Get_NX(); x++)
+		CGWR_Solver	Model;	Model.Create(m_nPredictors, bLogistic);	CSG_Vector	Predictors(m_nPredictors);
+
+		#pragma omp for schedule(dynamic)
+		for(int y=0; y<System.Get_NY(); y++)
 		{
-			CSG_Regression_Weighted	Model;
+			if( SG_OMP_Get_Thread_Num() == 0 && !Set_Progress(nDone, System.Get_NY()) )	// user interaction only on the main thread
+			{
+				bOkay = false;
+			}
 
-			if( Get_Model(x, y, Model, bLogistic) )
+			for(int x=0; x<System.Get_NX() && bOkay; x++)
 			{
-				m_pQuality->Set_Value(x, y, Model.Get_R2());
+				if( Get_Model(x, y, Model, Predictors) )
+				{
+					m_pQuality->Set_Value(x, y, Model.Get_R2());
 
-				m_pModel[m_nPredictors]->Set_Value(x, y, Model[0]);	// intercept
+					m_pModel[m_nPredictors]->Set_Value(x, y, Model[0]);	// intercept
 
-				for(int i=0; i<m_nPredictors; i++)
-				{
-					m_pModel[i]->Set_Value(x, y, Model[i + 1]);
+					for(int i=0; i<m_nPredictors; i++)
+					{
+						m_pModel[i]->Set_Value(x, y, Model[i + 1]);
+					}
 				}
-			}
-			else
-			{
-				m_pQuality->Set_NoData(x, y);
-
-				for(int i=0; i<=m_nPredictors; i++)
+				else
 				{
-					m_pModel[i]->Set_NoData(x, y);
-				}
+					m_pQuality->Set_NoData(x, y);
 
-				m_pResiduals->Set_NoData(x, y);
+					for(int i=0; i<=m_nPredictors; i++)
+					{
+						m_pModel[i]->Set_NoData(x, y);
+					}
+
+					m_pResiduals->Set_NoData(x, y);
+				}
 			}
+
+			nDone++;
 		}
 	}
 
 	//-----------------------------------------------------
 	m_Search.Destroy();
 
-	return( true );
+	return( bOkay );
 }
 
 //---------------------------------------------------------
-bool CGWR_Grid_Downscaling::Get_Model(int x, int y, CSG_Regression_Weighted &Model, bool bLogistic)
+bool CGWR_Grid_Downscaling::Get_Model(int x, int y, CGWR_Solver &Model, CSG_Vector &Predictors)
 {
-	CSG_Vector	Predictors(m_nPredictors);
-
-	Model.Destroy();
+	Model.Clear();
 
 	//-----------------------------------------------------
 	for(int i=0, ix, iy; i<m_Search.Get_Count(); i++)
@@ -353,13 +374,13 @@ bool CGWR_Grid_Downscaling::Get_Model(int x, int y, CSG_Regression_Weighted &Mod
 
 			if( Weight > 0.0 )
 			{
-				Model.Add_Sample(Weight, m_pDependent->asDouble(ix, iy), Predictors);
+				Model.Add_Sample(Weight, m_pDependent->asDouble(ix, iy), Predictors.Get_Data());
 			}
 		}
 	}
 
 	//-----------------------------------------------------
-	if( Model.Calculate(bLogistic) )
+	if( Model.Calculate() )
 	{
 		m_pResiduals->Set_NoData(x, y);
 
@@ -396,7 +417,7 @@ bool CGWR_Grid_Downscaling::Get_Model(int x, int y, CSG_Regression_Weighted &Mod
 //---------------------------------------------------------
 bool CGWR_Grid_Downscaling::Set_Model(double x, double y, double &Value, double &Residual)
 {
-	if( !m_pModel[m_nPredictors]->Get_Value(x, y, Value, GRID_RESAMPLING_BSpline) )
+	if( !m_pModel[m_nPredictors]->Get_Value(x, y, Value, m_Resampling) )
 	{
 		return( false );
 	}
@@ -405,7 +426,7 @@ bool CGWR_Grid_Downscaling::Set_Model(double x, double y, double &Value, double
 
 	for(int i=0; i<m_nPredictors; i++)
 	{
-		if( !m_pModel     [i]->Get_Value(x, y, Model    , GRID_RESAMPLING_BSpline)
+		if( !m_pModel     [i]->Get_Value(x, y, Model    , m_Resampling)
 		||  !m_pPredictors[i]->Get_Value(x, y, Predictor, GRID_RESAMPLING_BSpline) )
 		{
 			return( false );
@@ -414,7 +435,7 @@ bool CGWR_Grid_Downscaling::Set_Model(double x, double y, double &Value, double
 		Value	+= Model * Predictor;
 	}
 
-	if( !m_pResiduals->Get_Value(x, y, Residual, GRID_RESAMPLING_BSpline) )
+	if( !m_pResiduals->Get_Value(x, y, Residual, m_Resampling) )
 	{
 		Residual	= 0.0;
 	}
@@ -437,6 +458,8 @@ bool CGWR_Grid_Downscaling::Set_Model(void)
 
 	bool	bLogistic	= Parameters("LOGISTIC")->asBool();
 
+	m_Resampling	= Parameters("INTERPOLATION")->asInt() == 0 ? GRID_RESAMPLING_Bilinear : GRID_RESAMPLING_BSpline;
+
 	for(int y=0; y<Get_NY() && Set_Progress_Rows(y); y++)
 	{
 		double	p_y	= Get_YMin() + y * Get_Cellsize();
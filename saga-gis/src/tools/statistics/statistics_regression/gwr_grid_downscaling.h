@@ -57,7 +57,7 @@
 ///////////////////////////////////////////////////////////
 
 //---------------------------------------------------------
-#include "MLB_Interface.h"
+#include "gwr_solver.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -86,13 +86,15 @@ private:
 
 	int								m_nPredictors;
 
+	TSG_Grid_Resampling				m_Resampling;
+
 	CSG_Grid_Cell_Addressor			m_Search;
 
 	CSG_Grid						*m_pDependent, **m_pPredictors, **m_pModel, *m_pQuality, *m_pResiduals;
 
 
 	bool							Get_Model				(void);
-	bool							Get_Model				(int x, int y, CSG_Regression_Weighted &Model, bool bLogistic);
+	bool							Get_Model				(int x, int y, CGWR_Solver &Model, CSG_Vector &Predictors);
 
 	bool							Set_Model				(double x, double y, double &Value, double &Residual);
 	bool							Set_Model				(void);
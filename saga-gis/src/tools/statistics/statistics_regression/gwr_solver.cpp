@@ -0,0 +1,413 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                 statistics_regression                 //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                    gwr_solver.cpp                     //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//                         agent                         //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "gwr_solver.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Each sample is stored as one array entry:
+// weight, dependent, probability (logistic), 1, predictors...
+//---------------------------------------------------------
+#define SAMPLE_W	0
+#define SAMPLE_Y	1
+#define SAMPLE_P	2
+#define SAMPLE_X	3
+
+//---------------------------------------------------------
+#define LOG_MAXITER		30
+#define LOG_EPSILON		0.001
+#define LOG_DIFFERENCE	1000.
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CGWR_Solver::CGWR_Solver(void)
+{
+	m_bLogistic	= false;
+	m_nCoeffs	= 0;
+	m_R2		= -1.;
+}
+
+//---------------------------------------------------------
+bool CGWR_Solver::Create(int nPredictors, bool bLogistic)
+{
+	if( nPredictors < 1 )
+	{
+		return( false );
+	}
+
+	m_bLogistic	= bLogistic;
+	m_nCoeffs	= 1 + nPredictors;
+	m_R2		= -1.;
+
+	m_Samples.Create((SAMPLE_X + m_nCoeffs) * sizeof(double), 0, TSG_Array_Growth::SG_ARRAY_GROWTH_2);
+
+	m_b     .Create(m_nCoeffs);
+	m_b_Best.Create(m_nCoeffs);
+	m_v     .Create(m_nCoeffs);
+	m_N     .Create(m_nCoeffs, m_nCoeffs);
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CGWR_Solver::Add_Sample(double Weight, double Dependent, const double *Predictors)
+{
+	if( m_nCoeffs < 2 || !m_Samples.Inc_Array() )
+	{
+		return( false );
+	}
+
+	double *Sample = _Get_Sample(Get_Sample_Count() - 1);
+
+	Sample[SAMPLE_W] = Weight;
+	Sample[SAMPLE_Y] = Dependent;
+	Sample[SAMPLE_P] = 0.;
+	Sample[SAMPLE_X] = 1.;
+
+	for(int i=1; i<m_nCoeffs; i++)
+	{
+		Sample[SAMPLE_X + i] = Predictors[i - 1];
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+double CGWR_Solver::Get_Value(const double *Predictors) const
+{
+	double Value = m_b[0];
+
+	for(int i=1; i<m_nCoeffs; i++)
+	{
+		Value += m_b[i] * Predictors[i - 1];
+	}
+
+	return( Value );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CGWR_Solver::Calculate(void)
+{
+	m_R2 = -1.;
+
+	int nSamples = Get_Sample_Count();
+
+	if( nSamples < m_nCoeffs || nSamples < 2 )
+	{
+		return( false );
+	}
+
+	if( !(m_bLogistic ? _Get_Logistic() : _Get_Linear()) )
+	{
+		return( false );
+	}
+
+	//-----------------------------------------------------
+	double yMean = 0.;
+
+	for(int i=0; i<nSamples; i++)
+	{
+		yMean += _Get_Sample(i)[SAMPLE_Y];
+	}
+
+	yMean /= nSamples;
+
+	double rss = 0., tss = 0.;
+
+	for(int i=0; i<nSamples; i++)
+	{
+		double *Sample = _Get_Sample(i), yr = Get_Value(Sample + SAMPLE_X + 1);
+
+		if( m_bLogistic )
+		{
+			yr = 1. / (1. + exp(-yr));
+		}
+
+		rss += Sample[SAMPLE_W] * SG_Get_Square(Sample[SAMPLE_Y] - yr   );
+		tss += Sample[SAMPLE_W] * SG_Get_Square(Sample[SAMPLE_Y] - yMean);
+	}
+
+	if( tss > 0. && tss >= rss )
+	{
+		m_R2 = fabs(tss - rss) / tss;
+
+		return( true );
+	}
+
+	return( false );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+bool CGWR_Solver::_Get_Linear(void)
+{
+	if( !_Solve(false) )
+	{
+		return( false );
+	}
+
+	for(int i=0; i<m_nCoeffs; i++)
+	{
+		m_b[i] = m_v[i];
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+// Iteratively reweighted least squares, following the
+// stopping rules of CSG_Regression_Weighted.
+//---------------------------------------------------------
+bool CGWR_Solver::_Get_Logistic(void)
+{
+	bool bBest = false;
+
+	m_b.Assign(0.);
+
+	for(int i=0; i<Get_Sample_Count(); i++)
+	{
+		_Get_Sample(i)[SAMPLE_P] = 0.5;
+	}
+
+	//-----------------------------------------------------
+	for(int Iteration=0; Iteration<LOG_MAXITER; Iteration++)
+	{
+		if( !_Solve(true) )
+		{
+			break;
+		}
+
+		bool bNoChange = true, bOutOfControl = false, bZero = false;
+
+		for(int j=0; j<m_nCoeffs; j++)
+		{
+			if( SG_is_NaN(m_v[j]) )
+			{
+				return( bBest && m_b.Assign(m_b_Best) );
+			}
+
+			if( fabs(m_v[j]) > LOG_EPSILON )
+			{
+				bNoChange = false;
+			}
+
+			if( !bZero && !bOutOfControl )
+			{
+				if( m_b[j] == 0. )
+				{
+					bZero = true;
+				}
+				else if( fabs(m_v[j]) / fabs(m_b[j]) > LOG_DIFFERENCE )
+				{
+					bOutOfControl = true;
+				}
+			}
+		}
+
+		if( bNoChange )
+		{
+			for(int j=0; j<m_nCoeffs; j++)
+			{
+				m_b[j] += m_v[j];
+			}
+
+			return( true );
+		}
+
+		if( bOutOfControl )
+		{
+			break;
+		}
+
+		//-------------------------------------------------
+		for(int j=0; j<m_nCoeffs; j++)
+		{
+			m_b[j] += m_v[j]; m_b_Best[j] = m_b[j];
+		}
+
+		bBest = true;
+
+		for(int i=0; i<Get_Sample_Count(); i++)
+		{
+			double *Sample = _Get_Sample(i);
+
+			Sample[SAMPLE_P] = 1. / (1. + exp(-Get_Value(Sample + SAMPLE_X + 1)));
+		}
+	}
+
+	return( bBest && m_b.Assign(m_b_Best) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Sets up the normal equations (X'WX) v = X'Wy, resp. for
+// the logistic update (X'WVX) v = X'W(y - p), and solves
+// them in place with a Cholesky decomposition. Only the
+// lower triangle of the symmetric matrix is used.
+//---------------------------------------------------------
+bool CGWR_Solver::_Solve(bool bLogistic)
+{
+	int n = m_nCoeffs; double **N = m_N.Get_Data(), *v = m_v.Get_Data();
+
+	for(int j=0; j<n; j++)
+	{
+		v[j] = 0.; for(int k=0; k<=j; k++) { N[j][k] = 0.; }
+	}
+
+	for(int i=0; i<Get_Sample_Count(); i++)
+	{
+		double *Sample = _Get_Sample(i), *x = Sample + SAMPLE_X, w, r;
+
+		if( bLogistic )
+		{
+			w = Sample[SAMPLE_W] * Sample[SAMPLE_P] * (1. - Sample[SAMPLE_P]);
+			r = Sample[SAMPLE_W] * (Sample[SAMPLE_Y] - Sample[SAMPLE_P]);
+		}
+		else
+		{
+			w = Sample[SAMPLE_W];
+			r = Sample[SAMPLE_W] *  Sample[SAMPLE_Y];
+		}
+
+		for(int j=0; j<n; j++)
+		{
+			double wx = w * x[j];
+
+			for(int k=0; k<=j; k++)
+			{
+				N[j][k] += wx * x[k];
+			}
+
+			v[j] += r * x[j];
+		}
+	}
+
+	//-----------------------------------------------------
+	for(int j=0; j<n; j++)	// decomposition, N = L L'
+	{
+		double d = N[j][j];
+
+		for(int k=0; k<j; k++)
+		{
+			d -= N[j][k] * N[j][k];
+		}
+
+		if( d <= 0. || SG_is_NaN(d) )
+		{
+			return( false );	// not positive definite
+		}
+
+		N[j][j] = d = sqrt(d);
+
+		for(int i=j+1; i<n; i++)
+		{
+			double s = N[i][j];
+
+			for(int k=0; k<j; k++)
+			{
+				s -= N[i][k] * N[j][k];
+			}
+
+			N[i][j] = s / d;
+		}
+	}
+
+	for(int j=0; j<n; j++)	// forward substitution, L y = b
+	{
+		for(int k=0; k<j; k++)
+		{
+			v[j] -= N[j][k] * v[k];
+		}
+
+		v[j] /= N[j][j];
+	}
+
+	for(int j=n-1; j>=0; j--)	// backward substitution, L' x = y
+	{
+		for(int k=j+1; k<n; k++)
+		{
+			v[j] -= N[k][j] * v[k];
+		}
+
+		v[j] /= N[j][j];
+	}
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
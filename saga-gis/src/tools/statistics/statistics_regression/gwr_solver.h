@@ -0,0 +1,127 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                 statistics_regression                 //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//                     gwr_solver.h                      //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//                         agent                         //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef HEADER_INCLUDED__gwr_solver_H
+#define HEADER_INCLUDED__gwr_solver_H
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "MLB_Interface.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+/**
+  * Weighted (logistic) least squares solver for the local
+  * models of a geographically weighted regression. Results
+  * match those of CSG_Regression_Weighted, but all buffers
+  * are kept between two calls, so that a solver created once
+  * per thread can be reused for all cells without further
+  * memory allocations. The normal equations are solved with
+  * a Cholesky decomposition.
+*/
+//---------------------------------------------------------
+class CGWR_Solver
+{
+public:
+	CGWR_Solver(void);
+
+	bool							Create					(int nPredictors, bool bLogistic = false);
+
+	void							Clear					(void)	{	m_Samples.Set_Array(0, false);	}
+
+	bool							Add_Sample				(double Weight, double Dependent, const double *Predictors);
+	int								Get_Sample_Count		(void)	const	{	return( (int)m_Samples.Get_Size() );	}
+
+	bool							Calculate				(void);
+
+	double							Get_R2					(void)	const	{	return( m_R2   );	}
+	double							operator []				(int i)	const	{	return( m_b[i] );	}
+
+	double							Get_Value				(const double *Predictors)	const;
+
+
+private:
+
+	bool							m_bLogistic;
+
+	int								m_nCoeffs;
+
+	double							m_R2;
+
+	CSG_Array						m_Samples;
+
+	CSG_Vector						m_b, m_b_Best, m_v;
+
+	CSG_Matrix						m_N;
+
+
+	double *						_Get_Sample				(int i)	const	{	return( (double *)m_Samples.Get_Entry(i) );	}
+
+	bool							_Get_Linear				(void);
+	bool							_Get_Logistic			(void);
+
+	bool							_Solve					(bool bLogistic);
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef HEADER_INCLUDED__gwr_solver_H
@@ -109,13 +109,20 @@ CTable_Cluster_Analysis::CTable_Cluster_Analysis(void)
 	Parameters.Add_Choice("",
 		"METHOD"		, _TL("Method"),
 		_TL(""),
-		CSG_String::Format("%s|%s|%s",
+		CSG_String::Format("%s|%s|%s|%s",
 			_TL("Iterative Minimum Distance (Forgy 1965)"),
 			_TL("Hill-Climbing (Rubin 1967)"),
-			_TL("Combined Minimum Distance / Hillclimbing") 
+			_TL("Combined Minimum Distance / Hillclimbing"),
+			_TL("Mini-Batch Minimum Distance (Sculley 2010)")
 		), 1
 	);
 
+	Parameters.Add_Int("METHOD",
+		"BATCH_SIZE"	, _TL("Batch Size"),
+		_TL("Number of randomly sampled elements used per iteration by the mini-batch method."),
+		1000, 10, true
+	);
+
 	Parameters.Add_Int("",
 		"NCLUSTER"		, _TL("Number of Clusters"),
 		_TL(""),
@@ -134,6 +141,11 @@ CTable_Cluster_Analysis::CTable_Cluster_Analysis(void)
 //---------------------------------------------------------
 int CTable_Cluster_Analysis::On_Parameters_Enable(CSG_Parameters *pParameters, CSG_Parameter *pParameter)
 {
+	if(	pParameter->Cmp_Identifier("METHOD") )
+	{
+		pParameters->Set_Enabled("BATCH_SIZE", pParameter->asInt() == 3);
+	}
+
 	if(	pParameter->Cmp_Identifier("INPUT") )
 	{
 		if( pParameter->asDataObject() )
@@ -258,7 +270,7 @@ bool CTable_Cluster_Analysis::On_Execute(void)
 	}
 
 	//-----------------------------------------------------
-	bool bResult = Analysis.Execute(Parameters("METHOD")->asInt(), Parameters("NCLUSTER")->asInt());
+	bool bResult = Analysis.Execute(Parameters("METHOD")->asInt(), Parameters("NCLUSTER")->asInt(), 0, 0, Parameters("BATCH_SIZE")->asInt());
 
 	for(sLong i=0, n=0; i<pTable->Get_Count() && Set_Progress(i, pTable->Get_Count()); i++)
 	{
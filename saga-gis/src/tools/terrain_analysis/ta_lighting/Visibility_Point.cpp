@@ -93,6 +93,18 @@ bool CVisibility::Create(CSG_Parameters &Parameters)
 		false
 	);
 
+	Parameters.Add_Choice("",
+		"ALGORITHM" , _TL("Algorithm"),
+		_TL("Line of sight tracing checks each cell with its own ray to the observer. "
+		    "Horizon propagation sweeps outwards from the observer ring by ring and derives "
+		    "each cell's horizon from the interpolated horizons of its two neighbours on the previous ring, "
+		    "which only needs a single pass over the grid per observer. Multiple observers are then processed in parallel."),
+		CSG_String::Format("%s|%s",
+			_TL("line of sight tracing"),
+			_TL("horizon propagation")
+		), 0
+	);
+
 	return( true );
 }
 
@@ -105,6 +117,7 @@ bool CVisibility::Initialize(const CSG_Parameters &Parameters)
 	m_bIgnoreNoData = Parameters("NODATA"    )->asBool();
 	m_bDegree       = Parameters("UNIT"      )->asInt () == 1;
 	m_bCumulative   = Parameters("CUMULATIVE")->asBool();
+	m_Algorithm     = Parameters("ALGORITHM" )->asInt ();
 
 	m_pDEM->Set_Max_Samples(m_pDEM->Get_NCells());	// we use max z (queried by Get_Max()) as a breaking condition in ray tracing
 
@@ -169,12 +182,18 @@ bool CVisibility::Finalize(bool bShow)
 
 //---------------------------------------------------------
 bool CVisibility::Reset(void)
+{
+	return( _Reset(m_pVisibility) );
+}
+
+//---------------------------------------------------------
+bool CVisibility::_Reset(CSG_Grid *pVisibility)
 {
 	switch( m_Method )
 	{
-	case  0: m_pVisibility->Assign(      0.); break; // Visibility
-	case  1: m_pVisibility->Assign(M_PI_090); break; // Shade
-	default: m_pVisibility->Assign_NoData( ); break; // Distance, Size
+	case  0: pVisibility->Assign(      0.); break; // Visibility
+	case  1: pVisibility->Assign(M_PI_090); break; // Shade
+	default: pVisibility->Assign_NoData( ); break; // Distance, Size
 	}
 
 	return( true );
@@ -193,10 +212,18 @@ bool CVisibility::Set_Visibility(int xOrigin, int yOrigin, double Height, bool b
 		Reset();
 	}
 
+	//-----------------------------------------------------
+	if( is_Horizon_Propagation() )
+	{
+		CSG_Grid Horizon(m_pDEM->Get_System(), SG_DATATYPE_Float);
+
+		return( _Set_Horizon(xOrigin, yOrigin, Height, Horizon, m_pVisibility, true) );
+	}
+
+	//-----------------------------------------------------
 	double zOrigin = m_pDEM->asDouble(xOrigin, yOrigin) + Height;
 	double zMax    = m_pDEM->Get_Max();
 
-	//-----------------------------------------------------
 	for(int y=0; y<m_pDEM->Get_NY() && SG_UI_Process_Set_Progress(y, m_pDEM->Get_NY()); y++)
 	{
 		#ifndef _DEBUG
@@ -217,58 +244,7 @@ bool CVisibility::Set_Visibility(int xOrigin, int yOrigin, double Height, bool b
 				//-----------------------------------------
 				if( _Trace_Point(x, y, dx, dy, dz, xOrigin, yOrigin, zMax) )
 				{
-					switch( m_Method )
-					{
-					default: { // Visibility
-						m_pVisibility->Set_Value(x, y, 1.);
-						break; }
-
-					case  1: { // Shade
-						double dec, azi; const double Exaggeration = 1.;
-
-						if( m_pDEM->Get_Gradient(x, y, dec, azi) )
-						{
-							dec	= M_PI_090 - atan(Exaggeration * tan(dec));
-
-							double decSrc = atan2(dz, sqrt(dx*dx + dy*dy));
-							double aziSrc = atan2(dx, dy);
-
-							double d = acos(sin(dec) * sin(decSrc) + cos(dec) * cos(decSrc) * cos(azi - aziSrc)); if( d > M_PI_090 ) { d = M_PI_090; }
-
-							if( m_pVisibility->asDouble(x, y) > d )
-							{
-								m_pVisibility->Set_Value(x, y, d);
-							}
-						}
-						break; }
-
-					case  2: { // Distance
-						double d = m_pDEM->Get_Cellsize() * sqrt(dx*dx + dy*dy);
-
-						if( m_pVisibility->is_NoData(x, y) || m_pVisibility->asDouble(x, y) > d )
-						{
-							m_pVisibility->Set_Value(x, y, d);
-						}
-						break; }
-
-					case  3: { // Size
-						double d = m_pDEM->Get_Cellsize() * sqrt(dx*dx + dy*dy);
-
-						if( d > 0. )
-						{
-							d = atan2(fabs(Height), d); if( m_bDegree ) { d *= M_RAD_TO_DEG; }
-
-							if( m_pVisibility->is_NoData(x, y) || (!m_bCumulative && m_pVisibility->asDouble(x, y) < d) )
-							{
-								m_pVisibility->Set_Value(x, y, d);
-							}
-							else if( m_bCumulative )
-							{
-								m_pVisibility->Add_Value(x, y, d);
-							}
-						}
-						break; }
-					}
+					_Set_Value(m_pVisibility, x, y, dx, dy, dz, Height);
 				}
 			}
 		}
@@ -277,6 +253,174 @@ bool CVisibility::Set_Visibility(int xOrigin, int yOrigin, double Height, bool b
 	return( true );
 }
 
+//---------------------------------------------------------
+// Processes all observers with horizon propagation in
+// parallel. Each thread accumulates its observers into its
+// own visibility buffer, which are finally reduced into the
+// target grid. Observer cells are expected to be in the grid.
+//---------------------------------------------------------
+bool CVisibility::Set_Visibility(const CSG_Points_Int &Cells, const CSG_Vector &Heights)
+{
+	int nThreads = (int)M_GET_MIN((sLong)SG_OMP_Get_Max_Num_Threads(), Cells.Get_Count());
+
+	if( nThreads < 1 )
+	{
+		return( false );
+	}
+
+	CSG_Grid *Horizon = new CSG_Grid[nThreads], *Visibility = new CSG_Grid[nThreads];
+
+	for(int i=0; i<nThreads; i++)
+	{
+		Horizon   [i].Create(m_pDEM->Get_System(), SG_DATATYPE_Float);
+		Visibility[i].Create(m_pDEM->Get_System(), SG_DATATYPE_Float); _Reset(&Visibility[i]);
+	}
+
+	//-----------------------------------------------------
+	sLong nDone = 0; bool bOkay = true;
+
+	#ifndef _DEBUG
+	#pragma omp parallel for schedule(dynamic) num_threads(nThreads)
+	#endif
+	for(sLong i=0; i<Cells.Get_Count(); i++)
+	{
+		if( bOkay )
+		{
+			int iThread = SG_OMP_Get_Thread_Num();
+
+			_Set_Horizon(Cells[i].x, Cells[i].y, Heights[i], Horizon[iThread], &Visibility[iThread], false);
+
+			#pragma omp atomic
+			nDone++;
+
+			if( iThread == 0 && !SG_UI_Process_Set_Progress(nDone, Cells.Get_Count()) )
+			{
+				bOkay = false;
+			}
+		}
+	}
+
+	delete[](Horizon);
+
+	//-----------------------------------------------------
+	for(int y=0; y<m_pDEM->Get_NY() && bOkay; y++)
+	{
+		#ifndef _DEBUG
+		#pragma omp parallel for
+		#endif
+		for(int x=0; x<m_pDEM->Get_NX(); x++)
+		{
+			if( m_pDEM->is_NoData(x, y) )
+			{
+				m_pVisibility->Set_NoData(x, y);
+			}
+			else for(int i=0; i<nThreads; i++)
+			{
+				if( !Visibility[i].is_NoData(x, y) )
+				{
+					_Add_Value(m_pVisibility, x, y, Visibility[i].asDouble(x, y));
+				}
+			}
+		}
+	}
+
+	delete[](Visibility);
+
+	return( bOkay );
+}
+
+//---------------------------------------------------------
+void CVisibility::_Set_Value(CSG_Grid *pVisibility, int x, int y, double dx, double dy, double dz, double Height)
+{
+	switch( m_Method )
+	{
+	default: { // Visibility
+		pVisibility->Set_Value(x, y, 1.);
+		break; }
+
+	case  1: { // Shade
+		double dec, azi; const double Exaggeration = 1.;
+
+		if( m_pDEM->Get_Gradient(x, y, dec, azi) )
+		{
+			dec	= M_PI_090 - atan(Exaggeration * tan(dec));
+
+			double decSrc = atan2(dz, sqrt(dx*dx + dy*dy));
+			double aziSrc = atan2(dx, dy);
+
+			double d = acos(sin(dec) * sin(decSrc) + cos(dec) * cos(decSrc) * cos(azi - aziSrc)); if( d > M_PI_090 ) { d = M_PI_090; }
+
+			if( pVisibility->asDouble(x, y) > d )
+			{
+				pVisibility->Set_Value(x, y, d);
+			}
+		}
+		break; }
+
+	case  2: { // Distance
+		double d = m_pDEM->Get_Cellsize() * sqrt(dx*dx + dy*dy);
+
+		if( pVisibility->is_NoData(x, y) || pVisibility->asDouble(x, y) > d )
+		{
+			pVisibility->Set_Value(x, y, d);
+		}
+		break; }
+
+	case  3: { // Size
+		double d = m_pDEM->Get_Cellsize() * sqrt(dx*dx + dy*dy);
+
+		if( d > 0. )
+		{
+			d = atan2(fabs(Height), d); if( m_bDegree ) { d *= M_RAD_TO_DEG; }
+
+			_Add_Value(pVisibility, x, y, d);
+		}
+		break; }
+	}
+}
+
+//---------------------------------------------------------
+// Combines a cell's value with the value already stored,
+// following the same rules as used for multiple observers.
+//---------------------------------------------------------
+void CVisibility::_Add_Value(CSG_Grid *pVisibility, int x, int y, double Value)
+{
+	switch( m_Method )
+	{
+	default: // Visibility
+		if( pVisibility->asDouble(x, y) < Value )
+		{
+			pVisibility->Set_Value(x, y, Value);
+		}
+		break;
+
+	case  1: // Shade
+		if( pVisibility->asDouble(x, y) > Value )
+		{
+			pVisibility->Set_Value(x, y, Value);
+		}
+		break;
+
+	case  2: // Distance
+		if( pVisibility->is_NoData(x, y) || pVisibility->asDouble(x, y) > Value )
+		{
+			pVisibility->Set_Value(x, y, Value);
+		}
+		break;
+
+	case  3: // Size
+		if( pVisibility->is_NoData(x, y) || (!m_bCumulative && pVisibility->asDouble(x, y) < Value) )
+		{
+			pVisibility->Set_Value(x, y, Value);
+		}
+		else if( m_bCumulative )
+		{
+			pVisibility->Add_Value(x, y, Value);
+		}
+		break;
+	}
+}
+
 //---------------------------------------------------------
 bool CVisibility::_Trace_Point(int x, int y, double dx, double dy, double dz, int xOrigin, int yOrigin, double zMax)
 {
@@ -337,6 +481,104 @@ bool CVisibility::_Trace_Point(int x, int y, double dx, double dy, double dz, in
 }
 
 
+//---------------------------------------------------------
+// Horizon propagation visits the cells on square rings of
+// growing size around the observer. A cell's horizon, i.e.
+// the steepest slope seen from the observer between observer
+// and cell, is interpolated from the two cells of the previous
+// ring that enclose the line of sight. The cell is visible if
+// its own slope is not below that horizon.
+//---------------------------------------------------------
+bool CVisibility::_Set_Horizon(int xOrigin, int yOrigin, double Height, CSG_Grid &Horizon, CSG_Grid *pVisibility, bool bProgress)
+{
+	double zOrigin = m_pDEM->asDouble(xOrigin, yOrigin) + Height;
+
+	_Set_Value(pVisibility, xOrigin, yOrigin, 0., 0., Height, Height);
+
+	int nRings = M_GET_MAX(M_GET_MAX(xOrigin, m_pDEM->Get_NX() - 1 - xOrigin), M_GET_MAX(yOrigin, m_pDEM->Get_NY() - 1 - yOrigin));
+
+	for(int Ring=1; Ring<=nRings; Ring++)
+	{
+		if( bProgress && !SG_UI_Process_Set_Progress(Ring, nRings) )
+		{
+			return( false );
+		}
+
+		int ax = xOrigin - Ring, bx = xOrigin + Ring;
+		int ay = yOrigin - Ring, by = yOrigin + Ring;
+
+		for(int x=ax; x<=bx; x++)
+		{
+			_Set_Horizon(x, ay, xOrigin, yOrigin, zOrigin, Height, Horizon, pVisibility);
+			_Set_Horizon(x, by, xOrigin, yOrigin, zOrigin, Height, Horizon, pVisibility);
+		}
+
+		for(int y=ay+1; y<by; y++)
+		{
+			_Set_Horizon(ax, y, xOrigin, yOrigin, zOrigin, Height, Horizon, pVisibility);
+			_Set_Horizon(bx, y, xOrigin, yOrigin, zOrigin, Height, Horizon, pVisibility);
+		}
+	}
+
+	return( true );
+}
+
+//---------------------------------------------------------
+inline void CVisibility::_Set_Horizon(int x, int y, int xOrigin, int yOrigin, double zOrigin, double Height, CSG_Grid &Horizon, CSG_Grid *pVisibility)
+{
+	if( !m_pDEM->Get_System().is_InGrid(x, y) )
+	{
+		return;
+	}
+
+	const double Blocked = 1e30; // any line of sight through this cell is blocked
+
+	int dx = x - xOrigin, adx = abs(dx);
+	int dy = y - yOrigin, ady = abs(dy);
+
+	double h = -Blocked; // horizon
+
+	if( adx > 1 || ady > 1 ) // not a neighbour of the observer
+	{
+		if( adx >= ady )
+		{
+			double d = dy * (adx - 1) / (double)adx; int ix = x - (dx > 0 ? 1 : -1), iy = yOrigin + (int)floor(d); d -= floor(d);
+
+			h = d > 0. ? (1. - d) * Horizon.asDouble(ix, iy) + d * Horizon.asDouble(ix, iy + 1) : Horizon.asDouble(ix, iy);
+		}
+		else
+		{
+			double d = dx * (ady - 1) / (double)ady; int iy = y - (dy > 0 ? 1 : -1), ix = xOrigin + (int)floor(d); d -= floor(d);
+
+			h = d > 0. ? (1. - d) * Horizon.asDouble(ix, iy) + d * Horizon.asDouble(ix + 1, iy) : Horizon.asDouble(ix, iy);
+		}
+	}
+
+	//-----------------------------------------------------
+	if( m_pDEM->is_NoData(x, y) )
+	{
+		pVisibility->Set_NoData(x, y);
+
+		Horizon.Set_Value(x, y, m_bIgnoreNoData ? h : Blocked);
+	}
+	else
+	{
+		double z = m_pDEM->asDouble(x, y), Slope = (z - zOrigin) / sqrt((double)(dx*dx + dy*dy));
+
+		if( Slope >= h )
+		{
+			_Set_Value(pVisibility, x, y, -dx, -dy, zOrigin - z, Height);
+
+			Horizon.Set_Value(x, y, Slope);
+		}
+		else
+		{
+			Horizon.Set_Value(x, y, h);
+		}
+	}
+}
+
+
 ///////////////////////////////////////////////////////////
 //														 //
 //														 //
@@ -469,7 +711,27 @@ bool CVisibility_Points::On_Execute(void)
 	double Height = Parameters("HEIGHT")->asDouble();
 
 	//-----------------------------------------------------
-	for(sLong iPoint=0; iPoint<pPoints->Get_Count() && Process_Get_Okay(); iPoint++)
+	if( is_Horizon_Propagation() )
+	{
+		CSG_Points_Int Cells; CSG_Vector Heights;
+
+		for(sLong iPoint=0; iPoint<pPoints->Get_Count(); iPoint++)
+		{
+			CSG_Shape &Point = *pPoints->Get_Shape(iPoint);
+
+			int x, y; Get_System().Get_World_to_Grid(x, y, Point.Get_Point());
+
+			if( Parameters("ELEVATION")->asGrid()->is_InGrid(x, y) )
+			{
+				Cells.Add(x, y); Heights.Add_Row(Field < 0 ? Height : Point.asDouble(Field));
+			}
+		}
+
+		Process_Set_Text("%s: %lld", _TL("processing observers"), Cells.Get_Count());
+
+		Set_Visibility(Cells, Heights);
+	}
+	else for(sLong iPoint=0; iPoint<pPoints->Get_Count() && Process_Get_Okay(); iPoint++)
 	{
 		Process_Set_Text("%s %lld...", _TL("processing observer"), 1 + iPoint);
 
@@ -79,19 +79,30 @@ protected:
 	bool					Reset					(void);
 
 	bool					Set_Visibility			(int x, int y, double Height, bool bReset);
+	bool					Set_Visibility			(const CSG_Points_Int &Cells, const CSG_Vector &Heights);
+
+	bool					is_Horizon_Propagation	(void)	const	{	return( m_Algorithm == 1 );	}
 
 
 private:
 
 	bool					m_bIgnoreNoData, m_bDegree, m_bCumulative;
 
-	int						m_Method;
+	int						m_Method, m_Algorithm;
 
 	CSG_Grid				*m_pDEM, *m_pVisibility;
 
 
+	bool					_Reset					(CSG_Grid *pVisibility);
+
+	void					_Set_Value				(CSG_Grid *pVisibility, int x, int y, double dx, double dy, double dz, double Height);
+	void					_Add_Value				(CSG_Grid *pVisibility, int x, int y, double Value);
+
 	bool					_Trace_Point			(int x, int y, double dx, double dy, double dz, int xOrigin, int yOrigin, double zMax);
 
+	bool					_Set_Horizon			(int xOrigin, int yOrigin, double Height, CSG_Grid &Horizon, CSG_Grid *pVisibility, bool bProgress);
+	void					_Set_Horizon			(int x, int y, int xOrigin, int yOrigin, double zOrigin, double Height, CSG_Grid &Horizon, CSG_Grid *pVisibility);
+
 };
 
 
@@ -47,8 +47,11 @@
 
 //---------------------------------------------------------
 #include <wx/dcclient.h>
+#include <wx/timer.h>
+#include <wx/stopwatch.h>
 
 #include "3d_viewer_pointcloud.h"
+#include "3d_viewer_pointcloud_lod.h"
 
 
 ///////////////////////////////////////////////////////////
@@ -77,6 +80,7 @@ protected:
 	virtual void				Update_Parent			(void);
 
 	virtual void				On_Key_Down				(wxKeyEvent   &event);
+	void						On_Timer				(wxTimerEvent &event);
 
 	virtual bool				On_Before_Draw			(void);
 	virtual bool				On_Draw					(void);
@@ -86,6 +90,8 @@ protected:
 
 private:
 
+	bool						m_bLOD { false }, m_bRefine { false };
+
 	int							m_Coloring;
 
 	double						m_Color_Min, m_Color_Scale, m_Color_Dim_Min, m_Color_Dim_Max;
@@ -100,6 +106,13 @@ private:
 
 	CSG_PointCloud				*m_pPoints;
 
+	CPointCloud_LOD				m_LOD;
+
+	wxTimer						m_Timer;
+
+
+	bool						_Draw_LOD				(int cField, int minSize, double dSize);
+
 
 	//-----------------------------------------------------
 	DECLARE_EVENT_TABLE()
@@ -114,6 +127,7 @@ private:
 //---------------------------------------------------------
 BEGIN_EVENT_TABLE(C3D_Viewer_PointCloud_Panel, CSG_3DView_Panel)
 	EVT_KEY_DOWN	(C3D_Viewer_PointCloud_Panel::On_Key_Down)
+	EVT_TIMER		(wxID_ANY, C3D_Viewer_PointCloud_Panel::On_Timer)
 END_EVENT_TABLE()
 
 
@@ -137,6 +151,7 @@ C3D_Viewer_PointCloud_Panel::C3D_Viewer_PointCloud_Panel(wxWindow *pParent, CSG_
 
 	//----------------------------------------------------
 	m_Parameters.Add_Double    ("GENERAL"    , "DETAIL"       , _TL("Level of Detail"   ), _TL(""), 100., 0., true, 100., true);
+	m_Parameters.Add_Int       ("DETAIL"     , "FRAME_TIME"   , _TL("Frame Time Budget" ), _TL("Time in milliseconds to be spent on drawing while navigating. Remaining details are added, when navigation stops."), 100, 10, true);
 
 	m_Parameters.Add_Choice    ("GENERAL"    , "COLORING"     , _TL("Coloring"          ), _TL(""), CSG_String::Format("%s|%s|%s|%s", _TL("Classified"), _TL("Discrete Colors"), _TL("Graduated Colors"), _TL("RGB Coded Values")), Coloring);
 	m_Parameters.Add_Choice    ("COLORING"   , "COLORS_ATTR"  , _TL("Attribute"         ), _TL(""), Attributes, Attribute);
@@ -183,6 +198,17 @@ C3D_Viewer_PointCloud_Panel::C3D_Viewer_PointCloud_Panel(wxWindow *pParent, CSG_
 	m_Selection.Create(sizeof(sLong), 0, TSG_Array_Growth::SG_ARRAY_GROWTH_2);
 
 	Update_Statistics();
+
+	//-----------------------------------------------------
+	// the octree is built in the background, until it is
+	// ready the view falls back to drawing every n-th point
+
+	m_Timer.SetOwner(this);
+
+	if( m_LOD.Create(m_pPoints) )
+	{
+		m_Timer.Start(500);
+	}
 }
 
 
@@ -279,6 +305,24 @@ void C3D_Viewer_PointCloud_Panel::Update_Statistics(void)
 		m_Data_Min.z = m_pPoints->Get_Minimum(2);	// Get_ZMin();	ToDo in CSG_PointCloud class!!!
 		m_Data_Max.z = m_pPoints->Get_Maximum(2);	// Get_ZMax();	ToDo in CSG_PointCloud class!!!
 	}
+	else if( m_bLOD )
+	{
+		CSG_Simple_Statistics cStats; double zMin, zMax;
+
+		if( m_LOD.Get_Statistics(m_Extent, cField, zMin, zMax, cStats) )
+		{
+			if( m_Parameters("COLORS_FIT")->asInt() == 0 )
+			{
+				m_Parameters("COLORS_RANGE")->asRange()->Set_Range(
+					cStats.Get_Mean() - cSigma * cStats.Get_StdDev(),
+					cStats.Get_Mean() + cSigma * cStats.Get_StdDev()
+				);
+			}
+
+			m_Data_Min.z = zMin;
+			m_Data_Max.z = zMax;
+		}
+	}
 	else
 	{
 		CSG_Simple_Statistics zStats, cStats;
@@ -351,6 +395,28 @@ void C3D_Viewer_PointCloud_Panel::On_Key_Down(wxKeyEvent &event)
 	}
 }
 
+//---------------------------------------------------------
+void C3D_Viewer_PointCloud_Panel::On_Timer(wxTimerEvent &event)
+{
+	if( !m_bLOD )
+	{
+		if( m_LOD.is_Ready() )
+		{
+			m_Timer.Stop(); m_bLOD = true;
+
+			Update_View(true);
+		}
+	}
+	else if( HasCapture() )	// still navigating, try again later
+	{
+		m_Timer.StartOnce(300);
+	}
+	else					// draw with full detail, ignoring the frame time budget
+	{
+		m_bRefine = true; Update_View(); m_bRefine = false;
+	}
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
@@ -479,7 +545,12 @@ bool C3D_Viewer_PointCloud_Panel::On_Draw(void)
 
 	//-----------------------------------------------------
 	int minSize = m_Parameters("SIZE")->asInt(); double dSize = m_Parameters("SIZE_SCALE")->asDouble() / 100.;
-	
+
+	if( m_bLOD )
+	{
+		return( _Draw_LOD(cField, minSize, dSize) );
+	}
+
 	int   nSkip = 1 + (int)(0.001 * m_pPoints->Get_Count() * SG_Get_Square(1. - 0.01 * m_Parameters("DETAIL")->asDouble()));
 
 	sLong nPoints = m_Selection.Get_Size() > 0 ? m_Selection.Get_Size() : m_pPoints->Get_Count();
@@ -505,6 +576,123 @@ bool C3D_Viewer_PointCloud_Panel::On_Draw(void)
 	return( true );
 }
 
+//---------------------------------------------------------
+// Draws the octree level by level, so that coarse overviews
+// of all visible nodes come first. A node is refined, when
+// the spacing of its sampling cells exceeds the pixel size
+// requested by the level of detail. When the frame time
+// budget is exceeded, the remaining nodes are skipped and
+// drawn later by the refinement timer.
+//---------------------------------------------------------
+bool C3D_Viewer_PointCloud_Panel::_Draw_LOD(int cField, int minSize, double dSize)
+{
+	wxStopWatch StopWatch; long maxTime = m_Parameters("FRAME_TIME")->asInt();
+
+	double Threshold = 0.1 * (100. - m_Parameters("DETAIL")->asDouble());	// max. sampling cell spacing [pixels]
+
+	int Margin = minSize + (dSize > 0. ? 50 : 0), NX = m_Image.GetWidth(), NY = m_Image.GetHeight();
+
+	bool bComplete = true; CSG_Array_Int Queue; Queue += 0;
+
+	for(sLong iQueue=0; iQueue<Queue.Get_Size(); iQueue++)
+	{
+		if( !m_bRefine && StopWatch.Time() > maxTime )
+		{
+			bComplete = false;
+
+			break;
+		}
+
+		const CPointCloud_LOD::TNode &Node = m_LOD.Get_Node(Queue[iQueue]);
+
+		TSG_Intersection Intersection = m_Extent.Intersects(CSG_Rect(Node.Min.x, Node.Min.y, Node.Max.x, Node.Max.y));
+
+		if( Intersection == INTERSECTION_None )
+		{
+			continue;
+		}
+
+		bool bInside = Intersection == INTERSECTION_Contains || Intersection == INTERSECTION_Identical;
+
+		//-------------------------------------------------
+		// frustum culling with the projected bounding box
+
+		bool bBehind = false; double xMin = 0., xMax = 0., yMin = 0., yMax = 0.;
+
+		for(int i=0; i<8; i++)
+		{
+			TSG_Point_3D p;
+
+			p.x = i & 1 ? Node.Max.x : Node.Min.x;
+			p.y = i & 2 ? Node.Max.y : Node.Min.y;
+			p.z = i & 4 ? Node.zMax  : Node.zMin ;
+
+			m_Projector.Get_Projection(p);
+
+			if( p.z <= 0. )
+			{
+				bBehind = true;
+			}
+
+			if( i == 0 )
+			{
+				xMin = xMax = p.x; yMin = yMax = p.y;
+			}
+			else
+			{
+				if( xMin > p.x ) { xMin = p.x; } else if( xMax < p.x ) { xMax = p.x; }
+				if( yMin > p.y ) { yMin = p.y; } else if( yMax < p.y ) { yMax = p.y; }
+			}
+		}
+
+		if( !bBehind && (xMax < -Margin || xMin > NX + Margin || yMax < -Margin || yMin > NY + Margin) )
+		{
+			continue;
+		}
+
+		//-------------------------------------------------
+		#pragma omp parallel for
+		for(sLong i=Node.First; i<Node.First+Node.nPoints; i++)
+		{
+			sLong jPoint = m_LOD.Get_Point(i); TSG_Point_3D p = m_pPoints->Get_Point(jPoint);
+
+			if( bInside || m_Extent.Contains(p.x, p.y) )
+			{
+				m_Projector.Get_Projection(p);
+
+				int Color = Get_Color(m_pPoints->Get_Value(jPoint, cField), p.z);
+
+				if( Color >= 0 )
+				{
+					double Size = minSize; if( dSize > 0. ) { Size += (int)(50. * exp(-p.z / dSize)); }
+
+					Draw_Point(p.x, p.y, p.z, Color, Size);
+				}
+			}
+		}
+
+		//-------------------------------------------------
+		if( bBehind || M_GET_MAX(xMax - xMin, yMax - yMin) / CPointCloud_LOD::Sampling > Threshold )
+		{
+			for(int k=0; k<8; k++)
+			{
+				if( Node.Child[k] >= 0 )
+				{
+					Queue += Node.Child[k];
+				}
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	if( !bComplete )
+	{
+		m_Timer.StartOnce(300);
+	}
+
+	return( true );
+}
+
 
 ///////////////////////////////////////////////////////////
 //														 //
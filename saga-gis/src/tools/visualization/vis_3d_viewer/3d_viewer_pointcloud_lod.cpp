@@ -0,0 +1,377 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                      3d_viewer                        //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//             3d_viewer_pointcloud_lod.cpp              //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//                         agent                         //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include "3d_viewer_pointcloud_lod.h"
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#define LOD_MAX_LEVEL	24	// deeper nodes keep all of their points, e.g. for duplicates
+
+//---------------------------------------------------------
+inline int	LOD_Get_Cell	(double v, double Min, double d)
+{
+	int i = d > 0. ? (int)((v - Min) / d) : 0;
+
+	return( i < 0 ? 0 : i < CPointCloud_LOD::Sampling ? i : CPointCloud_LOD::Sampling - 1 );
+}
+
+//---------------------------------------------------------
+inline int	LOD_Get_Octant	(const TSG_Point_3D &p, const TSG_Point_3D &Center)
+{
+	return( (p.x < Center.x ? 0 : 1) | (p.y < Center.y ? 0 : 2) | (p.z < Center.z ? 0 : 4) );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+CPointCloud_LOD::CPointCloud_LOD(void)
+{
+	m_Nodes.Create(sizeof(TNode), 0, TSG_Array_Growth::SG_ARRAY_GROWTH_3);
+}
+
+//---------------------------------------------------------
+CPointCloud_LOD::~CPointCloud_LOD(void)
+{
+	Destroy();
+}
+
+//---------------------------------------------------------
+bool CPointCloud_LOD::Create(CSG_PointCloud *pPoints)
+{
+	Destroy();
+
+	if( !pPoints || pPoints->Get_Count() < 1 )
+	{
+		return( false );
+	}
+
+	m_pPoints = pPoints;
+
+	m_Thread  = std::thread(&CPointCloud_LOD::_Build, this);
+
+	return( true );
+}
+
+//---------------------------------------------------------
+bool CPointCloud_LOD::Destroy(void)
+{
+	if( m_Thread.joinable() )
+	{
+		m_bCancel = true; m_Thread.join();
+	}
+
+	m_bCancel = false;
+	m_bReady  = false;
+
+	m_Nodes.Set_Array(0);
+	m_Index.Destroy();
+
+	m_pPoints = NULL;
+
+	return( true );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+void CPointCloud_LOD::_Build(void)
+{
+	sLong nPoints = m_pPoints->Get_Count();
+
+	if( !m_Index.Create(nPoints) )
+	{
+		return;
+	}
+
+	// the bounds are taken from the points themselves, because
+	// the point cloud's statistics might be updated concurrently
+
+	TSG_Point_3D Min = m_pPoints->Get_Point(0), Max = Min;
+
+	for(sLong i=0; i<nPoints; i++)
+	{
+		m_Index[i] = i; TSG_Point_3D p = m_pPoints->Get_Point(i);
+
+		if( Min.x > p.x ) { Min.x = p.x; } else if( Max.x < p.x ) { Max.x = p.x; }
+		if( Min.y > p.y ) { Min.y = p.y; } else if( Max.y < p.y ) { Max.y = p.y; }
+		if( Min.z > p.z ) { Min.z = p.z; } else if( Max.z < p.z ) { Max.z = p.z; }
+	}
+
+	if( _Build_Node(Min, Max, 0, nPoints, 0) == 0 && !m_bCancel )
+	{
+		m_bReady = true;
+	}
+}
+
+//---------------------------------------------------------
+int CPointCloud_LOD::_Build_Node(const TSG_Point_3D &Min, const TSG_Point_3D &Max, sLong First, sLong Count, int Level)
+{
+	if( m_bCancel || !m_Nodes.Inc_Array() )
+	{
+		return( -1 );
+	}
+
+	int iNode = (int)m_Nodes.Get_Size() - 1;
+
+	TNode Node; Node.Min = Min; Node.Max = Max; Node.First = First; Node.nPoints = Count; Node.nTotal = Count;
+
+	for(int i=0; i<8; i++)
+	{
+		Node.Child[i] = -1;
+	}
+
+	sLong *Index = m_Index.Get_Array() + First;
+
+	Node.zMin = Node.zMax = m_pPoints->Get_Z(Index[0]);
+
+	for(sLong i=1; i<Count; i++)
+	{
+		double z = m_pPoints->Get_Z(Index[i]);
+
+		if( Node.zMin > z ) { Node.zMin = z; } else if( Node.zMax < z ) { Node.zMax = z; }
+	}
+
+	if( Count <= Sampling * Sampling * Sampling || Level >= LOD_MAX_LEVEL )
+	{
+		*((TNode *)m_Nodes.Get_Entry(iNode)) = Node;
+
+		return( iNode );
+	}
+
+	//-----------------------------------------------------
+	// the first point found in a sampling cell represents it,
+	// representatives are moved to the front of the node's range
+
+	char Cells[Sampling * Sampling * Sampling]; memset(Cells, 0, sizeof(Cells));
+
+	double dx = (Max.x - Min.x) / Sampling, dy = (Max.y - Min.y) / Sampling, dz = (Max.z - Min.z) / Sampling;
+
+	sLong n = 0;
+
+	for(sLong i=0; i<Count; i++)
+	{
+		TSG_Point_3D p = m_pPoints->Get_Point(Index[i]);
+
+		int Cell = LOD_Get_Cell(p.x, Min.x, dx) + Sampling * (LOD_Get_Cell(p.y, Min.y, dy) + Sampling * LOD_Get_Cell(p.z, Min.z, dz));
+
+		if( !Cells[Cell] )
+		{
+			Cells[Cell] = 1; sLong j = Index[i]; Index[i] = Index[n]; Index[n++] = j;
+		}
+	}
+
+	Node.nPoints = n;
+
+	*((TNode *)m_Nodes.Get_Entry(iNode)) = Node;
+
+	//-----------------------------------------------------
+	// the remaining points are sorted in place by octant
+
+	TSG_Point_3D Center; Center.x = (Min.x + Max.x) / 2.; Center.y = (Min.y + Max.y) / 2.; Center.z = (Min.z + Max.z) / 2.;
+
+	sLong Start[9], Next[8]; Start[0] = n;
+
+	for(int k=0; k<8; k++)
+	{
+		Next[k] = 0;
+	}
+
+	for(sLong i=n; i<Count; i++)
+	{
+		Next[LOD_Get_Octant(m_pPoints->Get_Point(Index[i]), Center)]++;
+	}
+
+	for(int k=0; k<8; k++)
+	{
+		Start[k + 1] = Start[k] + Next[k]; Next[k] = Start[k];
+	}
+
+	for(int k=0; k<8; k++)
+	{
+		while( Next[k] < Start[k + 1] )
+		{
+			int o = LOD_Get_Octant(m_pPoints->Get_Point(Index[Next[k]]), Center);
+
+			if( o == k )
+			{
+				Next[k]++;
+			}
+			else
+			{
+				sLong j = Index[Next[k]]; Index[Next[k]] = Index[Next[o]]; Index[Next[o]++] = j;
+			}
+		}
+	}
+
+	//-----------------------------------------------------
+	for(int k=0; k<8; k++)
+	{
+		if( Start[k + 1] > Start[k] )
+		{
+			TSG_Point_3D kMin, kMax;
+
+			kMin.x = k & 1 ? Center.x : Min.x; kMax.x = k & 1 ? Max.x : Center.x;
+			kMin.y = k & 2 ? Center.y : Min.y; kMax.y = k & 2 ? Max.y : Center.y;
+			kMin.z = k & 4 ? Center.z : Min.z; kMax.z = k & 4 ? Max.z : Center.z;
+
+			int iChild = _Build_Node(kMin, kMax, First + Start[k], Start[k + 1] - Start[k], Level + 1);
+
+			if( iChild < 0 )
+			{
+				return( -1 );
+			}
+
+			((TNode *)m_Nodes.Get_Entry(iNode))->Child[k] = iChild;
+		}
+	}
+
+	return( iNode );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Z range and attribute statistics of the points within the
+// given extent. Nodes completely inside the extent contribute
+// their subtree's z range, per point checks are only needed
+// for nodes crossing the extent's border. Attribute statistics
+// are estimated from the representative points of the upper
+// tree levels, until the requested sample size is reached.
+//---------------------------------------------------------
+bool CPointCloud_LOD::Get_Statistics(const CSG_Rect &Extent, int Field, double &zMin, double &zMax, CSG_Simple_Statistics &Stats, sLong maxSamples)
+{
+	Stats.Create(); zMin = 1.; zMax = 0.;
+
+	if( !m_bReady )
+	{
+		return( false );
+	}
+
+	CSG_Array_Int Queue; Queue += 0;
+
+	for(sLong iQueue=0; iQueue<Queue.Get_Size(); iQueue++)
+	{
+		const TNode &Node = Get_Node(Queue[iQueue]);
+
+		TSG_Intersection Intersection = Extent.Intersects(CSG_Rect(Node.Min.x, Node.Min.y, Node.Max.x, Node.Max.y));
+
+		if( Intersection == INTERSECTION_None )
+		{
+			continue;
+		}
+
+		bool bInside = Intersection == INTERSECTION_Contains || Intersection == INTERSECTION_Identical;
+
+		if( bInside )
+		{
+			if( zMin > zMax ) { zMin = Node.zMin; zMax = Node.zMax; } else
+			{
+				if( zMin > Node.zMin ) { zMin = Node.zMin; }
+				if( zMax < Node.zMax ) { zMax = Node.zMax; }
+			}
+
+			if( Stats.Get_Count() >= maxSamples )
+			{
+				continue;
+			}
+		}
+
+		//-------------------------------------------------
+		for(sLong i=Node.First; i<Node.First+Node.nPoints; i++)
+		{
+			sLong j = m_Index[i]; TSG_Point_3D p = m_pPoints->Get_Point(j);
+
+			if( bInside || Extent.Contains(p.x, p.y) )
+			{
+				if( !bInside )
+				{
+					if( zMin > zMax ) { zMin = zMax = p.z; } else
+					{
+						if( zMin > p.z ) { zMin = p.z; } else if( zMax < p.z ) { zMax = p.z; }
+					}
+				}
+
+				if( Stats.Get_Count() < maxSamples )
+				{
+					Stats += m_pPoints->Get_Value(j, Field);
+				}
+			}
+		}
+
+		for(int k=0; k<8; k++)
+		{
+			if( Node.Child[k] >= 0 )
+			{
+				Queue += Node.Child[k];
+			}
+		}
+	}
+
+	return( zMin <= zMax );
+}
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
@@ -0,0 +1,135 @@
+
+///////////////////////////////////////////////////////////
+//                                                       //
+//                         SAGA                          //
+//                                                       //
+//      System for Automated Geoscientific Analyses      //
+//                                                       //
+//                     Tool Library                      //
+//                      3d_viewer                        //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//              3d_viewer_pointcloud_lod.h               //
+//                                                       //
+//                 Copyright (C) 2026 by                 //
+//                         agent                         //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+// This file is part of 'SAGA - System for Automated     //
+// Geoscientific Analyses'. SAGA is free software; you   //
+// can redistribute it and/or modify it under the terms  //
+// of the GNU General Public License as published by the //
+// Free Software Foundation, either version 2 of the     //
+// License, or (at your option) any later version.       //
+//                                                       //
+// SAGA is distributed in the hope that it will be       //
+// useful, but WITHOUT ANY WARRANTY; without even the    //
+// implied warranty of MERCHANTABILITY or FITNESS FOR A  //
+// PARTICULAR PURPOSE. See the GNU General Public        //
+// License for more details.                             //
+//                                                       //
+// You should have received a copy of the GNU General    //
+// Public License along with this program; if not, see   //
+// <http://www.gnu.org/licenses/>.                       //
+//                                                       //
+//-------------------------------------------------------//
+//                                                       //
+//    e-mail:     agent@local                            //
+//                                                       //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#ifndef HEADER_INCLUDED__3d_viewer_pointcloud_lod_H
+#define HEADER_INCLUDED__3d_viewer_pointcloud_lod_H
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#include <saga_api/saga_api.h>
+
+#include <atomic>
+#include <thread>
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+// Octree based level of detail structure for point clouds.
+// Each node keeps a spatially uniform subset of the points
+// within its bounds (at most one point per sampling cell) and
+// passes the remaining points on to its children, so drawing
+// the tree level by level refines from coarse to fine. The
+// tree is built in a background thread and stores the point
+// indices ordered by node; the point cloud is not modified.
+//---------------------------------------------------------
+class CPointCloud_LOD
+{
+public:
+
+	static const int			Sampling = 16;	// sampling grid resolution per axis, i.e. max. 4096 points per node
+
+	typedef struct SNode
+	{
+		TSG_Point_3D			Min, Max;		// node bounds
+		double					zMin, zMax;		// z range of all points in the node's subtree
+		sLong					First, nPoints;	// the node's own points as range of the index array
+		sLong					nTotal;			// number of points in the node's subtree
+		int						Child[8];		// child nodes or -1
+	}
+	TNode;
+
+	//-----------------------------------------------------
+	CPointCloud_LOD(void);
+	virtual ~CPointCloud_LOD(void);
+
+	bool						Create					(CSG_PointCloud *pPoints);
+	bool						Destroy					(void);
+
+	bool						is_Ready				(void)	const	{	return( m_bReady );	}
+
+	int							Get_Node_Count			(void)	const	{	return( (int)m_Nodes.Get_Size() );	}
+	const TNode &				Get_Node				(int i)	const	{	return( ((TNode *)m_Nodes.Get_Array())[i] );	}
+
+	sLong						Get_Point				(sLong i)	const	{	return( m_Index[i] );	}
+
+	bool						Get_Statistics			(const CSG_Rect &Extent, int Field, double &zMin, double &zMax, CSG_Simple_Statistics &Stats, sLong maxSamples = 1000000);
+
+
+private:
+
+	std::atomic<bool>			m_bReady { false }, m_bCancel { false };
+
+	std::thread					m_Thread;
+
+	CSG_Array					m_Nodes;
+
+	CSG_Array_sLong				m_Index;
+
+	CSG_PointCloud				*m_pPoints { NULL };
+
+
+	void						_Build					(void);
+	int							_Build_Node				(const TSG_Point_3D &Min, const TSG_Point_3D &Max, sLong First, sLong Count, int Level);
+
+};
+
+
+///////////////////////////////////////////////////////////
+//														 //
+//														 //
+//														 //
+///////////////////////////////////////////////////////////
+
+//---------------------------------------------------------
+#endif // #ifndef HEADER_INCLUDED__3d_viewer_pointcloud_lod_H